@@ -141,6 +141,13 @@ otInstance *otapp_getOpenThreadInstancePtr(void);
  */
 const otIp6Address *otapp_multicastAddressGet(void);
 
+/**
+ * @brief Gets the multicast address of this device's name group (observe notifications).
+ * Derived with @ref otapp_deviceNameGroupAddressGet, falls back to @ref otapp_multicastAddressGet.
+ * @return const otIp6Address* Pointer to the group multicast IPv6 address.
+ */
+const otIp6Address *otapp_multicastGroupAddressGet(void);
+
 /**
  * @brief Gets the current Mesh-Local EID (IPv6 address) of this device.
  * @return const otIp6Address* Pointer to the IPv6 address.
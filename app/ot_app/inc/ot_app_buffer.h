@@ -13,9 +13,18 @@
  * read/write operations.
  * **Key Features:**
  * - **Static Allocation:** No heap fragmentation (uses `HRO_SEC_NOINIT` section).
- * - **Thread Safety:** All API calls are protected by a mutex.
+ * - **Thread Safety:** Every slot has its own mutex, so users of different keys never serialize each other.
  * - **Zero-Copy Write:** `otapp_buf_getWriteOnly_ptr` allows direct memory access with a locking mechanism.
  * - **Key-Based Access:** Data is organized by predefined keys (e.g., `OTAPP_BUF_KEY_1`).
+ * - **Slot Handles:** `OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1)` resolves the key at compile time, 
+ *   the `otapp_buf_slot_*` API then accesses the slot by direct index.
+ * - **Lock Order:** Operations touching more than one slot (e.g. @ref otapp_buf_appendFromKey) take the slot 
+ *   locks in ascending order of `otapp_buf_init_config[]` and release them in reverse order.
+ * - **Slab Blocks:** Fixed-size scratch blocks with O(1) alloc/free (@ref otapp_buf_slabAlloc), 
+ *   so concurrent handlers do not fail on a locked key.
+ * - **SPSC Ring Slots:** Keys declared with @ref OTAPP_BUF_MODE_SPSC_RING use lock-free 
+ *   single-producer/single-consumer atomics instead of the mutex. The firmware has no ring user yet, 
+ *   `OTAPP_BUF_KEY_4` exists only in the UNIT_TEST pool.
  * **Locking Mechanism (Zero-Copy):**
  * When utilizing direct write access (@ref otapp_buf_getWriteOnly_ptr), the buffer slot is logically **LOCKED**.
  * Any subsequent attempt to write to this key (from any thread) will return @ref OTAPP_BUF_ERROR_WRITE_LOCK
@@ -38,6 +47,7 @@
 #define OT_APP_BUFFER_H_
 
 #include "stdint.h"
+#include "hro_utils.h"
 
 /** @name Return Codes */
 ///@{
@@ -46,26 +56,100 @@
 #define OTAPP_BUF_ERROR_OVERFLOW        (-3) ///< Buffer is full or data exceeds slot size
 #define OTAPP_BUF_ERROR_KEY_NOT_FOUND   (-4) ///< The provided key does not exist in config
 #define OTAPP_BUF_ERROR_WRITE_LOCK      (-5) ///< The slot is currently locked for direct writing
+#define OTAPP_BUF_ERROR_MODE            (-6) ///< The operation is not supported by the slot mode
+#define OTAPP_BUF_ERROR_TIMEOUT         (-7) ///< The slot was not released within the requested wait time
+///@}
+
+/** @name Slot Access Modes */
+///@{
+/** @brief Default mode. Every access is serialized by the pool mutex, any number of writers is allowed. */
+#define OTAPP_BUF_MODE_MUTEX            0
+/** @brief Lock-free single-producer/single-consumer ring.
+ * Exactly one task may call otapp_buf_append() and exactly one task may call otapp_buf_getData()
+ * or otapp_buff_clear() on this key. No mutex is taken, so the producer never blocks behind the reader.
+ * The slot size must be a power of two. Zero-copy pointers are not available in this mode.
+ */
+#define OTAPP_BUF_MODE_SPSC_RING        1
+///@}
+
+/** @name Lease Debug 
+ * Define OTAPP_BUF_LEASE_DEBUG to record the call site (file:line) of every lease owner, 
+ * @ref otapp_buf_leaseReportLeaks then prints who is still holding a slot.
+ * The owner records enlarge every slot entry, so the define is set per build 
+ * (HOST_ot_app_buffer_test sets it in its CMakeLists.txt), not for every UNIT_TEST build.
+ */
+///@{
+// #define OTAPP_BUF_LEASE_DEBUG
+#define OTAPP_BUF_LEASE_DEBUG_OWNERS_MAX    4   ///< Tracked owners per slot (debug mode only)
+///@}
+
+/** @name Write Acquisition Flags 
+ * By default a write pointer / write lease / slab block is zeroed before it is returned. 
+ * Callers that overwrite every reserved byte anyway (e.g. `otMessageRead()` of the whole payload) pass 
+ * @ref OTAPP_BUF_ACQ_NO_CLEAR and skip the memset.
+ */
+///@{
+#define OTAPP_BUF_ACQ_ZERO              0x00 ///< Reserved bytes are zeroed (default)
+#define OTAPP_BUF_ACQ_NO_CLEAR          0x01 ///< Reserved bytes keep the old content (poisoned in OTAPP_BUF_POISON mode)
+///@}
+
+/** @name Debug Poisoning 
+ * Define OTAPP_BUF_POISON to fill bytes that are not guaranteed to be initialized (no-clear acquisition, 
+ * cleared slot, freed slab block) with @ref OTAPP_BUF_POISON_BYTE, so a read of never written data shows up as a 0xA5 pattern.
+ */
+///@{
+// #define OTAPP_BUF_POISON
+#define OTAPP_BUF_POISON_BYTE           0xA5
+///@}
+
+/** @name Write Wait Queue 
+ * Timed write acquisition (@ref otapp_buf_leaseWriteTimed, @ref otapp_buf_getWriteOnly_ptrTimed) and timed slab 
+ * allocation (@ref otapp_buf_slabAllocTimed) queue the caller in FIFO order when the slot / block class is busy. 
+ * The resource is handed to the oldest waiter first, new callers cannot overtake it. 
+ * A waiter blocks on its RTOS task notification (index 0), the release wakes only the head of the queue.
+ */
+///@{
+#define OTAPP_BUF_WAITERS_MAX           4   ///< Queued writers per slot (callers per slab class), further callers fail immediately
+#define OTAPP_BUF_WAIT_FOREVER          0xFFFFFFFFUL ///< Wait without timeout (same value as portMAX_DELAY)
 ///@}
 
 /** @name Buffer Configuration Keys */
 ///@{
 /** @brief Key 1: General purpose buffer.
- * Used by otapp_pair_uriParseMessage() and otapp_pair_uriResourcesCreate().
+ * No firmware user at the moment (handlers take slab blocks), kept small so the slot table is not empty.
  */
 #define OTAPP_BUF_KEY_1         0x1001 
 
 #ifdef UNIT_TEST
     #define OTAPP_BUF_KEY_1_SIZE    30000 
 #else    
-    #define OTAPP_BUF_KEY_1_SIZE    256
+    #define OTAPP_BUF_KEY_1_SIZE    64
 #endif
 
-#define OTAPP_BUF_KEY_2         0x1002 ///< Auxiliary buffer slot 2
-#define OTAPP_BUF_KEY_2_SIZE    64
+#ifdef UNIT_TEST
+    // auxiliary slots of the unit tests, add a firmware slot together with its user
+    #define OTAPP_BUF_KEY_2         0x1002 ///< Auxiliary buffer slot 2
+    #define OTAPP_BUF_KEY_2_SIZE    64
+
+    #define OTAPP_BUF_KEY_3         0x1003 ///< Auxiliary buffer slot 3
+    #define OTAPP_BUF_KEY_3_SIZE    64
 
-#define OTAPP_BUF_KEY_3         0x1003 ///< Auxiliary buffer slot 3
-#define OTAPP_BUF_KEY_3_SIZE    64
+    #define OTAPP_BUF_SLOT_TABLE_AUX(X) \
+        X(OTAPP_BUF_KEY_2, OTAPP_BUF_KEY_2_SIZE, OTAPP_BUF_MODE_MUTEX) \
+        X(OTAPP_BUF_KEY_3, OTAPP_BUF_KEY_3_SIZE, OTAPP_BUF_MODE_MUTEX)
+#else
+    #define OTAPP_BUF_SLOT_TABLE_AUX(X)
+#endif
+
+#ifdef UNIT_TEST
+    // no firmware producer/consumer uses a ring yet: add a ring slot together with its user
+    #define OTAPP_BUF_KEY_4         0x1004 ///< SPSC ring slot of the unit tests
+    #define OTAPP_BUF_KEY_4_SIZE    64     ///< must be a power of two (@ref OTAPP_BUF_MODE_SPSC_RING)
+    #define OTAPP_BUF_SLOT_TABLE_RING(X) \
+        X(OTAPP_BUF_KEY_4, OTAPP_BUF_KEY_4_SIZE, OTAPP_BUF_MODE_SPSC_RING)
+#else
+    #define OTAPP_BUF_SLOT_TABLE_RING(X)
+#endif
 ///@}
 
 /**
@@ -74,22 +158,98 @@
 typedef struct {
     uint16_t key;  ///< Unique identifier for the buffer slot
     uint16_t size; ///< Size in bytes allocated for this slot
+    uint8_t  mode; ///< Access mode: @ref OTAPP_BUF_MODE_MUTEX (default) or @ref OTAPP_BUF_MODE_SPSC_RING
 } bufferConfig_t;
 
+/**
+ * @brief Slot table: X(key, size, mode).
+ * @details Single source of the pool layout. The configuration array, the slot enum, 
+ * the key to slot mapping and @ref OTAPP_BUF_SIZE are all generated from this table.
+ * To add a slot, define its key and size above and add one line here.
+ */
+#define OTAPP_BUF_SLOT_TABLE(X) \
+    X(OTAPP_BUF_KEY_1, OTAPP_BUF_KEY_1_SIZE, OTAPP_BUF_MODE_MUTEX) \
+    OTAPP_BUF_SLOT_TABLE_AUX(X) \
+    OTAPP_BUF_SLOT_TABLE_RING(X)
+
+#define OTAPP_BUF_X_SLOT_ENUM(k, sz, md)      k##_SLOT,
+#define OTAPP_BUF_X_SLOT_CASE(k, sz, md)      case k: return k##_SLOT;
+#define OTAPP_BUF_X_SLOT_SIZE(k, sz, md)      + (sz)
+#define OTAPP_BUF_X_SLOT_CONFIG(k, sz, md)    { .key = (k), .size = (sz), .mode = (md) },
+
+/**
+ * @brief Slot handle, resolved at compile time (e.g. `OTAPP_BUF_KEY_1_SLOT`).
+ * @details Use @ref OTAPP_BUF_SLOT to get the handle of a key and the `otapp_buf_slot_*` API 
+ * to access the slot by direct index, without any key lookup.
+ */
+typedef enum {
+    OTAPP_BUF_SLOT_TABLE(OTAPP_BUF_X_SLOT_ENUM)
+    OTAPP_BUF_SLOTS_QTY ///< Number of slots in the pool
+} otapp_buf_slot_t;
+
+#define OTAPP_BUF_SLOT_INVALID  OTAPP_BUF_SLOTS_QTY ///< Returned by otapp_buf_keyToSlot() for an unknown key
+
+/** @brief Compile-time slot handle of a key, e.g. `OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1)` */
+#define OTAPP_BUF_SLOT(k)       k##_SLOT
+
 /* Single Definition Guard: 
  * This ensures the configuration array is instantiated in memory exactly once 
  * (inside the source file that defines OTAPP_BUF_INIT_CONGIG_IMPL). 
  */
 #ifdef OTAPP_BUF_INIT_CONGIG_IMPL
     const bufferConfig_t otapp_buf_init_config[] = {
-        { .key = OTAPP_BUF_KEY_1, .size = OTAPP_BUF_KEY_1_SIZE }, 
-        { .key = OTAPP_BUF_KEY_2, .size = OTAPP_BUF_KEY_2_SIZE }, 
-        { .key = OTAPP_BUF_KEY_3, .size = OTAPP_BUF_KEY_3_SIZE }  
+        OTAPP_BUF_SLOT_TABLE(OTAPP_BUF_X_SLOT_CONFIG)
     };
 #endif
 
 /** @brief Total size of the buffer pool */
-#define OTAPP_BUF_SIZE      (OTAPP_BUF_KEY_1_SIZE + OTAPP_BUF_KEY_2_SIZE + OTAPP_BUF_KEY_3_SIZE)
+#define OTAPP_BUF_SIZE      (0 OTAPP_BUF_SLOT_TABLE(OTAPP_BUF_X_SLOT_SIZE))
+
+/**
+ * @brief Slab size classes: X(class, blockSize, blocksQty).
+ * @details Scratch blocks for handlers that may run concurrently (DNS, pairing, well-known/core).
+ * Blocks are carved from the same static arena, right after the key slots. 
+ * Block size must be a multiple of 4, at most 32 blocks per class. Classes must be sorted by block size.
+ * Firmware: slots + slabs fit in the 384 B of the former key slots, a 64 B request takes the 256 B block 
+ * when the 64 B one is in use.
+ */
+#ifdef UNIT_TEST
+    #define OTAPP_BUF_SLAB_TABLE(X) \
+        X(OTAPP_BUF_SLAB_64,  64,  4) \
+        X(OTAPP_BUF_SLAB_256, 256, 2)
+#else
+    #define OTAPP_BUF_SLAB_TABLE(X) \
+        X(OTAPP_BUF_SLAB_64,  64,  1) \
+        X(OTAPP_BUF_SLAB_256, 256, 1)
+#endif
+
+#define OTAPP_BUF_X_SLAB_ENUM(c, bs, qty)     c,
+#define OTAPP_BUF_X_SLAB_SIZE(c, bs, qty)     + ((bs) * (qty))
+
+/** @brief Slab class index */
+typedef enum {
+    OTAPP_BUF_SLAB_TABLE(OTAPP_BUF_X_SLAB_ENUM)
+    OTAPP_BUF_SLAB_CLASSES_QTY ///< Number of slab classes
+} otapp_buf_slabClass_t;
+
+/** @brief Total size of all slab blocks */
+#define OTAPP_BUF_SLAB_SIZE     (0 OTAPP_BUF_SLAB_TABLE(OTAPP_BUF_X_SLAB_SIZE))
+
+/**
+ * @brief Maps a key to its slot handle.
+ * @details The switch is generated from @ref OTAPP_BUF_SLOT_TABLE, so for a constant key 
+ * the compiler folds it to a constant, otherwise it becomes a jump table.
+ * @param key Buffer slot identifier.
+ * @return otapp_buf_slot_t Slot handle or @ref OTAPP_BUF_SLOT_INVALID.
+ */
+static inline otapp_buf_slot_t otapp_buf_keyToSlot(uint16_t key)
+{
+    switch(key)
+    {
+        OTAPP_BUF_SLOT_TABLE(OTAPP_BUF_X_SLOT_CASE)
+        default: return OTAPP_BUF_SLOT_INVALID;
+    }
+}
 
 /**
  * @brief Appends data to the buffer slot associated with the key.
@@ -98,12 +258,57 @@ typedef struct {
  * @param[in] len      Length of data to copy.
  * @return int8_t      @ref OTAPP_BUF_OK on success, or error code (e.g. @ref OTAPP_BUF_ERROR_OVERFLOW).
  * @note **Thread Safe (Mutex Protected):**
- * This function acquires the mutex to protect the `current_len` increment and memory copy 
+ * This function acquires the slot mutex to protect the `current_len` increment and memory copy 
  * from race conditions. The critical section covers the bounds check and memory update.
  * @warning Returns @ref OTAPP_BUF_ERROR_WRITE_LOCK if the slot is currently locked by `otapp_buf_getWriteOnly_ptr`.
+ * @note **SPSC ring slot:** no mutex is taken. The data is copied all-or-nothing, 
+ * @ref OTAPP_BUF_ERROR_OVERFLOW is returned when the free space in the ring is smaller than `len`.
+ * Only one producer task may append to a ring slot.
  */
 int8_t otapp_buf_append(uint16_t key, const uint8_t* new_data, uint16_t len);
 
+/**
+ * @brief One source fragment of a scatter-gather write (@ref otapp_buf_appendv).
+ */
+typedef struct {
+    const uint8_t *base;  ///< Fragment data, only read
+    uint16_t len;         ///< Fragment length in bytes
+} otapp_buf_iov_t;
+
+/**
+ * @brief One destination fragment of a gather read (@ref otapp_buf_getDatav).
+ */
+typedef struct {
+    uint8_t *base;  ///< Fragment buffer, filled by the read
+    uint16_t len;   ///< Fragment length in bytes
+} otapp_buf_iovOut_t;
+
+/**
+ * @brief Appends `iovCnt` fragments to the slot in one critical section.
+ * @details The fragments are copied back to back, with a single bounds check for the total length: 
+ * either the whole vector is appended or nothing (@ref OTAPP_BUF_ERROR_OVERFLOW). 
+ * Use it to build e.g. token + header + value without a temporary buffer and without interleaving with other writers.
+ * @param[in] key    Buffer slot identifier.
+ * @param[in] iov    Fragment array (NULL `base` is not allowed).
+ * @param[in] iovCnt Number of fragments.
+ * @return int8_t @ref OTAPP_BUF_OK on success, or error code as @ref otapp_buf_append.
+ * @note **SPSC ring slot:** all fragments are published to the consumer at once.
+ */
+int8_t otapp_buf_appendv(uint16_t key, const otapp_buf_iov_t *iov, uint8_t iovCnt);
+
+/**
+ * @brief Gather read: copies the slot content into `iovCnt` destination fragments in order.
+ * @details Every fragment is filled up to its `len` before the next one is used, the last used fragment may be filled partially.
+ * The slot content must fit the sum of the fragment lengths.
+ * @param[in]  key       Buffer slot identifier.
+ * @param[in]  iov       Destination fragments.
+ * @param[in]  iovCnt    Number of fragments.
+ * @param[out] lenBufOut Total number of bytes copied.
+ * @return int8_t @ref OTAPP_BUF_OK on success.
+ * @note **SPSC ring slot:** destructive read of up to the sum of the fragment lengths, as @ref otapp_buf_getData.
+ */
+int8_t otapp_buf_getDatav(uint16_t key, const otapp_buf_iovOut_t *iov, uint8_t iovCnt, uint16_t *lenBufOut);
+
 /**
  * @brief Retrieves data from a buffer slot into a user-provided buffer.
  * @param[in]  key       Buffer slot identifier.
@@ -111,6 +316,9 @@ int8_t otapp_buf_append(uint16_t key, const uint8_t* new_data, uint16_t len);
  * @param[in]  bufSize   Size of the destination buffer.
  * @param[out] lenBufOut Pointer to store the actual number of bytes read.
  * @return int8_t @ref OTAPP_BUF_OK on success.
+ * @note **SPSC ring slot:** the read is destructive (consumes the data) and lock-free. 
+ * Up to `bufSize` bytes are copied, the rest stays in the ring for the next call.
+ * Only one consumer task may read from a ring slot.
  */
 int8_t otapp_buf_getData(uint16_t key, uint8_t* bufOut, uint16_t bufSize, uint16_t *lenBufOut);
 
@@ -122,6 +330,7 @@ int8_t otapp_buf_getData(uint16_t key, uint8_t* bufOut, uint16_t bufSize, uint16
  * @return const uint8_t* Pointer to the data, or NULL on error.
  * @note This function acquires the mutex briefly to read the current length, 
  * but returns a direct pointer to static memory.
+ * @note Returns NULL for @ref OTAPP_BUF_MODE_SPSC_RING slots (data is not contiguous).
  */
 const uint8_t *otapp_buf_getReadOnly_ptr(uint16_t key, uint16_t *bufSize_out);
 
@@ -137,11 +346,22 @@ const uint8_t *otapp_buf_getReadOnly_ptr(uint16_t key, uint16_t *bufSize_out);
  * @return uint8_t* Pointer to the buffer slot start, or NULL if locked/full.
  * @warning **Blocking Behavior:** If successful, this function explicitly **LOCKS** the slot. 
  * You **MUST** call @ref otapp_buf_writeUnlock(key) immediately after finishing the write operation.
+ * @note Returns NULL for @ref OTAPP_BUF_MODE_SPSC_RING slots.
  */
 uint8_t* otapp_buf_getWriteOnly_ptr(uint16_t key, uint16_t required_size);
 
+/**
+ * @brief Same as @ref otapp_buf_getWriteOnly_ptr, but the reserved bytes are not zeroed (@ref OTAPP_BUF_ACQ_NO_CLEAR).
+ * @warning The caller must write all `required_size` bytes before unlocking the slot.
+ */
+uint8_t* otapp_buf_getWriteOnly_ptrNoClear(uint16_t key, uint16_t required_size);
+
 /**
  * @brief Clears the data in a specific buffer slot.
+ * @details `current_len` is reset and all `max_size` payload bytes are zeroed 
+ * (filled with @ref OTAPP_BUF_POISON_BYTE in OTAPP_BUF_POISON mode).
+ * @note For @ref OTAPP_BUF_MODE_SPSC_RING slots this drops all unread data and must be called 
+ * from the consumer task.
  * @param key Buffer slot identifier.
  * @return int8_t @ref OTAPP_BUF_OK on success.
  */
@@ -163,13 +383,268 @@ uint16_t otapp_buf_getCurrentLenSize(uint16_t key);
 
 /**
  * @brief Unlocks a slot previously locked by `otapp_buf_getWriteOnly_ptr`.
+ * @details The reservation is dropped (`current_len` = 0), the written bytes are not kept for readers. 
+ * A write lease (@ref otapp_buf_leaseRelease) commits its bytes instead.
  * @param key Buffer slot identifier.
- * @return int8_t @ref OTAPP_BUF_OK on success.
+ * @return int8_t @ref OTAPP_BUF_OK on success, @ref OTAPP_BUF_ERROR_MODE for SPSC ring slots.
  */
 int8_t otapp_buf_writeUnlock(uint16_t key);
 
+/** @name Slot API (direct index, no key lookup) 
+ * @details Same behaviour and return codes as the key based functions, 
+ * an out of range slot is reported as @ref OTAPP_BUF_ERROR_KEY_NOT_FOUND (or NULL / 0).
+ */
+///@{
+int8_t otapp_buf_slot_append(otapp_buf_slot_t slot, const uint8_t* new_data, uint16_t len);
+int8_t otapp_buf_slot_getData(otapp_buf_slot_t slot, uint8_t* bufOut, uint16_t bufSize, uint16_t *lenBufOut);
+const uint8_t *otapp_buf_slot_getReadOnly_ptr(otapp_buf_slot_t slot, uint16_t *bufSize_out);
+uint8_t* otapp_buf_slot_getWriteOnly_ptr(otapp_buf_slot_t slot, uint16_t required_size);
+int8_t otapp_buf_slot_writeUnlock(otapp_buf_slot_t slot);
+int8_t otapp_buf_slot_clear(otapp_buf_slot_t slot);
+uint16_t otapp_buf_slot_getCurrentLenSize(otapp_buf_slot_t slot);
+uint8_t* otapp_buf_slot_getWriteOnly_ptrTimed(otapp_buf_slot_t slot, uint16_t required_size, uint32_t timeoutTicks);
+uint8_t* otapp_buf_slot_getWriteOnly_ptrEx(otapp_buf_slot_t slot, uint16_t required_size, uint32_t timeoutTicks, uint8_t flags);
+int8_t otapp_buf_slot_appendv(otapp_buf_slot_t slot, const otapp_buf_iov_t *iov, uint8_t iovCnt);
+int8_t otapp_buf_slot_getDatav(otapp_buf_slot_t slot, const otapp_buf_iovOut_t *iov, uint8_t iovCnt, uint16_t *lenBufOut);
+///@}
+
+/**
+ * @brief Same as @ref otapp_buf_getWriteOnly_ptr, but waits in the slot FIFO queue up to `timeoutTicks` 
+ * when the slot is write-locked or has read leases.
+ * @param[in] key           Buffer slot identifier.
+ * @param[in] required_size Number of bytes intended to be written.
+ * @param[in] timeoutTicks  Max wait in RTOS ticks, 0 = no wait, @ref OTAPP_BUF_WAIT_FOREVER = no timeout.
+ * @return uint8_t* Pointer to the buffer slot start, or NULL on timeout / full queue / error.
+ * @warning You **MUST** call @ref otapp_buf_writeUnlock(key) after finishing the write operation.
+ */
+uint8_t* otapp_buf_getWriteOnly_ptrTimed(uint16_t key, uint16_t required_size, uint32_t timeoutTicks);
+
+/**
+ * @brief Contention counters of a slot's write wait queue.
+ */
+typedef struct {
+    uint32_t contention_cnt; ///< Write requests that found the slot busy
+    uint32_t timeout_cnt;    ///< Queued writers that gave up after their timeout
+    uint32_t queue_full_cnt; ///< Writers rejected because @ref OTAPP_BUF_WAITERS_MAX was reached
+    uint32_t wait_max_ticks; ///< Longest wait of a writer that got the slot
+    uint8_t  waiters;        ///< Writers queued right now
+    uint8_t  waiters_peak;   ///< Highest waiters seen
+} otapp_buf_waitStats_t;
+
+/**
+ * @brief Reads the write wait queue counters of a slot.
+ * @param[in]  slot     Slot handle.
+ * @param[out] statsOut Counters.
+ * @return int8_t @ref OTAPP_BUF_OK on success, @ref OTAPP_BUF_ERROR_KEY_NOT_FOUND for an invalid slot.
+ */
+int8_t otapp_buf_slot_getWaitStats(otapp_buf_slot_t slot, otapp_buf_waitStats_t *statsOut);
+
+/** @name Zero-Copy Leases 
+ * @details A lease is a reference counted handle to the slot payload:
+ * - **Read lease:** any number of readers share the bytes without copying. 
+ *   While at least one read lease exists, write leases, `otapp_buf_getWriteOnly_ptr` and `otapp_buff_clear` fail.
+ * - **Write lease:** exclusive. It fails when the slot has readers or another writer. 
+ *   The leased bytes are zeroed, unless @ref OTAPP_BUF_ACQ_NO_CLEAR is passed to @ref otapp_buf_leaseWriteEx.
+ *   On release `current_len` is set to `lease.len`, so the written data becomes visible to readers. 
+ *   This differs from @ref otapp_buf_writeUnlock, which drops the zero-copy reservation (`current_len` = 0): 
+ *   a writer that fills only part of the lease reduces `lease.len` before release, a writer that 
+ *   wants nothing to stay in the slot sets `lease.len` to 0.
+ * 
+ * Declare the lease with @ref OTAPP_BUF_LEASE_SCOPED to release it automatically at the end of the scope:
+ * @code
+ * {
+ *     OTAPP_BUF_LEASE_SCOPED(lease);
+ *     if(otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), size, &lease) != OTAPP_BUF_OK) return;
+ *     fill(lease.data, lease.len);
+ * } // released here, also on every early return
+ * @endcode
+ */
+///@{
+#define OTAPP_BUF_LEASE_NONE    0   ///< Lease is not held
+#define OTAPP_BUF_LEASE_READ    1   ///< Shared read lease
+#define OTAPP_BUF_LEASE_WRITE   2   ///< Exclusive write lease
+
+/**
+ * @brief Lease handle. Initialize with @ref OTAPP_BUF_LEASE_INIT before use.
+ */
+typedef struct {
+    uint8_t *data;          ///< Slot payload (read lease: must not be modified)
+    uint16_t len;           ///< Valid data length (write lease: may be reduced before release)
+    otapp_buf_slot_t slot;  ///< Leased slot
+    uint8_t type;           ///< @ref OTAPP_BUF_LEASE_NONE, @ref OTAPP_BUF_LEASE_READ or @ref OTAPP_BUF_LEASE_WRITE
+    int8_t owner;           ///< Owner record index (debug mode), -1 if not tracked
+} otapp_buf_lease_t;
+
+#define OTAPP_BUF_LEASE_INIT    { .data = NULL, .len = 0, .slot = OTAPP_BUF_SLOT_INVALID, .type = OTAPP_BUF_LEASE_NONE, .owner = -1 }
+
+/** @brief Declares a lease that is released automatically when it goes out of scope. */
+#define OTAPP_BUF_LEASE_SCOPED(name) \
+    HRO_TOOL_CLEANUP(otapp_buf_leaseRelease) otapp_buf_lease_t name = OTAPP_BUF_LEASE_INIT
+
+#ifdef OTAPP_BUF_LEASE_DEBUG
+    #define OTAPP_BUF_LEASE_FILE    __FILE__
+#else
+    #define OTAPP_BUF_LEASE_FILE    NULL
+#endif
+
+/** @brief Acquires a shared read lease. Returns @ref OTAPP_BUF_ERROR_WRITE_LOCK while a writer holds the slot. */
+#define otapp_buf_leaseRead(slot, lease)            otapp_buf_leaseReadAt((slot), (lease), OTAPP_BUF_LEASE_FILE, __LINE__)
+
+/** @brief Acquires an exclusive write lease of `size` bytes. Returns @ref OTAPP_BUF_ERROR_WRITE_LOCK if the slot is in use. */
+#define otapp_buf_leaseWrite(slot, size, lease)     otapp_buf_leaseWriteExAt((slot), (size), 0, OTAPP_BUF_ACQ_ZERO, (lease), OTAPP_BUF_LEASE_FILE, __LINE__)
+
+/** @brief Same as @ref otapp_buf_leaseWrite, but waits in the slot FIFO queue up to `ticks`.
+ * Returns @ref OTAPP_BUF_ERROR_TIMEOUT when the wait expired, @ref OTAPP_BUF_ERROR_WRITE_LOCK when the queue is full. */
+#define otapp_buf_leaseWriteTimed(slot, size, ticks, lease) \
+    otapp_buf_leaseWriteExAt((slot), (size), (ticks), OTAPP_BUF_ACQ_ZERO, (lease), OTAPP_BUF_LEASE_FILE, __LINE__)
+
+/** @brief Write lease with explicit wait time and @ref OTAPP_BUF_ACQ_NO_CLEAR / @ref OTAPP_BUF_ACQ_ZERO flags. */
+#define otapp_buf_leaseWriteEx(slot, size, ticks, flags, lease) \
+    otapp_buf_leaseWriteExAt((slot), (size), (ticks), (flags), (lease), OTAPP_BUF_LEASE_FILE, __LINE__)
+
+int8_t otapp_buf_leaseReadAt(otapp_buf_slot_t slot, otapp_buf_lease_t *lease, const char *file, uint16_t line);
+int8_t otapp_buf_leaseWriteExAt(otapp_buf_slot_t slot, uint16_t size, uint32_t timeoutTicks, uint8_t flags, 
+                                otapp_buf_lease_t *lease, const char *file, uint16_t line);
+
+/**
+ * @brief Releases a lease. Safe to call on a lease that is not held (no-op).
+ * @details Write lease: commits `lease.len` bytes as the new `current_len` of the slot.
+ * @param lease Lease handle, it is reset to @ref OTAPP_BUF_LEASE_INIT.
+ * @return int8_t @ref OTAPP_BUF_OK on success.
+ */
+int8_t otapp_buf_leaseRelease(otapp_buf_lease_t *lease);
+
+/**
+ * @brief Reports leases that are still held.
+ * @details With OTAPP_BUF_LEASE_DEBUG every held lease is printed with the owner's call site.
+ * @return uint16_t Number of held leases (readers + writers) in the whole pool.
+ */
+uint16_t otapp_buf_leaseReportLeaks(void);
+///@}
+
+/** @name Slab Allocator 
+ * @details O(1) allocation of fixed-size scratch blocks. Every class has its own free list and mutex, 
+ * so concurrent handlers each get a private block instead of competing for one key slot.
+ * Declare the block with @ref OTAPP_BUF_SLAB_SCOPED to free it automatically at the end of the scope:
+ * @code
+ * OTAPP_BUF_SLAB_SCOPED(block);
+ * block = otapp_buf_slabAlloc(size, &blockSize);
+ * if(block == NULL) return;
+ * @endcode
+ */
+///@{
+
+/**
+ * @brief Per-class usage counters.
+ */
+typedef struct {
+    uint16_t block_size;    ///< Block size in bytes
+    uint8_t  blocks_total;  ///< Blocks in the class
+    uint8_t  blocks_used;   ///< Blocks allocated right now
+    uint8_t  blocks_peak;   ///< Highest blocks_used seen
+    uint32_t alloc_cnt;     ///< Successful allocations from this class
+    uint32_t fail_cnt;      ///< Requests that fit this class but found no free block here nor in a larger class
+    uint32_t timeout_cnt;   ///< Of fail_cnt: queued requests whose wait expired (@ref otapp_buf_slabAllocTimed)
+} otapp_buf_slabStats_t;
+
+#define OTAPP_BUF_SLAB_WAIT_TICKS   5   ///< Bounded wait of the OpenThread callbacks (DNS, CoAP handlers) for a block
+
+/** @brief Declares a slab block pointer that is freed automatically when it goes out of scope. */
+#define OTAPP_BUF_SLAB_SCOPED(name) \
+    HRO_TOOL_CLEANUP(otapp_buf_slabRelease) uint8_t *name = NULL
+
+/**
+ * @brief Allocates a block from the smallest class that fits `size` (falls back to larger classes).
+ * @param[in]  size         Required bytes, they are zeroed.
+ * @param[out] blockSizeOut Optional, real size of the returned block.
+ * @return uint8_t* Block pointer (4-byte aligned) or NULL if no block is free.
+ */
+uint8_t *otapp_buf_slabAlloc(uint16_t size, uint16_t *blockSizeOut);
+
+/**
+ * @brief Same as @ref otapp_buf_slabAlloc with acquisition flags, @ref OTAPP_BUF_ACQ_NO_CLEAR skips zeroing.
+ */
+uint8_t *otapp_buf_slabAllocEx(uint16_t size, uint8_t flags, uint16_t *blockSizeOut);
+
+/**
+ * @brief Same as @ref otapp_buf_slabAllocEx, but waits up to `timeoutTicks` for a block to be freed.
+ * @details The caller is queued in FIFO order in the best fitting class, a block freed in that class 
+ * or in a larger one wakes the oldest waiter. @ref OTAPP_BUF_WAIT_FOREVER waits without timeout, 0 does not wait.
+ * @return uint8_t* Block pointer or NULL (size too large, timeout, wait queue full).
+ */
+uint8_t *otapp_buf_slabAllocTimed(uint16_t size, uint8_t flags, uint32_t timeoutTicks, uint16_t *blockSizeOut);
+
+/**
+ * @brief Returns a block to its class.
+ * @param block Pointer returned by @ref otapp_buf_slabAlloc.
+ * @return int8_t @ref OTAPP_BUF_OK, @ref OTAPP_BUF_ERROR for a foreign pointer or a double free.
+ */
+int8_t otapp_buf_slabFree(uint8_t *block);
+
+/**
+ * @brief Cleanup handler for @ref OTAPP_BUF_SLAB_SCOPED, frees `*block` if not NULL and sets it to NULL.
+ */
+void otapp_buf_slabRelease(uint8_t **block);
+
+/**
+ * @brief Reads the usage counters of a slab class.
+ * @param[in]  slabClass Class index.
+ * @param[out] statsOut  Counters.
+ * @return int8_t @ref OTAPP_BUF_OK on success.
+ */
+int8_t otapp_buf_slabGetStats(otapp_buf_slabClass_t slabClass, otapp_buf_slabStats_t *statsOut);
+///@}
+
+/** @name Telemetry 
+ * @details Per-slot counters for right-sizing `OTAPP_BUF_KEY_*_SIZE` in the field and for finding 
+ * which user holds a slot for too long. They are always on, the cost is a counter update per slot lock. 
+ * Slot lock waits are much shorter than an RTOS tick, so lock contention is counted, not timed.
+ */
+///@{
+
+/**
+ * @brief Per-slot usage counters.
+ */
+typedef struct {
+    uint16_t key;             ///< Slot key
+    uint16_t max_size;        ///< Configured slot size
+    uint16_t peak_len;        ///< High-water mark of `current_len` (ring slot: of unread bytes)
+    uint32_t acquire_cnt;     ///< Slot lock acquisitions (always 0 for ring slots)
+    uint32_t contended_cnt;   ///< Of acquire_cnt: acquisitions that found the slot lock held by another task and blocked
+    uint32_t overflow_cnt;    ///< Requests rejected with @ref OTAPP_BUF_ERROR_OVERFLOW
+    uint32_t busy_reject_cnt; ///< Requests rejected with @ref OTAPP_BUF_ERROR_WRITE_LOCK because the slot was busy 
+                              ///< (write-locked, held by read leases, or its write wait queue full), not lock acquisitions
+} otapp_buf_stats_t;
+
+/**
+ * @brief Reads the telemetry counters of a slot.
+ * @param[in]  key      Buffer slot identifier.
+ * @param[out] statsOut Counters.
+ * @return int8_t @ref OTAPP_BUF_OK on success, @ref OTAPP_BUF_ERROR_KEY_NOT_FOUND for an unknown key.
+ */
+int8_t otapp_buf_getStats(uint16_t key, otapp_buf_stats_t *statsOut);
+int8_t otapp_buf_slot_getStats(otapp_buf_slot_t slot, otapp_buf_stats_t *statsOut);
+
+/**
+ * @brief Clears the telemetry counters of all slots, `peak_len` restarts from the current fill level.
+ */
+void otapp_buf_resetStats(void);
+///@}
+
+/**
+ * @brief Appends the whole content of one slot to another slot.
+ * @details Both slot locks are held for the copy, taken according to the lock order rule 
+ * (ascending position in `otapp_buf_init_config[]`), so no deadlock with other multi-slot operations is possible.
+ * The source slot is left unchanged.
+ * @param[in] dstKey Destination buffer slot identifier.
+ * @param[in] srcKey Source buffer slot identifier (must differ from `dstKey`).
+ * @return int8_t @ref OTAPP_BUF_OK on success, @ref OTAPP_BUF_ERROR_OVERFLOW if the data does not fit, 
+ * @ref OTAPP_BUF_ERROR_WRITE_LOCK if the destination or the source is locked, @ref OTAPP_BUF_ERROR_MODE for SPSC ring slots.
+ */
+int8_t otapp_buf_appendFromKey(uint16_t dstKey, uint16_t srcKey);
+
 /**
- * @brief Initializes the buffer module and creates the RTOS mutex.
+ * @brief Initializes the buffer module and creates the per-slot RTOS mutexes.
  * @note This is called internally during the framework initialization.
  */
 void otapp_buffer_init(void);
@@ -13,7 +13,7 @@
  * **Key Functionalities:**
  * - **Initialization:** Starts the CoAP service on the default UDP port.
  * - **Resource Management:** Registers URI paths and their callback handlers.
- * - **Response Helpers:** Provides ready-to-use functions for sending ACK (`2.04 Changed`), ERROR (`4.04 Not Found`), or Data payloads.
+ * - **Response Helpers:** Provides ready-to-use functions for sending ACK (`2.04 Changed`), ERROR (`4.00 Bad Request`), or Data payloads.
  * - **Payload Extraction:** Safely copies data from OpenThread messages (Packet Buffers) to flat C buffers.
  * 
  * @author Jan Łukaszewicz (plhareo@gmail.com)
@@ -36,6 +36,7 @@
     #include <openthread/message.h>
     #include <openthread/coap.h>
 #endif
+#include "ot_app_coap_block.h"
 
 #define OTAPP_COAP_PORT 5683 ///< Default CoAP port, as specified in RFC 7252
 
@@ -58,11 +59,30 @@ typedef struct ot_app_devDrv_t ot_app_devDrv_t; // forward declaration
         
         OTAPP_URI_TEST,
         OTAPP_URI_TEST_LED,
+        OTAPP_URI_BUF_STATS,
+        OTAPP_URI_COAP_STATS,
 
         OTAPP_URI_END_OF_INDEX,
     }otapp_coap_uriIndex_t;
 #endif
 
+#define OTAPP_COAP_NON_CHECKPOINT_INTERVAL  8 ///< every Nth message of a NON stream is sent CON (RFC 7641 4.5)
+
+/**
+ * @brief transport of a client request
+ */
+typedef enum {
+    OTAPP_COAP_TRANSPORT_CON = 0,   ///< Confirmable: retransmitted until ACK
+    OTAPP_COAP_TRANSPORT_NON,       ///< Non-confirmable: no ACK, no retransmission state (streaming updates)
+}otapp_coap_transport_t;
+
+/**
+ * @brief state of one NON stream (e.g. one button dimming one light), see @ref ot_app_coap_transport
+ */
+typedef struct {
+    uint8_t nonSent;    ///< NON messages since the last CON checkpoint
+}otapp_coap_nonStream_t;
+
 typedef struct otapp_coap_uri_t{
     uint32_t            devType; // otapp_deviceType_t
     otCoapResource      resource;
@@ -72,6 +92,7 @@ typedef enum {
     OTAPP_MESSAGE_OK = 0,
     OTAPP_MESSAGE_ERROR,
     OTAPP_MESSAGE_TEST,
+    OTAPP_MESSAGE_BAD_OPTION,       ///< malformed or unsupported option, e.g. Block2 behind the representation
 }otapp_coap_messageId_t;
 
 /**
@@ -93,17 +114,58 @@ int8_t otapp_coap_init(ot_app_devDrv_t *devDriver);
  */
 void otapp_coap_sendResponse(otMessage *requestMessage, const otMessageInfo *aMessageInfo, const uint8_t *responseContent, uint16_t responseLength);
 
+/**
+ * @brief Sends a pre-encoded response (@ref otapp_coap_messageId_t), the hot path of the request handlers.
+ * @details Code and payload are resolved by @ref otapp_coap_responseResolve: GET gets the payload
+ *          (2.05 Content, error messages their 4.xx code), PUT the code without payload, other methods 4.05.
+ *          A Confirmable request is answered with a piggybacked ACK, a Non-confirmable one with a NON response.
+ * @param requestMessage    [in] The original request message.
+ * @param aMessageInfo      [in] Source address and port of the requester.
+ * @param msgID             [in] Pre-encoded response.
+ */
+void otapp_coap_sendResponseMessage(otMessage *requestMessage, const otMessageInfo *aMessageInfo, otapp_coap_messageId_t msgID);
+
+/**
+ * @brief Creates a 2.05 Content response to a GET request, ready for payload append.
+ * @details The payload marker is already set, the caller appends the payload directly
+ *          (e.g. @ref otapp_msg_tlv_msgWriterInit) and sends it with @ref otapp_coap_responseSend.
+ *          On append error the caller must free the message with otMessageFree().
+ * @param requestMessage    [in] The original GET request.
+ * @return otMessage* New response, or NULL (not a GET request / no message buffers).
+ */
+otMessage *otapp_coap_responseNew(otMessage *requestMessage);
+
+/**
+ * @brief Creates a 2.05 Content response with the Block2 option, ready for the block payload.
+ * @details Same as @ref otapp_coap_responseNew, the Block2 option goes before the payload marker.
+ *          The block is selected by @ref otapp_coap_block2Window.
+ * @param requestMessage    [in] The original GET request.
+ * @param block2            [in] Block2 option of the response, NULL: without the option.
+ * @return otMessage* New response, or NULL (not a GET request / no message buffers).
+ */
+otMessage *otapp_coap_responseNewBlock2(otMessage *requestMessage, const otapp_coap_block_t *block2);
+
+/**
+ * @brief Sends a response created by @ref otapp_coap_responseNew.
+ * @details The message is freed when sending fails.
+ * @param responseMessage   [in] Response message.
+ * @param aMessageInfo      [in] Source address and port of the requester.
+ */
+void otapp_coap_responseSend(otMessage *responseMessage, const otMessageInfo *aMessageInfo);
+
 /**
  * @brief Sends a simple "OK" response (2.04 Changed).
  * @details Typically used to acknowledge PUT/POST requests that don't require returning data.
+ *          Pre-encoded, see @ref otapp_coap_sendResponseMessage.
  * @param request       [in] The original request message.
  * @param aMessageInfo  [in] Source address and port.
  */
 void otapp_coap_sendResponseOK(otMessage *aMessage, const otMessageInfo *aMessageInfo);
 
 /**
- * @brief Sends a "Not Found" error response (4.04).
- * @details Used when the requested URI or resource does not exist.
+ * @brief Sends an "ERROR" response (4.00 Bad Request).
+ * @details Used when the request cannot be processed (e.g. invalid payload).
+ *          Pre-encoded, see @ref otapp_coap_sendResponseMessage.
  * @param request       [in] The original request message.
  * @param aMessageInfo  [in] Source address and port.
  */
@@ -115,13 +177,6 @@ void otapp_coap_sendResponseERROR(otMessage *aMessage, const otMessageInfo *aMes
  */
 void otapp_coap_printSenderIP(const otMessageInfo *aMessageInfo);
 
-/**
- * @brief Converts an internal message ID/Type to a string representation.
- * @param msgID [in] Internal message identifier.
- * @return const char* String literal (e.g., "GET", "PUT", "ACK").
- */
-const char *otapp_coap_getMessage(otapp_coap_messageId_t msgID);
-
 /**
  * @brief Sends a test PUT message (Debug function).
  * @details Hardcoded test routine for verifying transmission logic during development.
@@ -146,6 +201,7 @@ void otapp_coapSendDeviceNamePut();
  * @brief Sends a GET request to the standard discovery URI `.well-known/core`.
  * @details This function is used for Service Discovery. It queries a remote device 
  * to list its available resources (URIs). The response is handled by the provided callback.
+ * The list is fetched block-wise (@ref otapp_coap_block2Request), the callback gets the whole list.
  * @param ipAddr          [in] IPv6 address of the target device.
  * @param responseHandler [in] Callback function to handle the list of resources returned.
  * @param aContext        [in] User context to pass to the handler.
@@ -162,6 +218,16 @@ void otapp_coapSendGetUri_Well_known(const otIp6Address *ipAddr, otCoapResponseH
  */
 void otapp_coapSendPutUri_subscribed_uris(const otIp6Address *ipAddr, const uint8_t *data, uint16_t dataSize);
 
+/**
+ * @brief Sends one `subscribed_uris` PUT to a multicast group (group observers).
+ * @details Sent as Non-confirmable, CON is not allowed for a multicast destination.
+ * Every receiver keeps only the records with its own subscription tokens.
+ * @param groupAddr   [in] IPv6 multicast address of the group.
+ * @param data        [in] Pointer to the payload data (TLV records).
+ * @param dataSize    [in] Size of the payload.
+ */
+void otapp_coapSendPutUri_subscribed_urisMulticast(const otIp6Address *groupAddr, const uint8_t *data, uint16_t dataSize);
+
 /**
  * @brief Initiates a CoAP Observe subscription (RFC 7641).
  * @details Sends a GET request with the Observe option set to 0 (Register). 
@@ -194,6 +260,20 @@ void otapp_coapSendSubscribeRequestUpdate(const otIp6Address *ipAddr, const char
  */
 void otapp_coap_clientSendPutByte(const otIp6Address *peer_addr, const char *aUriPath, const uint8_t *payloadMsg, const uint16_t payloadMsgSize, otCoapResponseHandler responseHandler, void *aContext);
 
+/**
+ * @brief send coap message bytes using the PUT method with the selected transport
+ * 
+ * @param peer_addr         [in] ptr to device IPv6 address
+ * @param aUriPath          [in] string ptr to uri
+ * @param payloadMsg        [in] ptr to payload data
+ * @param payloadMsgSize    [in] payload size
+ * @param transport         [in] OTAPP_COAP_TRANSPORT_CON or OTAPP_COAP_TRANSPORT_NON
+ * @param responseHandler   [in] callback to response handler (NON: called only if the server answers)
+ * @param aContext          [in] content will be provided with responseHandler
+ * @return otError          OT_ERROR_NONE: request handed to OpenThread, responseHandler will be called (CON)
+ */
+otError otapp_coap_clientSendPutByteTransport(const otIp6Address *peer_addr, const char *aUriPath, const uint8_t *payloadMsg, const uint16_t payloadMsgSize, otapp_coap_transport_t transport, otCoapResponseHandler responseHandler, void *aContext);
+
 /**
  * @brief send coap request using the GET method. Response will contain bytes
  * 
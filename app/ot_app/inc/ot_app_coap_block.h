@@ -0,0 +1,146 @@
+/**
+ * @file ot_app_coap_block.h
+ * @brief CoAP Block2 (RFC 7959): block window of a server response, block-wise GET of the client.
+ * @details see more information in section: @ref ot_app_coap_block
+ *
+ * @defgroup ot_app_coap_block CoAP Block2 transfer
+ * @ingroup ot_app
+ * @brief CoAP Block2 (RFC 7959): block window of a server response, block-wise GET of the client.
+ * @details
+ * @{
+ *
+ * A large representation (e.g. TLV of the `.well-known/core` URI list) is sent in blocks of
+ * 16 << szx bytes, every block in its own request / response exchange. Neither side needs a
+ * buffer for the whole representation:
+ * - **server**: @ref otapp_coap_block2Window selects the block from the Block2 option of the request,
+ *   the handler encodes the representation again for every block and appends only the block bytes
+ *   (@ref otapp_pair_uriResourcesAppendWindow),
+ * - **client**: @ref otapp_coap_block2Request sends GET with Block2 num 0, appends the payload of every
+ *   block to one otMessage and asks for the next block until more = 0. The user handler gets the
+ *   whole representation in that message (payload offset 0), or the response itself when the server
+ *   answered without Block2 / in one block.
+ *
+ * The default block (OTAPP_COAP_BLOCK_SZX_DEFAULT, 64 bytes) with the CoAP header fits into one
+ * 802.15.4 frame, a block lost on the radio costs one frame instead of a whole 6LoWPAN datagram.
+ *
+ * @code{.c}
+ * otapp_coap_block2Request(ipAddr, uriPath, responseHandler, context);
+ * @endcode
+ *
+ * @version 0.1
+ * @date 17-10-2026
+ * @author Jan Łukaszewicz (plhareo@gmail.com)
+ * @copyright © 2025 MIT @ref prj_license
+ */
+
+#ifndef OT_APP_COAP_BLOCK_H_
+#define OT_APP_COAP_BLOCK_H_
+
+#include "hro_utils.h"
+
+#ifdef UNIT_TEST
+    #include "mock_ot_app_coap.h"
+    #include "mock_ot_message.h"
+#else
+    #include <openthread/coap.h>
+    #include <openthread/message.h>
+#endif
+
+#define OTAPP_COAP_BLOCK_OK                 (-1)
+#define OTAPP_COAP_BLOCK_ERROR              (-2)
+#define OTAPP_COAP_BLOCK_NONE               (-3)    ///< no Block2 option / whole representation in one response
+
+#define OTAPP_COAP_BLOCK_SZX_DEFAULT        2       ///< 64 bytes, server block size and first block size of the client
+#define OTAPP_COAP_BLOCK_SZX_MAX            6       ///< 1024 bytes, szx 7 is reserved
+#define OTAPP_COAP_BLOCK_SIZE(szx)          (16u << (szx))
+#define OTAPP_COAP_BLOCK_NUM_MAX            0xFFFFFu ///< 20-bit block number
+
+#define OTAPP_COAP_BLOCK_TRANSFERS_MAX      2       ///< client transfers at once
+#define OTAPP_COAP_BLOCK_BODY_MAX           1024    ///< max reassembled representation
+
+/**
+ * @brief Block1 / Block2 option value
+ */
+typedef struct {
+    uint32_t num;       ///< block number
+    uint8_t more;       ///< more blocks follow
+    uint8_t szx;        ///< block size exponent, size = 16 << szx
+} otapp_coap_block_t;
+
+/**
+ * @brief send function of the client, in the application: GET with the Block2 option (block2 NULL: without)
+ * @return otError OT_ERROR_NONE: responseHandler will be called (response or timeout)
+ */
+typedef otError (*otapp_coap_blockSendGet_t)(const otIp6Address *peer_addr, const char *aUriPath, const otapp_coap_block_t *block2, otCoapResponseHandler responseHandler, void *aContext);
+
+/**
+ * @brief new empty message for the reassembled representation, in the application: otIp6NewMessage()
+ */
+typedef otMessage *(*otapp_coap_blockMessageNew_t)(void);
+
+/**
+ * @brief encode the option value: num << 4 | more << 3 | szx
+ */
+uint32_t otapp_coap_blockEncode(const otapp_coap_block_t *block);
+
+/**
+ * @brief decode the option value
+ * @return int8_t OTAPP_COAP_BLOCK_OK or OTAPP_COAP_BLOCK_ERROR (szx 7, number above 20 bits)
+ */
+int8_t otapp_coap_blockDecode(uint32_t value, otapp_coap_block_t *blockOut);
+
+/**
+ * @brief read the Block2 option of a message
+ *
+ * @param message   [in] request (server) or response (client)
+ * @param blockOut  [out] option value
+ * @return int8_t OTAPP_COAP_BLOCK_OK, OTAPP_COAP_BLOCK_NONE (no option) or OTAPP_COAP_BLOCK_ERROR (malformed)
+ */
+int8_t otapp_coap_block2Get(const otMessage *message, otapp_coap_block_t *blockOut);
+
+/**
+ * @brief server: block of the response for the Block2 option of the request
+ * @details Block size: the smaller of the requested one and OTAPP_COAP_BLOCK_SZX_DEFAULT, the block number
+ *          is scaled to the same byte offset (RFC 7959 2.4). Request without Block2 and a representation
+ *          bigger than the default block: server starts the block-wise transfer with block 0.
+ *
+ * @param request       [in] Block2 of the request, NULL: request without the option
+ * @param totalSize     size of the whole representation
+ * @param blockOut      [out] Block2 option of the response
+ * @param offsetOut     [out] first representation byte of the block
+ * @param sizeOut       [out] bytes of the block
+ * @return int8_t OTAPP_COAP_BLOCK_OK (send with blockOut), OTAPP_COAP_BLOCK_NONE (send whole, without option)
+ *         or OTAPP_COAP_BLOCK_ERROR (block behind the end of the representation)
+ */
+int8_t otapp_coap_block2Window(const otapp_coap_block_t *request, uint16_t totalSize, otapp_coap_block_t *blockOut, uint16_t *offsetOut, uint16_t *sizeOut);
+
+/**
+ * @brief clear the client transfers and set the send / message functions
+ */
+void otapp_coap_blockInit(otapp_coap_blockSendGet_t sendGetFn, otapp_coap_blockMessageNew_t messageNewFn);
+
+/**
+ * @brief client: block-wise GET of the whole representation
+ * @details `aUriPath` is stored as a pointer, the string must stay valid until the handler is called.
+ *          Transfer table full: plain GET, the handler gets the response as it is.
+ *          The handler is called once: whole representation, or aMessage NULL and the error
+ *          (timeout, OT_ERROR_PARSE: unexpected block, OT_ERROR_NO_BUFS: representation too big).
+ *
+ * @param peer_addr         [in] ptr to device IPv6 address
+ * @param aUriPath          [in] string ptr to uri
+ * @param responseHandler   [in] called with the whole representation
+ * @param aContext          [in] content will be provided with responseHandler
+ * @return int8_t OTAPP_COAP_BLOCK_OK or OTAPP_COAP_BLOCK_ERROR (not initialized, invalid args, send error)
+ */
+int8_t otapp_coap_block2Request(const otIp6Address *peer_addr, const char *aUriPath, otCoapResponseHandler responseHandler, void *aContext);
+
+/**
+ * @brief number of client transfers in progress
+ */
+uint8_t otapp_coap_blockTransfersGet(void);
+
+#endif  /* OT_APP_COAP_BLOCK_H_ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,96 @@
+/**
+ * @file ot_app_coap_coalesce.h
+ * @brief Latest-value-wins outgoing PUT slots, one per (device, URI).
+ * @details see more information in section: @ref ot_app_coap_coalesce
+ *
+ * @defgroup ot_app_coap_coalesce CoAP PUT coalescing
+ * @ingroup ot_app
+ * @brief Latest-value-wins outgoing PUT slots, one per (device, URI).
+ * @details
+ * @{
+ *
+ * High-rate state updates (e.g. dimming during a long press) must not pile up behind
+ * requests that are still waiting for an ACK. Every target (peer address + URI path) has one slot:
+ * - no request in flight: the value is sent immediately,
+ * - Confirmable request in flight: the value is stored as pending, a newer value replaces it,
+ * - response / timeout of the request in flight: the pending value (the newest one) is sent.
+ *
+ * At most one CON request per target is in flight and at most one value waits, so the queue
+ * is bounded and the latency tracks the newest value. A NON message holds no exchange state,
+ * it does not block the slot. If any of the replaced values was CON, the pending one is sent CON.
+ *
+ * The put runs in the caller's task (buttons), the response in the OpenThread tasklet: the slots are
+ * accessed under the OpenThread lock (`otapp_port_openthread_lock()`, held by the tasklet).
+ *
+ * @code{.c}
+ * drv->api.coap.sendBytePutCoalesce(ipAddr, uriPath, (uint8_t *)&dimVal, sizeof(dimVal), transport, responseHandler, NULL);
+ * @endcode
+ *
+ * @version 0.1
+ * @date 17-10-2026
+ * @author Jan Łukaszewicz (plhareo@gmail.com)
+ * @copyright © 2025 MIT @ref prj_license
+ */
+
+#ifndef OT_APP_COAP_COALESCE_H_
+#define OT_APP_COAP_COALESCE_H_
+
+#include "hro_utils.h"
+
+#ifdef UNIT_TEST
+    #include "mock_ot_app_coap.h"
+#endif
+#include "ot_app_coap.h"
+
+#define OTAPP_COAP_COALESCE_OK          (-1)    ///< value sent
+#define OTAPP_COAP_COALESCE_ERROR       (-2)
+#define OTAPP_COAP_COALESCE_PENDING     (-3)    ///< value stored, it is sent when the request in flight ends
+
+#define OTAPP_COAP_COALESCE_SLOTS_MAX   8       ///< targets tracked at once
+#define OTAPP_COAP_COALESCE_PAYLOAD_MAX 32      ///< max size of one stored value
+
+/**
+ * @brief send function used by the slots, in the application: otapp_coap_clientSendPutByteTransport()
+ * @details OT_ERROR_NONE: the request is sent and responseHandler will be called (CON),
+ *          any other value: nothing is sent, responseHandler is not called.
+ */
+typedef otError (*otapp_coap_coalesceSend_t)(const otIp6Address *peer_addr, const char *aUriPath, const uint8_t *payloadMsg, const uint16_t payloadMsgSize, otapp_coap_transport_t transport, otCoapResponseHandler responseHandler, void *aContext);
+
+/**
+ * @brief clear all slots and set the send function
+ *
+ * @param sendFn [in] send function, NULL: otapp_coap_coalescePut() returns OTAPP_COAP_COALESCE_ERROR
+ */
+void otapp_coap_coalesceInit(otapp_coap_coalesceSend_t sendFn);
+
+/**
+ * @brief send a PUT to the target or store it as its pending value
+ * @details `aUriPath` is stored as a pointer, the string must stay valid (e.g. uri from the pair list).
+ *          Slot table full: the value is sent directly without coalescing.
+ *          Send error: the slot is not left in flight, the next value is sent immediately.
+ *          A pending value that fails to send when the request in flight ends is reported to its
+ *          responseHandler with the send error (aMessage == NULL).
+ *
+ * @param peer_addr         [in] ptr to device IPv6 address
+ * @param aUriPath          [in] string ptr to uri
+ * @param payloadMsg        [in] ptr to payload data (copied)
+ * @param payloadMsgSize    [in] payload size, max OTAPP_COAP_COALESCE_PAYLOAD_MAX
+ * @param transport         [in] OTAPP_COAP_TRANSPORT_CON or OTAPP_COAP_TRANSPORT_NON
+ * @param responseHandler   [in] called for the sent requests (not for replaced values), can be NULL
+ * @param aContext          [in] content will be provided with responseHandler
+ * @return int8_t           OTAPP_COAP_COALESCE_OK, OTAPP_COAP_COALESCE_PENDING or OTAPP_COAP_COALESCE_ERROR (invalid args, send error)
+ */
+int8_t otapp_coap_coalescePut(const otIp6Address *peer_addr, const char *aUriPath, const uint8_t *payloadMsg, const uint16_t payloadMsgSize, otapp_coap_transport_t transport, otCoapResponseHandler responseHandler, void *aContext);
+
+/**
+ * @brief number of values waiting for the end of a request in flight
+ *
+ * @return uint8_t
+ */
+uint8_t otapp_coap_coalescePendingGet(void);
+
+#endif  /* OT_APP_COAP_COALESCE_H_ */
+
+/**
+ * @}
+ */
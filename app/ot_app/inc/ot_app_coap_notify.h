@@ -0,0 +1,148 @@
+/**
+ * @file ot_app_coap_notify.h
+ * @brief Observer notify jobs deferred from the CoAP receive path, pending depth / notify lag statistics.
+ * @details see more information in section: @ref ot_app_coap_notify
+ *
+ * @defgroup ot_app_coap_notify CoAP deferred notify
+ * @ingroup ot_app
+ * @brief Observer notify jobs deferred from the CoAP receive path, pending depth / notify lag statistics.
+ * @details
+ * @{
+ *
+ * `otapp_coap_processUriRequest()` runs inside the OpenThread CoAP resource handler. Building and
+ * sending one message per subscriber there stalls the OpenThread tasklet for the whole fan-out,
+ * so the handler only sends the ACK and posts the change (@ref otapp_coap_notifyPost):
+ * - one slot per uri with a change waiting, a newer value of the same uri replaces the waiting one
+ *   (latest value wins, observers only need the current state),
+ * - the notify task takes up to OTAPP_COAP_NOTIFY_BATCH_MAX slots, oldest first, notifies them in one
+ *   cycle (@ref oac_uri_obs_notifyBatch) and ends it with @ref otapp_coap_notifyDone. A change of a uri
+ *   that is in the cycle waits for the next one, so no subscriber ends on an older value,
+ * - all slots taken by other uris: the change is notified inline and counted as overflow. No value of
+ *   this uri waits or is in a cycle, so the order is kept.
+ *
+ * Notify lag: time the change waited in its slot, from the first post to the start of its notify cycle.
+ *
+ * Runtime query: CoAP GET "diag/coap", line `notify ...`.
+ *
+ * @version 0.1
+ * @date 17-10-2026
+ * @author Jan Łukaszewicz (plhareo@gmail.com)
+ * @copyright © 2025 MIT @ref prj_license
+ */
+
+#ifndef OT_APP_COAP_NOTIFY_H_
+#define OT_APP_COAP_NOTIFY_H_
+
+#include "hro_utils.h"
+#include "ot_app_coap_uri_obs.h"
+
+#define OTAPP_COAP_NOTIFY_OK                (-1)
+#define OTAPP_COAP_NOTIFY_ERROR             (-2)
+#define OTAPP_COAP_NOTIFY_MERGED            (-3)        ///< replaced the waiting value of the same uri
+#define OTAPP_COAP_NOTIFY_FULL              (-4)        ///< no free slot, notify inline
+
+#define OTAPP_COAP_NOTIFY_QUEUE_LENGTH      8           ///< uris with a change waiting for the notify task
+#define OTAPP_COAP_NOTIFY_BATCH_MAX         4           ///< jobs notified in one cycle
+#define OTAPP_COAP_NOTIFY_TASK_STACK_DEPTH  (128 * 24)  ///< Stack size for the notify RTOS task
+#define OTAPP_COAP_NOTIFY_TASK_PRIORITY     4           ///< below the OpenThread task (5 in the ESP-IDF examples)
+
+/**
+ * @brief notify function of the task, in the application: oac_uri_obs_notifyBatch() of the subscriber list
+ */
+typedef int8_t (*otapp_coap_notifyBatch_t)(const oac_uri_obs_notifyItem_t *items, uint8_t itemsQty);
+
+/**
+ * @brief one resource change, copied out of the request
+ */
+typedef struct {
+    otIp6Address excludedIpAddr;                ///< request sender, not notified
+    uint8_t data[OAC_URI_OBS_BUFFER_SIZE];
+    uint16_t dataSize;
+    oacu_uriIndex_t uriIndex;
+    uint8_t isExcluded;                         ///< 0: all subscribers are notified
+    uint32_t postTimeMs;
+} otapp_coap_notifyJob_t;
+
+/**
+ * @brief slot and lag statistics
+ */
+typedef struct {
+    uint32_t posted;        ///< changes posted (merged included)
+    uint32_t merged;        ///< replaced a waiting value of the same uri
+    uint32_t overflow;      ///< no free slot, notified inline
+    uint32_t done;          ///< jobs notified by the task
+    uint32_t cycles;        ///< notify cycles of the task
+    uint32_t lagLastMs;
+    uint32_t lagMaxMs;
+    uint32_t lagSumMs;      ///< average: lagSumMs / done
+    uint8_t depth;          ///< uris waiting after the last post / take
+    uint8_t depthMax;
+} otapp_coap_notifyStats_t;
+
+/**
+ * @brief clear the statistics and the slots, set the notify function
+ *
+ * @param notifyFn [in] notify function, NULL: otapp_coap_notifyRun() returns OTAPP_COAP_NOTIFY_ERROR
+ */
+void otapp_coap_notifyInit(otapp_coap_notifyBatch_t notifyFn);
+
+/**
+ * @brief fill a job with copies of the request data
+ *
+ * @param jobOut            [out] job to post
+ * @param excludedIpAddr    [in] request sender, NULL: all subscribers are notified
+ * @param uriIndex          uri of the changed resource
+ * @param data              [in] payload of the request
+ * @param dataSize          max OAC_URI_OBS_BUFFER_SIZE
+ * @param nowMs             post time
+ * @return int8_t OTAPP_COAP_NOTIFY_OK or OTAPP_COAP_NOTIFY_ERROR (invalid args)
+ */
+int8_t otapp_coap_notifyJobSet(otapp_coap_notifyJob_t *jobOut, const otIp6Address *excludedIpAddr, oacu_uriIndex_t uriIndex, const uint8_t *data, uint16_t dataSize, uint32_t nowMs);
+
+/**
+ * @brief post a resource change for the notify task (OpenThread tasklet)
+ *
+ * @param excludedIpAddr    [in] request sender, NULL: all subscribers are notified
+ * @param uriIndex          uri of the changed resource
+ * @param data              [in] payload of the request, copied
+ * @param dataSize          max OAC_URI_OBS_BUFFER_SIZE
+ * @param nowMs             post time
+ * @return int8_t OTAPP_COAP_NOTIFY_OK (new slot), OTAPP_COAP_NOTIFY_MERGED (waiting value replaced),
+ *                OTAPP_COAP_NOTIFY_FULL (notify inline) or OTAPP_COAP_NOTIFY_ERROR (invalid args)
+ */
+int8_t otapp_coap_notifyPost(const otIp6Address *excludedIpAddr, oacu_uriIndex_t uriIndex, const uint8_t *data, uint16_t dataSize, uint32_t nowMs);
+
+/**
+ * @brief take the waiting changes for one notify cycle (notify task), oldest first
+ *
+ * @param jobsOut   [out] copies of the changes
+ * @param jobsMax   capacity of jobsOut
+ * @return uint8_t  number of jobs, 0: nothing waits
+ */
+uint8_t otapp_coap_notifyTake(otapp_coap_notifyJob_t *jobsOut, uint8_t jobsMax);
+
+/**
+ * @brief end of the notify cycle of the taken jobs, changes posted meanwhile go in the next cycle
+ */
+void otapp_coap_notifyDone(void);
+
+/**
+ * @brief notify cycle of the task: all jobs in one @ref otapp_coap_notifyBatch_t call
+ *
+ * @param jobs      [in] jobs from @ref otapp_coap_notifyTake
+ * @param jobsQty   1 .. OTAPP_COAP_NOTIFY_BATCH_MAX
+ * @param nowMs     start of the cycle, lag of every job: nowMs - postTimeMs
+ * @return int8_t result of the notify function or OTAPP_COAP_NOTIFY_ERROR (invalid args, not initialized)
+ */
+int8_t otapp_coap_notifyRun(const otapp_coap_notifyJob_t *jobs, uint8_t jobsQty, uint32_t nowMs);
+
+/**
+ * @brief slot and lag statistics
+ */
+const otapp_coap_notifyStats_t *otapp_coap_notifyStatsGet(void);
+
+#endif  /* OT_APP_COAP_NOTIFY_H_ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,76 @@
+/**
+ * @file ot_app_coap_response.h
+ * @brief Pre-encoded CoAP responses: type, code and payload of a reply to a request.
+ * @details see more information in section: @ref ot_app_coap_response
+ *
+ * @defgroup ot_app_coap_response CoAP pre-encoded responses
+ * @ingroup ot_app
+ * @brief Pre-encoded CoAP responses: type, code and payload of a reply to a request.
+ * @details
+ * @{
+ *
+ * Reply of @ref otapp_coap_sendResponseMessage to a request:
+ *
+ * | message                   | GET                              | PUT              |
+ * |---------------------------|----------------------------------|------------------|
+ * | OTAPP_MESSAGE_OK          | 2.05 Content "OK"                | 2.04 Changed     |
+ * | OTAPP_MESSAGE_TEST        | 2.05 Content "Hello coap !!"     | 2.04 Changed     |
+ * | OTAPP_MESSAGE_ERROR       | 4.00 Bad Request "ERROR"         | 4.00 Bad Request |
+ * | OTAPP_MESSAGE_BAD_OPTION  | 4.02 Bad Option "BAD OPTION"     | 4.02 Bad Option  |
+ *
+ * PUT is answered without payload, other methods with 4.05 Method Not Allowed.
+ * Response type: @ref otapp_coap_responseType (piggybacked ACK to CON, NON to NON).
+ *
+ * @version 0.1
+ * @date 17-10-2026
+ * @author Jan Łukaszewicz (plhareo@gmail.com)
+ * @copyright © 2025 MIT @ref prj_license
+ */
+
+#ifndef OT_APP_COAP_RESPONSE_H_
+#define OT_APP_COAP_RESPONSE_H_
+
+#include "hro_utils.h"
+
+#ifdef UNIT_TEST
+    #include "mock_ot_app_coap.h"
+#endif
+#include "ot_app_coap.h"
+
+#define OTAPP_COAP_RESPONSE_OK      (-1)
+#define OTAPP_COAP_RESPONSE_ERROR   (-2)
+
+/**
+ * @brief resolved response to one request
+ */
+typedef struct {
+    otCoapType type;
+    otCoapCode code;
+    const uint8_t *payload;     ///< NULL: without payload
+    uint16_t payloadLength;
+} otapp_coap_response_t;
+
+/**
+ * @brief type, code and payload of the pre-encoded response msgID to a request
+ *
+ * @param msgID         pre-encoded response
+ * @param requestCode   code of the request (method)
+ * @param requestType   type of the request
+ * @param responseOut   [out] resolved response
+ * @return int8_t OTAPP_COAP_RESPONSE_OK or OTAPP_COAP_RESPONSE_ERROR (unknown msgID, responseOut NULL)
+ */
+int8_t otapp_coap_responseResolve(otapp_coap_messageId_t msgID, otCoapCode requestCode, otCoapType requestType, otapp_coap_response_t *responseOut);
+
+/**
+ * @brief payload text of a pre-encoded response (the GET payload)
+ *
+ * @param msgID [in] pre-encoded response
+ * @return const char* payload, NULL: unknown msgID
+ */
+const char *otapp_coap_getMessage(otapp_coap_messageId_t msgID);
+
+#endif  /* OT_APP_COAP_RESPONSE_H_ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,160 @@
+/**
+ * @file ot_app_coap_stats.h
+ * @brief In-flight CoAP client requests and per-peer RTT / loss statistics.
+ * @details see more information in section: @ref ot_app_coap_stats
+ *
+ * @defgroup ot_app_coap_stats CoAP client statistics
+ * @ingroup ot_app
+ * @brief In-flight CoAP client requests and per-peer RTT / loss statistics.
+ * @details
+ * @{
+ *
+ * Every Confirmable request sent by `otapp_coap_client_send()` takes an entry of the bounded
+ * in-flight table (token, peer, send time, user response handler). The request is sent with the
+ * response handler of this module, which closes the entry and calls the user handler:
+ * - response: RTT goes to the histogram of the peer,
+ * - timeout / error: the request is counted as lost.
+ *
+ * OpenThread does not report the number of transmissions, the attempts are estimated from the RTT
+ * and the RFC 7252 backoff lower bound (retransmission k is not sent before ACK_TIMEOUT * (2^k - 1)).
+ * A lost request used all OTAPP_COAP_STATS_MAX_RETRANSMIT retransmissions.
+ *
+ * Table full: the request is sent with the user handler and counted as untracked.
+ * Peer table full: statistics go to the last entry (address ::, "other peers").
+ *
+ * Runtime query: CoAP GET "diag/coap", one text line per peer.
+ *
+ * @version 0.1
+ * @date 17-10-2026
+ * @author Jan Łukaszewicz (plhareo@gmail.com)
+ * @copyright © 2025 MIT @ref prj_license
+ */
+
+#ifndef OT_APP_COAP_STATS_H_
+#define OT_APP_COAP_STATS_H_
+
+#include "hro_utils.h"
+
+#ifdef UNIT_TEST
+    #include "mock_ot_app_coap.h"
+#else
+    #include <openthread/coap.h>
+#endif
+
+#define OTAPP_COAP_STATS_OK                 (-1)
+#define OTAPP_COAP_STATS_ERROR              (-2)
+
+#define OTAPP_COAP_STATS_INFLIGHT_MAX       16      ///< requests waiting for a response
+#define OTAPP_COAP_STATS_PEERS_MAX          8       ///< peers with own statistics, +1 entry for other peers
+#define OTAPP_COAP_STATS_TOKEN_MAX          8       ///< OT_COAP_MAX_TOKEN_LENGTH
+
+#define OTAPP_COAP_STATS_ACK_TIMEOUT_MS     2000    ///< RFC 7252 ACK_TIMEOUT (OpenThread default)
+#define OTAPP_COAP_STATS_MAX_RETRANSMIT     4       ///< RFC 7252 MAX_RETRANSMIT (OpenThread default)
+
+#define OTAPP_COAP_STATS_RTT_LIMITS_MS      {50, 100, 200, 500, 1000, 2000, 5000} ///< upper bounds of the histogram buckets, last bucket: above
+#define OTAPP_COAP_STATS_RTT_BUCKETS        8
+
+/**
+ * @brief statistics of one peer
+ */
+typedef struct {
+    otIp6Address peerAddr;
+    uint32_t sent;          ///< tracked requests
+    uint32_t completed;     ///< response received
+    uint32_t lost;          ///< timeout or error
+    uint32_t retransmits;   ///< estimated
+    uint32_t rttMin;        ///< ms
+    uint32_t rttMax;        ///< ms
+    uint32_t rttSum;        ///< ms, average: rttSum / completed
+    uint32_t rttHist[OTAPP_COAP_STATS_RTT_BUCKETS];
+    uint8_t isTaken;
+} otapp_coap_statsPeer_t;
+
+/**
+ * @brief one in-flight request
+ */
+typedef struct {
+    uint8_t token[OTAPP_COAP_STATS_TOKEN_MAX];
+    uint8_t tokenLength;
+    uint8_t peerId;
+    uint8_t isTaken;
+    uint32_t sendTimeMs;
+    otCoapResponseHandler responseHandler;  ///< user handler, can be NULL
+    void *aContext;                         ///< user context
+} otapp_coap_statsRequest_t;
+
+/**
+ * @brief clear the in-flight table and all statistics
+ */
+void otapp_coap_statsInit(void);
+
+/**
+ * @brief take an in-flight entry for a sent request
+ *
+ * @param peer_addr         [in] destination
+ * @param token             [in] request token
+ * @param tokenLength       token length, max OTAPP_COAP_STATS_TOKEN_MAX
+ * @param responseHandler   [in] user handler, called from @ref otapp_coap_statsRequestEnd caller
+ * @param aContext          [in] user context
+ * @param nowMs             send time
+ * @return otapp_coap_statsRequest_t* entry (send the request with it as the handler context),
+ *         NULL: table full or the token is already in flight (request is counted as untracked)
+ */
+otapp_coap_statsRequest_t *otapp_coap_statsRequestStart(const otIp6Address *peer_addr, const uint8_t *token, uint8_t tokenLength, otCoapResponseHandler responseHandler, void *aContext, uint32_t nowMs);
+
+/**
+ * @brief close the entry: response or timeout of the request
+ *
+ * @param request           [in] entry from @ref otapp_coap_statsRequestStart
+ * @param result            OT_ERROR_NONE: response received, other: lost
+ * @param nowMs             completion time
+ * @param responseHandlerOut [out] user handler of the request, NULL to skip
+ * @param aContextOut       [out] user context of the request, NULL to skip
+ * @return int8_t OTAPP_COAP_STATS_OK or OTAPP_COAP_STATS_ERROR (entry not in flight)
+ */
+int8_t otapp_coap_statsRequestEnd(otapp_coap_statsRequest_t *request, otError result, uint32_t nowMs, otCoapResponseHandler *responseHandlerOut, void **aContextOut);
+
+/**
+ * @brief release the entry without statistics (request was not sent)
+ *
+ * @param request [in] entry from @ref otapp_coap_statsRequestStart
+ */
+void otapp_coap_statsRequestCancel(otapp_coap_statsRequest_t *request);
+
+/**
+ * @brief find an in-flight request by token
+ *
+ * @return const otapp_coap_statsRequest_t* or NULL
+ */
+const otapp_coap_statsRequest_t *otapp_coap_statsRequestGet(const uint8_t *token, uint8_t tokenLength);
+
+/**
+ * @brief statistics of one peer
+ *
+ * @param peerId 0 .. OTAPP_COAP_STATS_PEERS_MAX (last: other peers)
+ * @return const otapp_coap_statsPeer_t* or NULL (no statistics)
+ */
+const otapp_coap_statsPeer_t *otapp_coap_statsPeerGet(uint8_t peerId);
+
+/**
+ * @brief loss rate of the peer
+ *
+ * @return uint16_t lost / (completed + lost) in permille
+ */
+uint16_t otapp_coap_statsLossPermille(const otapp_coap_statsPeer_t *peer);
+
+/**
+ * @brief number of requests in flight
+ */
+uint8_t otapp_coap_statsInFlightGet(void);
+
+/**
+ * @brief number of requests sent without tracking (table full, token in flight)
+ */
+uint32_t otapp_coap_statsUntrackedGet(void);
+
+#endif  /* OT_APP_COAP_STATS_H_ */
+
+/**
+ * @}
+ */
@@ -0,0 +1,80 @@
+/**
+ * @file ot_app_coap_transport.h
+ * @brief CoAP message type selection: NON streams with CON checkpoints, request and response types.
+ * @details see more information in section: @ref ot_app_coap_transport
+ *
+ * @defgroup ot_app_coap_transport CoAP transport selection
+ * @ingroup ot_app
+ * @brief CoAP message type selection: NON streams with CON checkpoints, request and response types.
+ * @details
+ * @{
+ *
+ * Decisions only, no OpenThread message calls, so the rules are testable on the host:
+ * - **NON stream** (e.g. dimming during a long press): every update goes Non-confirmable,
+ *   every OTAPP_COAP_NON_CHECKPOINT_INTERVAL-th one Confirmable (RFC 7641 4.5). When the stream stops
+ *   after a NON update, the final value is sent CON, so a lost last step is not left on the peer.
+ * - **Request type:** @ref otapp_coap_transport_t to the CoAP header type.
+ * - **Response type:** a CON request is answered with a piggybacked ACK, a NON request with a NON response,
+ *   no retransmission state on this side in both cases.
+ *
+ * @code{.c}
+ * transport = drv->api.coap.nonStreamNext(&dimStream);                 // every tick
+ * if(drv->api.coap.nonStreamStop(&dimStream)) { send final value CON } // button released
+ * @endcode
+ *
+ * @version 0.1
+ * @date 17-10-2026
+ * @author Jan Łukaszewicz (plhareo@gmail.com)
+ * @copyright © 2025 MIT @ref prj_license
+ */
+
+#ifndef OT_APP_COAP_TRANSPORT_H_
+#define OT_APP_COAP_TRANSPORT_H_
+
+#include "hro_utils.h"
+
+#ifdef UNIT_TEST
+    #include "mock_ot_app_coap.h"
+#endif
+#include "ot_app_coap.h"
+
+/**
+ * @brief transport of the next message of a NON stream
+ * @details returns OTAPP_COAP_TRANSPORT_NON, and OTAPP_COAP_TRANSPORT_CON for every
+ *          OTAPP_COAP_NON_CHECKPOINT_INTERVAL-th message, so the peer is checked periodically
+ *          and a lost NON update is corrected by the next CON.
+ *
+ * @param stream    [in/out] stream state, zeroed: first message is NON
+ * @return otapp_coap_transport_t OTAPP_COAP_TRANSPORT_CON for stream == NULL
+ */
+otapp_coap_transport_t otapp_coap_nonStreamNext(otapp_coap_nonStream_t *stream);
+
+/**
+ * @brief end of a NON stream, the next @ref otapp_coap_nonStreamNext starts a new one
+ *
+ * @param stream    [in/out] stream state
+ * @return uint8_t  1: the last update was NON, send the final value CON, 0: last update was a CON checkpoint (or none)
+ */
+uint8_t otapp_coap_nonStreamStop(otapp_coap_nonStream_t *stream);
+
+/**
+ * @brief CoAP header type of a client request
+ *
+ * @param transport OTAPP_COAP_TRANSPORT_CON or OTAPP_COAP_TRANSPORT_NON
+ * @return otCoapType OT_COAP_TYPE_NON_CONFIRMABLE for NON, else OT_COAP_TYPE_CONFIRMABLE
+ */
+otCoapType otapp_coap_transportType(otapp_coap_transport_t transport);
+
+/**
+ * @brief CoAP header type of a response
+ *
+ * @param requestType type of the request
+ * @return otCoapType OT_COAP_TYPE_NON_CONFIRMABLE for a NON request, else OT_COAP_TYPE_ACKNOWLEDGMENT (piggybacked)
+ */
+otCoapType otapp_coap_responseType(otCoapType requestType);
+
+#endif  /* OT_APP_COAP_TRANSPORT_H_ */
+
+/**
+ * @}
+ */
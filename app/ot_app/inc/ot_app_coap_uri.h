@@ -70,7 +70,8 @@ void otapp_coap_uri_paringServicesHandle(void *aContext, otMessage *request, con
  * **Logic:**
  * 1. Extracts the CoAP Token from the message.
  * 2. Matches the Token using `oac_uri_obs` to identify the sender device.
- * 3. Updates the internal state mirroring the remote device via `oac_uri_obs_parseMessageFromNotify`.
+ * 3. Unpacks all records of the message (one per observed URI) via `oac_uri_obs_parseNotify`
+ *    and calls `obs_subscribedUri_clb` for each of them.
  * @param[in] aContext      User context pointer.
  * @param[in] request       Pointer to the incoming notification message.
  * @param[in] aMessageInfo  Pointer to message metadata.
@@ -80,6 +81,29 @@ void otapp_coap_uri_subscribedHandle(void *aContext, otMessage *request, const o
 
 void ad_temp_uri_well_knownCoreHandle(void *aContext, otMessage *request, const otMessageInfo *aMessageInfo);
 
+/**
+ * @brief Handler for the buffer pool diagnostics resource ("diag/buf").
+ * @details Responds with one text line per `ot_app_buffer` slot: 
+ * `key:peak/max a=<lock acquisitions> c=<contended acquisitions> o=<overflow rejections> b=<busy-slot rejections>`.
+ * @param[in] aContext      User context pointer (unused).
+ * @param[in] request       Pointer to the incoming CoAP request message.
+ * @param[in] aMessageInfo  Pointer to message metadata.
+ */
+void otapp_coap_uri_bufStatsHandle(void *aContext, otMessage *request, const otMessageInfo *aMessageInfo);
+
+/**
+ * @brief Handler for the CoAP client statistics resource ("diag/coap").
+ * @details Responds with one text line per peer (@ref ot_app_coap_stats), the first line is global:
+ * `inflight=<requests in flight> untracked=<not tracked>`, the deferred notify line (@ref ot_app_coap_notify)
+ * `notify posted=<jobs> overflow=<notified inline> depth=<last>/<max> lag=<last>/<avg>/<max>`, then
+ * `<peer IID> n=<sent> ok=<completed> lost=<lost> loss=<permille> rtx=<retransmits> rtt=<min>/<avg>/<max> h=<histogram>`.
+ * The peer `0000:0000:0000:0000` collects the peers that did not fit in the table.
+ * @param[in] aContext      User context pointer (unused).
+ * @param[in] request       Pointer to the incoming CoAP request message.
+ * @param[in] aMessageInfo  Pointer to message metadata.
+ */
+void otapp_coap_uri_coapStatsHandle(void *aContext, otMessage *request, const otMessageInfo *aMessageInfo);
+
 #endif  /* OT_APP_COAP_URI_TEST_H_ */
 
 /**
@@ -15,6 +15,25 @@
  * 2. **Registration:** This module saves the Client's IP address, the Token they generated, and the URI they are interested in.
  * 3. **Notification:** When the local resource changes (e.g. light turns ON), the application iterates through this registry.
  * 4. **Delivery:** The application sends an asynchronous CoAP Response (Notification) to all registered IPs using the stored Tokens.
+ *
+ * **Aggregation:** all notifications of one notify cycle (@ref oac_uri_obs_notifyBatch) that go to the
+ * same IP address are packed into one `subscribed_uris` PUT. The payload is a format byte
+ * `OAC_URI_OBS_NOTIFY_FORMAT_VERSION` followed by a TLV buffer (@ref ot_app_msg_tlv),
+ * one block per record: key `OAC_URI_OBS_NOTIFY_KEY_PATTERN + n`, value `token | data`.
+ * The receiver unpacks it with @ref oac_uri_obs_parseNotify, a payload with another format byte is rejected
+ * (the old layout: a bare `token | data` record without the format byte).
+ *
+ * **Multicast fan-out:** with @ref OAC_URI_OBS_NOTIFY_MODE_MULTICAST and at least
+ * `OAC_URI_OBS_NOTIFY_MULTICAST_MIN` destinations, the records for all subscribers are packed into
+ * one Non-confirmable PUT to the group address (@ref oac_uri_obs_notifyModeSet). Every receiver
+ * keeps only the records with its own tokens (`tokenFilter` of @ref oac_uri_obs_parseNotify).
+ *
+ * **Tasks:** subscribe runs in the OpenThread tasklet, the notify cycle in the notify task. After
+ * @ref oac_uri_obs_init the list is guarded by a mutex (subscribe, unsubscribe, deleteAll, notifyModeSet):
+ * - @ref oac_uri_obs_notifyBatch copies the list under the mutex and sends from the copy without it,
+ *   every send takes the OpenThread lock by itself, the tasklet is not held for the fan-out,
+ * - @ref oac_uri_obs_notify sends from the live list under the mutex: lock order OpenThread lock first,
+ *   then the mutex, so only for a caller holding the OpenThread lock (the tasklet).
  * 
  * @author Jan Łukaszewicz (plhareo@gmail.com)
  * @version 0.1
@@ -25,6 +44,7 @@
 #define OT_APP_COAP_URI_OBS_H_
 
 #include "hro_utils.h"
+#include "ot_app_msg_tlv.h"
 
 #ifdef UNIT_TEST
     #include "mock_ot_app_coap.h"
@@ -41,7 +61,17 @@
 #define OAC_URI_OBS_PAIRED_URI_MAX          OTAPP_PAIRED_URI_MAX 
 
 #define OAC_URI_OBS_BUFFER_SIZE             (8 * 4)
-#define OAC_URI_OBS_TX_BUFFER_SIZE         (OAC_URI_OBS_TOKEN_LENGTH + OAC_URI_OBS_BUFFER_SIZE)
+
+#define OAC_URI_OBS_NOTIFY_KEY_PATTERN      0xAB00
+#define OAC_URI_OBS_NOTIFY_FORMAT_VERSION   0x01    // first byte of the notify payload, bump on a layout change
+#define OAC_URI_OBS_NOTIFY_FORMAT_SIZE      1
+#define OAC_URI_OBS_NOTIFY_RECORD_SIZE      (OAC_URI_OBS_TOKEN_LENGTH + OAC_URI_OBS_BUFFER_SIZE)  // token | data
+#define OAC_URI_OBS_NOTIFY_RECORDS_MAX      OAC_URI_OBS_PAIRED_URI_MAX  // records in one message, more are sent in the next one
+#ifndef OAC_URI_OBS_NOTIFY_MULTICAST
+    #define OAC_URI_OBS_NOTIFY_MULTICAST    0   // default notify mode: 0 - unicast, 1 - multicast to the group address
+#endif
+#define OAC_URI_OBS_NOTIFY_MULTICAST_MIN    2   // destinations needed to send one multicast message instead of unicasts
+#define OAC_URI_OBS_TX_BUFFER_SIZE          (OAC_URI_OBS_NOTIFY_FORMAT_SIZE + OT_APP_MSG_TLV_RESERVED_SIZE + OAC_URI_OBS_NOTIFY_RECORDS_MAX * OT_APP_MSG_TLV_BLOCK_SIZE_MAX(OAC_URI_OBS_NOTIFY_RECORD_SIZE))
 
 #define OAC_URI_OBS_UPDATE_IP_ADDR_Msk         (0x1UL << 0U) // 1
 #define OAC_URI_OBS_UPDATE_URI_TOKEN_Msk       (0x1UL << 1U) // 2
@@ -73,6 +103,26 @@ typedef struct {
     uint8_t buffer[OAC_URI_OBS_BUFFER_SIZE];
 } oac_uri_dataPacket_t;
 
+typedef enum {
+    OAC_URI_OBS_NOTIFY_MODE_UNICAST = 0,    ///< one message per destination IP
+    OAC_URI_OBS_NOTIFY_MODE_MULTICAST,      ///< one NON message to the group address
+} oac_uri_obs_notifyMode_t;
+
+/**
+ * @brief receiver side record filter, returns OAC_URI_OBS_IS for the own subscription token
+ */
+typedef int8_t (*oac_uri_obs_tokenFilter_t)(const oacu_token_t *token);
+
+/**
+ * @brief One local resource change for @ref oac_uri_obs_notifyBatch.
+ */
+typedef struct {
+    const otIp6Address *excludedIpAddr; ///< subscriber not notified (request sender), NULL: none
+    const uint8_t *data;
+    uint16_t dataSize;                  ///< up to OAC_URI_OBS_BUFFER_SIZE
+    oacu_uriIndex_t uriIndex;
+} oac_uri_obs_notifyItem_t;
+
 typedef struct oac_uri_obs_t{
     oacu_token_t token[OAC_URI_OBS_TOKEN_LENGTH];
     oacu_uriIndex_t uriIndex; 
@@ -94,9 +144,17 @@ typedef struct oac_uri_observer_t{
 oac_uri_observer_t *oac_uri_obs_getSubListHandle(void);
 
 /**
- * @brief get ptr to oac_uri_dataPacket_t struct. it is like as a buffer. You can override it
+ * @brief create the mutex of the subscriber list, before the first call from a second task
+ * @details without it the module is not locked (single task use, host tests)
+ *
+ * @return int8_t OAC_URI_OBS_OK or OAC_URI_OBS_ERROR (no memory for the mutex)
+ */
+int8_t oac_uri_obs_init(void);
+
+/**
+ * @brief get ptr to oac_uri_dataPacket_t array (OAC_URI_OBS_NOTIFY_RECORDS_MAX items). it is like as a buffer. You can override it
  * 
- * @return oac_uri_dataPacket_t* [out] ptr to oac_uri_dataPacket_t
+ * @return oac_uri_dataPacket_t* [out] ptr to the first oac_uri_dataPacket_t
  */
 oac_uri_dataPacket_t *oac_uri_obs_getdataPacketHandle(void);
 
@@ -132,18 +190,43 @@ int8_t oac_uri_obs_subscribeFromUri(oac_uri_observer_t *subListHandle, otMessage
 int8_t oac_uri_obs_unsubscribe(oac_uri_observer_t *subListHandle, char* deviceNameFull, const oacu_token_t *token);
 
 /**
- * @brief todo
+ * @brief notify subscribers of one uri from the OpenThread tasklet
+ * @details one item, as @ref oac_uri_obs_notifyBatch, but on the live list with the list mutex held for the sends
  * 
  * @param subListHandle 
- * @param serverUri 
+ * @param excludedIpAddr [in] subscriber which is not notified, NULL: none
+ * @param uriIndex 
  * @param dataToNotify 
  * @param dataSize 
- * @return int8_t 
+ * @return int8_t number of notified (subscriber, uri) records or OAC_URI_OBS_ERROR
  */
 int8_t oac_uri_obs_notify(oac_uri_observer_t *subListHandle, const otIp6Address *excludedIpAddr, oacu_uriIndex_t uriIndex, const uint8_t *dataToNotify, uint16_t dataSize);
 
 /**
- * @brief parse incomming message from notify
+ * @brief set the notify mode of @ref oac_uri_obs_notifyBatch
+ * 
+ * @param mode      OAC_URI_OBS_NOTIFY_MODE_UNICAST / OAC_URI_OBS_NOTIFY_MODE_MULTICAST
+ * @param groupAddr [in] multicast group of the observers (copied), NULL: keep the previous one
+ */
+void oac_uri_obs_notifyModeSet(oac_uri_obs_notifyMode_t mode, const otIp6Address *groupAddr);
+
+/**
+ * @brief notify subscribers about several resource changes (one notify cycle)
+ * @details records for the same destination IP are packed into one `subscribed_uris` message
+ *          (up to OAC_URI_OBS_NOTIFY_RECORDS_MAX records, the rest goes in the next message).
+ *          Multicast mode: all records in one message to the group address (next one if the buffer is full).
+ *          Sent from a copy of the list, a subscribe during the cycle is notified in the next one.
+ *          Must not be called with the OpenThread lock held.
+ * 
+ * @param subListHandle 
+ * @param items     [in] resource changes
+ * @param itemsQty  
+ * @return int8_t number of notified (subscriber, uri) records or OAC_URI_OBS_ERROR
+ */
+int8_t oac_uri_obs_notifyBatch(oac_uri_observer_t *subListHandle, const oac_uri_obs_notifyItem_t *items, uint8_t itemsQty);
+
+/**
+ * @brief parse one notify record: token | data
  * 
  * @param inBuffer 
  * @param dataSize 
@@ -152,6 +235,18 @@ int8_t oac_uri_obs_notify(oac_uri_observer_t *subListHandle, const otIp6Address
  */
 int8_t oac_uri_obs_parseMessageFromNotify(const uint8_t *inBuffer, const uint16_t dataSize, oac_uri_dataPacket_t *out);
 
+/**
+ * @brief parse incomming message from notify (format byte + TLV, one block per record)
+ * 
+ * @param inBuffer      [in] payload of `subscribed_uris`, first byte OAC_URI_OBS_NOTIFY_FORMAT_VERSION
+ * @param dataSize      
+ * @param packetsOut    [out] array for the records
+ * @param packetsMax    capacity of packetsOut
+ * @param tokenFilter   records rejected by the filter are skipped (multicast), NULL: take all
+ * @return int8_t number of records (0: none for this device) or OAC_URI_OBS_ERROR (unknown format, malformed payload, too many records)
+ */
+int8_t oac_uri_obs_parseNotify(const uint8_t *inBuffer, const uint16_t dataSize, oac_uri_dataPacket_t *packetsOut, uint8_t packetsMax, oac_uri_obs_tokenFilter_t tokenFilter);
+
 /**
  * @brief 
  * 
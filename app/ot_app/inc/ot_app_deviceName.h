@@ -63,6 +63,7 @@
 #define OTAPP_DEVICENAME_SIZE               (OTAPP_DEVICENAME_FULL_SIZE - 22) ///< Max user GroupName length (~10 chars)
 #define OTAPP_DEVICENAME_MIN_SIZE           (OTAPP_DEVICENAME_FULL_SIZE - OTAPP_DEVICENAME_SIZE + 1) ///< Min required size for metadata
 #define OTAPP_DEVICENAME_MIN_ADD_DOMAIN_BUFFER_SIZE           (2 * OTAPP_DEVICENAME_FULL_SIZE) ///< Buffer safety margin for DNS domain
+#define OTAPP_DEVICENAME_GROUP_ADDR_PREFIX  {0xff, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x6f, 0x61} ///< ff03::6f61:0:0, group hash in the last 4 bytes
 ///@}
 
 /**
@@ -137,6 +138,17 @@ int8_t otapp_hostNameToDeviceNameFull(char *hostName);
  */
 int8_t otapp_deviceNameIsMatching(const char *deviceFullName);
 
+/**
+ * @brief Derives the realm-local multicast address of a device-name group.
+ * @details All devices of one group (e.g. "kitchen") get the same address:
+ * @ref OTAPP_DEVICENAME_GROUP_ADDR_PREFIX followed by the FNV-1a hash of the GroupName.
+ * Used for multicast observe notifications, receivers subscribe to it.
+ * @param deviceNameFull [in] Full name string (GroupName_DeviceType_EUI64).
+ * @param addrOut        [out] Group multicast address.
+ * @return int8_t        @ref OTAPP_DEVICENAME_OK or @ref OTAPP_DEVICENAME_ERROR (no GroupName).
+ */
+int8_t otapp_deviceNameGroupAddressGet(const char *deviceNameFull, otIp6Address *addrOut);
+
 /**
  * @brief Clears the internal device name buffer.
  */
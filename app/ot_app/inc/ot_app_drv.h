@@ -178,6 +178,51 @@ typedef struct ot_app_drv_coap_t{
      */
     void (*sendBytePut)(const otIp6Address *peer_addr, const char *aUriPath, const uint8_t *payloadMsg, const uint16_t payloadMsgSize, otCoapResponseHandler responseHandler,  void *aContext);
     
+    /**
+     * @brief send coap message bytes using the PUT method with the selected transport (CON / NON)
+     * 
+     * @param peer_addr         [in] ptr to device IPv6 address
+     * @param aUriPath          [in] string ptr to uri
+     * @param payloadMsg        [in] ptr to payload data
+     * @param payloadMsgSize    [in] payload size
+     * @param transport         [in] OTAPP_COAP_TRANSPORT_CON or OTAPP_COAP_TRANSPORT_NON, for streams use nonStreamNext
+     * @param responseHandler   [in] callback to response handler
+     * @param aContext          [in] content will be provided with responseHandler
+     * @return otError          [out] OT_ERROR_NONE or the send error
+     */
+    otError (*sendBytePutTransport)(const otIp6Address *peer_addr, const char *aUriPath, const uint8_t *payloadMsg, const uint16_t payloadMsgSize, otapp_coap_transport_t transport, otCoapResponseHandler responseHandler, void *aContext);
+
+    /**
+     * @brief send coap PUT through the per-(device, uri) slot: latest value wins, one CON in flight per target
+     * @details see @ref ot_app_coap_coalesce. `aUriPath` must stay valid (uri from the pair list).
+     * 
+     * @param peer_addr         [in] ptr to device IPv6 address
+     * @param aUriPath          [in] string ptr to uri
+     * @param payloadMsg        [in] ptr to payload data (copied, max OTAPP_COAP_COALESCE_PAYLOAD_MAX)
+     * @param payloadMsgSize    [in] payload size
+     * @param transport         [in] OTAPP_COAP_TRANSPORT_CON or OTAPP_COAP_TRANSPORT_NON
+     * @param responseHandler   [in] callback to response handler
+     * @param aContext          [in] content will be provided with responseHandler
+     * @return int8_t           [out] OTAPP_COAP_COALESCE_OK, OTAPP_COAP_COALESCE_PENDING or OTAPP_COAP_COALESCE_ERROR
+     */
+    int8_t (*sendBytePutCoalesce)(const otIp6Address *peer_addr, const char *aUriPath, const uint8_t *payloadMsg, const uint16_t payloadMsgSize, otapp_coap_transport_t transport, otCoapResponseHandler responseHandler, void *aContext);
+
+    /**
+     * @brief transport of the next message of a NON stream: NON with a periodic CON checkpoint
+     * 
+     * @param stream    [in/out] stream state kept by the caller (one per destination uri)
+     * @return otapp_coap_transport_t 
+     */
+    otapp_coap_transport_t (*nonStreamNext)(otapp_coap_nonStream_t *stream);
+
+    /**
+     * @brief end of a NON stream, the next nonStreamNext starts a new one
+     * 
+     * @param stream    [in/out] stream state kept by the caller
+     * @return uint8_t  1: last update was NON, send the final value CON
+     */
+    uint8_t (*nonStreamStop)(otapp_coap_nonStream_t *stream);
+
     /**
      * @brief send coap request using the GET method. Response will contain bytes
      * 
@@ -18,10 +18,15 @@
  *
  * *Key features:**
  * - Append unique TLV blocks (`keyAdd()`): key (u16) + length (u16) + value
+ * - Build many blocks without rescans (`builderInit()` / `builderAdd()`): O(1) append, optional strict duplicate check
  * - Extract value by key (`keyGet()`): linear search with optional value copy
+ * - Patch existing blocks (`keyUpdate()` / `keyDelete()`): in place or with one memmove compaction
+ * - Walk all blocks once (`iterFirst()` / `iterNext()` / `iterPeek()`): no copy, bounds checked
  * - Query free space (`freeBufSpaceGet()`): remaining capacity calculation
  * - **2-byte reserved header** tracks total used bytes (writtenBytes counter)
  * - **Packed 4-byte TLV header** (no padding): `uint16_t key; uint16_t length;`
+ * - Optional **compact format** (`formatSet()`): varint key delta + varint length, 2 bytes for small keys/values
+ * - Struct codecs from a field table (`schemaEncode()` / `schemaFieldGet()` / `schemaSize()`), see @ref msg_tlv_schema
  *
  * *Buffer layout (exact byte-by-byte format):**
  * ```
@@ -39,6 +44,14 @@
  * | `[6:9]`| **value**        | 4B   | `[1,2,3,4]`   | Actual data              |
  * | **↓**  | **TOTAL**        | **10B**|             | **Minimum buffer size**  |
  *
+ * *Compact format:**
+ *
+ * Selected on an empty buffer with `otapp_msg_tlv_formatSet(buffer, size, OT_APP_MSG_TLV_FORMAT_COMPACT)`.
+ * Bit 15 of the reserved header is the format flag, bits 0..14 hold writtenBytes. Each block is
+ * `[varint(key - previous key)][varint(length)][value]` (first block: previous key = 0), varint = 7 bits
+ * per byte with the continuation bit 0x80. Consecutive keys (0xAA01, 0xAA02 ...) with values < 128 B
+ * take 2 header bytes instead of 4. All other functions detect the format from the header.
+ *
  * *Error handling:**
  * - Strict validation: null pointers, buffer overflow, invalid sizes
  * - Duplicate key detection during append
@@ -161,8 +174,85 @@
 #define OT_APP_MSG_TLV_KEY_EXIST            (-4) ///< Key already exists (duplicate add)
 #define OT_APP_MSG_TLV_KEY_NO_EXIST         (-5) ///< Key not found
 #define OT_APP_MSG_TLV_EMPTY_BUFFER         (-5) ///< Buffer has no TLV data
+#define OT_APP_MSG_TLV_END                  (-6) ///< Iterator: no more TLV blocks
+
+#define OT_APP_MSG_TLV_FORMAT_CLASSIC       0   ///< block header: key u16 + length u16
+#define OT_APP_MSG_TLV_FORMAT_COMPACT       1   ///< block header: varint(key delta) + varint(length)
+
+#define OT_APP_MSG_TLV_RESERVED_SIZE        2   ///< reserved header: writtenBytes (bits 0..14) + format (bit 15)
+#define OT_APP_MSG_TLV_HDR_SIZE_MAX         6   ///< biggest block header (compact: 3 + 3 byte varint)
 
 #include "stdint.h"
+#include "stddef.h"
+
+#define OT_APP_MSG_TLV_BUILDER_BITMAP_BITS  64  ///< key filter size of the builder (power of 2)
+#define OT_APP_MSG_TLV_BUILDER_TRUSTED      0   ///< builder: caller guarantees unique keys, no duplicate check
+#define OT_APP_MSG_TLV_BUILDER_STRICT       1   ///< builder: reject duplicates (full scan only on filter hit)
+
+/**
+ * @brief Append context for building a TLV buffer without per-add rescans.
+ * @details Caches writtenBytes and keeps a bitmap filter of written keys
+ *          (bit = key & (OT_APP_MSG_TLV_BUILDER_BITMAP_BITS - 1)). In strict mode a key whose
+ *          bit is clear is known to be unique, so the buffer is scanned only on a filter hit.
+ */
+typedef struct {
+    uint8_t *buffer;            ///< TLV buffer (including the reserved header)
+    uint16_t bufferSize;        ///< total buffer size
+    uint16_t usedBytes;         ///< cached writtenBytes header
+    uint16_t lastKey;           ///< key of the last block (compact key delta base)
+    uint8_t strict;             ///< OT_APP_MSG_TLV_BUILDER_STRICT / OT_APP_MSG_TLV_BUILDER_TRUSTED
+    uint8_t format;             ///< format read from the reserved header
+    uint32_t keyFilter[OT_APP_MSG_TLV_BUILDER_BITMAP_BITS / 32]; ///< bitmap of written keys
+} otapp_msg_tlv_builder_t;
+
+/**
+ * @brief Single TLV block returned by the iterator.
+ * @note `value` points directly into the TLV buffer (no copy, no alignment guarantee).
+ */
+typedef struct {
+    uint16_t key;               ///< TLV key
+    uint16_t length;            ///< value length in bytes
+    const uint8_t *value;       ///< pointer to the first value byte inside the buffer
+} otapp_msg_tlv_item_t;
+
+/**
+ * @brief Cursor for a single pass over a TLV buffer.
+ * @details Initialised by otapp_msg_tlv_iterFirst(). Every block is validated against
+ *          the writtenBytes header and the buffer size before it is returned.
+ */
+typedef struct {
+    const uint8_t *buffer;      ///< TLV buffer (including the reserved header)
+    uint16_t end;               ///< offset of the first byte after the TLV data
+    uint16_t offset;            ///< offset of the next block header
+    uint16_t prevKey;           ///< key of the last returned block (compact key delta base)
+    uint8_t format;             ///< OT_APP_MSG_TLV_FORMAT_CLASSIC / OT_APP_MSG_TLV_FORMAT_COMPACT
+} otapp_msg_tlv_iter_t;
+
+/**
+ * @brief Select the block format of an empty TLV buffer.
+ *
+ * The format is stored in bit 15 of the reserved header, so readers detect it
+ * automatically and every other function works on both formats. A zeroed buffer
+ * is in the classic format.
+ *
+ * @param buffer Pointer to TLV buffer with no blocks written.
+ * @param bufferSize Total buffer size.
+ * @param format OT_APP_MSG_TLV_FORMAT_CLASSIC or OT_APP_MSG_TLV_FORMAT_COMPACT.
+ *
+ * @return OT_APP_MSG_TLV_OK, OT_APP_MSG_TLV_ERROR if the buffer already has blocks.
+ */
+int8_t otapp_msg_tlv_formatSet(uint8_t *buffer, const uint16_t bufferSize, const uint8_t format);
+
+/**
+ * @brief Read the block format of a TLV buffer.
+ *
+ * @param buffer Pointer to TLV buffer.
+ * @param bufferSize Total buffer size.
+ * @param formatOut OUT: OT_APP_MSG_TLV_FORMAT_CLASSIC or OT_APP_MSG_TLV_FORMAT_COMPACT.
+ *
+ * @return OT_APP_MSG_TLV_OK or OT_APP_MSG_TLV_ERROR.
+ */
+int8_t otapp_msg_tlv_formatGet(const uint8_t *buffer, const uint16_t bufferSize, uint8_t *formatOut);
 
 /**
  * @brief Add new TLV block to buffer if key unique and space available.
@@ -181,7 +271,7 @@
  * @note Buffer must have >= 2B + (x * TLV struct + keys valueLength)) bytes free.
  * @note Existing keys rejected (use update if needed).
  */
-int8_t otapp_msg_tlv_keyAdd(uint8_t *buffer, const uint16_t bufferSize, const uint16_t key, const uint16_t valueLengthIn, uint8_t *valueIn);
+int8_t otapp_msg_tlv_keyAdd(uint8_t *buffer, const uint16_t bufferSize, const uint16_t key, const uint16_t valueLengthIn, const uint8_t *valueIn);
 
 /**
  * @brief Extract TLV value by key (optional copy to output).
@@ -198,7 +288,39 @@ int8_t otapp_msg_tlv_keyAdd(uint8_t *buffer, const uint16_t bufferSize, const ui
  * @return OT_APP_MSG_TLV_KEY_EXIST on found (with copy if requested),
  *         OT_APP_MSG_TLV_KEY_NO_EXIST if missing, error otherwise.
  */
-int8_t otapp_msg_tlv_keyGet(uint8_t *buffer, const uint16_t bufferSize, const uint16_t key, uint16_t *valueLengthOut, uint8_t *valueOut);
+int8_t otapp_msg_tlv_keyGet(const uint8_t *buffer, const uint16_t bufferSize, const uint16_t key, uint16_t *valueLengthOut, uint8_t *valueOut);
+
+/**
+ * @brief Remove TLV block by key.
+ *
+ * Blocks after the removed one are moved back with a single memmove, the
+ * writtenBytes header is decreased and the freed bytes are zeroed.
+ *
+ * @param buffer Pointer to TLV buffer.
+ * @param bufferSize Total buffer size.
+ * @param key 16-bit key to remove.
+ *
+ * @return OT_APP_MSG_TLV_OK, OT_APP_MSG_TLV_KEY_NO_EXIST or OT_APP_MSG_TLV_ERROR.
+ */
+int8_t otapp_msg_tlv_keyDelete(uint8_t *buffer, const uint16_t bufferSize, const uint16_t key);
+
+/**
+ * @brief Replace the value of an existing TLV block.
+ *
+ * Same length: value is overwritten in place. Other length: blocks after this one
+ * are moved with a single memmove and the writtenBytes header is fixed up.
+ * The block keeps its position in the buffer.
+ *
+ * @param buffer Pointer to TLV buffer.
+ * @param bufferSize Total buffer size.
+ * @param key 16-bit key to update.
+ * @param valueLengthIn New value length in bytes (0 invalid).
+ * @param valueIn Pointer to new value data.
+ *
+ * @return OT_APP_MSG_TLV_OK, OT_APP_MSG_TLV_KEY_NO_EXIST,
+ *         OT_APP_MSG_TLV_ERROR_NO_SPACE (buffer unchanged) or OT_APP_MSG_TLV_ERROR.
+ */
+int8_t otapp_msg_tlv_keyUpdate(uint8_t *buffer, const uint16_t bufferSize, const uint16_t key, const uint16_t valueLengthIn, const uint8_t *valueIn);
 
 /**
  * @brief Get remaining free space in TLV buffer.
@@ -216,7 +338,201 @@ int8_t otapp_msg_tlv_getBufferTotalFreeSpace(const uint8_t *buffer, const uint16
 
 int8_t otapp_msg_tlv_getBufferTotalUsedSpace(const uint8_t *buffer, const uint16_t bufferSize, uint16_t *writtenBufSpaceOut);
 
-uint16_t otapp_msg_tlv_calcualeBuffer(uint8_t keyDataLength, uint8_t cnt);
+/**
+ * @brief Start iterating over a TLV buffer and return its first block.
+ *
+ * Unlike keyGet(), which rescans from the start for every key, the iterator walks
+ * the buffer once. Use it to parse messages with many keys in linear time.
+ *
+ * @param iter       OUT: iterator state.
+ * @param buffer     Pointer to TLV buffer.
+ * @param bufferSize Total buffer size.
+ * @param itemOut    OUT: first block (NULL to skip).
+ *
+ * @return OT_APP_MSG_TLV_OK when a block was returned,
+ *         OT_APP_MSG_TLV_END when the buffer has no TLV data,
+ *         OT_APP_MSG_TLV_ERROR on invalid params or a corrupted buffer.
+ */
+int8_t otapp_msg_tlv_iterFirst(otapp_msg_tlv_iter_t *iter, const uint8_t *buffer, const uint16_t bufferSize, otapp_msg_tlv_item_t *itemOut);
+
+/**
+ * @brief Return the next TLV block and advance the iterator.
+ *
+ * @param iter    Iterator started with otapp_msg_tlv_iterFirst().
+ * @param itemOut OUT: next block (NULL to skip).
+ *
+ * @return OT_APP_MSG_TLV_OK, OT_APP_MSG_TLV_END after the last block,
+ *         OT_APP_MSG_TLV_ERROR when the block does not fit in the written data.
+ */
+int8_t otapp_msg_tlv_iterNext(otapp_msg_tlv_iter_t *iter, otapp_msg_tlv_item_t *itemOut);
+
+/**
+ * @brief Return the next TLV block without advancing the iterator.
+ *
+ * @param iter    Iterator started with otapp_msg_tlv_iterFirst().
+ * @param itemOut OUT: next block.
+ *
+ * @return Same codes as otapp_msg_tlv_iterNext().
+ */
+int8_t otapp_msg_tlv_iterPeek(const otapp_msg_tlv_iter_t *iter, otapp_msg_tlv_item_t *itemOut);
+
+/**
+ * @brief Start building TLV data in a buffer.
+ *
+ * Keys already present in the buffer are added to the key filter (one pass),
+ * so a builder can also continue a buffer filled by keyAdd().
+ *
+ * @param builder    OUT: builder context.
+ * @param buffer     Pointer to TLV buffer (zeroed or with valid TLV data).
+ * @param bufferSize Total buffer size.
+ * @param strict     OT_APP_MSG_TLV_BUILDER_STRICT for untrusted keys, OT_APP_MSG_TLV_BUILDER_TRUSTED otherwise.
+ *
+ * @return OT_APP_MSG_TLV_OK or OT_APP_MSG_TLV_ERROR.
+ */
+int8_t otapp_msg_tlv_builderInit(otapp_msg_tlv_builder_t *builder, uint8_t *buffer, const uint16_t bufferSize, const uint8_t strict);
+
+/**
+ * @brief Append TLV block in O(1) (strict mode: full scan only on a key filter hit).
+ *
+ * @param builder       Builder started with otapp_msg_tlv_builderInit().
+ * @param key           16-bit key identifier.
+ * @param valueLengthIn Value length in bytes (0 invalid).
+ * @param valueIn       Pointer to value data to copy.
+ *
+ * @return Same codes as otapp_msg_tlv_keyAdd(). OT_APP_MSG_TLV_KEY_EXIST only in strict mode.
+ */
+int8_t otapp_msg_tlv_builderAdd(otapp_msg_tlv_builder_t *builder, const uint16_t key, const uint16_t valueLengthIn, const uint8_t *valueIn);
+
+/**
+ * @name Block codec
+ * @brief Low level encoding shared with TLV backends that do not keep the data in a
+ *        contiguous buffer (see @ref ot_app_msg_tlv_msg.h).
+ * @{
+ */
+
+/** @brief Build the reserved header value. */
+uint16_t otapp_msg_tlv_reservedEncode(const uint16_t usedBytes, const uint8_t format);
+
+/** @brief Split the reserved header value into writtenBytes and format. */
+void otapp_msg_tlv_reservedDecode(const uint16_t reserved, uint16_t *usedBytesOut, uint8_t *formatOut);
+
+/** @brief Size of a block header in the given format (prevKey: key of the previous block, 0 for the first one). */
+uint8_t otapp_msg_tlv_hdrSize(const uint8_t format, const uint16_t key, const uint16_t prevKey, const uint16_t length);
+
+/** @brief Write a block header, returns its size (max OT_APP_MSG_TLV_HDR_SIZE_MAX). */
+uint8_t otapp_msg_tlv_hdrEncode(uint8_t *pWrite, const uint8_t format, const uint16_t key, const uint16_t prevKey, const uint16_t length);
+
+/** @brief Read a block header, returns its size or 0 when it is corrupted or longer than `left` bytes. */
+uint8_t otapp_msg_tlv_hdrDecode(const uint8_t *pRead, const uint16_t left, const uint8_t format, const uint16_t prevKey, uint16_t *keyOut, uint16_t *lengthOut);
+
+/** @} */
+
+/**
+ * @name Schema codec
+ * @anchor msg_tlv_schema
+ * @brief Encode / decode / size of structs described by a field table, no hand written keys.
+ *
+ * A record struct is described by an X-macro list expanded into an `otapp_msg_tlv_field_t` table
+ * with @ref OT_APP_MSG_TLV_SCHEMA_FIELD. Field `f` of record `r` gets the key
+ * `keyBase + r * fieldsQty + f + 1`, so the X-macro order is the wire layout. The worst case size
+ * of a record is a compile time constant: sum of @ref OT_APP_MSG_TLV_BLOCK_SIZE_MAX over the fields.
+ *
+ * @code{.c}
+ * #define MY_SCHEMA(X)  X(temp, OT_APP_MSG_TLV_FIELD_BYTES, sizeof(int16_t)) X(name, OT_APP_MSG_TLV_FIELD_STR, 15)
+ * #define MY_FIELD(member, type, maxLength)  OT_APP_MSG_TLV_SCHEMA_FIELD(my_t, member, type, maxLength)
+ * #define MY_SIZE(member, type, maxLength)   + OT_APP_MSG_TLV_BLOCK_SIZE_MAX(maxLength)
+ *
+ * static const otapp_msg_tlv_field_t myFields[] = { MY_SCHEMA(MY_FIELD) };
+ * static const otapp_msg_tlv_schema_t mySchema = OT_APP_MSG_TLV_SCHEMA(my_t, myFields, 0x1000);
+ * uint8_t buffer[OT_APP_MSG_TLV_RESERVED_SIZE + 4 * (0 MY_SCHEMA(MY_SIZE))]; // 4 records, fixed at compile time
+ * @endcode
+ * @{
+ */
+
+#define OT_APP_MSG_TLV_FIELD_BYTES          0   ///< fixed size member, value length == maxLength
+#define OT_APP_MSG_TLV_FIELD_STR            1   ///< char array member, value: string without '\0' (max maxLength)
+#define OT_APP_MSG_TLV_FIELD_STR_PTR        2   ///< `const char *` member (encode only), value as OT_APP_MSG_TLV_FIELD_STR
+
+/** @brief Classic block size for a value of `valueLength` bytes, upper bound for the compact format too. */
+#define OT_APP_MSG_TLV_BLOCK_SIZE_MAX(valueLength)     (4 + (valueLength))
+
+/** @brief One table entry: member of `recordType` sent as a TLV block of max `maxLength` value bytes. */
+#define OT_APP_MSG_TLV_SCHEMA_FIELD(recordType, member, fieldType, maxLength) \
+    { (uint16_t)offsetof(recordType, member), (uint16_t)(maxLength), (fieldType) },
+
+/** @brief Compile time check that `member` holds `maxLength` value bytes (strings: plus '\0'). */
+#define OT_APP_MSG_TLV_SCHEMA_FIELD_CHECK(recordType, member, fieldType, maxLength) \
+    _Static_assert((fieldType) == OT_APP_MSG_TLV_FIELD_STR_PTR || \
+                   ((fieldType) == OT_APP_MSG_TLV_FIELD_BYTES ? sizeof(((recordType *)0)->member) == (maxLength) \
+                                                              : sizeof(((recordType *)0)->member) > (maxLength)), \
+                   #recordType "." #member " does not match its TLV schema length");
+
+/** @brief Schema initializer for a field table of `recordType`. */
+#define OT_APP_MSG_TLV_SCHEMA(recordType, fieldsTable, keyBase) \
+    { (fieldsTable), (uint8_t)(sizeof(fieldsTable) / sizeof((fieldsTable)[0])), (uint16_t)sizeof(recordType), (uint16_t)(keyBase) }
+
+typedef struct {
+    uint16_t offset;            ///< offsetof() the member in the record struct
+    uint16_t maxLength;         ///< max value length on the wire
+    uint8_t type;               ///< OT_APP_MSG_TLV_FIELD_BYTES / _STR / _STR_PTR
+} otapp_msg_tlv_field_t;
+
+typedef struct {
+    const otapp_msg_tlv_field_t *fields;
+    uint8_t fieldsQty;
+    uint16_t recordSize;        ///< sizeof() the record struct (array stride)
+    uint16_t keyBase;           ///< record r, field f: key = keyBase + r * fieldsQty + f + 1
+} otapp_msg_tlv_schema_t;
+
+/** @brief TLV sink for schemaEncode(): builder (otapp_msg_tlv_builderAddFn) or otMessage writer (otapp_msg_tlv_msgWriterAddFn). */
+typedef int8_t (*otapp_msg_tlv_addFn_t)(void *addCtx, const uint16_t key, const uint16_t valueLengthIn, const uint8_t *valueIn);
+
+/** @brief otapp_msg_tlv_builderAdd() as an otapp_msg_tlv_addFn_t, `addCtx` is otapp_msg_tlv_builder_t *. */
+int8_t otapp_msg_tlv_builderAddFn(void *addCtx, const uint16_t key, const uint16_t valueLengthIn, const uint8_t *valueIn);
+
+/**
+ * @brief Exact size of the TLV blocks of `recordsQty` records in the classic format.
+ *
+ * Stateless, upper bound for the compact format. Add OT_APP_MSG_TLV_RESERVED_SIZE for a whole buffer.
+ *
+ * @return Bytes, 0 on error (NULL args, string longer than its maxLength).
+ */
+uint16_t otapp_msg_tlv_schemaSize(const otapp_msg_tlv_schema_t *schema, const void *records, const uint8_t recordsQty);
+
+/**
+ * @brief Append every field of `recordsQty` records as TLV blocks.
+ *
+ * @param schema      Schema of the record struct.
+ * @param records     Array of records.
+ * @param recordsQty  Number of records.
+ * @param addFn       TLV sink.
+ * @param addCtx      Sink context (builder / msgWriter).
+ *
+ * @return OT_APP_MSG_TLV_OK, OT_APP_MSG_TLV_ERROR (string longer than maxLength, empty value) or the sink error.
+ */
+int8_t otapp_msg_tlv_schemaEncode(const otapp_msg_tlv_schema_t *schema, const void *records, const uint8_t recordsQty, otapp_msg_tlv_addFn_t addFn, void *addCtx);
+
+/**
+ * @brief Map a decoded TLV block to its member in an array of records.
+ *
+ * The caller copies `length` value bytes to `*dstOut` (from a buffer or with otMessageRead()).
+ *
+ * @param schema      Schema of the record struct.
+ * @param records     Array of records (zeroed before decoding, strings stay '\0' terminated).
+ * @param recordsQty  Number of records in the array.
+ * @param key         Block key.
+ * @param length      Block value length.
+ * @param dstOut      OUT: destination of the value.
+ * @param recordOut   OUT: record index, NULL to skip.
+ * @param fieldOut    OUT: field index in the schema, NULL to skip.
+ *
+ * @return OT_APP_MSG_TLV_OK, OT_APP_MSG_TLV_KEY_NO_EXIST (key not in the schema, skip the block)
+ *         or OT_APP_MSG_TLV_ERROR (value longer than the member).
+ */
+int8_t otapp_msg_tlv_schemaFieldGet(const otapp_msg_tlv_schema_t *schema, void *records, const uint8_t recordsQty, const uint16_t key, const uint16_t length,
+                                    void **dstOut, uint8_t *recordOut, uint8_t *fieldOut);
+
+/** @} */
 
 #endif  /* OT_APP_MSG_TLV_H_ */
 
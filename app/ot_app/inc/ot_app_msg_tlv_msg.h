@@ -0,0 +1,154 @@
+/**
+ * @file ot_app_msg_tlv_msg.h
+ * @brief TLV writer / reader working directly on an OpenThread message.
+ * @details see more information in section: @ref ot_app_msg_tlv_msg
+ *
+ * @defgroup ot_app_msg_tlv_msg TLV on otMessage
+ * @ingroup ot_app
+ * @brief TLV writer / reader working directly on an OpenThread message.
+ * @details
+ * @{
+ *
+ * Same wire format as @ref ot_app_msg_tlv (2-byte reserved header + blocks, classic or compact),
+ * but without an intermediate RAM buffer and without taking a block from the buffer pool:
+ * - **writer**: appends every block with `otMessageAppend()` and patches the reserved header
+ *   with `otMessageWrite()` in `msgWriterFinish()`,
+ * - **reader**: decodes block headers with small `otMessageRead()` calls and returns the
+ *   message offset of each value, the caller reads the value straight into its destination.
+ *
+ * @code{.c}
+ * otapp_msg_tlv_msgWriter_t writer;
+ * otapp_msg_tlv_msgWriterInit(&writer, response, OT_APP_MSG_TLV_FORMAT_CLASSIC);
+ * otapp_msg_tlv_msgWriterAdd(&writer, key, sizeof(value), (const uint8_t *)&value);
+ * otapp_msg_tlv_msgWriterFinish(&writer, NULL);
+ *
+ * otapp_msg_tlv_msgReader_t reader;
+ * otapp_msg_tlv_msgItem_t item;
+ * otapp_msg_tlv_msgReaderInit(&reader, request, otMessageGetOffset(request));
+ * while (otapp_msg_tlv_msgReaderNext(&reader, &item) == OT_APP_MSG_TLV_OK)
+ * {
+ *     otMessageRead(request, item.valueOffset, dst, item.length);
+ * }
+ * @endcode
+ *
+ * @version 0.1
+ * @date 17-10-2026
+ * @author Jan Łukaszewicz (plhareo@gmail.com)
+ * @copyright © 2025 MIT @ref prj_license
+ */
+
+#ifndef OT_APP_MSG_TLV_MSG_H_
+#define OT_APP_MSG_TLV_MSG_H_
+
+#include "stdint.h"
+#include "ot_app_msg_tlv.h"
+
+#ifdef UNIT_TEST
+    #include "mock_ot_message.h"
+#else
+    #include <openthread/message.h>
+#endif
+
+/**
+ * @brief Writer state, blocks are appended at the end of the message.
+ */
+typedef struct {
+    otMessage *message;
+    uint16_t headerOffset;      ///< message offset of the reserved header
+    uint16_t usedBytes;         ///< bytes of blocks written after the header
+    uint16_t lastKey;           ///< key of the last block (compact key delta base)
+    uint16_t windowStart;       ///< first TLV byte (reserved header = 0) appended to the message
+    uint16_t windowEnd;         ///< first TLV byte after the window
+    uint8_t format;             ///< OT_APP_MSG_TLV_FORMAT_CLASSIC / OT_APP_MSG_TLV_FORMAT_COMPACT
+} otapp_msg_tlv_msgWriter_t;
+
+/**
+ * @brief Reader state.
+ */
+typedef struct {
+    const otMessage *message;
+    uint16_t offset;            ///< message offset of the next block header
+    uint16_t end;               ///< message offset of the first byte after the TLV data
+    uint16_t prevKey;           ///< key of the last returned block
+    uint8_t format;
+} otapp_msg_tlv_msgReader_t;
+
+/**
+ * @brief Block returned by the reader, the value stays in the message.
+ */
+typedef struct {
+    uint16_t key;
+    uint16_t length;
+    uint16_t valueOffset;       ///< message offset of the first value byte (for otMessageRead())
+} otapp_msg_tlv_msgItem_t;
+
+/**
+ * @brief Append the reserved header placeholder to the message.
+ *
+ * @param writer  OUT: writer state.
+ * @param message Message (e.g. CoAP response after the payload marker).
+ * @param format  OT_APP_MSG_TLV_FORMAT_CLASSIC or OT_APP_MSG_TLV_FORMAT_COMPACT.
+ *
+ * @return OT_APP_MSG_TLV_OK, OT_APP_MSG_TLV_ERROR_NO_SPACE (no message buffers) or OT_APP_MSG_TLV_ERROR.
+ */
+int8_t otapp_msg_tlv_msgWriterInit(otapp_msg_tlv_msgWriter_t *writer, otMessage *message, const uint8_t format);
+
+/**
+ * @brief Writer which appends only the bytes [windowOffset, windowOffset + windowSize) of the TLV data
+ *        (reserved header + blocks), e.g. one CoAP Block2 block.
+ * @details The blocks are encoded in full every time, bytes outside the window are only counted.
+ *          The reserved header is patched when it is inside the window (windowOffset 0).
+ *          windowSize 0: size pass, nothing is appended and `message` can be NULL.
+ *
+ * @param writer        OUT: writer state.
+ * @param message       Message, the window bytes are appended at its end.
+ * @param format        OT_APP_MSG_TLV_FORMAT_CLASSIC or OT_APP_MSG_TLV_FORMAT_COMPACT.
+ * @param windowOffset  First TLV byte of the window, 0 or >= OT_APP_MSG_TLV_RESERVED_SIZE.
+ * @param windowSize    Window size, 0 or >= OT_APP_MSG_TLV_RESERVED_SIZE when windowOffset is 0.
+ *
+ * @return OT_APP_MSG_TLV_OK, OT_APP_MSG_TLV_ERROR_NO_SPACE (no message buffers) or OT_APP_MSG_TLV_ERROR.
+ */
+int8_t otapp_msg_tlv_msgWriterInitWindow(otapp_msg_tlv_msgWriter_t *writer, otMessage *message, const uint8_t format, const uint16_t windowOffset, const uint16_t windowSize);
+
+/**
+ * @brief Append one TLV block to the message. Keys are not checked for duplicates.
+ *
+ * @return OT_APP_MSG_TLV_OK, OT_APP_MSG_TLV_ERROR_NO_SPACE (no message buffers / header full) or OT_APP_MSG_TLV_ERROR.
+ */
+int8_t otapp_msg_tlv_msgWriterAdd(otapp_msg_tlv_msgWriter_t *writer, const uint16_t key, const uint16_t valueLengthIn, const uint8_t *valueIn);
+
+/** @brief otapp_msg_tlv_msgWriterAdd() as an otapp_msg_tlv_addFn_t (schemaEncode()), `addCtx` is otapp_msg_tlv_msgWriter_t *. */
+int8_t otapp_msg_tlv_msgWriterAddFn(void *addCtx, const uint16_t key, const uint16_t valueLengthIn, const uint8_t *valueIn);
+
+/**
+ * @brief Write the final writtenBytes into the reserved header.
+ *
+ * @param writer        Writer state.
+ * @param totalSizeOut  OUT: TLV size (reserved header + blocks), NULL to skip. Window writer: size of
+ *                      the whole TLV data, not only of the window.
+ *
+ * @return OT_APP_MSG_TLV_OK or OT_APP_MSG_TLV_ERROR.
+ */
+int8_t otapp_msg_tlv_msgWriterFinish(otapp_msg_tlv_msgWriter_t *writer, uint16_t *totalSizeOut);
+
+/**
+ * @brief Read the reserved header at `offset` and prepare the reader.
+ *
+ * @return OT_APP_MSG_TLV_OK, or OT_APP_MSG_TLV_ERROR when the header is missing or the
+ *         TLV data is longer than the message.
+ */
+int8_t otapp_msg_tlv_msgReaderInit(otapp_msg_tlv_msgReader_t *reader, const otMessage *message, const uint16_t offset);
+
+/**
+ * @brief Decode the next block header and advance.
+ *
+ * @return OT_APP_MSG_TLV_OK, OT_APP_MSG_TLV_END after the last block,
+ *         OT_APP_MSG_TLV_ERROR when the block does not fit in the TLV data.
+ */
+int8_t otapp_msg_tlv_msgReaderNext(otapp_msg_tlv_msgReader_t *reader, otapp_msg_tlv_msgItem_t *itemOut);
+
+#endif  /* OT_APP_MSG_TLV_MSG_H_ */
+
+/**
+ * @}
+ */
@@ -29,6 +29,7 @@
 #include "hro_utils.h"
 #include "ot_app_coap_uri_obs.h"
 #include "ot_app_coap.h"
+#include "ot_app_msg_tlv.h"
 #include "string.h"
 
 #ifndef UNIT_TEST
@@ -62,6 +63,10 @@
 #define OTAPP_PAIR_URI_RESOURCE_BUFFER_SIZE         (OTAPP_URI_MAX_NAME_LENGHT + sizeof(otapp_deviceType_t) + sizeof(uint8_t))
 #define OTAPP_PAIR_URI_RESOURCE_BUFFER_MAX_SIZE     (OTAPP_PAIR_URI_RESOURCE_BUFFER_SIZE * OTAPP_PAIR_URI_MAX)
 
+#ifndef OTAPP_PAIR_TLV_COMPACT
+#define OTAPP_PAIR_TLV_COMPACT                      0   ///< 1: send URI resources in the compact TLV format (parser reads both formats)
+#endif
+
 #define OTAPP_PAIR_URI_MAX_VAL      OTAPP_URI_END_OF_INDEX
 #define OTAPP_PAIR_NAME_FULL_SIZE   OTAPP_DEVICE_NAME_FULL_SIZE 
 #define OTAPP_PAIR_NO_URI           OTAPP_URI_NO_URI_INDEX
@@ -98,6 +103,25 @@ typedef struct {
 
 typedef uint8_t otapp_pair_resUrisBuffer_t[OTAPP_PAIR_URI_RESOURCE_BUFFER_SIZE];
 
+/**
+ * @brief TLV schema of one URI in the well-known/core payload (see @ref msg_tlv_schema).
+ * @details X(member of otapp_coap_uri_t, its field type, member of @ref otapp_pair_resUrisParseData_t,
+ *          its field type, max value length). The order sets the keys: `0xAA00 + 2*i + 1` devType,
+ *          `0xAA00 + 2*i + 2` uri path, key `0xAA00` carries the number of URIs.
+ */
+#define OTAPP_PAIR_URI_TLV_SCHEMA(X) \
+    X(devType,           OT_APP_MSG_TLV_FIELD_BYTES,   devTypeUriFn, OT_APP_MSG_TLV_FIELD_BYTES, sizeof(uint32_t)) \
+    X(resource.mUriPath, OT_APP_MSG_TLV_FIELD_STR_PTR, uri,          OT_APP_MSG_TLV_FIELD_STR,   OTAPP_URI_MAX_NAME_LENGHT - 1)
+
+#define OTAPP_PAIR_URI_TLV_BLOCK_SIZE_MAX(encMember, encType, decMember, decType, maxLength) + OT_APP_MSG_TLV_BLOCK_SIZE_MAX(maxLength)
+
+/** @brief Worst case TLV bytes of one URI, compile time. */
+#define OTAPP_PAIR_URI_TLV_RECORD_SIZE_MAX  (0 OTAPP_PAIR_URI_TLV_SCHEMA(OTAPP_PAIR_URI_TLV_BLOCK_SIZE_MAX))
+
+/** @brief Worst case well-known/core TLV payload for `uriQty` URIs (reserved header + uris count + records), compile time. */
+#define OTAPP_PAIR_URI_TLV_SIZE_MAX(uriQty) \
+    (OT_APP_MSG_TLV_RESERVED_SIZE + OT_APP_MSG_TLV_BLOCK_SIZE_MAX(sizeof(uint8_t)) + (uriQty) * OTAPP_PAIR_URI_TLV_RECORD_SIZE_MAX)
+
 /**
  * @brief Represents a single URI endpoint belonging to a paired device.
  */
@@ -280,6 +304,19 @@ otapp_pair_resUrisParseData_t *otapp_pair_uriParseMessage(uint8_t *inBuffer, uin
  */
 uint16_t otapp_pair_uriParseMessageCalculateBufSize(uint16_t aMessagePayloadSize);
 
+/**
+ * @brief Parses URI resources directly from a CoAP message, without copying the payload.
+ * @details Same TLV layout as @ref otapp_pair_uriParseMessage, decoded with @ref ot_app_msg_tlv_msg.
+ *          Values are read from the message straight into @p urisOut.
+ * @param[in]  message      CoAP response.
+ * @param[in]  offset       Message offset of the TLV data (usually otMessageGetOffset()).
+ * @param[out] urisOut      Array for the parsed URIs.
+ * @param[in]  urisOutMax   Capacity of @p urisOut.
+ * @param[out] dataSizeOut  Number of URI items found.
+ * @return int8_t @ref OTAPP_PAIR_OK or @ref OTAPP_PAIR_ERROR (malformed TLV, too many URIs).
+ */
+int8_t otapp_pair_uriParseOtMessage(const otMessage *message, uint16_t offset, otapp_pair_resUrisParseData_t *urisOut, uint8_t urisOutMax, uint16_t *dataSizeOut);
+
 /**
  * @brief Adds a parsed URI to a specific slot in a device's URI list.
  * @param deviceUrisList Pointer to the destination slot in the device structure.
@@ -330,6 +367,32 @@ int8_t otapp_pair_uriAdd(otapp_pair_uris_t *deviceUrisList, const otapp_pair_res
  */
 int8_t otapp_pair_uriResourcesCreate(otapp_coap_uri_t *uri, uint8_t uriSize, uint8_t *bufferOut, uint16_t *bufferSizeInOut);
 
+/**
+ * @brief Serializes URI resources directly into a CoAP message.
+ * @details Same TLV layout as @ref otapp_pair_uriResourcesCreate, appended to @p messageOut
+ *          with @ref ot_app_msg_tlv_msg (no intermediate buffer).
+ * @param[in]  uri              Pointer to the array of URI resource structures.
+ * @param[in]  uriSize          Number of URIs to serialize (max @ref OTAPP_PAIR_URI_MAX).
+ * @param[out] messageOut       Message with the payload marker already set (@ref otapp_coap_responseNew).
+ * @param[out] appendedSizeOut  Bytes appended to the message, NULL to skip.
+ * @return int8_t @ref OTAPP_PAIR_OK or @ref OTAPP_PAIR_ERROR (invalid args, no message buffers).
+ */
+int8_t otapp_pair_uriResourcesAppend(otapp_coap_uri_t *uri, uint8_t uriSize, otMessage *messageOut, uint16_t *appendedSizeOut);
+
+/**
+ * @brief Serializes URI resources and appends only one window of the TLV data (CoAP Block2 block).
+ * @details The TLV is encoded in full, only bytes [windowOffset, windowOffset + windowSize) are appended.
+ *          windowSize 0: size pass, @p messageOut can be NULL.
+ * @param[in]  uri              Pointer to the array of URI resource structures.
+ * @param[in]  uriSize          Number of URIs to serialize (max @ref OTAPP_PAIR_URI_MAX).
+ * @param[out] messageOut       Message with the payload marker already set (@ref otapp_coap_responseNewBlock2).
+ * @param[in]  windowOffset     First TLV byte of the window (block number * block size).
+ * @param[in]  windowSize       Window size (block size).
+ * @param[out] totalSizeOut     Size of the whole TLV data, NULL to skip.
+ * @return int8_t @ref OTAPP_PAIR_OK or @ref OTAPP_PAIR_ERROR (invalid args, no message buffers).
+ */
+int8_t otapp_pair_uriResourcesAppendWindow(otapp_coap_uri_t *uri, uint8_t uriSize, otMessage *messageOut, uint16_t windowOffset, uint16_t windowSize, uint16_t *totalSizeOut);
+
 /**
  * @brief Calculates the buffer size needed to serialize a list of URIs.
  * @param uri     Pointer to array of URIs.
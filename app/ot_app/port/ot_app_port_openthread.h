@@ -16,6 +16,8 @@
  * **Usage:**
  * The core application calls `otapp_port_openthread_get_instance()` without needing to know 
  * which hardware is currently running.
+ * A task other than the OpenThread tasklet wraps its OpenThread API calls in
+ * `otapp_port_openthread_lock()` / `otapp_port_openthread_unlock()`.
  * 
  * @version 0.1
  * @date 24-10-2025
@@ -34,6 +36,18 @@
      */
     #define otapp_port_openthread_get_instance() esp_openthread_get_instance()
 
+    #include "esp_openthread_lock.h"
+
+    /**
+     * @brief Takes the OpenThread API lock (ESP32: recursive, held by the tasklet while it runs).
+     */
+    #define otapp_port_openthread_lock()    esp_openthread_lock_acquire(portMAX_DELAY)
+
+    /**
+     * @brief Releases the OpenThread API lock.
+     */
+    #define otapp_port_openthread_unlock()  esp_openthread_lock_release()
+
 #elif defined(STM_PLATFORM)
     #include "app_thread.h"
 
@@ -43,6 +57,12 @@
      */
     #define otapp_port_openthread_get_instance() APP_THREAD_GetInstance()
 
+    /**
+     * @brief OpenThread API lock (STM32: no-op, OpenThread calls are serialized by the IPCC command transfer to the M0 core).
+     */
+    #define otapp_port_openthread_lock()
+    #define otapp_port_openthread_unlock()
+
 #else
     #error "Unsupported platform. Define ESP_PLATFORM or STM_PLATFORM"
 #endif
@@ -24,6 +24,7 @@
 #include "ot_app_pair.h"
 #include "ot_app_dataset_tlv.h"
 #include "ot_app_deviceName.h"
+#include "ot_app_coap_uri_obs.h"
 #include "ot_app_srp_client.h"
 #include "ot_app_drv.h"
 #include "ot_app_buffer.h"
@@ -41,6 +42,7 @@
 #include "ot_app_port_rtos.h"
 #include "openthread/dataset.h"
 #include "openthread/instance.h"
+#include "openthread/ip6.h"
 #include "openthread/thread.h"
 
 #include <inttypes.h>
@@ -68,6 +70,33 @@ const otIp6Address *otapp_multicastAddressGet()
     return &ot_app_multicastAddr;
 }
 
+static otIp6Address ot_app_multicastGroupAddr; // device-name group, observe notifications
+
+const otIp6Address *otapp_multicastGroupAddressGet()
+{
+    return &ot_app_multicastGroupAddr;
+}
+
+static void otapp_multicastGroupInit(void)
+{
+    otError error;
+
+    if(otapp_deviceNameGroupAddressGet(otapp_deviceNameFullGet(), &ot_app_multicastGroupAddr) != OTAPP_DEVICENAME_OK)
+    {
+        ot_app_multicastGroupAddr = ot_app_multicastAddr;
+    }else
+    {
+        error = otIp6SubscribeMulticastAddress(openThreadInstance, &ot_app_multicastGroupAddr);
+        if(error != OT_ERROR_NONE && error != OT_ERROR_ALREADY)
+        {
+            OTAPP_PRINTF(TAG, "ERROR group multicast subscribe: %d\n", error);
+            ot_app_multicastGroupAddr = ot_app_multicastAddr;
+        }
+    }
+
+    oac_uri_obs_notifyModeSet(OAC_URI_OBS_NOTIFY_MULTICAST ? OAC_URI_OBS_NOTIFY_MODE_MULTICAST : OAC_URI_OBS_NOTIFY_MODE_UNICAST, &ot_app_multicastGroupAddr);
+}
+
 const otIp6Address *otapp_ip6AddressGet()
 {
     return otapp_Ip6Address;
@@ -247,6 +276,7 @@ void otapp_network_init() // this function will be initialize in ot_task_worker
     
     otapp_macAddrInit();
     otapp_deviceNameSet(otapp_devDrv->deviceName, *otapp_devDrv->deviceType);
+    otapp_multicastGroupInit();
     otapp_coap_init(otapp_devDrv);    
     otapp_srpInit();
 }
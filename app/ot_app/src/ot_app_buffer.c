@@ -25,6 +25,7 @@
 #include "ot_app_buffer.h"
 #include "hro_utils.h"
 #include "string.h"
+#include <stdatomic.h>
 
 #ifdef UNIT_TEST
     #ifdef TEST_PTHREAD
@@ -36,23 +37,75 @@
     #include "ot_app_port_rtos.h"
 #endif
 
-#define OTAPP_BUF_KEYS_QTY  (sizeof(otapp_buf_init_config) / sizeof(otapp_buf_init_config[0]))
+#define OTAPP_BUF_KEYS_QTY  OTAPP_BUF_SLOTS_QTY
+
+#ifdef OTAPP_BUF_LEASE_DEBUG
+typedef struct {
+    const char *file;     // NULL = free record
+    uint16_t    line;
+    uint8_t     type;     // OTAPP_BUF_LEASE_READ / OTAPP_BUF_LEASE_WRITE
+} leaseOwner_t;
+#endif
+
+typedef struct {
+    uint16_t peak_len;          // high-water mark of current_len (ring: of unread bytes)
+    uint32_t acquire_cnt;       // slot mutex takes
+    uint32_t contended_cnt;     // slot mutex takes that found the mutex held and had to block
+    _Atomic uint32_t overflow_cnt;   // may be counted outside the slot lock
+    _Atomic uint32_t busy_reject_cnt;
+} slotStats_t;
+
 typedef struct {
     uint16_t key;
     uint16_t offset;      // Where does the data start in a large array
     uint16_t max_size;    // How many has been reserved bytes
     uint16_t current_len; // How many actually written bytes there are
     uint8_t  write_lock;  // It is only locked when getWriteOnly_ptr() is using
+    uint8_t  mode;        // OTAPP_BUF_MODE_MUTEX or OTAPP_BUF_MODE_SPSC_RING
+    _Atomic uint32_t head; // SPSC ring: free-running write counter (written only by the producer)
+    _Atomic uint32_t tail; // SPSC ring: free-running read counter (written only by the consumer)
+    SemaphoreHandle_t mutex; // per-slot lock (NULL for SPSC ring slots)
+    uint8_t  readers;     // number of held read leases
+    TaskHandle_t waiter[OTAPP_BUF_WAITERS_MAX]; // FIFO of queued writers, waiter[0] is served first
+    otapp_buf_waitStats_t wait; // write wait queue counters
+    slotStats_t stats;    // telemetry, see otapp_buf_getStats()
+#ifdef OTAPP_BUF_LEASE_DEBUG
+    leaseOwner_t owner[OTAPP_BUF_LEASE_DEBUG_OWNERS_MAX]; // call sites of held leases
+#endif
 } indexEntry_t;
 
+// slab blocks start right after the key slots, aligned to 4
+#define OTAPP_BUF_SLAB_OFFSET       ((OTAPP_BUF_SIZE + 3u) & ~3u)
+#define OTAPP_BUF_SLAB_BLOCKS_MAX   32 // used[] bitmap width
+
+typedef struct slabBlock_s {
+    struct slabBlock_s *next;   // valid only while the block is free
+} slabBlock_t;
+
+typedef struct {
+    uint8_t     *base;          // first block of the class
+    slabBlock_t *free_list;
+    uint32_t     used;          // bit per block, catches double free / foreign pointers
+    SemaphoreHandle_t mutex;
+    TaskHandle_t waiter[OTAPP_BUF_WAITERS_MAX]; // FIFO of callers waiting for a block, waiter[0] is served first
+    uint8_t      waiters;
+    otapp_buf_slabStats_t stats;
+} slabClass_t;
+
 typedef struct {
     indexEntry_t index[OTAPP_BUF_KEYS_QTY]; // Metadata array
-    uint8_t      data[OTAPP_BUF_SIZE];      // Raw data
+    slabClass_t  slab[OTAPP_BUF_SLAB_CLASSES_QTY]; // Slab metadata
+    uint8_t      data[OTAPP_BUF_SLAB_OFFSET + OTAPP_BUF_SLAB_SIZE]; // Raw data: key slots + slab blocks
 } otapp_buf_t;
 
 static HRO_SEC_NOINIT_AL4 otapp_buf_t buf;
 
-static SemaphoreHandle_t otapp_buf_mutex = NULL;
+#define OTAPP_BUF_X_SLAB_CONFIG(c, bs, qty)   { .block_size = (bs), .blocks_total = (qty) },
+static const otapp_buf_slabStats_t otapp_buf_slab_config[] = {
+    OTAPP_BUF_SLAB_TABLE(OTAPP_BUF_X_SLAB_CONFIG)
+};
+
+static uint8_t otapp_buf_initialized = 0;
 
 static int8_t otapp_buf_initKeysIndex(void) 
 {
@@ -73,6 +126,19 @@ static int8_t otapp_buf_initKeysIndex(void)
         // Resetujemy aktualną długość danych (bo bufor jest pusty)
         buf.index[i].current_len = 0;
 
+        buf.index[i].mode = otapp_buf_init_config[i].mode;
+        atomic_init(&buf.index[i].head, 0);
+        atomic_init(&buf.index[i].tail, 0);
+        atomic_init(&buf.index[i].stats.overflow_cnt, 0);
+        atomic_init(&buf.index[i].stats.busy_reject_cnt, 0);
+
+        // SAFETY CHECK: ring index is masked, so the slot size must be a power of two
+        if(buf.index[i].mode == OTAPP_BUF_MODE_SPSC_RING && 
+          (buf.index[i].max_size == 0 || (buf.index[i].max_size & (buf.index[i].max_size - 1)) != 0))
+        {
+            return OTAPP_BUF_ERROR;
+        }
+
         //  Przesuwamy licznik dla NASTĘPNEGO elementu
         running_offset += otapp_buf_init_config[i].size;
 
@@ -86,84 +152,431 @@ static int8_t otapp_buf_initKeysIndex(void)
     return OTAPP_BUF_OK;
 }
 
-static int8_t otapp_buf_mutex_lock(void)
+static int8_t otapp_buf_initMutexes(void)
+{
+    for(uint8_t i = 0; i < OTAPP_BUF_KEYS_QTY; i++) 
+    {
+        if(buf.index[i].mode == OTAPP_BUF_MODE_SPSC_RING) continue; // lock-free slot
+
+        buf.index[i].mutex = xSemaphoreCreateMutex();
+        if(buf.index[i].mutex == NULL) return OTAPP_BUF_ERROR;
+    }
+    return OTAPP_BUF_OK;
+}
+
+static int8_t otapp_buf_initSlab(void)
+{
+    uint32_t running_offset = OTAPP_BUF_SLAB_OFFSET;
+
+    for(uint8_t c = 0; c < OTAPP_BUF_SLAB_CLASSES_QTY; c++) 
+    {
+        slabClass_t *cls = &buf.slab[c];
+        const otapp_buf_slabStats_t *cfg = &otapp_buf_slab_config[c];
+
+        // SAFETY CHECK: alignment for the free list pointer, bitmap width, sorted classes
+        if((cfg->block_size % 4) != 0 || cfg->block_size < sizeof(slabBlock_t) || 
+            cfg->blocks_total == 0 || cfg->blocks_total > OTAPP_BUF_SLAB_BLOCKS_MAX ||
+           (c > 0 && cfg->block_size <= otapp_buf_slab_config[c - 1].block_size))
+        {
+            return OTAPP_BUF_ERROR;
+        }
+
+        cls->base = &buf.data[running_offset];
+        cls->free_list = NULL;
+        cls->used = 0;
+        cls->stats = *cfg;
+
+        // build the free list, first block on top
+        for(int16_t b = cfg->blocks_total - 1; b >= 0; b--) 
+        {
+            slabBlock_t *block = (slabBlock_t*)(cls->base + (uint32_t)b * cfg->block_size);
+            block->next = cls->free_list;
+            cls->free_list = block;
+        }
+
+        cls->mutex = xSemaphoreCreateMutex();
+        if(cls->mutex == NULL) return OTAPP_BUF_ERROR;
+
+        running_offset += (uint32_t)cfg->block_size * cfg->blocks_total;
+    }
+
+    if(running_offset > sizeof(buf.data)) return OTAPP_BUF_ERROR;
+    
+    return OTAPP_BUF_OK;
+}
+
+static int8_t otapp_buf_mutex_lock(indexEntry_t *entry)
 {
-   if(xSemaphoreTake(otapp_buf_mutex, portMAX_DELAY) == pdTRUE)
+   uint8_t contended = 0;
+
+   // a lock wait is far shorter than a tick, so contention is counted instead of timed
+   if(xSemaphoreTake(entry->mutex, 0) != pdTRUE)
    {
-       return OTAPP_BUF_OK;
+       contended = 1;
+       if(xSemaphoreTake(entry->mutex, portMAX_DELAY) != pdTRUE) return OTAPP_BUF_ERROR;
    }
-   return OTAPP_BUF_ERROR;
+
+   // lock telemetry, updated under the lock
+   entry->stats.acquire_cnt++;
+   entry->stats.contended_cnt += contended;
+   return OTAPP_BUF_OK;
 }
 
-static void otapp_buf_mutex_unlock(void)
+static void otapp_buf_mutex_unlock(indexEntry_t *entry)
 {
-    xSemaphoreGive(otapp_buf_mutex);
+    xSemaphoreGive(entry->mutex);
 }
 
-static indexEntry_t* otapp_buf_find_entry(uint16_t key)
+/* LOCK ORDER RULE: 
+ * An operation that needs more than one slot MUST take the slot locks in ascending order 
+ * of their position in buf.index[] (the order of otapp_buf_init_config[]) and release them in reverse order. 
+ * Never take a second slot lock by calling a public API function while a slot lock is held.
+ */
+static int8_t otapp_buf_mutex_lockPair(indexEntry_t *a, indexEntry_t *b)
 {
-    if(key == 0)
+    indexEntry_t *first  = (a < b) ? a : b;
+    indexEntry_t *second = (a < b) ? b : a;
+
+    if(otapp_buf_mutex_lock(first) != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
+    if(otapp_buf_mutex_lock(second) != OTAPP_BUF_OK)
+    {
+        otapp_buf_mutex_unlock(first);
+        return OTAPP_BUF_ERROR;
+    }
+    return OTAPP_BUF_OK;
+}
+
+static void otapp_buf_mutex_unlockPair(indexEntry_t *a, indexEntry_t *b)
+{
+    indexEntry_t *first  = (a < b) ? a : b;
+    indexEntry_t *second = (a < b) ? b : a;
+
+    otapp_buf_mutex_unlock(second);
+    otapp_buf_mutex_unlock(first);
+}
+
+static indexEntry_t* otapp_buf_slot_entry(otapp_buf_slot_t slot)
+{
+    if(slot >= OTAPP_BUF_KEYS_QTY)
     {
         return NULL;
     }
-    
-    for (uint8_t i = 0; i < OTAPP_BUF_KEYS_QTY; i++)
+    return &buf.index[slot];
+}
+
+static indexEntry_t* otapp_buf_find_entry(uint16_t key)
+{
+    // O(1): the key is mapped by a switch generated from OTAPP_BUF_SLOT_TABLE
+    return otapp_buf_slot_entry(otapp_buf_keyToSlot(key));
+}
+
+static uint8_t otapp_buf_isRing(const indexEntry_t *entry)
+{
+    return (entry->mode == OTAPP_BUF_MODE_SPSC_RING);
+}
+
+// counts a rejected request (slot full / slot busy) and passes the error code through
+static int8_t otapp_buf_reject(indexEntry_t *entry, int8_t code)
+{
+    if(code == OTAPP_BUF_ERROR_OVERFLOW)
+    {
+        atomic_fetch_add_explicit(&entry->stats.overflow_cnt, 1, memory_order_relaxed);
+    }else if(code == OTAPP_BUF_ERROR_WRITE_LOCK)
+    {
+        atomic_fetch_add_explicit(&entry->stats.busy_reject_cnt, 1, memory_order_relaxed);
+    }
+    return code;
+}
+
+// high-water mark, call under the slot lock (ring: from the producer)
+static void otapp_buf_statsLen(indexEntry_t *entry, uint16_t len)
+{
+    if(len > entry->stats.peak_len) entry->stats.peak_len = len;
+}
+
+// prepares freshly acquired bytes: zero them, or leave them (poison in debug) for OTAPP_BUF_ACQ_NO_CLEAR
+static void otapp_buf_fillAcquired(uint8_t *dst, uint16_t len, uint8_t flags)
+{
+    if((flags & OTAPP_BUF_ACQ_NO_CLEAR) == 0)
+    {
+        memset(dst, 0, len);
+        return;
+    }
+#ifdef OTAPP_BUF_POISON
+    memset(dst, OTAPP_BUF_POISON_BYTE, len);
+#endif
+}
+
+/* Wait queue of blocked tasks (slot writers, slab callers), protected by the owner's mutex.
+ * A waiter sleeps on its task notification, the side that frees the resource notifies only waiter[0], 
+ * so the hand-off order is FIFO and the wake-up does not depend on any poll period.
+ */
+static void otapp_buf_waitQueueWakeHead(TaskHandle_t *queue, uint8_t qty)
+{
+    if(qty > 0) xTaskNotifyGive(queue[0]);
+}
+
+// returns 1 if the task was the head of the queue
+static uint8_t otapp_buf_waitQueueRemove(TaskHandle_t *queue, uint8_t *qty, TaskHandle_t task)
+{
+    for(uint8_t i = 0; i < *qty; i++)
     {
-        if(buf.index[i].key == key)
+        if(queue[i] == task)
         {
-            return &buf.index[i];
+            for(uint8_t j = i; j + 1 < *qty; j++)
+            {
+                queue[j] = queue[j + 1];
+            }
+            (*qty)--;
+            return (i == 0);
         }
     }
-    
-    return NULL;
+    return 0;
 }
 
-static int8_t otapp_buf_writeLock(uint16_t key)
+// sleeps until the waker's notification or the rest of the timeout, the caller re-checks its condition either way
+static void otapp_buf_waitQueueSleep(uint32_t timeoutTicks, uint32_t waited)
 {
-    if(key == 0) return OTAPP_BUF_ERROR;
+    ulTaskNotifyTake(pdTRUE, (timeoutTicks == OTAPP_BUF_WAIT_FOREVER) ? portMAX_DELAY : (TickType_t)(timeoutTicks - waited));
+}
 
-    indexEntry_t* entry = otapp_buf_find_entry(key);     
-    if(entry == NULL) return OTAPP_BUF_ERROR_KEY_NOT_FOUND;
+/* Bounded-wait write acquire with FIFO hand-off.
+ * A busy slot queues the caller (up to OTAPP_BUF_WAITERS_MAX), the slot is given only to the oldest waiter, 
+ * so a new caller cannot overtake the queue. Waiters block on their task notification, 
+ * otapp_buf_writeRelease() wakes the head of the queue.
+ * On OTAPP_BUF_OK the slot is write-locked and entry->mutex is STILL HELD, the caller finishes the setup and unlocks.
+ */
+static int8_t otapp_buf_writeAcquire(indexEntry_t *entry, uint32_t timeoutTicks)
+{
+    TickType_t   start  = xTaskGetTickCount();
+    TaskHandle_t self   = NULL;
+    uint8_t      queued = 0;
+
+    if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
+
+    while(1)
+    {
+        uint8_t  slotFree = (entry->write_lock == 0 && entry->readers == 0);
+        uint8_t  myTurn   = queued ? (entry->waiter[0] == self) : (entry->wait.waiters == 0);
+        uint32_t waited   = (uint32_t)(xTaskGetTickCount() - start);
+
+        if(slotFree && myTurn)
+        {
+            if(queued)
+            {
+                otapp_buf_waitQueueRemove(entry->waiter, &entry->wait.waiters, self);
+                if(waited > entry->wait.wait_max_ticks) entry->wait.wait_max_ticks = waited;
+            }
+            entry->write_lock = 1;
+            return OTAPP_BUF_OK; // mutex held
+        }
+
+        if(!queued)
+        {
+            entry->wait.contention_cnt++;
+            if(timeoutTicks == 0)
+            {
+                otapp_buf_mutex_unlock(entry);
+                return otapp_buf_reject(entry, OTAPP_BUF_ERROR_WRITE_LOCK);
+            }
+            if(entry->wait.waiters >= OTAPP_BUF_WAITERS_MAX)
+            {
+                entry->wait.queue_full_cnt++;
+                otapp_buf_mutex_unlock(entry);
+                return otapp_buf_reject(entry, OTAPP_BUF_ERROR_WRITE_LOCK);
+            }
+
+            self = xTaskGetCurrentTaskHandle();
+            entry->waiter[entry->wait.waiters++] = self;
+            if(entry->wait.waiters > entry->wait.waiters_peak) entry->wait.waiters_peak = entry->wait.waiters;
+            queued = 1;
+        }
+
+        if(timeoutTicks != OTAPP_BUF_WAIT_FOREVER && waited >= timeoutTicks)
+        {
+            // the slot may already be free for the next one in the queue
+            if(otapp_buf_waitQueueRemove(entry->waiter, &entry->wait.waiters, self) && slotFree)
+            {
+                otapp_buf_waitQueueWakeHead(entry->waiter, entry->wait.waiters);
+            }
+            entry->wait.timeout_cnt++;
+            otapp_buf_mutex_unlock(entry);
+            return OTAPP_BUF_ERROR_TIMEOUT;
+        }
+
+        otapp_buf_mutex_unlock(entry);
+        otapp_buf_waitQueueSleep(timeoutTicks, waited);
+        // portMAX_DELAY take, it does not fail on a created mutex, so the waiter cannot be left in the queue
+        if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
+    }
+}
+
+// call under the slot lock when write_lock or readers drop, hands the slot to the oldest queued writer
+static void otapp_buf_writeRelease(indexEntry_t *entry)
+{
+    if(entry->write_lock == 0 && entry->readers == 0)
+    {
+        otapp_buf_waitQueueWakeHead(entry->waiter, entry->wait.waiters);
+    }
+}
+
+
+static uint16_t otapp_buf_ring_len(indexEntry_t *entry)
+{
+    uint32_t head = atomic_load_explicit(&entry->head, memory_order_acquire);
+    uint32_t tail = atomic_load_explicit(&entry->tail, memory_order_acquire);
+
+    return (uint16_t)(head - tail);
+}
+
+// producer side - only one task may call it for the given key
+static int8_t otapp_buf_ring_appendv(indexEntry_t *entry, const otapp_buf_iov_t *iov, uint8_t iovCnt, uint16_t total)
+{
+    uint32_t head = atomic_load_explicit(&entry->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&entry->tail, memory_order_acquire);
+    uint16_t mask = entry->max_size - 1;
+
+    if((uint32_t)total > (uint32_t)entry->max_size - (head - tail))
+    {
+        return otapp_buf_reject(entry, OTAPP_BUF_ERROR_OVERFLOW);
+    }
+
+    uint32_t wr = head;
+    for(uint8_t i = 0; i < iovCnt; i++)
+    {
+        uint16_t len   = iov[i].len;
+        uint16_t pos   = (uint16_t)(wr & mask);
+        uint16_t first = entry->max_size - pos; // bytes until the end of the slot
+        if(first > len) first = len;
+
+        memcpy(&buf.data[entry->offset + pos], iov[i].base, first);
+        memcpy(&buf.data[entry->offset], iov[i].base + first, len - first);
+        wr += len;
+    }
 
-    entry->write_lock = 1;
+    // publish all fragments to the consumer at once
+    atomic_store_explicit(&entry->head, wr, memory_order_release);
+    otapp_buf_statsLen(entry, (uint16_t)(wr - tail));
 
     return OTAPP_BUF_OK;
 }
 
-int8_t otapp_buf_writeUnlock(uint16_t key)
+static int8_t otapp_buf_ring_append(indexEntry_t *entry, const uint8_t* new_data, uint16_t len)
 {
-    if(key == 0) return OTAPP_BUF_ERROR;
+    const otapp_buf_iov_t iov = { .base = new_data, .len = len };
+    return otapp_buf_ring_appendv(entry, &iov, 1, len);
+}
+
+// consumer side - only one task may call it for the given key
+static int8_t otapp_buf_ring_getDatav(indexEntry_t *entry, const otapp_buf_iovOut_t *iov, uint8_t iovCnt, uint16_t *lenBufOut)
+{
+    uint32_t tail = atomic_load_explicit(&entry->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&entry->head, memory_order_acquire);
+    uint16_t mask = entry->max_size - 1;
+    uint16_t left = (uint16_t)(head - tail);
+
+    if(left == 0) return OTAPP_BUF_ERROR;
+
+    uint32_t rd = tail;
+    for(uint8_t i = 0; i < iovCnt && left > 0; i++)
+    {
+        uint16_t len   = (iov[i].len < left) ? iov[i].len : left;
+        uint16_t pos   = (uint16_t)(rd & mask);
+        uint16_t first = entry->max_size - pos;
+        if(first > len) first = len;
+
+        memcpy(iov[i].base, &buf.data[entry->offset + pos], first);
+        memcpy(iov[i].base + first, &buf.data[entry->offset], len - first);
+        rd   += len;
+        left -= len;
+    }
+
+    // release the space to the producer
+    atomic_store_explicit(&entry->tail, rd, memory_order_release);
+
+    *lenBufOut = (uint16_t)(rd - tail);
+    return OTAPP_BUF_OK;
+}
+
+static int8_t otapp_buf_ring_getData(indexEntry_t *entry, uint8_t* bufOut, uint16_t bufSize, uint16_t *lenBufOut)
+{
+    const otapp_buf_iovOut_t iov = { .base = bufOut, .len = bufSize };
+    return otapp_buf_ring_getDatav(entry, &iov, 1, lenBufOut);
+}
+
+// sums the fragment lengths, 0 = invalid vector (NULL fragment, empty or longer than UINT16_MAX)
+static uint16_t otapp_buf_iovTotal(const otapp_buf_iov_t *iov, uint8_t iovCnt)
+{
+    uint32_t total = 0;
+
+    if(iov == NULL) return 0;
+
+    for(uint8_t i = 0; i < iovCnt; i++)
+    {
+        if(iov[i].base == NULL) return 0;
+        total += iov[i].len;
+    }
+    return (total > UINT16_MAX) ? 0 : (uint16_t)total;
+}
 
-    indexEntry_t* entry = otapp_buf_find_entry(key);     
+// same check for the destination fragments of a gather read
+static uint16_t otapp_buf_iovOutTotal(const otapp_buf_iovOut_t *iov, uint8_t iovCnt)
+{
+    uint32_t total = 0;
+
+    if(iov == NULL) return 0;
+
+    for(uint8_t i = 0; i < iovCnt; i++)
+    {
+        if(iov[i].base == NULL) return 0;
+        total += iov[i].len;
+    }
+    return (total > UINT16_MAX) ? 0 : (uint16_t)total;
+}
+
+int8_t otapp_buf_slot_writeUnlock(otapp_buf_slot_t slot)
+{
+    indexEntry_t* entry = otapp_buf_slot_entry(slot);     
     if(entry == NULL) return OTAPP_BUF_ERROR_KEY_NOT_FOUND;
 
+    if(otapp_buf_isRing(entry)) return OTAPP_BUF_ERROR_MODE;
+
     // --- Critical section START ---
-    if(otapp_buf_mutex_lock() != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
+    if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
         entry->write_lock = 0;
         entry->current_len = 0;
-    otapp_buf_mutex_unlock();
+        otapp_buf_writeRelease(entry);
+    otapp_buf_mutex_unlock(entry);
     // --- Critical section STOP ---
     return OTAPP_BUF_OK;
 }
 
-int8_t otapp_buf_append(uint16_t key, const uint8_t* new_data, uint16_t len) 
+int8_t otapp_buf_writeUnlock(uint16_t key)
+{
+    if(key == 0) return OTAPP_BUF_ERROR;
+
+    return otapp_buf_slot_writeUnlock(otapp_buf_keyToSlot(key));
+}
+
+int8_t otapp_buf_slot_append(otapp_buf_slot_t slot, const uint8_t* new_data, uint16_t len) 
 {
-    if(new_data == NULL || len == 0 || key == 0) return OTAPP_BUF_ERROR;
+    if(new_data == NULL || len == 0) return OTAPP_BUF_ERROR;
 
-    // Find the entry in index[] (fast loops over a small array)
-    indexEntry_t* entry = otapp_buf_find_entry(key);     
+    indexEntry_t* entry = otapp_buf_slot_entry(slot);     
     if(entry == NULL) return OTAPP_BUF_ERROR_KEY_NOT_FOUND;
 
-    if(entry->write_lock) return OTAPP_BUF_ERROR_WRITE_LOCK;
+    if(otapp_buf_isRing(entry)) return otapp_buf_ring_append(entry, new_data, len);
+
+    if(entry->write_lock) return otapp_buf_reject(entry, OTAPP_BUF_ERROR_WRITE_LOCK);
 
     // --- Critical section START ---
-    if(otapp_buf_mutex_lock() != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
+    if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
         
     // Safety Check (Bounds Check)
         if(entry->current_len + len > entry->max_size) 
         {   
-            otapp_buf_mutex_unlock();
-            return OTAPP_BUF_ERROR_OVERFLOW; 
+            otapp_buf_mutex_unlock(entry);
+            return otapp_buf_reject(entry, OTAPP_BUF_ERROR_OVERFLOW); 
         }
 
         uint16_t write_pos = entry->offset + entry->current_len;   
@@ -173,30 +586,39 @@ int8_t otapp_buf_append(uint16_t key, const uint8_t* new_data, uint16_t len)
 
         // Update length
         entry->current_len += len;
+        otapp_buf_statsLen(entry, entry->current_len);
 
-    otapp_buf_mutex_unlock();
+    otapp_buf_mutex_unlock(entry);
     // --- Critical section STOP ---
 
     return OTAPP_BUF_OK;
 }
 
-int8_t otapp_buf_getData(uint16_t key, uint8_t* bufOut, uint16_t bufSize, uint16_t *lenBufOut) 
+int8_t otapp_buf_append(uint16_t key, const uint8_t* new_data, uint16_t len) 
+{
+    if(key == 0) return OTAPP_BUF_ERROR;
+
+    return otapp_buf_slot_append(otapp_buf_keyToSlot(key), new_data, len);
+}
+
+int8_t otapp_buf_slot_getData(otapp_buf_slot_t slot, uint8_t* bufOut, uint16_t bufSize, uint16_t *lenBufOut) 
 {
-    if(key == 0 || bufOut == NULL || lenBufOut == NULL || bufSize == 0) return OTAPP_BUF_ERROR;
+    if(bufOut == NULL || lenBufOut == NULL || bufSize == 0) return OTAPP_BUF_ERROR;
 
     *lenBufOut = 0;
 
-    // Find the entry in index[] (fast loops over a small array)
-    indexEntry_t* entry = otapp_buf_find_entry(key);     
+    indexEntry_t* entry = otapp_buf_slot_entry(slot);     
     if(entry == NULL) return OTAPP_BUF_ERROR_KEY_NOT_FOUND;
 
+    if(otapp_buf_isRing(entry)) return otapp_buf_ring_getData(entry, bufOut, bufSize, lenBufOut);
+
     // --- Critical section START ---
-    if(otapp_buf_mutex_lock() != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
+    if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
 
         uint16_t curLen = entry->current_len;
         if(curLen == 0 || curLen > bufSize)
         {            
-            otapp_buf_mutex_unlock();
+            otapp_buf_mutex_unlock(entry);
             return OTAPP_BUF_ERROR;
         }else
         {
@@ -207,144 +629,794 @@ int8_t otapp_buf_getData(uint16_t key, uint8_t* bufOut, uint16_t bufSize, uint16
             *lenBufOut = curLen;
         }
 
-    otapp_buf_mutex_unlock();
+    otapp_buf_mutex_unlock(entry);
     // --- Critical section STOP ---
 
     return OTAPP_BUF_OK;
 }
 
-const uint8_t *otapp_buf_getReadOnly_ptr(uint16_t key, uint16_t *bufSize_out)
+int8_t otapp_buf_getData(uint16_t key, uint8_t* bufOut, uint16_t bufSize, uint16_t *lenBufOut) 
 {
-    if(bufSize_out == NULL)
-    {        
-        return NULL;
-    }
-
-    // Domyślnie zerujemy, żeby użytkownik nie dostał śmieci w razie błędu
-    *bufSize_out = 0;
+    if(key == 0) return OTAPP_BUF_ERROR;
 
-    if(key == 0) return NULL;
+    return otapp_buf_slot_getData(otapp_buf_keyToSlot(key), bufOut, bufSize, lenBufOut);
+}
 
-    // Find the entry in index[] (fast loops over a small array)
-    indexEntry_t* entry = otapp_buf_find_entry(key); 
-    if(entry == NULL) return NULL;
-    
-    // --- Critical section START ---
-    if(otapp_buf_mutex_lock() != OTAPP_BUF_OK) return NULL;
+int8_t otapp_buf_slot_appendv(otapp_buf_slot_t slot, const otapp_buf_iov_t *iov, uint8_t iovCnt) 
+{
+    uint16_t total = otapp_buf_iovTotal(iov, iovCnt);
+    if(total == 0) return OTAPP_BUF_ERROR;
 
-        // getting current length
-        *bufSize_out = entry->current_len;
-    otapp_buf_mutex_unlock();
-    // --- Critical section STOP ---
+    indexEntry_t* entry = otapp_buf_slot_entry(slot);     
+    if(entry == NULL) return OTAPP_BUF_ERROR_KEY_NOT_FOUND;
 
-    const uint8_t *buffer = &buf.data[entry->offset];
+    if(otapp_buf_isRing(entry)) return otapp_buf_ring_appendv(entry, iov, iovCnt, total);
 
-    return buffer;    
-}
- 
-uint8_t* otapp_buf_getWriteOnly_ptr(uint16_t key, uint16_t required_size) 
-{
-    if(key == 0 || required_size == 0) return NULL;
+    if(entry->write_lock) return otapp_buf_reject(entry, OTAPP_BUF_ERROR_WRITE_LOCK);
 
-    indexEntry_t* entry = otapp_buf_find_entry(key);
-    if(entry == NULL) return NULL;
-    
     // --- Critical section START ---
-    if (otapp_buf_mutex_lock() != OTAPP_BUF_OK) return NULL;
+    if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
 
-        // check write_lock
-        if(entry->write_lock)
-        {
-            otapp_buf_mutex_unlock();
-            return NULL; 
+        // one bounds check for all fragments, nothing is copied if the whole vector does not fit
+        if(entry->current_len + total > entry->max_size) 
+        {   
+            otapp_buf_mutex_unlock(entry);
+            return otapp_buf_reject(entry, OTAPP_BUF_ERROR_OVERFLOW); 
         }
 
-        // Validation: Can we fit this data in the slot? 
-        if(required_size > (entry->max_size)) 
+        uint16_t write_pos = entry->offset + entry->current_len;   
+
+        for(uint8_t i = 0; i < iovCnt; i++)
         {
-            otapp_buf_mutex_unlock();
-            return NULL; 
+            memcpy(&buf.data[write_pos], iov[i].base, iov[i].len);
+            write_pos += iov[i].len;
         }
-        
-        // write will be locked for next call until call writeUnlock()
-        otapp_buf_writeLock(key);
 
-        // clear buffer         
-        memset(&buf.data[entry->offset], 0, required_size);
+        entry->current_len += total;
+        otapp_buf_statsLen(entry, entry->current_len);
 
-        // update length (reservation)
-        entry->current_len = required_size; 
-    otapp_buf_mutex_unlock();
+    otapp_buf_mutex_unlock(entry);
     // --- Critical section STOP ---
 
-    uint8_t *buffer = &buf.data[entry->offset];
-    // return a pointer to the beginning of this key's data
-    return buffer;
+    return OTAPP_BUF_OK;
 }
 
-uint16_t otapp_buf_getMaxSize(uint16_t key)
+int8_t otapp_buf_appendv(uint16_t key, const otapp_buf_iov_t *iov, uint8_t iovCnt) 
 {
-    if(key == 0) return 0;
-
-    indexEntry_t* entry = otapp_buf_find_entry(key);
-    if(entry == NULL) return 0;
+    if(key == 0) return OTAPP_BUF_ERROR;
 
-    return entry->max_size;
+    return otapp_buf_slot_appendv(otapp_buf_keyToSlot(key), iov, iovCnt);
 }
 
-uint16_t otapp_buf_getCurrentLenSize(uint16_t key)
+int8_t otapp_buf_slot_getDatav(otapp_buf_slot_t slot, const otapp_buf_iovOut_t *iov, uint8_t iovCnt, uint16_t *lenBufOut) 
 {
-    if(key == 0) return 0;
+    if(lenBufOut == NULL) return OTAPP_BUF_ERROR;
+    *lenBufOut = 0;
 
-    indexEntry_t* entry = otapp_buf_find_entry(key);
-    if(entry == NULL) return 0;
+    uint16_t total = otapp_buf_iovOutTotal(iov, iovCnt);
+    if(total == 0) return OTAPP_BUF_ERROR;
 
-    // --- Critical section START ---
-    if(otapp_buf_mutex_lock() != OTAPP_BUF_OK) return 0;
-        uint16_t curLen = entry->current_len;
-    otapp_buf_mutex_unlock();
-    // --- Critical section STOP ---
+    indexEntry_t* entry = otapp_buf_slot_entry(slot);     
+    if(entry == NULL) return OTAPP_BUF_ERROR_KEY_NOT_FOUND;
 
-    return curLen;
-}
+    if(otapp_buf_isRing(entry)) return otapp_buf_ring_getDatav(entry, iov, iovCnt, lenBufOut);
 
-int8_t otapp_buff_clear(uint16_t key)
-{
-    if(key == 0) return OTAPP_BUF_ERROR;
+    // --- Critical section START ---
+    if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
 
-    // Find the entry in index[] (fast loops over a small array)
-    indexEntry_t* entry = otapp_buf_find_entry(key);
-    if(entry == NULL) return OTAPP_BUF_ERROR;
+        uint16_t curLen = entry->current_len;
+        if(curLen == 0 || curLen > total)
+        {            
+            otapp_buf_mutex_unlock(entry);
+            return OTAPP_BUF_ERROR;
+        }
 
-    // --- Critical section START ---
-    if(otapp_buf_mutex_lock() != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
+        // scatter the slot content over the fragments in order, the last one may be filled partially
+        uint16_t read_pos = entry->offset;
+        uint16_t left     = curLen;
+        for(uint8_t i = 0; i < iovCnt && left > 0; i++)
+        {
+            uint16_t len = (iov[i].len < left) ? iov[i].len : left;
 
-        // clear key data
-        memset(&buf.data[entry->offset], 0, entry->max_size); 
+            memcpy(iov[i].base, &buf.data[read_pos], len);
+            read_pos += len;
+            left     -= len;
+        }
+        *lenBufOut = curLen;
 
-        // update length
-        entry->current_len = 0;
-    otapp_buf_mutex_unlock();
+    otapp_buf_mutex_unlock(entry);
     // --- Critical section STOP ---
 
     return OTAPP_BUF_OK;
 }
 
-void otapp_buffer_init(void)
+int8_t otapp_buf_getDatav(uint16_t key, const otapp_buf_iovOut_t *iov, uint8_t iovCnt, uint16_t *lenBufOut) 
 {
-    int8_t result;
+    if(key == 0) return OTAPP_BUF_ERROR;
 
-    if(otapp_buf_mutex == NULL) 
-    {
-        otapp_buf_mutex = xSemaphoreCreateMutex();
+    return otapp_buf_slot_getDatav(otapp_buf_keyToSlot(key), iov, iovCnt, lenBufOut);
+}
 
-        result = otapp_buf_initKeysIndex();
-    
-        if(otapp_buf_mutex == NULL || result == OTAPP_BUF_ERROR) 
-        {       
-            while(1);  // error
+const uint8_t *otapp_buf_slot_getReadOnly_ptr(otapp_buf_slot_t slot, uint16_t *bufSize_out)
+{
+    if(bufSize_out == NULL)
+    {        
+        return NULL;
+    }
+
+    // Domyślnie zerujemy, żeby użytkownik nie dostał śmieci w razie błędu
+    *bufSize_out = 0;
+
+    indexEntry_t* entry = otapp_buf_slot_entry(slot); 
+    if(entry == NULL || otapp_buf_isRing(entry)) return NULL;
+    
+    // --- Critical section START ---
+    if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) return NULL;
+
+        // getting current length
+        *bufSize_out = entry->current_len;
+    otapp_buf_mutex_unlock(entry);
+    // --- Critical section STOP ---
+
+    const uint8_t *buffer = &buf.data[entry->offset];
+
+    return buffer;    
+}
+
+const uint8_t *otapp_buf_getReadOnly_ptr(uint16_t key, uint16_t *bufSize_out)
+{
+    return otapp_buf_slot_getReadOnly_ptr(otapp_buf_keyToSlot(key), bufSize_out);
+}
+ 
+uint8_t* otapp_buf_slot_getWriteOnly_ptrEx(otapp_buf_slot_t slot, uint16_t required_size, uint32_t timeoutTicks, uint8_t flags) 
+{
+    if(required_size == 0) return NULL;
+
+    indexEntry_t* entry = otapp_buf_slot_entry(slot);
+    if(entry == NULL || otapp_buf_isRing(entry)) return NULL;
+
+    // Validation: Can we fit this data in the slot? 
+    if(required_size > (entry->max_size)) 
+    {
+        otapp_buf_reject(entry, OTAPP_BUF_ERROR_OVERFLOW);
+        return NULL; 
+    }
+    
+    // --- Critical section START ---
+    // write will be locked for next call until call writeUnlock()
+    if(otapp_buf_writeAcquire(entry, timeoutTicks) != OTAPP_BUF_OK) return NULL;
+
+        // update length (reservation)
+        entry->current_len = required_size; 
+        otapp_buf_statsLen(entry, required_size);
+    otapp_buf_mutex_unlock(entry);
+    // --- Critical section STOP ---
+
+    uint8_t *buffer = &buf.data[entry->offset];
+
+    // the slot is write-locked, so the bytes are prepared outside of the critical section
+    otapp_buf_fillAcquired(buffer, required_size, flags);
+
+    // return a pointer to the beginning of this key's data
+    return buffer;
+}
+
+uint8_t* otapp_buf_slot_getWriteOnly_ptrTimed(otapp_buf_slot_t slot, uint16_t required_size, uint32_t timeoutTicks) 
+{
+    return otapp_buf_slot_getWriteOnly_ptrEx(slot, required_size, timeoutTicks, OTAPP_BUF_ACQ_ZERO);
+}
+
+uint8_t* otapp_buf_slot_getWriteOnly_ptr(otapp_buf_slot_t slot, uint16_t required_size) 
+{
+    return otapp_buf_slot_getWriteOnly_ptrTimed(slot, required_size, 0);
+}
+
+uint8_t* otapp_buf_getWriteOnly_ptr(uint16_t key, uint16_t required_size) 
+{
+    return otapp_buf_slot_getWriteOnly_ptrTimed(otapp_buf_keyToSlot(key), required_size, 0);
+}
+
+uint8_t* otapp_buf_getWriteOnly_ptrTimed(uint16_t key, uint16_t required_size, uint32_t timeoutTicks) 
+{
+    return otapp_buf_slot_getWriteOnly_ptrTimed(otapp_buf_keyToSlot(key), required_size, timeoutTicks);
+}
+
+uint8_t* otapp_buf_getWriteOnly_ptrNoClear(uint16_t key, uint16_t required_size) 
+{
+    return otapp_buf_slot_getWriteOnly_ptrEx(otapp_buf_keyToSlot(key), required_size, 0, OTAPP_BUF_ACQ_NO_CLEAR);
+}
+
+int8_t otapp_buf_slot_getWaitStats(otapp_buf_slot_t slot, otapp_buf_waitStats_t *statsOut)
+{
+    if(statsOut == NULL) return OTAPP_BUF_ERROR;
+
+    indexEntry_t* entry = otapp_buf_slot_entry(slot);
+    if(entry == NULL) return OTAPP_BUF_ERROR_KEY_NOT_FOUND;
+
+    // --- Critical section START ---
+    if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
+        *statsOut = entry->wait;
+    otapp_buf_mutex_unlock(entry);
+    // --- Critical section STOP ---
+
+    return OTAPP_BUF_OK;
+}
+
+uint16_t otapp_buf_getMaxSize(uint16_t key)
+{
+    indexEntry_t* entry = otapp_buf_find_entry(key);
+    if(entry == NULL) return 0;
+
+    return entry->max_size;
+}
+
+uint16_t otapp_buf_slot_getCurrentLenSize(otapp_buf_slot_t slot)
+{
+    indexEntry_t* entry = otapp_buf_slot_entry(slot);
+    if(entry == NULL) return 0;
+
+    if(otapp_buf_isRing(entry)) return otapp_buf_ring_len(entry);
+
+    // --- Critical section START ---
+    if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) return 0;
+        uint16_t curLen = entry->current_len;
+    otapp_buf_mutex_unlock(entry);
+    // --- Critical section STOP ---
+
+    return curLen;
+}
+
+uint16_t otapp_buf_getCurrentLenSize(uint16_t key)
+{
+    return otapp_buf_slot_getCurrentLenSize(otapp_buf_keyToSlot(key));
+}
+
+int8_t otapp_buf_slot_clear(otapp_buf_slot_t slot)
+{
+    indexEntry_t* entry = otapp_buf_slot_entry(slot);
+    if(entry == NULL) return OTAPP_BUF_ERROR;
+
+    if(otapp_buf_isRing(entry))
+    {
+        // consumer side: drop everything that was published so far
+        atomic_store_explicit(&entry->tail, atomic_load_explicit(&entry->head, memory_order_acquire), memory_order_release);
+        return OTAPP_BUF_OK;
+    }
+
+    // --- Critical section START ---
+    if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
+
+        // readers share these bytes
+        if(entry->readers)
+        {
+            otapp_buf_mutex_unlock(entry);
+            return otapp_buf_reject(entry, OTAPP_BUF_ERROR_WRITE_LOCK); 
+        }
+
+#ifdef OTAPP_BUF_POISON
+        // stale data must not look valid to a reader that ignores current_len
+        memset(&buf.data[entry->offset], OTAPP_BUF_POISON_BYTE, entry->max_size); 
+#else
+        // clear key data
+        memset(&buf.data[entry->offset], 0, entry->max_size); 
+#endif
+        // update length
+        entry->current_len = 0;
+    otapp_buf_mutex_unlock(entry);
+    // --- Critical section STOP ---
+
+    return OTAPP_BUF_OK;
+}
+
+int8_t otapp_buff_clear(uint16_t key)
+{
+    return otapp_buf_slot_clear(otapp_buf_keyToSlot(key));
+}
+
+static int8_t otapp_buf_leaseOwnerAdd(indexEntry_t *entry, uint8_t type, const char *file, uint16_t line)
+{
+#ifdef OTAPP_BUF_LEASE_DEBUG
+    if(file == NULL) return -1;
+
+    for(uint8_t i = 0; i < OTAPP_BUF_LEASE_DEBUG_OWNERS_MAX; i++) 
+    {
+        if(entry->owner[i].file == NULL)
+        {
+            entry->owner[i].file = file;
+            entry->owner[i].line = line;
+            entry->owner[i].type = type;
+            return (int8_t)i;
         }
     }
-       
+#else
+    UNUSED(entry); UNUSED(type); UNUSED(file); UNUSED(line);
+#endif
+    return -1; // not tracked
+}
+
+static void otapp_buf_leaseOwnerRemove(indexEntry_t *entry, int8_t owner)
+{
+#ifdef OTAPP_BUF_LEASE_DEBUG
+    if(owner >= 0 && owner < OTAPP_BUF_LEASE_DEBUG_OWNERS_MAX)
+    {
+        entry->owner[owner].file = NULL;
+    }
+#else
+    UNUSED(entry); UNUSED(owner);
+#endif
+}
+
+int8_t otapp_buf_leaseReadAt(otapp_buf_slot_t slot, otapp_buf_lease_t *lease, const char *file, uint16_t line)
+{
+    if(lease == NULL || lease->type != OTAPP_BUF_LEASE_NONE) return OTAPP_BUF_ERROR;
+
+    indexEntry_t* entry = otapp_buf_slot_entry(slot);
+    if(entry == NULL) return OTAPP_BUF_ERROR_KEY_NOT_FOUND;
+
+    if(otapp_buf_isRing(entry)) return OTAPP_BUF_ERROR_MODE;
+
+    // --- Critical section START ---
+    if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
+
+        if(entry->write_lock)
+        {
+            otapp_buf_mutex_unlock(entry);
+            return otapp_buf_reject(entry, OTAPP_BUF_ERROR_WRITE_LOCK); 
+        }
+
+        if(entry->readers == UINT8_MAX)
+        {
+            otapp_buf_mutex_unlock(entry);
+            return OTAPP_BUF_ERROR; 
+        }
+
+        entry->readers++;
+        lease->owner = otapp_buf_leaseOwnerAdd(entry, OTAPP_BUF_LEASE_READ, file, line);
+        lease->len   = entry->current_len;
+    otapp_buf_mutex_unlock(entry);
+    // --- Critical section STOP ---
+
+    lease->data = &buf.data[entry->offset];
+    lease->slot = slot;
+    lease->type = OTAPP_BUF_LEASE_READ;
+
+    return OTAPP_BUF_OK;
+}
+
+int8_t otapp_buf_leaseWriteExAt(otapp_buf_slot_t slot, uint16_t size, uint32_t timeoutTicks, uint8_t flags, 
+                                otapp_buf_lease_t *lease, const char *file, uint16_t line)
+{
+    if(lease == NULL || lease->type != OTAPP_BUF_LEASE_NONE || size == 0) return OTAPP_BUF_ERROR;
+
+    indexEntry_t* entry = otapp_buf_slot_entry(slot);
+    if(entry == NULL) return OTAPP_BUF_ERROR_KEY_NOT_FOUND;
+
+    if(otapp_buf_isRing(entry)) return OTAPP_BUF_ERROR_MODE;
+
+    if(size > entry->max_size) return otapp_buf_reject(entry, OTAPP_BUF_ERROR_OVERFLOW);
+
+    // --- Critical section START ---
+    int8_t result = otapp_buf_writeAcquire(entry, timeoutTicks);
+    if(result != OTAPP_BUF_OK) return result;
+
+        entry->current_len = size; // reservation
+        otapp_buf_statsLen(entry, size);
+        lease->owner = otapp_buf_leaseOwnerAdd(entry, OTAPP_BUF_LEASE_WRITE, file, line);
+    otapp_buf_mutex_unlock(entry);
+    // --- Critical section STOP ---
+
+    // the slot is write-locked, so the bytes are prepared outside of the critical section
+    otapp_buf_fillAcquired(&buf.data[entry->offset], size, flags);
+
+    lease->data = &buf.data[entry->offset];
+    lease->len  = size;
+    lease->slot = slot;
+    lease->type = OTAPP_BUF_LEASE_WRITE;
+
+    return OTAPP_BUF_OK;
+}
+
+int8_t otapp_buf_leaseRelease(otapp_buf_lease_t *lease)
+{
+    if(lease == NULL) return OTAPP_BUF_ERROR;
+    if(lease->type == OTAPP_BUF_LEASE_NONE) return OTAPP_BUF_OK;
+
+    indexEntry_t* entry = otapp_buf_slot_entry(lease->slot);
+    if(entry == NULL) return OTAPP_BUF_ERROR_KEY_NOT_FOUND;
+
+    // --- Critical section START ---
+    if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
+
+        if(lease->type == OTAPP_BUF_LEASE_READ)
+        {
+            if(entry->readers) entry->readers--;
+        }else
+        {
+            // commit: written data stays in the slot for readers
+            entry->current_len = (lease->len < entry->max_size) ? lease->len : entry->max_size;
+            entry->write_lock  = 0;
+        }
+        otapp_buf_writeRelease(entry);
+        otapp_buf_leaseOwnerRemove(entry, lease->owner);
+    otapp_buf_mutex_unlock(entry);
+    // --- Critical section STOP ---
+
+    lease->data  = NULL;
+    lease->len   = 0;
+    lease->slot  = OTAPP_BUF_SLOT_INVALID;
+    lease->type  = OTAPP_BUF_LEASE_NONE;
+    lease->owner = -1;
+
+    return OTAPP_BUF_OK;
+}
+
+uint16_t otapp_buf_leaseReportLeaks(void)
+{
+    uint16_t held = 0;
+
+    for(uint8_t i = 0; i < OTAPP_BUF_KEYS_QTY; i++) 
+    {
+        indexEntry_t *entry = &buf.index[i];
+        if(otapp_buf_isRing(entry)) continue;
+
+        // --- Critical section START ---
+        if(otapp_buf_mutex_lock(entry) != OTAPP_BUF_OK) continue;
+
+            held += entry->readers + (entry->write_lock ? 1 : 0);
+
+#ifdef OTAPP_BUF_LEASE_DEBUG
+            for(uint8_t j = 0; j < OTAPP_BUF_LEASE_DEBUG_OWNERS_MAX; j++) 
+            {
+                if(entry->owner[j].file != NULL)
+                {
+                    HRO_PRINTF("otapp_buf", "lease leak: key 0x%04x %s held by %s:%u\n", 
+                               (unsigned)entry->key, 
+                               (entry->owner[j].type == OTAPP_BUF_LEASE_WRITE) ? "WRITE" : "READ", 
+                               entry->owner[j].file, 
+                               (unsigned)entry->owner[j].line);
+                }
+            }
+#endif
+        otapp_buf_mutex_unlock(entry);
+        // --- Critical section STOP ---
+    }
+
+    return held;
+}
+
+static uint8_t *otapp_buf_slabPop(slabClass_t *cls)
+{
+    slabBlock_t *block = NULL;
+
+    // --- Critical section START ---
+    if(xSemaphoreTake(cls->mutex, portMAX_DELAY) != pdTRUE) return NULL;
+
+        block = cls->free_list;
+        if(block != NULL)
+        {
+            cls->free_list = block->next;
+            cls->used |= (1UL << (((uint8_t*)block - cls->base) / cls->stats.block_size));
+
+            cls->stats.blocks_used++;
+            cls->stats.alloc_cnt++;
+            if(cls->stats.blocks_used > cls->stats.blocks_peak) cls->stats.blocks_peak = cls->stats.blocks_used;
+        }
+    xSemaphoreGive(cls->mutex);
+    // --- Critical section STOP ---
+
+    return (uint8_t*)block;
+}
+
+// smallest class that fits size, -1 if the size is larger than every class
+static int8_t otapp_buf_slabFirstFit(uint16_t size)
+{
+    for(uint8_t c = 0; c < OTAPP_BUF_SLAB_CLASSES_QTY; c++) 
+    {
+        if(buf.slab[c].stats.block_size >= size) return (int8_t)c;
+    }
+    return -1;
+}
+
+// one pass over the fitting classes, smallest first
+static uint8_t *otapp_buf_slabTryAlloc(int8_t firstFit, uint16_t size, uint8_t flags, uint16_t *blockSizeOut)
+{
+    for(uint8_t c = (uint8_t)firstFit; c < OTAPP_BUF_SLAB_CLASSES_QTY; c++) 
+    {
+        slabClass_t *cls = &buf.slab[c];
+        uint8_t *block = otapp_buf_slabPop(cls);
+        if(block != NULL)
+        {
+            otapp_buf_fillAcquired(block, size, flags);
+            if(blockSizeOut != NULL) *blockSizeOut = cls->stats.block_size;
+            return block;
+        }
+    }
+    return NULL;
+}
+
+/* Bounded-wait allocation with FIFO hand-off, per class of the best fit.
+ * While callers are queued in the class a new caller queues too, only waiter[0] takes a block. 
+ * Waiters block on their task notification, otapp_buf_slabFree() wakes the head of the queue.
+ */
+uint8_t *otapp_buf_slabAllocTimed(uint16_t size, uint8_t flags, uint32_t timeoutTicks, uint16_t *blockSizeOut)
+{
+    TickType_t   start  = xTaskGetTickCount();
+    TaskHandle_t self   = NULL;
+    uint8_t      queued = 0;
+    uint8_t     *block  = NULL;
+
+    if(size == 0) return NULL;
+
+    int8_t firstFit = otapp_buf_slabFirstFit(size);
+    if(firstFit < 0) return NULL;
+
+    slabClass_t *cls = &buf.slab[firstFit];
+
+    while(1)
+    {
+        // --- Critical section START ---
+        if(xSemaphoreTake(cls->mutex, portMAX_DELAY) != pdTRUE) return NULL;
+            uint8_t myTurn = queued ? (cls->waiter[0] == self) : (cls->waiters == 0);
+        xSemaphoreGive(cls->mutex);
+        // --- Critical section STOP ---
+
+        if(myTurn)
+        {
+            block = otapp_buf_slabTryAlloc(firstFit, size, flags, blockSizeOut);
+        }
+
+        uint32_t waited = (uint32_t)(xTaskGetTickCount() - start);
+        uint8_t  giveUp = (block == NULL && (timeoutTicks == 0 || 
+                          (timeoutTicks != OTAPP_BUF_WAIT_FOREVER && waited >= timeoutTicks)));
+
+        // --- Critical section START ---
+        if(xSemaphoreTake(cls->mutex, portMAX_DELAY) != pdTRUE) return block;
+
+            if(block != NULL || giveUp)
+            {
+                if(queued)
+                {
+                    otapp_buf_waitQueueRemove(cls->waiter, &cls->waiters, self);
+                    // more blocks may be free (or were freed meanwhile), the next waiter re-checks
+                    otapp_buf_waitQueueWakeHead(cls->waiter, cls->waiters);
+                }
+                if(block == NULL)
+                {
+                    // nothing free - account the failure to the class that should have served it
+                    cls->stats.fail_cnt++;
+                    if(queued) cls->stats.timeout_cnt++;
+                }
+                xSemaphoreGive(cls->mutex);
+                return block;
+            }
+
+            if(!queued)
+            {
+                if(cls->waiters >= OTAPP_BUF_WAITERS_MAX)
+                {
+                    cls->stats.fail_cnt++;
+                    xSemaphoreGive(cls->mutex);
+                    return NULL;
+                }
+                self = xTaskGetCurrentTaskHandle();
+                cls->waiter[cls->waiters++] = self;
+                queued = 1;
+                xSemaphoreGive(cls->mutex);
+                continue; // a block freed before the enqueue is not signalled, check once more
+            }
+        xSemaphoreGive(cls->mutex);
+        // --- Critical section STOP ---
+
+        otapp_buf_waitQueueSleep(timeoutTicks, waited);
+    }
+}
+
+uint8_t *otapp_buf_slabAllocEx(uint16_t size, uint8_t flags, uint16_t *blockSizeOut)
+{
+    return otapp_buf_slabAllocTimed(size, flags, 0, blockSizeOut);
+}
+
+uint8_t *otapp_buf_slabAlloc(uint16_t size, uint16_t *blockSizeOut)
+{
+    return otapp_buf_slabAllocEx(size, OTAPP_BUF_ACQ_ZERO, blockSizeOut);
+}
+
+int8_t otapp_buf_slabFree(uint8_t *block)
+{
+    if(block == NULL) return OTAPP_BUF_ERROR;
+
+    for(uint8_t c = 0; c < OTAPP_BUF_SLAB_CLASSES_QTY; c++) 
+    {
+        slabClass_t *cls = &buf.slab[c];
+        uint32_t classBytes = (uint32_t)cls->stats.block_size * cls->stats.blocks_total;
+
+        if(block < cls->base || block >= cls->base + classBytes) continue;
+
+        uint32_t offset = (uint32_t)(block - cls->base);
+        if((offset % cls->stats.block_size) != 0) return OTAPP_BUF_ERROR; // not a block start
+
+        uint32_t bit = 1UL << (offset / cls->stats.block_size);
+
+        // --- Critical section START ---
+        if(xSemaphoreTake(cls->mutex, portMAX_DELAY) != pdTRUE) return OTAPP_BUF_ERROR;
+
+            if((cls->used & bit) == 0)
+            {
+                xSemaphoreGive(cls->mutex);
+                return OTAPP_BUF_ERROR; // double free
+            }
+            cls->used &= ~bit;
+
+#ifdef OTAPP_BUF_POISON
+            // use-after-free reads show the poison pattern (the first bytes hold the free list link)
+            memset(block, OTAPP_BUF_POISON_BYTE, cls->stats.block_size);
+#endif
+            ((slabBlock_t*)block)->next = cls->free_list;
+            cls->free_list = (slabBlock_t*)block;
+            cls->stats.blocks_used--;
+            otapp_buf_waitQueueWakeHead(cls->waiter, cls->waiters);
+        xSemaphoreGive(cls->mutex);
+        // --- Critical section STOP ---
+
+        // smaller classes fall back to this one, their oldest waiter may take the block too
+        for(uint8_t sc = 0; sc < c; sc++)
+        {
+            slabClass_t *smaller = &buf.slab[sc];
+            if(xSemaphoreTake(smaller->mutex, portMAX_DELAY) != pdTRUE) continue;
+                otapp_buf_waitQueueWakeHead(smaller->waiter, smaller->waiters);
+            xSemaphoreGive(smaller->mutex);
+        }
+
+        return OTAPP_BUF_OK;
+    }
+
+    return OTAPP_BUF_ERROR; // foreign pointer
+}
+
+void otapp_buf_slabRelease(uint8_t **block)
+{
+    if(block == NULL || *block == NULL) return;
+
+    otapp_buf_slabFree(*block);
+    *block = NULL;
+}
+
+int8_t otapp_buf_slabGetStats(otapp_buf_slabClass_t slabClass, otapp_buf_slabStats_t *statsOut)
+{
+    if(slabClass >= OTAPP_BUF_SLAB_CLASSES_QTY || statsOut == NULL) return OTAPP_BUF_ERROR;
+
+    slabClass_t *cls = &buf.slab[slabClass];
+
+    // --- Critical section START ---
+    if(xSemaphoreTake(cls->mutex, portMAX_DELAY) != pdTRUE) return OTAPP_BUF_ERROR;
+        *statsOut = cls->stats;
+    xSemaphoreGive(cls->mutex);
+    // --- Critical section STOP ---
+
+    return OTAPP_BUF_OK;
+}
+
+int8_t otapp_buf_slot_getStats(otapp_buf_slot_t slot, otapp_buf_stats_t *statsOut)
+{
+    if(statsOut == NULL) return OTAPP_BUF_ERROR;
+
+    indexEntry_t* entry = otapp_buf_slot_entry(slot);
+    if(entry == NULL) return OTAPP_BUF_ERROR_KEY_NOT_FOUND;
+
+    uint8_t locked = 0;
+
+    // the query itself is not counted as an acquisition, so the mutex is taken directly
+    // --- Critical section START ---
+    if(!otapp_buf_isRing(entry))
+    {
+        if(xSemaphoreTake(entry->mutex, portMAX_DELAY) != pdTRUE) return OTAPP_BUF_ERROR;
+        locked = 1;
+    }
+        statsOut->key             = entry->key;
+        statsOut->max_size        = entry->max_size;
+        statsOut->peak_len        = entry->stats.peak_len;
+        statsOut->acquire_cnt     = entry->stats.acquire_cnt;
+        statsOut->contended_cnt   = entry->stats.contended_cnt;
+        statsOut->overflow_cnt    = atomic_load_explicit(&entry->stats.overflow_cnt, memory_order_relaxed);
+        statsOut->busy_reject_cnt = atomic_load_explicit(&entry->stats.busy_reject_cnt, memory_order_relaxed);
+    if(locked) xSemaphoreGive(entry->mutex);
+    // --- Critical section STOP ---
+
+    return OTAPP_BUF_OK;
+}
+
+int8_t otapp_buf_getStats(uint16_t key, otapp_buf_stats_t *statsOut)
+{
+    return otapp_buf_slot_getStats(otapp_buf_keyToSlot(key), statsOut);
+}
+
+void otapp_buf_resetStats(void)
+{
+    for(uint8_t i = 0; i < OTAPP_BUF_KEYS_QTY; i++) 
+    {
+        indexEntry_t *entry = &buf.index[i];
+        uint8_t locked = 0;
+
+        if(!otapp_buf_isRing(entry))
+        {
+            if(xSemaphoreTake(entry->mutex, portMAX_DELAY) != pdTRUE) continue;
+            locked = 1;
+        }
+            // the high-water mark restarts from the current fill level
+            entry->stats.peak_len        = otapp_buf_isRing(entry) ? otapp_buf_ring_len(entry) : entry->current_len;
+            entry->stats.acquire_cnt     = 0;
+            entry->stats.contended_cnt   = 0;
+            atomic_store_explicit(&entry->stats.overflow_cnt, 0, memory_order_relaxed);
+            atomic_store_explicit(&entry->stats.busy_reject_cnt, 0, memory_order_relaxed);
+        if(locked) xSemaphoreGive(entry->mutex);
+    }
+}
+
+int8_t otapp_buf_appendFromKey(uint16_t dstKey, uint16_t srcKey)
+{
+    if(dstKey == 0 || srcKey == 0 || dstKey == srcKey) return OTAPP_BUF_ERROR;
+
+    indexEntry_t* dst = otapp_buf_find_entry(dstKey);
+    indexEntry_t* src = otapp_buf_find_entry(srcKey);
+    if(dst == NULL || src == NULL) return OTAPP_BUF_ERROR_KEY_NOT_FOUND;
+
+    if(otapp_buf_isRing(dst) || otapp_buf_isRing(src)) return OTAPP_BUF_ERROR_MODE;
+
+    // --- Critical section START (both slots, lock order rule) ---
+    if(otapp_buf_mutex_lockPair(dst, src) != OTAPP_BUF_OK) return OTAPP_BUF_ERROR;
+
+        if(dst->write_lock)
+        {
+            otapp_buf_mutex_unlockPair(dst, src);
+            return otapp_buf_reject(dst, OTAPP_BUF_ERROR_WRITE_LOCK); 
+        }
+
+        // a writer of the source may still be filling it through its raw pointer
+        if(src->write_lock)
+        {
+            otapp_buf_mutex_unlockPair(dst, src);
+            return otapp_buf_reject(src, OTAPP_BUF_ERROR_WRITE_LOCK); 
+        }
+
+        if(dst->current_len + src->current_len > dst->max_size) 
+        {   
+            otapp_buf_mutex_unlockPair(dst, src);
+            return otapp_buf_reject(dst, OTAPP_BUF_ERROR_OVERFLOW); 
+        }
+
+        memcpy(&buf.data[dst->offset + dst->current_len], &buf.data[src->offset], src->current_len);
+        dst->current_len += src->current_len;
+        otapp_buf_statsLen(dst, dst->current_len);
+
+    otapp_buf_mutex_unlockPair(dst, src);
+    // --- Critical section STOP ---
+
+    return OTAPP_BUF_OK;
+}
+
+void otapp_buffer_init(void)
+{
+    int8_t result;
+
+    if(otapp_buf_initialized == 0) 
+    {
+        result = otapp_buf_initKeysIndex();
     
+        if(result == OTAPP_BUF_OK) 
+        {
+            result = otapp_buf_initMutexes();
+        }
+
+        if(result == OTAPP_BUF_OK) 
+        {
+            result = otapp_buf_initSlab();
+        }
+
+        if(result == OTAPP_BUF_ERROR) 
+        {       
+            while(1);  // error
+        }
+
+        otapp_buf_initialized = 1;
+    }
 }
\ No newline at end of file
@@ -24,6 +24,12 @@
 #include "ot_app_deviceName.h"
 #include "ot_app_drv.h"
 #include "ot_app_coap_uri.h"
+#include "ot_app_coap_coalesce.h"
+#include "ot_app_coap_stats.h"
+#include "ot_app_coap_block.h"
+#include "ot_app_coap_notify.h"
+#include "ot_app_coap_transport.h"
+#include "ot_app_coap_response.h"
 
 #include "string.h"
 
@@ -34,6 +40,8 @@
  #else
     #include <openthread/ip6.h>
     #include "ot_app.h"
+    #include "ot_app_port_rtos.h"
+    #include "ot_app_port_openthread.h"
 #endif
 
 #define TAG "ot_app_coap "
@@ -46,35 +54,11 @@ static otapp_coap_uri_t otapp_coap_uriDefault[] ={
     {OTAPP_URI_SUBSCRIBED_URIS, {"subscribed_uris", otapp_coap_uri_subscribedHandle, NULL, NULL}},
     {OTAPP_URI_TEST,            {"test", otapp_coap_uri_testHandle, NULL, NULL}},                  // for test
     {OTAPP_URI_TEST_LED,        {"test/led", otapp_coap_uri_ledControlHandle, NULL, NULL}},      // for test
+    {OTAPP_URI_BUF_STATS,       {"diag/buf", otapp_coap_uri_bufStatsHandle, NULL, NULL}},        // buffer pool telemetry
+    {OTAPP_URI_COAP_STATS,      {"diag/coap", otapp_coap_uri_coapStatsHandle, NULL, NULL}},      // client RTT / loss telemetry
 };
 #define OTAPP_COAP_URI_DEFAULT_SIZE (sizeof(otapp_coap_uriDefault) / sizeof(otapp_coap_uriDefault[0]))
 
-typedef struct {
-    otapp_coap_messageId_t msgID;
-    char *message;
-}otapp_coap_message_t;
-
-static const otapp_coap_message_t otapp_coap_messages[] = {
-    {OTAPP_MESSAGE_OK, "OK"},
-    {OTAPP_MESSAGE_ERROR, "ERROR"},
-    {OTAPP_MESSAGE_TEST, "Hello coap !!"},
-};
-#define OTAPP_COAP_MESSAGE_SIZE (sizeof(otapp_coap_messages) / sizeof(otapp_coap_messages[0]))
-
-
-const char *otapp_coap_getMessage(otapp_coap_messageId_t msgID)
-{
-    for (uint16_t i = 0; i < OTAPP_COAP_MESSAGE_SIZE; i++)
-    {
-        if(otapp_coap_messages[i].msgID == msgID)
-        {
-            return otapp_coap_messages[i].message;
-        }
-    }
-    
-    return NULL;
-} 
-
 const char *otapp_coap_getUriName(const otapp_coap_uri_t *uriTable, uint8_t tableSize, otapp_coap_uriIndex_t uriIndex)
 {
     if(uriTable == NULL || tableSize == 0 || uriIndex == OTAPP_URI_NO_URI_INDEX || uriIndex == OTAPP_URI_END_OF_INDEX)
@@ -132,6 +116,44 @@ void otapp_coap_printSenderIP(const otMessageInfo *aMessageInfo)
     }
 }
 
+void otapp_coap_sendResponseMessage(otMessage *requestMessage, const otMessageInfo *aMessageInfo, otapp_coap_messageId_t msgID)
+{
+    otapp_coap_response_t response;
+    otMessage *responseMessage;
+    otError error;
+
+    if (requestMessage == NULL || aMessageInfo == NULL) return;
+
+    if (otapp_coap_responseResolve(msgID, otCoapMessageGetCode(requestMessage), otCoapMessageGetType(requestMessage), &response) != OTAPP_COAP_RESPONSE_OK) return;
+
+    responseMessage = otCoapNewMessage(otapp_getOpenThreadInstancePtr(), NULL);
+    if (responseMessage == NULL)
+    {
+        OTAPP_PRINTF(TAG, "CoAP error: %d (%s)\n", OT_ERROR_NO_BUFS, otThreadErrorToString(OT_ERROR_NO_BUFS));
+        return;
+    }
+
+    error = otCoapMessageInitResponse(responseMessage, requestMessage, response.type, response.code);
+    if (error == OT_ERROR_NONE && response.payload != NULL)
+    {
+        error = otCoapMessageSetPayloadMarker(responseMessage);
+        if (error == OT_ERROR_NONE)
+        {
+            error = otMessageAppend(responseMessage, response.payload, response.payloadLength);
+        }
+    }
+    if (error == OT_ERROR_NONE)
+    {
+        error = otCoapSendResponse(otapp_getOpenThreadInstancePtr(), responseMessage, aMessageInfo);
+    }
+
+    if (error != OT_ERROR_NONE)
+    {
+        OTAPP_PRINTF(TAG, "CoAP error: %d (%s)\n", error, otThreadErrorToString(error));
+        otMessageFree(responseMessage);
+    }
+}
+
 void otapp_coap_sendResponse(otMessage *requestMessage, const otMessageInfo *aMessageInfo, const uint8_t *responceContent, uint16_t responceLength)
 {
     otError error = OT_ERROR_NONE;
@@ -139,6 +161,7 @@ void otapp_coap_sendResponse(otMessage *requestMessage, const otMessageInfo *aMe
     otCoapCode responseCode = OT_COAP_CODE_EMPTY;
    
     otCoapCode requestCode = otCoapMessageGetCode(requestMessage);
+    otCoapType responseType = otapp_coap_responseType(otCoapMessageGetType(requestMessage));
 
     if (requestCode == OT_COAP_CODE_GET)
     {
@@ -152,7 +175,7 @@ void otapp_coap_sendResponse(otMessage *requestMessage, const otMessageInfo *aMe
         }
 
         // Create ACK for GET query
-        error = otCoapMessageInitResponse(responseMessage, requestMessage, OT_COAP_TYPE_CONFIRMABLE, responseCode);
+        error = otCoapMessageInitResponse(responseMessage, requestMessage, responseType, responseCode);
         if (error != OT_ERROR_NONE) { goto exit; }
 
         // // Add marker payload's and payload
@@ -176,7 +199,7 @@ void otapp_coap_sendResponse(otMessage *requestMessage, const otMessageInfo *aMe
         }
 
         // Create ACK for GET query
-        error = otCoapMessageInitResponse(responseMessage, requestMessage, OT_COAP_TYPE_CONFIRMABLE, responseCode);
+        error = otCoapMessageInitResponse(responseMessage, requestMessage, responseType, responseCode);
         if (error != OT_ERROR_NONE)  { goto exit; }
     
     }
@@ -190,7 +213,7 @@ void otapp_coap_sendResponse(otMessage *requestMessage, const otMessageInfo *aMe
             error = OT_ERROR_NO_BUFS;
             goto exit;
         }
-        error = otCoapMessageInitResponse(responseMessage, requestMessage, OT_COAP_TYPE_ACKNOWLEDGMENT, responseCode);
+        error = otCoapMessageInitResponse(responseMessage, requestMessage, responseType, responseCode);
         if (error != OT_ERROR_NONE) goto exit;
         
         error = otCoapSendResponse(otapp_getOpenThreadInstancePtr(), responseMessage, aMessageInfo);
@@ -221,19 +244,95 @@ exit:
     }
 }
 
-void otapp_coap_client_send(const otIp6Address *peer_addr, 
+otMessage *otapp_coap_responseNew(otMessage *requestMessage)
+{
+    return otapp_coap_responseNewBlock2(requestMessage, NULL);
+}
+
+otMessage *otapp_coap_responseNewBlock2(otMessage *requestMessage, const otapp_coap_block_t *block2)
+{
+    otError error;
+    otMessage *responseMessage;
+
+    if (requestMessage == NULL || otCoapMessageGetCode(requestMessage) != OT_COAP_CODE_GET) return NULL;
+
+    responseMessage = otCoapNewMessage(otapp_getOpenThreadInstancePtr(), NULL);
+    if (responseMessage == NULL) return NULL;
+
+    error = otCoapMessageInitResponse(responseMessage, requestMessage, otapp_coap_responseType(otCoapMessageGetType(requestMessage)), OT_COAP_CODE_CONTENT);
+    if (error == OT_ERROR_NONE && block2 != NULL)
+    {
+        error = otCoapMessageAppendBlock2Option(responseMessage, block2->num, block2->more, (otCoapBlockSzx)block2->szx);
+    }
+    if (error == OT_ERROR_NONE)
+    {
+        error = otCoapMessageSetPayloadMarker(responseMessage);
+    }
+
+    if (error != OT_ERROR_NONE)
+    {
+        OTAPP_PRINTF(TAG, "CoAP error: %d (%s)\n", error, otThreadErrorToString(error));
+        otMessageFree(responseMessage);
+        return NULL;
+    }
+
+    return responseMessage;
+}
+
+void otapp_coap_responseSend(otMessage *responseMessage, const otMessageInfo *aMessageInfo)
+{
+    otError error;
+
+    if (responseMessage == NULL) return;
+
+    error = otCoapSendResponse(otapp_getOpenThreadInstancePtr(), responseMessage, aMessageInfo);
+    if (error != OT_ERROR_NONE)
+    {
+        OTAPP_PRINTF(TAG, "CoAP error: %d (%s)\n", error, otThreadErrorToString(error));
+        otMessageFree(responseMessage);
+        return;
+    }
+    OTAPP_PRINTF(TAG, "CoAP response sent.\n");
+}
+
+static uint32_t otapp_coap_timeMsGet(void)
+{
+    return (uint32_t)(xTaskGetTickCount() * portTICK_PERIOD_MS);
+}
+
+// response / timeout of a tracked request: statistics, then the user handler
+static void otapp_coap_statsResponseHandle(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo, otError aResult)
+{
+    otCoapResponseHandler responseHandler = NULL;
+    void *userContext = NULL;
+
+    if(otapp_coap_statsRequestEnd((otapp_coap_statsRequest_t *)aContext, aResult, otapp_coap_timeMsGet(), &responseHandler, &userContext) != OTAPP_COAP_STATS_OK)
+    {
+        return;
+    }
+
+    if(responseHandler != NULL)
+    {
+        responseHandler(userContext, aMessage, aMessageInfo, aResult);
+    }
+}
+
+static otError otapp_coap_client_sendType(const otIp6Address *peer_addr, 
                             const char *aUriPath, 
+                            otCoapType coapType,
                             otCoapCode code, 
                             const void *payloadMsg, 
                             const uint16_t payloadMsgSize,
                             otCoapResponseHandler responseHandler, 
                             void *aContext, 
                             uint8_t *tokenOutIn,
-                            uint8_t obsState) // obsState: 0 - register, 1 - unsubscribe, 2 - update request
+                            uint8_t obsState, // obsState: 0 - register, 1 - unsubscribe, 2 - update request
+                            const otapp_coap_block_t *block2) // NULL: without Block2 option
 {
     otError error;
     otMessage *message = NULL;
     otMessageInfo messageInfo;
+    otapp_coap_statsRequest_t *statsRequest = NULL;
     
     memset(&messageInfo, 0, sizeof(messageInfo));
 
@@ -244,9 +343,12 @@ void otapp_coap_client_send(const otIp6Address *peer_addr,
 
     if(NULL == peer_addr || NULL == aUriPath)
     {
-        return;
+        return OT_ERROR_INVALID_ARGS;
     }
 
+    // called from the tasklet and from other tasks (notify, pair, buttons), the lock is recursive
+    otapp_port_openthread_lock();
+
     // create new message CoAP
     message = otCoapNewMessage(otapp_getOpenThreadInstancePtr(), NULL);
     if (message == NULL)
@@ -255,8 +357,8 @@ void otapp_coap_client_send(const otIp6Address *peer_addr,
         goto exit;
     }
 
-    // message initialize as Confirmable GET
-    otCoapMessageInit(message, OT_COAP_TYPE_CONFIRMABLE, code);  
+    // message initialize, multicast destination requires Non-confirmable
+    otCoapMessageInit(message, coapType, code);  
 
     // add observer token and option
     if(tokenOutIn != NULL)
@@ -280,6 +382,13 @@ void otapp_coap_client_send(const otIp6Address *peer_addr,
     error = otCoapMessageAppendUriPathOptions(message, aUriPath);
     if(error != OT_ERROR_NONE) { goto exit; }
 
+    // Block2 (23) after Uri-Path (11), options go in ascending order
+    if(block2 != NULL)
+    {
+        error = otCoapMessageAppendBlock2Option(message, block2->num, block2->more, (otCoapBlockSzx)block2->szx);
+        if(error != OT_ERROR_NONE) { goto exit; }
+    }
+
     if(code == OT_COAP_CODE_PUT)
     {
         if(NULL == payloadMsg) { goto exit; }
@@ -291,9 +400,25 @@ void otapp_coap_client_send(const otIp6Address *peer_addr,
         if (error != OT_ERROR_NONE) { goto exit; }
     }
     
+    // CON: tracked in the in-flight table (RTT, loss), the stats handler calls responseHandler
+    if(coapType == OT_COAP_TYPE_CONFIRMABLE)
+    {
+        statsRequest = otapp_coap_statsRequestStart(peer_addr, otCoapMessageGetToken(message), otCoapMessageGetTokenLength(message), responseHandler, aContext, otapp_coap_timeMsGet());
+    }
+
     // send request. otapp_coap_responseHandler 
-    error = otCoapSendRequest(otapp_getOpenThreadInstancePtr(), message, &messageInfo, responseHandler, aContext); // 
-    if (error != OT_ERROR_NONE) { goto exit; }
+    if(statsRequest != NULL)
+    {
+        error = otCoapSendRequest(otapp_getOpenThreadInstancePtr(), message, &messageInfo, otapp_coap_statsResponseHandle, statsRequest);
+    }else
+    {
+        error = otCoapSendRequest(otapp_getOpenThreadInstancePtr(), message, &messageInfo, responseHandler, aContext);
+    }
+    if (error != OT_ERROR_NONE) 
+    { 
+        otapp_coap_statsRequestCancel(statsRequest);
+        goto exit; 
+    }
 
 exit:
     if (error != OT_ERROR_NONE)
@@ -304,6 +429,101 @@ exit:
             otMessageFree(message);
         }
     }   
+    otapp_port_openthread_unlock();
+    return error;
+}
+
+// block-wise GET of ot_app_coap_block: Confirmable, tracked in the statistics like every CON request
+static otError otapp_coap_blockSendGet(const otIp6Address *peer_addr, const char *aUriPath, const otapp_coap_block_t *block2, otCoapResponseHandler responseHandler, void *aContext)
+{
+    return otapp_coap_client_sendType(peer_addr, aUriPath, OT_COAP_TYPE_CONFIRMABLE, OT_COAP_CODE_GET, NULL, 0, responseHandler, aContext, NULL, 0, block2);
+}
+
+// reassembled Block2 representation, payload from offset 0
+static otMessage *otapp_coap_blockMessageNew(void)
+{
+    return otIp6NewMessage(otapp_getOpenThreadInstancePtr(), NULL);
+}
+
+static TaskHandle_t otapp_coap_notifyTaskHandle;
+
+// notify cycle of the deferred jobs, subscribers of this device
+static int8_t otapp_coap_notifyBatchSubscribers(const oac_uri_obs_notifyItem_t *items, uint8_t itemsQty)
+{
+    return oac_uri_obs_notifyBatch(oac_uri_obs_getSubListHandle(), items, itemsQty);
+}
+
+// observer fan-out out of the OpenThread tasklet, every send takes the OpenThread lock itself
+static void otapp_coap_notifyTask(void *params)
+{
+    static otapp_coap_notifyJob_t jobs[OTAPP_COAP_NOTIFY_BATCH_MAX]; // not on the task stack
+    uint8_t jobsQty;
+
+    (void)params;
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while ((jobsQty = otapp_coap_notifyTake(jobs, OTAPP_COAP_NOTIFY_BATCH_MAX)) > 0)
+        {
+            if(otapp_coap_notifyRun(jobs, jobsQty, otapp_coap_timeMsGet()) == OAC_URI_OBS_ERROR)
+            {
+                OTAPP_PRINTF(TAG, "ERROR notify task: %u jobs\n", (unsigned)jobsQty);
+            }
+            otapp_coap_notifyDone();
+        }
+
+        UTILS_RTOS_CHECK_FREE_STACK();
+        BREAK_U_TEST;
+    }
+}
+
+static int8_t otapp_coap_notifyInitTask(void)
+{
+    otapp_coap_notifyInit(otapp_coap_notifyBatchSubscribers);
+
+    if(xTaskCreate(otapp_coap_notifyTask, "otapp notify task", OTAPP_COAP_NOTIFY_TASK_STACK_DEPTH, NULL, OTAPP_COAP_NOTIFY_TASK_PRIORITY, &otapp_coap_notifyTaskHandle) != pdPASS)
+    {
+        otapp_coap_notifyTaskHandle = NULL;
+        return OTAPP_COAP_ERROR;
+    }
+    return OTAPP_COAP_OK;
+}
+
+// handler side: post the change and wake the task, all slots full (or no task): inline fan-out as before
+static void otapp_coap_notifyDefer(oac_uri_observer_t *obsHandle, const otIp6Address *excludedIpAddr, oacu_uriIndex_t uriId, const uint8_t *data, uint16_t dataSize)
+{
+    int8_t result = OTAPP_COAP_NOTIFY_FULL;
+
+    if(otapp_coap_notifyTaskHandle != NULL)
+    {
+        result = otapp_coap_notifyPost(excludedIpAddr, uriId, data, dataSize, otapp_coap_timeMsGet());
+    }
+
+    if(result == OTAPP_COAP_NOTIFY_OK || result == OTAPP_COAP_NOTIFY_MERGED)
+    {
+        xTaskNotifyGive(otapp_coap_notifyTaskHandle);
+        return;
+    }
+    if(result == OTAPP_COAP_NOTIFY_ERROR)
+    {
+        return;
+    }
+
+    oac_uri_obs_notify(obsHandle, excludedIpAddr, uriId, data, dataSize);
+}
+
+void otapp_coap_client_send(const otIp6Address *peer_addr, 
+                            const char *aUriPath, 
+                            otCoapCode code, 
+                            const void *payloadMsg, 
+                            const uint16_t payloadMsgSize,
+                            otCoapResponseHandler responseHandler, 
+                            void *aContext, 
+                            uint8_t *tokenOutIn,
+                            uint8_t obsState)
+{
+    otapp_coap_client_sendType(peer_addr, aUriPath, OT_COAP_TYPE_CONFIRMABLE, code, payloadMsg, payloadMsgSize, responseHandler, aContext, tokenOutIn, obsState, NULL);
 }
 
 void otapp_coap_clientSendPutByte(const otIp6Address *peer_addr, const char *aUriPath, const uint8_t *payloadMsg, const uint16_t payloadMsgSize, otCoapResponseHandler responseHandler, void *aContext)
@@ -312,6 +532,15 @@ void otapp_coap_clientSendPutByte(const otIp6Address *peer_addr, const char *aUr
    OTAPP_PRINTF(TAG, "CoAP sentPutByte to %s\n", aUriPath);
 }
 
+otError otapp_coap_clientSendPutByteTransport(const otIp6Address *peer_addr, const char *aUriPath, const uint8_t *payloadMsg, const uint16_t payloadMsgSize, otapp_coap_transport_t transport, otCoapResponseHandler responseHandler, void *aContext)
+{
+   otError error;
+
+   error = otapp_coap_client_sendType(peer_addr, aUriPath, otapp_coap_transportType(transport), OT_COAP_CODE_PUT, (const uint8_t *)payloadMsg, payloadMsgSize, responseHandler, aContext, NULL, 0, NULL);
+   OTAPP_PRINTF(TAG, "CoAP sentPutByte %s to %s\n", (transport == OTAPP_COAP_TRANSPORT_NON) ? "NON" : "CON", aUriPath);
+   return error;
+}
+
 void otapp_coap_clientSendPutChar(const otIp6Address *peer_addr, const char *aUriPath, const char *payloadMsg, otCoapResponseHandler responseHandler)
 {
    otapp_coap_client_send(peer_addr, aUriPath, OT_COAP_CODE_PUT, (const char *)payloadMsg, strlen(payloadMsg), responseHandler, NULL, NULL, 0);
@@ -354,7 +583,8 @@ void otapp_coapSendDeviceNamePut()
 
 void otapp_coapSendGetUri_Well_known(const otIp6Address *ipAddr, otCoapResponseHandler responseHandler, void *aContext)
 {
-   otapp_coap_clientSendGetByte(ipAddr, otapp_coap_getUriNameFromDefault(OTAPP_URI_WELL_KNOWN_CORE), responseHandler, aContext);
+   // URI list can be longer than one block, the handler gets the whole list
+   otapp_coap_block2Request(ipAddr, otapp_coap_getUriNameFromDefault(OTAPP_URI_WELL_KNOWN_CORE), responseHandler, aContext);
    OTAPP_PRINTF(TAG, "CoAP sent WELL KNOWN URI \n");
 }
 
@@ -364,6 +594,12 @@ void otapp_coapSendPutUri_subscribed_uris(const otIp6Address *ipAddr, const uint
     OTAPP_PRINTF(TAG, "CoAP sent update subscribers \n");
 }
 
+void otapp_coapSendPutUri_subscribed_urisMulticast(const otIp6Address *groupAddr, const uint8_t *data, uint16_t dataSize)
+{
+    otapp_coap_client_sendType(groupAddr, otapp_coap_getUriNameFromDefault(OTAPP_URI_SUBSCRIBED_URIS), OT_COAP_TYPE_NON_CONFIRMABLE, OT_COAP_CODE_PUT, data, dataSize, NULL, NULL, NULL, 0, NULL);
+    OTAPP_PRINTF(TAG, "CoAP sent multicast update subscribers \n");
+}
+
 void otapp_coapSendSubscribeRequest(const otIp6Address *ipAddr, const char *aUriPath, uint8_t *tokenOut)
 {
     otapp_coap_client_send(ipAddr, aUriPath, OT_COAP_CODE_PUT, (char*)otapp_deviceNameFullGet(), strlen(otapp_deviceNameFullGet()), NULL, NULL, tokenOut, 0);
@@ -378,11 +614,11 @@ void otapp_coapSendSubscribeRequestUpdate(const otIp6Address *ipAddr, const char
 
 void otapp_coap_sendResponseOK(otMessage *aMessage, const otMessageInfo *aMessageInfo)
 {
-    otapp_coap_sendResponse(aMessage, aMessageInfo, (uint8_t*)otapp_coap_getMessage(OTAPP_MESSAGE_OK), strlen(otapp_coap_getMessage(OTAPP_MESSAGE_OK)) );
+    otapp_coap_sendResponseMessage(aMessage, aMessageInfo, OTAPP_MESSAGE_OK);
 }
 void otapp_coap_sendResponseERROR(otMessage *aMessage, const otMessageInfo *aMessageInfo)
 {
-    otapp_coap_sendResponse(aMessage, aMessageInfo, (uint8_t*)otapp_coap_getMessage(OTAPP_MESSAGE_ERROR), strlen(otapp_coap_getMessage(OTAPP_MESSAGE_ERROR)) );
+    otapp_coap_sendResponseMessage(aMessage, aMessageInfo, OTAPP_MESSAGE_ERROR);
 }
 
 int8_t otapp_coapReadPayload(otMessage *aMessage, uint8_t *bufferOut, uint16_t bufferSize, uint16_t *readBytesOut)
@@ -444,8 +680,8 @@ int8_t otapp_coap_processUriRequest(otMessage *aMessage, const otMessageInfo *aM
             // send response OK
             otapp_coap_sendResponseOK(aMessage, aMessageInfo);            
            
-            // notify subscribers about event
-            oac_uri_obs_notify(obsHandle, &aMessageInfo->mPeerAddr, uriId, bufOut, payloadReadBytes); 
+            // notify subscribers about event, fan-out in the notify task
+            otapp_coap_notifyDefer(obsHandle, &aMessageInfo->mPeerAddr, uriId, bufOut, payloadReadBytes);
 
         }else // if request concerned observer. result > 0 
         {
@@ -489,6 +725,17 @@ int8_t otapp_coap_init(ot_app_devDrv_t *devDriver)
        return OTAPP_COAP_URI_ERROR;
     }
     drv = devDriver;
+    otapp_coap_coalesceInit(otapp_coap_clientSendPutByteTransport);
+    otapp_coap_statsInit();
+    otapp_coap_blockInit(otapp_coap_blockSendGet, otapp_coap_blockMessageNew);
+    if (oac_uri_obs_init() != OAC_URI_OBS_OK)
+    {
+       return OTAPP_COAP_URI_ERROR;
+    }
+    if (otapp_coap_notifyInitTask() != OTAPP_COAP_OK)
+    {
+       return OTAPP_COAP_URI_ERROR;
+    }
     error = otCoapStart(otapp_getOpenThreadInstancePtr(), OT_DEFAULT_COAP_PORT);
     if (error != OT_ERROR_NONE)
     {
@@ -0,0 +1,330 @@
+/**
+ * @file ot_app_coap_block.c
+ * @author Jan Łukaszewicz (pldevluk@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 17-10-2026
+ *
+ * @copyright The MIT License (MIT) Copyright (c) 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ot_app_coap_block.h"
+#include "string.h"
+
+#define OTAPP_COAP_BLOCK_OPTION_SIZE_MAX    3       // 20-bit num + more + szx
+#define OTAPP_COAP_BLOCK_COPY_CHUNK         32      // stack chunk for message to message copy
+
+typedef struct {
+    otIp6Address peerAddr;
+    const char *uriPath;
+    otCoapResponseHandler responseHandler;
+    void *aContext;
+    otMessage *body;        // reassembled representation, NULL until the first block with more = 1
+    uint16_t received;      // representation bytes received
+    uint8_t isTaken;
+} otapp_coap_blockTransfer_t;
+
+static otapp_coap_blockTransfer_t otapp_blockTransfers[OTAPP_COAP_BLOCK_TRANSFERS_MAX];
+static otapp_coap_blockSendGet_t otapp_blockSendGetFn;
+static otapp_coap_blockMessageNew_t otapp_blockMessageNewFn;
+
+PRIVATE void otapp_coap_block2ResponseHandle(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo, otError aResult);
+
+uint32_t otapp_coap_blockEncode(const otapp_coap_block_t *block)
+{
+    if(block == NULL)
+    {
+        return 0;
+    }
+    return ((block->num & OTAPP_COAP_BLOCK_NUM_MAX) << 4) | ((block->more ? 1u : 0u) << 3) | (block->szx & 0x07u);
+}
+
+int8_t otapp_coap_blockDecode(uint32_t value, otapp_coap_block_t *blockOut)
+{
+    if(blockOut == NULL || (value >> 4) > OTAPP_COAP_BLOCK_NUM_MAX || (value & 0x07u) > OTAPP_COAP_BLOCK_SZX_MAX)
+    {
+        return OTAPP_COAP_BLOCK_ERROR;
+    }
+
+    blockOut->num  = value >> 4;
+    blockOut->more = (value >> 3) & 0x01u;
+    blockOut->szx  = value & 0x07u;
+    return OTAPP_COAP_BLOCK_OK;
+}
+
+int8_t otapp_coap_block2Get(const otMessage *message, otapp_coap_block_t *blockOut)
+{
+    otCoapOptionIterator iterator;
+    const otCoapOption *coapOption;
+    uint8_t optionValue[OTAPP_COAP_BLOCK_OPTION_SIZE_MAX];
+    uint32_t value = 0;
+
+    if(message == NULL || blockOut == NULL)
+    {
+        return OTAPP_COAP_BLOCK_ERROR;
+    }
+
+    if(otCoapOptionIteratorInit(&iterator, message) != OT_ERROR_NONE)
+    {
+        return OTAPP_COAP_BLOCK_ERROR;
+    }
+
+    coapOption = otCoapOptionIteratorGetFirstOptionMatching(&iterator, OT_COAP_OPTION_BLOCK2);
+    if(coapOption == NULL)
+    {
+        return OTAPP_COAP_BLOCK_NONE;
+    }
+
+    if(coapOption->mLength > sizeof(optionValue) ||
+       otCoapOptionIteratorGetOptionValue(&iterator, optionValue) != OT_ERROR_NONE)
+    {
+        return OTAPP_COAP_BLOCK_ERROR;
+    }
+
+    // uint option, network byte order, 0 bytes = value 0
+    for (uint8_t i = 0; i < coapOption->mLength; i++)
+    {
+        value = (value << 8) | optionValue[i];
+    }
+
+    return otapp_coap_blockDecode(value, blockOut);
+}
+
+int8_t otapp_coap_block2Window(const otapp_coap_block_t *request, uint16_t totalSize, otapp_coap_block_t *blockOut, uint16_t *offsetOut, uint16_t *sizeOut)
+{
+    uint32_t offset = 0;
+    uint8_t szx = OTAPP_COAP_BLOCK_SZX_DEFAULT;
+
+    if(blockOut == NULL || offsetOut == NULL || sizeOut == NULL)
+    {
+        return OTAPP_COAP_BLOCK_ERROR;
+    }
+
+    if(request == NULL && totalSize <= OTAPP_COAP_BLOCK_SIZE(OTAPP_COAP_BLOCK_SZX_DEFAULT))
+    {
+        *offsetOut = 0;
+        *sizeOut   = totalSize;
+        return OTAPP_COAP_BLOCK_NONE;
+    }
+
+    if(request != NULL)
+    {
+        offset = request->num * OTAPP_COAP_BLOCK_SIZE(request->szx);
+        if(request->szx < szx)
+        {
+            szx = request->szx;
+        }
+    }
+
+    if(offset >= totalSize && !(offset == 0 && totalSize == 0))
+    {
+        return OTAPP_COAP_BLOCK_ERROR;
+    }
+
+    blockOut->szx  = szx;
+    blockOut->num  = offset / OTAPP_COAP_BLOCK_SIZE(szx);
+    blockOut->more = (offset + OTAPP_COAP_BLOCK_SIZE(szx) < totalSize);
+
+    *offsetOut = (uint16_t)offset;
+    *sizeOut   = blockOut->more ? OTAPP_COAP_BLOCK_SIZE(szx) : (uint16_t)(totalSize - offset);
+    return OTAPP_COAP_BLOCK_OK;
+}
+
+void otapp_coap_blockInit(otapp_coap_blockSendGet_t sendGetFn, otapp_coap_blockMessageNew_t messageNewFn)
+{
+    memset(otapp_blockTransfers, 0, sizeof(otapp_blockTransfers));
+    otapp_blockSendGetFn    = sendGetFn;
+    otapp_blockMessageNewFn = messageNewFn;
+}
+
+// release the transfer before the user handler, the handler can start a new one
+PRIVATE void otapp_coap_block2TransferEnd(otapp_coap_blockTransfer_t *transfer, otMessage *aMessage, const otMessageInfo *aMessageInfo, otError aResult)
+{
+    otCoapResponseHandler handler = transfer->responseHandler;
+    void *aContext = transfer->aContext;
+    otMessage *body = transfer->body;
+
+    transfer->isTaken = 0;
+    transfer->body    = NULL;
+
+    if(handler != NULL)
+    {
+        handler(aContext, (aResult == OT_ERROR_NONE) ? aMessage : NULL, aMessageInfo, aResult);
+    }
+
+    if(body != NULL)
+    {
+        otMessageFree(body);
+    }
+}
+
+PRIVATE otError otapp_coap_block2BodyAppend(otapp_coap_blockTransfer_t *transfer, const otMessage *aMessage, uint16_t offset, uint16_t length)
+{
+    uint8_t chunk[OTAPP_COAP_BLOCK_COPY_CHUNK];
+    uint16_t chunkSize;
+
+    if(transfer->body == NULL)
+    {
+        transfer->body = otapp_blockMessageNewFn();
+        if(transfer->body == NULL)
+        {
+            return OT_ERROR_NO_BUFS;
+        }
+    }
+
+    while (length > 0)
+    {
+        chunkSize = (length < sizeof(chunk)) ? length : sizeof(chunk);
+        if(otMessageRead(aMessage, offset, chunk, chunkSize) != chunkSize)
+        {
+            return OT_ERROR_PARSE;
+        }
+        if(otMessageAppend(transfer->body, chunk, chunkSize) != OT_ERROR_NONE)
+        {
+            return OT_ERROR_NO_BUFS;
+        }
+        offset += chunkSize;
+        length -= chunkSize;
+    }
+    return OT_ERROR_NONE;
+}
+
+PRIVATE void otapp_coap_block2ResponseHandle(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo, otError aResult)
+{
+    otapp_coap_blockTransfer_t *transfer = (otapp_coap_blockTransfer_t *)aContext;
+    otapp_coap_block_t block;
+    otError error;
+    uint16_t payloadOffset;
+    uint16_t payloadSize;
+    int8_t result;
+
+    if(transfer == NULL || !transfer->isTaken)
+    {
+        return;
+    }
+
+    if(aResult != OT_ERROR_NONE || aMessage == NULL)
+    {
+        otapp_coap_block2TransferEnd(transfer, NULL, aMessageInfo, (aResult != OT_ERROR_NONE) ? aResult : OT_ERROR_PARSE);
+        return;
+    }
+
+    result = otapp_coap_block2Get(aMessage, &block);
+    if(result == OTAPP_COAP_BLOCK_NONE && transfer->received == 0) // server without Block2: whole representation
+    {
+        otapp_coap_block2TransferEnd(transfer, aMessage, aMessageInfo, OT_ERROR_NONE);
+        return;
+    }
+
+    if(result != OTAPP_COAP_BLOCK_OK || block.num * OTAPP_COAP_BLOCK_SIZE(block.szx) != transfer->received)
+    {
+        otapp_coap_block2TransferEnd(transfer, NULL, aMessageInfo, OT_ERROR_PARSE);
+        return;
+    }
+
+    if(transfer->received == 0 && !block.more) // one block, no copy
+    {
+        otapp_coap_block2TransferEnd(transfer, aMessage, aMessageInfo, OT_ERROR_NONE);
+        return;
+    }
+
+    payloadOffset = otMessageGetOffset(aMessage);
+    payloadSize   = otMessageGetLength(aMessage) - payloadOffset;
+
+    if((block.more && payloadSize != OTAPP_COAP_BLOCK_SIZE(block.szx)) || payloadSize > OTAPP_COAP_BLOCK_SIZE(block.szx))
+    {
+        otapp_coap_block2TransferEnd(transfer, NULL, aMessageInfo, OT_ERROR_PARSE);
+        return;
+    }
+
+    if((uint32_t)transfer->received + payloadSize > OTAPP_COAP_BLOCK_BODY_MAX)
+    {
+        otapp_coap_block2TransferEnd(transfer, NULL, aMessageInfo, OT_ERROR_NO_BUFS);
+        return;
+    }
+
+    error = otapp_coap_block2BodyAppend(transfer, aMessage, payloadOffset, payloadSize);
+    if(error != OT_ERROR_NONE)
+    {
+        otapp_coap_block2TransferEnd(transfer, NULL, aMessageInfo, error);
+        return;
+    }
+    transfer->received += payloadSize;
+
+    if(!block.more)
+    {
+        otapp_coap_block2TransferEnd(transfer, transfer->body, aMessageInfo, OT_ERROR_NONE);
+        return;
+    }
+
+    // next block with the size chosen by the server
+    block.num  = transfer->received / OTAPP_COAP_BLOCK_SIZE(block.szx);
+    block.more = 0;
+
+    error = otapp_blockSendGetFn(&transfer->peerAddr, transfer->uriPath, &block, otapp_coap_block2ResponseHandle, transfer);
+    if(error != OT_ERROR_NONE)
+    {
+        otapp_coap_block2TransferEnd(transfer, NULL, aMessageInfo, error);
+    }
+}
+
+int8_t otapp_coap_block2Request(const otIp6Address *peer_addr, const char *aUriPath, otCoapResponseHandler responseHandler, void *aContext)
+{
+    otapp_coap_blockTransfer_t *transfer = NULL;
+    const otapp_coap_block_t block = {.num = 0, .more = 0, .szx = OTAPP_COAP_BLOCK_SZX_DEFAULT};
+
+    if(otapp_blockSendGetFn == NULL || otapp_blockMessageNewFn == NULL || peer_addr == NULL || aUriPath == NULL)
+    {
+        return OTAPP_COAP_BLOCK_ERROR;
+    }
+
+    for (uint8_t i = 0; i < OTAPP_COAP_BLOCK_TRANSFERS_MAX; i++)
+    {
+        if(!otapp_blockTransfers[i].isTaken)
+        {
+            transfer = &otapp_blockTransfers[i];
+            break;
+        }
+    }
+
+    if(transfer == NULL) // all transfers busy
+    {
+        return (otapp_blockSendGetFn(peer_addr, aUriPath, NULL, responseHandler, aContext) == OT_ERROR_NONE) ? OTAPP_COAP_BLOCK_OK : OTAPP_COAP_BLOCK_ERROR;
+    }
+
+    memset(transfer, 0, sizeof(otapp_coap_blockTransfer_t));
+    memcpy(&transfer->peerAddr, peer_addr, sizeof(otIp6Address));
+    transfer->uriPath         = aUriPath;
+    transfer->responseHandler = responseHandler;
+    transfer->aContext        = aContext;
+    transfer->isTaken         = 1;
+
+    if(otapp_blockSendGetFn(peer_addr, aUriPath, &block, otapp_coap_block2ResponseHandle, transfer) != OT_ERROR_NONE)
+    {
+        transfer->isTaken = 0;
+        return OTAPP_COAP_BLOCK_ERROR;
+    }
+    return OTAPP_COAP_BLOCK_OK;
+}
+
+uint8_t otapp_coap_blockTransfersGet(void)
+{
+    uint8_t transfers = 0;
+
+    for (uint8_t i = 0; i < OTAPP_COAP_BLOCK_TRANSFERS_MAX; i++)
+    {
+        transfers += otapp_blockTransfers[i].isTaken;
+    }
+    return transfers;
+}
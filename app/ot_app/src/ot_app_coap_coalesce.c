@@ -0,0 +1,218 @@
+/**
+ * @file ot_app_coap_coalesce.c
+ * @author Jan Łukaszewicz (pldevluk@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 17-10-2026
+ *
+ * @copyright The MIT License (MIT) Copyright (c) 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ot_app_coap_coalesce.h"
+#include "string.h"
+
+#ifdef UNIT_TEST
+    #include "mock_ot_app_port_openthread.h"
+#else
+    #include "ot_app_port_openthread.h"
+#endif
+
+typedef struct {
+    otIp6Address peerAddr;
+    const char *uriPath;
+
+    // request in flight (CON)
+    otCoapResponseHandler inFlightHandler;
+    void *inFlightContext;
+
+    // pending value, the newest one
+    uint8_t payload[OTAPP_COAP_COALESCE_PAYLOAD_MAX];
+    uint16_t payloadSize;
+    otapp_coap_transport_t transport;
+    otCoapResponseHandler responseHandler;
+    void *aContext;
+
+    uint8_t isTaken     : 1;
+    uint8_t isInFlight  : 1;
+    uint8_t isPending   : 1;
+} otapp_coap_coalesceSlot_t;
+
+static otapp_coap_coalesceSlot_t otapp_coalesceSlots[OTAPP_COAP_COALESCE_SLOTS_MAX];
+static otapp_coap_coalesceSend_t otapp_coalesceSendFn;
+
+PRIVATE void otapp_coap_coalesceResponseHandle(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo, otError aResult);
+
+PRIVATE otapp_coap_coalesceSlot_t *otapp_coap_coalesceSlotGet(const otIp6Address *peer_addr, const char *aUriPath)
+{
+    otapp_coap_coalesceSlot_t *freeSlot = NULL;
+    otapp_coap_coalesceSlot_t *slot;
+
+    for (uint8_t i = 0; i < OTAPP_COAP_COALESCE_SLOTS_MAX; i++)
+    {
+        slot = &otapp_coalesceSlots[i];
+        if(slot->isTaken)
+        {
+            if(memcmp(&slot->peerAddr, peer_addr, sizeof(otIp6Address)) == 0 && strcmp(slot->uriPath, aUriPath) == 0)
+            {
+                return slot;
+            }
+        }
+
+        // idle slot (nothing in flight, nothing pending) can be taken by a new target
+        if(freeSlot == NULL && !slot->isInFlight && !slot->isPending)
+        {
+            freeSlot = slot;
+        }
+    }
+
+    if(freeSlot != NULL)
+    {
+        memset(freeSlot, 0, sizeof(otapp_coap_coalesceSlot_t));
+        memcpy(&freeSlot->peerAddr, peer_addr, sizeof(otIp6Address));
+        freeSlot->uriPath = aUriPath;
+        freeSlot->isTaken = 1;
+    }
+    return freeSlot;
+}
+
+PRIVATE otError otapp_coap_coalesceSlotSend(otapp_coap_coalesceSlot_t *slot, const uint8_t *payloadMsg, uint16_t payloadMsgSize, otapp_coap_transport_t transport, otCoapResponseHandler responseHandler, void *aContext)
+{
+    otError error;
+
+    if(transport == OTAPP_COAP_TRANSPORT_CON)
+    {
+        // response handler of the slot ends the exchange and sends the pending value
+        slot->isInFlight      = 1;
+        slot->inFlightHandler = responseHandler;
+        slot->inFlightContext = aContext;
+        error = otapp_coalesceSendFn(&slot->peerAddr, slot->uriPath, payloadMsg, payloadMsgSize, transport, otapp_coap_coalesceResponseHandle, slot);
+        if(error != OT_ERROR_NONE)
+        {
+            // nic nie wyslano: odpowiedz nie przyjdzie, slot nie moze czekac w nieskonczonosc
+            slot->isInFlight      = 0;
+            slot->inFlightHandler = NULL;
+            slot->inFlightContext = NULL;
+        }
+    }else
+    {
+        error = otapp_coalesceSendFn(&slot->peerAddr, slot->uriPath, payloadMsg, payloadMsgSize, transport, responseHandler, aContext);
+    }
+    return error;
+}
+
+PRIVATE void otapp_coap_coalesceResponseHandle(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo, otError aResult)
+{
+    otapp_coap_coalesceSlot_t *slot = (otapp_coap_coalesceSlot_t *)aContext;
+    otCoapResponseHandler handler;
+    uint8_t payload[OTAPP_COAP_COALESCE_PAYLOAD_MAX];
+    otError error;
+
+    if(slot == NULL || !slot->isInFlight)
+    {
+        return;
+    }
+
+    handler = slot->inFlightHandler;
+    aContext = slot->inFlightContext;
+    slot->isInFlight = 0;
+
+    if(handler != NULL)
+    {
+        handler(aContext, aMessage, aMessageInfo, aResult);
+    }
+
+    // ACK or timeout: the newest value goes now
+    if(slot->isPending && !slot->isInFlight)
+    {
+        slot->isPending = 0;
+        memcpy(payload, slot->payload, slot->payloadSize);
+        error = otapp_coap_coalesceSlotSend(slot, payload, slot->payloadSize, slot->transport, slot->responseHandler, slot->aContext);
+        if(error != OT_ERROR_NONE && slot->responseHandler != NULL)
+        {
+            slot->responseHandler(slot->aContext, NULL, NULL, error); // the caller got PENDING, the error goes here
+        }
+    }
+}
+
+void otapp_coap_coalesceInit(otapp_coap_coalesceSend_t sendFn)
+{
+    memset(otapp_coalesceSlots, 0, sizeof(otapp_coalesceSlots));
+    otapp_coalesceSendFn = sendFn;
+}
+
+PRIVATE int8_t otapp_coap_coalescePutLocked(const otIp6Address *peer_addr, const char *aUriPath, const uint8_t *payloadMsg, const uint16_t payloadMsgSize, otapp_coap_transport_t transport, otCoapResponseHandler responseHandler, void *aContext)
+{
+    otapp_coap_coalesceSlot_t *slot;
+
+    if(otapp_coalesceSendFn == NULL || peer_addr == NULL || aUriPath == NULL || payloadMsg == NULL ||
+       payloadMsgSize == 0 || payloadMsgSize > OTAPP_COAP_COALESCE_PAYLOAD_MAX)
+    {
+        return OTAPP_COAP_COALESCE_ERROR;
+    }
+
+    slot = otapp_coap_coalesceSlotGet(peer_addr, aUriPath);
+    if(slot == NULL) // all slots busy
+    {
+        if(otapp_coalesceSendFn(peer_addr, aUriPath, payloadMsg, payloadMsgSize, transport, responseHandler, aContext) != OT_ERROR_NONE)
+        {
+            return OTAPP_COAP_COALESCE_ERROR;
+        }
+        return OTAPP_COAP_COALESCE_OK;
+    }
+
+    if(slot->isInFlight)
+    {
+        // replaced value was CON (checkpoint): keep CON
+        if(!slot->isPending || transport == OTAPP_COAP_TRANSPORT_CON)
+        {
+            slot->transport = transport;
+        }
+        memcpy(slot->payload, payloadMsg, payloadMsgSize);
+        slot->payloadSize     = payloadMsgSize;
+        slot->responseHandler = responseHandler;
+        slot->aContext        = aContext;
+        slot->isPending       = 1;
+        return OTAPP_COAP_COALESCE_PENDING;
+    }
+
+    if(otapp_coap_coalesceSlotSend(slot, payloadMsg, payloadMsgSize, transport, responseHandler, aContext) != OT_ERROR_NONE)
+    {
+        return OTAPP_COAP_COALESCE_ERROR;
+    }
+    return OTAPP_COAP_COALESCE_OK;
+}
+
+int8_t otapp_coap_coalescePut(const otIp6Address *peer_addr, const char *aUriPath, const uint8_t *payloadMsg, const uint16_t payloadMsgSize, otapp_coap_transport_t transport, otCoapResponseHandler responseHandler, void *aContext)
+{
+    int8_t result;
+
+    // slots are shared with otapp_coap_coalesceResponseHandle() in the OpenThread tasklet, which holds this lock
+    otapp_port_openthread_lock();
+    result = otapp_coap_coalescePutLocked(peer_addr, aUriPath, payloadMsg, payloadMsgSize, transport, responseHandler, aContext);
+    otapp_port_openthread_unlock();
+    return result;
+}
+
+uint8_t otapp_coap_coalescePendingGet(void)
+{
+    uint8_t pending = 0;
+
+    otapp_port_openthread_lock();
+    for (uint8_t i = 0; i < OTAPP_COAP_COALESCE_SLOTS_MAX; i++)
+    {
+        pending += otapp_coalesceSlots[i].isPending;
+    }
+    otapp_port_openthread_unlock();
+    return pending;
+}
@@ -0,0 +1,249 @@
+/**
+ * @file ot_app_coap_notify.c
+ * @author Jan Łukaszewicz (pldevluk@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 17-10-2026
+ *
+ * @copyright The MIT License (MIT) Copyright (c) 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ot_app_coap_notify.h"
+#include "string.h"
+
+#ifdef UNIT_TEST
+    #ifdef TEST_PTHREAD
+        #include "mock_freertos_semaphore_pthread.h"
+    #else
+        #include "mock_freertos_semaphore.h"
+    #endif
+#else
+    #include "ot_app_port_rtos.h"
+#endif
+
+// one slot per uri with a change waiting, a newer value of the same uri replaces the older one
+typedef struct {
+    otapp_coap_notifyJob_t job;
+    uint8_t isPending   : 1;    // value not taken by the task yet
+    uint8_t isInCycle   : 1;    // taken, notify cycle of the task not done yet
+} otapp_coap_notifySlot_t;
+
+static otapp_coap_notifyBatch_t otapp_notifyFn;
+static otapp_coap_notifyStats_t otapp_notifyStats;
+static otapp_coap_notifySlot_t otapp_notifySlots[OTAPP_COAP_NOTIFY_QUEUE_LENGTH];
+static SemaphoreHandle_t otapp_notifyMutex = NULL; // slots: OT tasklet (post) vs notify task (take, done)
+
+PRIVATE void otapp_coap_notifyLock(void)
+{
+    if(otapp_notifyMutex != NULL)
+    {
+        xSemaphoreTake(otapp_notifyMutex, portMAX_DELAY);
+    }
+}
+
+PRIVATE void otapp_coap_notifyUnlock(void)
+{
+    if(otapp_notifyMutex != NULL)
+    {
+        xSemaphoreGive(otapp_notifyMutex);
+    }
+}
+
+void otapp_coap_notifyInit(otapp_coap_notifyBatch_t notifyFn)
+{
+    if(otapp_notifyMutex == NULL)
+    {
+        otapp_notifyMutex = xSemaphoreCreateMutex();
+    }
+    memset(&otapp_notifyStats, 0, sizeof(otapp_notifyStats));
+    memset(otapp_notifySlots, 0, sizeof(otapp_notifySlots));
+    otapp_notifyFn = notifyFn;
+}
+
+int8_t otapp_coap_notifyJobSet(otapp_coap_notifyJob_t *jobOut, const otIp6Address *excludedIpAddr, oacu_uriIndex_t uriIndex, const uint8_t *data, uint16_t dataSize, uint32_t nowMs)
+{
+    if(jobOut == NULL || (data == NULL && dataSize > 0) || dataSize > OAC_URI_OBS_BUFFER_SIZE)
+    {
+        return OTAPP_COAP_NOTIFY_ERROR;
+    }
+
+    memset(jobOut, 0, sizeof(otapp_coap_notifyJob_t));
+    if(excludedIpAddr != NULL)
+    {
+        memcpy(&jobOut->excludedIpAddr, excludedIpAddr, sizeof(otIp6Address));
+        jobOut->isExcluded = 1;
+    }
+    if(dataSize > 0)
+    {
+        memcpy(jobOut->data, data, dataSize);
+    }
+    jobOut->dataSize   = dataSize;
+    jobOut->uriIndex   = uriIndex;
+    jobOut->postTimeMs = nowMs;
+
+    return OTAPP_COAP_NOTIFY_OK;
+}
+
+PRIVATE otapp_coap_notifySlot_t *otapp_coap_notifySlotFind(oacu_uriIndex_t uriIndex)
+{
+    otapp_coap_notifySlot_t *freeSlot = NULL;
+
+    for (uint8_t i = 0; i < OTAPP_COAP_NOTIFY_QUEUE_LENGTH; i++)
+    {
+        if(otapp_notifySlots[i].isPending || otapp_notifySlots[i].isInCycle)
+        {
+            if(otapp_notifySlots[i].job.uriIndex == uriIndex)
+            {
+                return &otapp_notifySlots[i];
+            }
+        }else if(freeSlot == NULL)
+        {
+            freeSlot = &otapp_notifySlots[i];
+        }
+    }
+    return freeSlot;
+}
+
+PRIVATE uint8_t otapp_coap_notifyDepth(void)
+{
+    uint8_t depth = 0;
+
+    for (uint8_t i = 0; i < OTAPP_COAP_NOTIFY_QUEUE_LENGTH; i++)
+    {
+        depth += otapp_notifySlots[i].isPending;
+    }
+    return depth;
+}
+
+int8_t otapp_coap_notifyPost(const otIp6Address *excludedIpAddr, oacu_uriIndex_t uriIndex, const uint8_t *data, uint16_t dataSize, uint32_t nowMs)
+{
+    otapp_coap_notifySlot_t *slot;
+    int8_t result;
+
+    if((data == NULL && dataSize > 0) || dataSize > OAC_URI_OBS_BUFFER_SIZE)
+    {
+        return OTAPP_COAP_NOTIFY_ERROR;
+    }
+
+    otapp_coap_notifyLock();
+    slot = otapp_coap_notifySlotFind(uriIndex);
+    if(slot == NULL)
+    {
+        otapp_notifyStats.overflow++;
+        otapp_coap_notifyUnlock();
+        return OTAPP_COAP_NOTIFY_FULL;
+    }
+
+    if(slot->isPending)
+    {
+        // lag of the merged value counts from the first change that was not notified
+        otapp_coap_notifyJobSet(&slot->job, excludedIpAddr, uriIndex, data, dataSize, slot->job.postTimeMs);
+        otapp_notifyStats.merged++;
+        result = OTAPP_COAP_NOTIFY_MERGED;
+    }else
+    {
+        // free slot, or the older value of this uri is in the notify cycle: this one goes in the next cycle
+        otapp_coap_notifyJobSet(&slot->job, excludedIpAddr, uriIndex, data, dataSize, nowMs);
+        slot->isPending = 1;
+        result = OTAPP_COAP_NOTIFY_OK;
+    }
+
+    otapp_notifyStats.posted++;
+    otapp_notifyStats.depth = otapp_coap_notifyDepth();
+    if(otapp_notifyStats.depth > otapp_notifyStats.depthMax) otapp_notifyStats.depthMax = otapp_notifyStats.depth;
+    otapp_coap_notifyUnlock();
+
+    return result;
+}
+
+uint8_t otapp_coap_notifyTake(otapp_coap_notifyJob_t *jobsOut, uint8_t jobsMax)
+{
+    otapp_coap_notifySlot_t *oldest;
+    uint8_t jobsQty = 0;
+
+    if(jobsOut == NULL)
+    {
+        return 0;
+    }
+
+    otapp_coap_notifyLock();
+    while (jobsQty < jobsMax)
+    {
+        oldest = NULL;
+        for (uint8_t i = 0; i < OTAPP_COAP_NOTIFY_QUEUE_LENGTH; i++)
+        {
+            if(otapp_notifySlots[i].isPending && !otapp_notifySlots[i].isInCycle &&
+               (oldest == NULL || (int32_t)(otapp_notifySlots[i].job.postTimeMs - oldest->job.postTimeMs) < 0))
+            {
+                oldest = &otapp_notifySlots[i];
+            }
+        }
+        if(oldest == NULL)
+        {
+            break;
+        }
+
+        jobsOut[jobsQty++] = oldest->job;
+        oldest->isPending = 0;
+        oldest->isInCycle = 1;
+    }
+    otapp_notifyStats.depth = otapp_coap_notifyDepth();
+    otapp_coap_notifyUnlock();
+
+    return jobsQty;
+}
+
+void otapp_coap_notifyDone(void)
+{
+    otapp_coap_notifyLock();
+    for (uint8_t i = 0; i < OTAPP_COAP_NOTIFY_QUEUE_LENGTH; i++)
+    {
+        otapp_notifySlots[i].isInCycle = 0; // posted during the cycle: still pending
+    }
+    otapp_coap_notifyUnlock();
+}
+
+int8_t otapp_coap_notifyRun(const otapp_coap_notifyJob_t *jobs, uint8_t jobsQty, uint32_t nowMs)
+{
+    oac_uri_obs_notifyItem_t items[OTAPP_COAP_NOTIFY_BATCH_MAX];
+    uint32_t lagMs;
+
+    if(otapp_notifyFn == NULL || jobs == NULL || jobsQty == 0 || jobsQty > OTAPP_COAP_NOTIFY_BATCH_MAX)
+    {
+        return OTAPP_COAP_NOTIFY_ERROR;
+    }
+
+    for (uint8_t i = 0; i < jobsQty; i++)
+    {
+        items[i].excludedIpAddr = jobs[i].isExcluded ? &jobs[i].excludedIpAddr : NULL;
+        items[i].data           = jobs[i].data;
+        items[i].dataSize       = jobs[i].dataSize;
+        items[i].uriIndex       = jobs[i].uriIndex;
+
+        lagMs = nowMs - jobs[i].postTimeMs; // wraps correctly
+        otapp_notifyStats.lagLastMs = lagMs;
+        if(lagMs > otapp_notifyStats.lagMaxMs) otapp_notifyStats.lagMaxMs = lagMs;
+        otapp_notifyStats.lagSumMs += lagMs;
+    }
+
+    otapp_notifyStats.done += jobsQty;
+    otapp_notifyStats.cycles++;
+
+    return otapp_notifyFn(items, jobsQty);
+}
+
+const otapp_coap_notifyStats_t *otapp_coap_notifyStatsGet(void)
+{
+    return &otapp_notifyStats;
+}
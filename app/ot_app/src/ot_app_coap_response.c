@@ -0,0 +1,80 @@
+/**
+ * @file ot_app_coap_response.c
+ * @author Jan Łukaszewicz (pldevluk@gmail.com)
+ * @brief pre-encoded CoAP responses
+ * @version 0.1
+ * @date 17-10-2026
+ *
+ * @copyright The MIT License (MIT) Copyright (c) 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ot_app_coap_response.h"
+#include "ot_app_coap_transport.h"
+
+// pre-encoded responses: code and payload resolved at compile time, no table scan / strlen() per request
+typedef struct {
+    otCoapCode codeGet;         // response to GET, with the payload
+    otCoapCode codePut;         // response to PUT, without payload
+    const uint8_t *payload;
+    uint16_t payloadLength;
+}otapp_coap_responseTemplate_t;
+
+#define OTAPP_COAP_RESPONSE_TEMPLATE(text)              {OT_COAP_CODE_CONTENT, OT_COAP_CODE_CHANGED, (const uint8_t *)(text), sizeof(text) - 1}
+#define OTAPP_COAP_RESPONSE_TEMPLATE_ERROR(code, text)  {(code), (code), (const uint8_t *)(text), sizeof(text) - 1}
+
+static const otapp_coap_responseTemplate_t otapp_coap_responseTemplates[] = {
+    [OTAPP_MESSAGE_OK]          = OTAPP_COAP_RESPONSE_TEMPLATE("OK"),
+    [OTAPP_MESSAGE_ERROR]       = OTAPP_COAP_RESPONSE_TEMPLATE_ERROR(OT_COAP_CODE_BAD_REQUEST, "ERROR"),
+    [OTAPP_MESSAGE_TEST]        = OTAPP_COAP_RESPONSE_TEMPLATE("Hello coap !!"),
+    [OTAPP_MESSAGE_BAD_OPTION]  = OTAPP_COAP_RESPONSE_TEMPLATE_ERROR(OT_COAP_CODE_BAD_OPTION, "BAD OPTION"),
+};
+#define OTAPP_COAP_RESPONSE_TEMPLATES_SIZE (sizeof(otapp_coap_responseTemplates) / sizeof(otapp_coap_responseTemplates[0]))
+
+int8_t otapp_coap_responseResolve(otapp_coap_messageId_t msgID, otCoapCode requestCode, otCoapType requestType, otapp_coap_response_t *responseOut)
+{
+    const otapp_coap_responseTemplate_t *responseTemplate;
+
+    if(responseOut == NULL || (uint32_t)msgID >= OTAPP_COAP_RESPONSE_TEMPLATES_SIZE)
+    {
+        return OTAPP_COAP_RESPONSE_ERROR;
+    }
+
+    responseTemplate = &otapp_coap_responseTemplates[msgID];
+    responseOut->type = otapp_coap_responseType(requestType);
+    responseOut->payload = NULL;
+    responseOut->payloadLength = 0;
+
+    if(requestCode == OT_COAP_CODE_GET)
+    {
+        responseOut->code = responseTemplate->codeGet;
+        responseOut->payload = responseTemplate->payload;
+        responseOut->payloadLength = responseTemplate->payloadLength;
+    }else if(requestCode == OT_COAP_CODE_PUT)
+    {
+        responseOut->code = responseTemplate->codePut;
+    }else
+    {
+        responseOut->code = OT_COAP_CODE_METHOD_NOT_ALLOWED; // 4.05
+    }
+    return OTAPP_COAP_RESPONSE_OK;
+}
+
+const char *otapp_coap_getMessage(otapp_coap_messageId_t msgID)
+{
+    if((uint32_t)msgID >= OTAPP_COAP_RESPONSE_TEMPLATES_SIZE)
+    {
+        return NULL;
+    }
+    return (const char *)otapp_coap_responseTemplates[msgID].payload;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file ot_app_coap_stats.c
+ * @author Jan Łukaszewicz (pldevluk@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 17-10-2026
+ *
+ * @copyright The MIT License (MIT) Copyright (c) 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ot_app_coap_stats.h"
+#include "string.h"
+
+#define OTAPP_COAP_STATS_PEER_OTHER     OTAPP_COAP_STATS_PEERS_MAX
+
+static const uint32_t otapp_statsRttLimits[OTAPP_COAP_STATS_RTT_BUCKETS - 1] = OTAPP_COAP_STATS_RTT_LIMITS_MS;
+
+static otapp_coap_statsRequest_t otapp_statsInFlight[OTAPP_COAP_STATS_INFLIGHT_MAX];
+static otapp_coap_statsPeer_t otapp_statsPeers[OTAPP_COAP_STATS_PEERS_MAX + 1]; // + other peers
+static uint32_t otapp_statsUntracked;
+
+PRIVATE uint8_t otapp_coap_statsPeerIdGet(const otIp6Address *peer_addr)
+{
+    int16_t freeId = -1;
+
+    for (uint8_t i = 0; i < OTAPP_COAP_STATS_PEERS_MAX; i++)
+    {
+        if(!otapp_statsPeers[i].isTaken)
+        {
+            if(freeId < 0) freeId = i;
+            continue;
+        }
+        if(memcmp(&otapp_statsPeers[i].peerAddr, peer_addr, sizeof(otIp6Address)) == 0)
+        {
+            return i;
+        }
+    }
+
+    if(freeId < 0)
+    {
+        otapp_statsPeers[OTAPP_COAP_STATS_PEER_OTHER].isTaken = 1; // address stays ::
+        return OTAPP_COAP_STATS_PEER_OTHER;
+    }
+
+    memcpy(&otapp_statsPeers[freeId].peerAddr, peer_addr, sizeof(otIp6Address));
+    otapp_statsPeers[freeId].rttMin  = UINT32_MAX;
+    otapp_statsPeers[freeId].isTaken = 1;
+    return (uint8_t)freeId;
+}
+
+// retransmissions before the response, RFC 7252 backoff lower bound: ACK_TIMEOUT * (2^k - 1)
+PRIVATE uint8_t otapp_coap_statsRetransmitsEstimate(uint32_t rttMs)
+{
+    uint8_t retransmits = 0;
+    uint32_t bound = OTAPP_COAP_STATS_ACK_TIMEOUT_MS;
+
+    while (retransmits < OTAPP_COAP_STATS_MAX_RETRANSMIT && rttMs >= bound)
+    {
+        retransmits++;
+        bound += (uint32_t)OTAPP_COAP_STATS_ACK_TIMEOUT_MS << retransmits;
+    }
+    return retransmits;
+}
+
+PRIVATE void otapp_coap_statsRttAdd(otapp_coap_statsPeer_t *peer, uint32_t rttMs)
+{
+    uint8_t bucket = 0;
+
+    while (bucket < OTAPP_COAP_STATS_RTT_BUCKETS - 1 && rttMs > otapp_statsRttLimits[bucket])
+    {
+        bucket++;
+    }
+    peer->rttHist[bucket]++;
+
+    if(rttMs < peer->rttMin) peer->rttMin = rttMs;
+    if(rttMs > peer->rttMax) peer->rttMax = rttMs;
+    peer->rttSum += rttMs;
+}
+
+void otapp_coap_statsInit(void)
+{
+    memset(otapp_statsInFlight, 0, sizeof(otapp_statsInFlight));
+    memset(otapp_statsPeers, 0, sizeof(otapp_statsPeers));
+    otapp_statsPeers[OTAPP_COAP_STATS_PEER_OTHER].rttMin = UINT32_MAX;
+    otapp_statsUntracked = 0;
+}
+
+otapp_coap_statsRequest_t *otapp_coap_statsRequestStart(const otIp6Address *peer_addr, const uint8_t *token, uint8_t tokenLength, otCoapResponseHandler responseHandler, void *aContext, uint32_t nowMs)
+{
+    otapp_coap_statsRequest_t *request = NULL;
+
+    if(peer_addr == NULL || token == NULL || tokenLength == 0 || tokenLength > OTAPP_COAP_STATS_TOKEN_MAX)
+    {
+        return NULL;
+    }
+
+    if(otapp_coap_statsRequestGet(token, tokenLength) != NULL) // same token twice (observe update): not tracked
+    {
+        otapp_statsUntracked++;
+        return NULL;
+    }
+
+    for (uint8_t i = 0; i < OTAPP_COAP_STATS_INFLIGHT_MAX; i++)
+    {
+        if(!otapp_statsInFlight[i].isTaken)
+        {
+            request = &otapp_statsInFlight[i];
+            break;
+        }
+    }
+
+    if(request == NULL)
+    {
+        otapp_statsUntracked++;
+        return NULL;
+    }
+
+    memcpy(request->token, token, tokenLength);
+    request->tokenLength     = tokenLength;
+    request->peerId          = otapp_coap_statsPeerIdGet(peer_addr);
+    request->sendTimeMs      = nowMs;
+    request->responseHandler = responseHandler;
+    request->aContext        = aContext;
+    request->isTaken         = 1;
+
+    otapp_statsPeers[request->peerId].sent++;
+
+    return request;
+}
+
+int8_t otapp_coap_statsRequestEnd(otapp_coap_statsRequest_t *request, otError result, uint32_t nowMs, otCoapResponseHandler *responseHandlerOut, void **aContextOut)
+{
+    otapp_coap_statsPeer_t *peer;
+    uint32_t rttMs;
+
+    if(request == NULL || request < otapp_statsInFlight || request >= &otapp_statsInFlight[OTAPP_COAP_STATS_INFLIGHT_MAX] || !request->isTaken)
+    {
+        return OTAPP_COAP_STATS_ERROR;
+    }
+
+    peer = &otapp_statsPeers[request->peerId];
+
+    if(result == OT_ERROR_NONE)
+    {
+        rttMs = nowMs - request->sendTimeMs; // wraps correctly
+        peer->completed++;
+        peer->retransmits += otapp_coap_statsRetransmitsEstimate(rttMs);
+        otapp_coap_statsRttAdd(peer, rttMs);
+    }else
+    {
+        peer->lost++;
+        peer->retransmits += OTAPP_COAP_STATS_MAX_RETRANSMIT;
+    }
+
+    if(responseHandlerOut != NULL) *responseHandlerOut = request->responseHandler;
+    if(aContextOut != NULL) *aContextOut = request->aContext;
+
+    request->isTaken = 0;
+    return OTAPP_COAP_STATS_OK;
+}
+
+void otapp_coap_statsRequestCancel(otapp_coap_statsRequest_t *request)
+{
+    if(request == NULL || !request->isTaken)
+    {
+        return;
+    }
+    otapp_statsPeers[request->peerId].sent--;
+    request->isTaken = 0;
+}
+
+const otapp_coap_statsRequest_t *otapp_coap_statsRequestGet(const uint8_t *token, uint8_t tokenLength)
+{
+    if(token == NULL)
+    {
+        return NULL;
+    }
+
+    for (uint8_t i = 0; i < OTAPP_COAP_STATS_INFLIGHT_MAX; i++)
+    {
+        if(otapp_statsInFlight[i].isTaken && otapp_statsInFlight[i].tokenLength == tokenLength &&
+           memcmp(otapp_statsInFlight[i].token, token, tokenLength) == 0)
+        {
+            return &otapp_statsInFlight[i];
+        }
+    }
+    return NULL;
+}
+
+const otapp_coap_statsPeer_t *otapp_coap_statsPeerGet(uint8_t peerId)
+{
+    if(peerId > OTAPP_COAP_STATS_PEER_OTHER || !otapp_statsPeers[peerId].isTaken)
+    {
+        return NULL;
+    }
+    return &otapp_statsPeers[peerId];
+}
+
+uint16_t otapp_coap_statsLossPermille(const otapp_coap_statsPeer_t *peer)
+{
+    uint32_t finished;
+
+    if(peer == NULL)
+    {
+        return 0;
+    }
+
+    finished = peer->completed + peer->lost;
+    if(finished == 0)
+    {
+        return 0;
+    }
+    return (uint16_t)(((uint64_t)peer->lost * 1000u) / finished);
+}
+
+uint8_t otapp_coap_statsInFlightGet(void)
+{
+    uint8_t inFlight = 0;
+
+    for (uint8_t i = 0; i < OTAPP_COAP_STATS_INFLIGHT_MAX; i++)
+    {
+        inFlight += otapp_statsInFlight[i].isTaken;
+    }
+    return inFlight;
+}
+
+uint32_t otapp_coap_statsUntrackedGet(void)
+{
+    return otapp_statsUntracked;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file ot_app_coap_transport.c
+ * @author Jan Łukaszewicz (pldevluk@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 17-10-2026
+ *
+ * @copyright The MIT License (MIT) Copyright (c) 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ot_app_coap_transport.h"
+
+otapp_coap_transport_t otapp_coap_nonStreamNext(otapp_coap_nonStream_t *stream)
+{
+    if(stream == NULL)
+    {
+        return OTAPP_COAP_TRANSPORT_CON;
+    }
+
+    stream->nonSent++;
+    if(stream->nonSent >= OTAPP_COAP_NON_CHECKPOINT_INTERVAL) // checkpoint
+    {
+        stream->nonSent = 0;
+        return OTAPP_COAP_TRANSPORT_CON;
+    }
+    return OTAPP_COAP_TRANSPORT_NON;
+}
+
+uint8_t otapp_coap_nonStreamStop(otapp_coap_nonStream_t *stream)
+{
+    uint8_t lastWasNon;
+
+    if(stream == NULL)
+    {
+        return 0;
+    }
+
+    // nonSent == 0: nic nie wyslano albo ostatni byl checkpoint CON
+    lastWasNon = (stream->nonSent != 0);
+    stream->nonSent = 0;
+    return lastWasNon;
+}
+
+otCoapType otapp_coap_transportType(otapp_coap_transport_t transport)
+{
+    return (transport == OTAPP_COAP_TRANSPORT_NON) ? OT_COAP_TYPE_NON_CONFIRMABLE : OT_COAP_TYPE_CONFIRMABLE;
+}
+
+otCoapType otapp_coap_responseType(otCoapType requestType)
+{
+    return (requestType == OT_COAP_TYPE_NON_CONFIRMABLE) ? OT_COAP_TYPE_NON_CONFIRMABLE : OT_COAP_TYPE_ACKNOWLEDGMENT;
+}
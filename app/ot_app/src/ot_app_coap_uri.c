@@ -28,11 +28,14 @@
 #include "ot_app_pair.h"
 #include "ot_app_drv.h"
 #include "ot_app_buffer.h"
+#include "ot_app_coap_stats.h"
+#include "ot_app_coap_notify.h"
 
 #include <openthread/coap.h>
 #include <openthread/instance.h>
 #include <openthread/message.h>
 #include <string.h>
+#include <stdio.h>
 
 #define TAG "ot_app_coap_uri "
 
@@ -44,7 +47,7 @@ void otapp_coap_uri_testHandle(void *aContext, otMessage *request, const otMessa
     if (request)
     {
 
-        otapp_coap_sendResponse(request, aMessageInfo, (uint8_t*) otapp_coap_getMessage(OTAPP_MESSAGE_TEST), strlen(otapp_coap_getMessage(OTAPP_MESSAGE_TEST)));
+        otapp_coap_sendResponseMessage(request, aMessageInfo, OTAPP_MESSAGE_TEST);
     }
 }
 
@@ -89,14 +92,18 @@ void otapp_coap_uri_paringServicesHandle(void *aContext, otMessage *request, con
 
 void ad_temp_uri_well_knownCoreHandle(void *aContext, otMessage *request, const otMessageInfo *aMessageInfo)
 {
-    int8_t result = 0;
     ot_app_devDrv_t *devDrv_ = otapp_getDevDrvInstance();
 
     otapp_coap_uri_t *urisList = NULL;    
     ot_app_size_t uriListSize = 0;
 
-    uint8_t *buffer = NULL;
-    uint16_t bufferSize = 0;
+    otMessage *response = NULL;
+    otapp_coap_block_t blockRequest;
+    otapp_coap_block_t block;
+    uint16_t totalSize = 0;
+    uint16_t blockOffset = 0;
+    uint16_t blockSize = 0;
+    int8_t result;
     
     if (request && devDrv_)
     {
@@ -105,77 +112,191 @@ void ad_temp_uri_well_knownCoreHandle(void *aContext, otMessage *request, const
         uriListSize = devDrv_->uriGetListSize;
         if(urisList == NULL || uriListSize == 0) return;
 
-        // Acquire access to the thread-safe global buffer
-        bufferSize = otapp_pair_uriResourcesCalculateBufSize(urisList, uriListSize);
-        buffer = otapp_buf_getWriteOnly_ptr(OTAPP_BUF_KEY_1, bufferSize);
-        if(buffer == NULL || bufferSize == 0) 
+        // size pass: nothing appended, the block depends on the whole TLV size
+        if(otapp_pair_uriResourcesAppendWindow(urisList, uriListSize, NULL, 0, 0, &totalSize) != OTAPP_PAIR_OK)
         {
-            otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
-            OTAPP_PRINTF(TAG, "ERROR well-known/core: buffer = NULL"); 
+            OTAPP_PRINTF(TAG, "ERROR well-known/core: uriResourcesAppend \n");
             return;
-        }         
+        }
 
-        // Serialize URI data into TLV format
-        result = otapp_pair_uriResourcesCreate(urisList, uriListSize, buffer, &bufferSize);
-        if(result == OTAPP_PAIR_OK)
+        result = otapp_coap_block2Get(request, &blockRequest);
+        if(result != OTAPP_COAP_BLOCK_ERROR)
         {
-            // Send the populated TLV buffer as a CoAP response
-            otapp_coap_sendResponse(request, aMessageInfo, buffer, bufferSize);
-            OTAPP_PRINTF(TAG, "well-known/core: sent resources size: %d\n", bufferSize);
-        }else
+            result = otapp_coap_block2Window((result == OTAPP_COAP_BLOCK_OK) ? &blockRequest : NULL, totalSize, &block, &blockOffset, &blockSize);
+        }
+        if(result == OTAPP_COAP_BLOCK_ERROR) // malformed option or block behind the list
+        {
+            otapp_coap_sendResponseMessage(request, aMessageInfo, OTAPP_MESSAGE_BAD_OPTION); // 4.02
+            OTAPP_PRINTF(TAG, "ERROR well-known/core: Block2 \n");
+            return;
+        }
+
+        response = otapp_coap_responseNewBlock2(request, (result == OTAPP_COAP_BLOCK_OK) ? &block : NULL);
+        if(response == NULL) 
         {
-            OTAPP_PRINTF(TAG, "ERROR well-known/core: uriResourcesCreate \n");
+            OTAPP_PRINTF(TAG, "ERROR well-known/core: response = NULL"); 
+            return;
         }
 
-        // unlock the buffer
-        otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
+        // Serialize URI data into TLV format directly after the payload marker, only bytes of this block
+        if(otapp_pair_uriResourcesAppendWindow(urisList, uriListSize, response, blockOffset, blockSize, &totalSize) == OTAPP_PAIR_OK)
+        {
+            otapp_coap_responseSend(response, aMessageInfo);
+            OTAPP_PRINTF(TAG, "well-known/core: sent resources %d..%d of %d\n", blockOffset, blockOffset + blockSize, totalSize);
+        }else
+        {
+            otMessageFree(response);
+            OTAPP_PRINTF(TAG, "ERROR well-known/core: uriResourcesAppend \n");
+        }
     }
 }
 
+// multicast notify carries records of all group observers, keep only own subscriptions
+static int8_t otapp_coap_uri_subscribedTokenFilter(const oacu_token_t *token)
+{
+    return (otapp_pair_tokenGetUriIteams(otapp_pair_getHandle(), token) != NULL) ? OAC_URI_OBS_IS : OAC_URI_OBS_IS_NOT;
+}
+
 void otapp_coap_uri_subscribedHandle(void *aContext, otMessage *request, const otMessageInfo *aMessageInfo)
 {
     int8_t result;
 
     ot_app_devDrv_t *drv;
     oac_uri_dataPacket_t *dataPacket;
+    int8_t packetsQty;
     uint16_t readBytes = 0;
    
     uint8_t *buffer = NULL;
     uint16_t bufferSize = 0;
+    OTAPP_BUF_SLAB_SCOPED(block); // freed on every return
 
 
     if (request)
     {
         bufferSize = otMessageGetLength(request) - otMessageGetOffset(request);
-        buffer = otapp_buf_getWriteOnly_ptr(OTAPP_BUF_KEY_1, bufferSize);
-        if(buffer == NULL || bufferSize == 0) 
+        block = otapp_buf_slabAllocTimed(bufferSize, OTAPP_BUF_ACQ_NO_CLEAR, OTAPP_BUF_SLAB_WAIT_TICKS, NULL); // fully overwritten by readPayload
+        if(block == NULL) 
         {
-            otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
             OTAPP_PRINTF(TAG, "ERROR ubscribedHandle: buffer = NULL\n"); 
             return;
         }   
+        buffer = block;
         result = otapp_coapReadPayload(request, buffer, bufferSize, &readBytes);
         if(result != OTAPP_COAP_OK || bufferSize != readBytes)
         {
-            otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
             OTAPP_PRINTF(TAG, "ERROR ubscribedHandle: readPayload\n");
             return;
         } 
         
-        otapp_coap_sendResponseOK(request, aMessageInfo);
+        if(otCoapMessageGetType(request) == OT_COAP_TYPE_CONFIRMABLE) // NON (multicast) is not acknowledged
+        {
+            otapp_coap_sendResponseOK(request, aMessageInfo);
+        }
 
         drv = otapp_getDevDrvInstance();
 
+        // one message carries all records of the notify cycle for this device (multicast: for the whole group)
         dataPacket = oac_uri_obs_getdataPacketHandle();
-        result = oac_uri_obs_parseMessageFromNotify(buffer, readBytes, dataPacket); 
-        if(result == OAC_URI_OBS_ERROR)
+        packetsQty = oac_uri_obs_parseNotify(buffer, readBytes, dataPacket, OAC_URI_OBS_NOTIFY_RECORDS_MAX, otapp_coap_uri_subscribedTokenFilter); 
+        if(packetsQty == OAC_URI_OBS_ERROR)
         {
-            otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
             OTAPP_PRINTF(TAG, "ERROR: ubscribedHandle\n");
             return;
         }
 
-        otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
-        drv->obs_subscribedUri_clb(dataPacket); // inform app device about new subscribed event.         
+        otapp_buf_slabRelease(&block);
+        for (int8_t i = 0; i < packetsQty; i++)
+        {
+            drv->obs_subscribedUri_clb(&dataPacket[i]); // inform app device about new subscribed event.         
+        }
+    }
+}
+
+#define OTAPP_COAP_URI_BUF_STATS_LINE_SIZE 64
+void otapp_coap_uri_bufStatsHandle(void *aContext, otMessage *request, const otMessageInfo *aMessageInfo)
+{
+    otapp_buf_stats_t stats;
+    otMessage *response = NULL;
+    char line[OTAPP_COAP_URI_BUF_STATS_LINE_SIZE];
+    int written = 0;
+
+    if (request)
+    {
+        response = otapp_coap_responseNew(request);
+        if(response == NULL)
+        {
+            OTAPP_PRINTF(TAG, "ERROR bufStats: response = NULL\n"); 
+            return;
+        }
+
+        // one text line per slot: key:peak/max acq contended overflow busy, appended straight to the response
+        for (uint8_t slot = 0; slot < OTAPP_BUF_SLOTS_QTY; slot++)
+        {
+            if(otapp_buf_slot_getStats((otapp_buf_slot_t)slot, &stats) != OTAPP_BUF_OK) continue;
+
+            written = snprintf(line, sizeof(line), "%04x:%u/%u a=%lu c=%lu o=%lu b=%lu\n",
+                                (unsigned)stats.key, (unsigned)stats.peak_len, (unsigned)stats.max_size,
+                                (unsigned long)stats.acquire_cnt, (unsigned long)stats.contended_cnt,
+                                (unsigned long)stats.overflow_cnt, (unsigned long)stats.busy_reject_cnt);
+            if(written < 0 || written >= (int)sizeof(line)) continue; // truncated line is dropped
+            if(otMessageAppend(response, line, (uint16_t)written) != OT_ERROR_NONE) break;
+        }
+
+        otapp_coap_responseSend(response, aMessageInfo);
+    }
+}
+
+#define OTAPP_COAP_URI_COAP_STATS_LINE_SIZE 160
+void otapp_coap_uri_coapStatsHandle(void *aContext, otMessage *request, const otMessageInfo *aMessageInfo)
+{
+    const otapp_coap_statsPeer_t *peer;
+    const otapp_coap_notifyStats_t *notify;
+    const uint8_t *iid;
+    otMessage *response = NULL;
+    char line[OTAPP_COAP_URI_COAP_STATS_LINE_SIZE];
+    int written = 0;
+
+    if (request)
+    {
+        response = otapp_coap_responseNew(request);
+        if(response == NULL)
+        {
+            OTAPP_PRINTF(TAG, "ERROR coapStats: response = NULL\n"); 
+            return;
+        }
+
+        // lines appended straight to the response, no scratch block for the whole table
+        written = snprintf(line, sizeof(line), "inflight=%u untracked=%lu\n", (unsigned)otapp_coap_statsInFlightGet(), (unsigned long)otapp_coap_statsUntrackedGet());
+        if(written > 0) otMessageAppend(response, line, (uint16_t)written);
+
+        notify  = otapp_coap_notifyStatsGet();
+        written = snprintf(line, sizeof(line), "notify posted=%lu merged=%lu overflow=%lu depth=%u/%u lag=%lu/%lu/%lu\n",
+                            (unsigned long)notify->posted, (unsigned long)notify->merged, (unsigned long)notify->overflow,
+                            (unsigned)notify->depth, (unsigned)notify->depthMax,
+                            (unsigned long)notify->lagLastMs,
+                            (unsigned long)(notify->done ? notify->lagSumMs / notify->done : 0),
+                            (unsigned long)notify->lagMaxMs);
+        if(written > 0 && written < (int)sizeof(line)) otMessageAppend(response, line, (uint16_t)written);
+
+        for (uint8_t peerId = 0; peerId <= OTAPP_COAP_STATS_PEERS_MAX; peerId++)
+        {
+            peer = otapp_coap_statsPeerGet(peerId);
+            if(peer == NULL) continue;
+
+            iid = &peer->peerAddr.mFields.m8[8];
+            written = snprintf(line, sizeof(line), "%02x%02x:%02x%02x:%02x%02x:%02x%02x n=%lu ok=%lu lost=%lu loss=%u rtx=%lu rtt=%lu/%lu/%lu h=%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n",
+                                iid[0], iid[1], iid[2], iid[3], iid[4], iid[5], iid[6], iid[7],
+                                (unsigned long)peer->sent, (unsigned long)peer->completed, (unsigned long)peer->lost,
+                                (unsigned)otapp_coap_statsLossPermille(peer), (unsigned long)peer->retransmits,
+                                (unsigned long)(peer->completed ? peer->rttMin : 0),
+                                (unsigned long)(peer->completed ? peer->rttSum / peer->completed : 0),
+                                (unsigned long)peer->rttMax,
+                                (unsigned long)peer->rttHist[0], (unsigned long)peer->rttHist[1], (unsigned long)peer->rttHist[2], (unsigned long)peer->rttHist[3],
+                                (unsigned long)peer->rttHist[4], (unsigned long)peer->rttHist[5], (unsigned long)peer->rttHist[6], (unsigned long)peer->rttHist[7]);
+            if(written < 0 || written >= (int)sizeof(line)) continue; // truncated line is dropped
+            if(otMessageAppend(response, line, (uint16_t)written) != OT_ERROR_NONE) break;
+        }
+
+        otapp_coap_responseSend(response, aMessageInfo);
     }
 }
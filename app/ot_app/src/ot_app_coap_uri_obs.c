@@ -23,9 +23,58 @@
 #include "ot_app_coap_uri_obs.h"
 #include "string.h"
 
+#ifdef UNIT_TEST
+    #ifdef TEST_PTHREAD
+        #include "mock_freertos_semaphore_pthread.h"
+    #else
+        #include "mock_freertos_semaphore.h"
+    #endif
+#else
+    #include "ot_app_port_rtos.h"
+#endif
+
 static oac_uri_observer_t oac_obsSubList[OAC_URI_OBS_SUBSCRIBERS_MAX_NUM];
-static oac_uri_dataPacket_t oac_dataPacket;
+static oac_uri_dataPacket_t oac_dataPacket[OAC_URI_OBS_NOTIFY_RECORDS_MAX];
 static uint8_t oac_txRxBuffer[OAC_URI_OBS_TX_BUFFER_SIZE]; // todo replace ot_app_buffer.h
+static oac_uri_obs_notifyMode_t oac_notifyMode = OAC_URI_OBS_NOTIFY_MULTICAST ? OAC_URI_OBS_NOTIFY_MODE_MULTICAST : OAC_URI_OBS_NOTIFY_MODE_UNICAST;
+static otIp6Address oac_notifyGroupAddr = {.mFields.m8 = {0xff, 0x03, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01}}; // realm-local all nodes, as otapp_multicastAddressGet()
+static SemaphoreHandle_t oac_obsMutex = NULL; // subscriber list and oac_txRxBuffer: OT tasklet (subscribe, notify) vs other tasks
+
+// notify cycle of oac_uri_obs_notifyBatch(): copy of the list, sent without oac_obsMutex
+static oac_uri_observer_t oac_obsSnapList[OAC_URI_OBS_SUBSCRIBERS_MAX_NUM];
+static otIp6Address oac_snapGroupAddr;
+static uint8_t oac_snapTxBuffer[OAC_URI_OBS_TX_BUFFER_SIZE];
+static SemaphoreHandle_t oac_snapMutex = NULL;
+
+// NULL (oac_uri_obs_init() not called): no locking, single task use
+PRIVATE void oac_uri_obs_lock(SemaphoreHandle_t mutex)
+{
+    if(mutex != NULL)
+    {
+        xSemaphoreTake(mutex, portMAX_DELAY);
+    }
+}
+
+PRIVATE void oac_uri_obs_unlock(SemaphoreHandle_t mutex)
+{
+    if(mutex != NULL)
+    {
+        xSemaphoreGive(mutex);
+    }
+}
+
+int8_t oac_uri_obs_init(void)
+{
+    if(oac_obsMutex == NULL)
+    {
+        oac_obsMutex = xSemaphoreCreateMutex();
+    }
+    if(oac_snapMutex == NULL)
+    {
+        oac_snapMutex = xSemaphoreCreateMutex();
+    }
+    return (oac_obsMutex != NULL && oac_snapMutex != NULL) ? OAC_URI_OBS_OK : OAC_URI_OBS_ERROR;
+}
 
 ///////////////////////
 // fn for devName
@@ -308,7 +357,7 @@ oac_uri_observer_t *oac_uri_obs_getSubListHandle()
 
 oac_uri_dataPacket_t *oac_uri_obs_getdataPacketHandle()
 {
-    return &oac_dataPacket;
+    return oac_dataPacket;
 }
 
 PRIVATE int8_t oac_uri_obs_checkTableIsInit(const uint8_t *tabPtr, uint16_t tabSize)
@@ -418,7 +467,7 @@ PRIVATE int8_t oac_uri_obs_subscribeIsValidData(oac_uri_observer_t *subListHandl
 }
 
 // updateState 
-int8_t oac_uri_obs_subscribe(oac_uri_observer_t *subListHandle, const oacu_token_t *token, oacu_uriIndex_t uriIndex, const otIp6Address *ipAddr, const char* deviceNameFull)
+PRIVATE int8_t oac_uri_obs_subscribeLocked(oac_uri_observer_t *subListHandle, const oacu_token_t *token, oacu_uriIndex_t uriIndex, const otIp6Address *ipAddr, const char* deviceNameFull)
 {
     oacu_result_t result_ = 0;
     int8_t updateState = 0;
@@ -501,6 +550,16 @@ int8_t oac_uri_obs_subscribe(oac_uri_observer_t *subListHandle, const oacu_token
     return OAC_URI_OBS_ADDED_NEW_DEVICE;
 }
 
+int8_t oac_uri_obs_subscribe(oac_uri_observer_t *subListHandle, const oacu_token_t *token, oacu_uriIndex_t uriIndex, const otIp6Address *ipAddr, const char* deviceNameFull)
+{
+    int8_t result;
+
+    oac_uri_obs_lock(oac_obsMutex);
+    result = oac_uri_obs_subscribeLocked(subListHandle, token, uriIndex, ipAddr, deviceNameFull);
+    oac_uri_obs_unlock(oac_obsMutex);
+    return result;
+}
+
 int8_t oac_uri_obs_subscribeFromUri(oac_uri_observer_t *subListHandle, otMessage *aMessage, const otMessageInfo *aMessageInfo, oacu_uriIndex_t uriId, char* deviceNameFull)
 {
     int8_t result = 0;
@@ -542,7 +601,7 @@ int8_t oac_uri_obs_subscribeFromUri(oac_uri_observer_t *subListHandle, otMessage
 }
 
 
-int8_t oac_uri_obs_unsubscribe(oac_uri_observer_t *subListHandle, char* deviceNameFull, const oacu_token_t *token)
+PRIVATE int8_t oac_uri_obs_unsubscribeLocked(oac_uri_observer_t *subListHandle, char* deviceNameFull, const oacu_token_t *token)
 {
     int8_t tabDevId_ = 0;
     int8_t tabUriId_ = 0;
@@ -596,65 +655,255 @@ int8_t oac_uri_obs_unsubscribe(oac_uri_observer_t *subListHandle, char* deviceNa
     return OAC_URI_OBS_TOKEN_NOT_EXIST;
 }
 
-int8_t oac_uri_obs_notify(oac_uri_observer_t *subListHandle, const otIp6Address *excludedIpAddr, oacu_uriIndex_t uriIndex, const uint8_t *dataToNotify, uint16_t dataSize)
+int8_t oac_uri_obs_unsubscribe(oac_uri_observer_t *subListHandle, char* deviceNameFull, const oacu_token_t *token)
 {
+    int8_t result;
 
-    uint16_t numOfnotifications = 0;
-    uint16_t dataSendSize = 0;
-    if(subListHandle == NULL || dataToNotify == NULL || uriIndex == 0)
+    oac_uri_obs_lock(oac_obsMutex);
+    result = oac_uri_obs_unsubscribeLocked(subListHandle, deviceNameFull, token);
+    oac_uri_obs_unlock(oac_obsMutex);
+    return result;
+}
+
+// jedna wiadomosc subscribed_uris w budowie
+typedef struct {
+    otapp_msg_tlv_builder_t builder;
+    uint8_t *buf;           // OAC_URI_OBS_TX_BUFFER_SIZE
+    const otIp6Address *dstAddr;
+    uint8_t recordsQty;
+    uint8_t recordsMax;     // unicast: odbiorca ma miejsce na OAC_URI_OBS_NOTIFY_RECORDS_MAX, multicast: tylko rozmiar bufora
+    uint8_t multicast;
+} oac_uri_obs_tx_t;
+
+PRIVATE void oac_uri_obs_txFlush(oac_uri_obs_tx_t *tx)
+{
+    uint16_t usedBytes = 0;
+
+    if(tx->recordsQty == 0 || otapp_msg_tlv_getBufferTotalUsedSpace(tx->buf + OAC_URI_OBS_NOTIFY_FORMAT_SIZE, OAC_URI_OBS_TX_BUFFER_SIZE - OAC_URI_OBS_NOTIFY_FORMAT_SIZE, &usedBytes) != OT_APP_MSG_TLV_OK)
     {
-        return OAC_URI_OBS_ERROR;
+        return;
     }
+    usedBytes += OAC_URI_OBS_NOTIFY_FORMAT_SIZE;
 
-    if(dataSize > OAC_URI_OBS_BUFFER_SIZE)
+    if(tx->multicast)
     {
-        return OAC_URI_OBS_ERROR;
+        otapp_coapSendPutUri_subscribed_urisMulticast(tx->dstAddr, tx->buf, usedBytes);
+    }else
+    {
+        otapp_coapSendPutUri_subscribed_uris(tx->dstAddr, tx->buf, usedBytes);
     }
+    tx->recordsQty = 0;
+}
 
-    for(uint8_t i = 0; i < OAC_URI_OBS_SUBSCRIBERS_MAX_NUM; i++)
+// record: token | data
+PRIVATE int8_t oac_uri_obs_txRecordAdd(oac_uri_obs_tx_t *tx, const oacu_token_t *token, const uint8_t *data, uint16_t dataSize)
+{
+    uint8_t record[OAC_URI_OBS_NOTIFY_RECORD_SIZE];
+    int8_t result;
+
+    memcpy(record, token, OAC_URI_OBS_TOKEN_LENGTH);
+    memcpy(record + OAC_URI_OBS_TOKEN_LENGTH, data, dataSize);
+
+    for (uint8_t attempt = 0; attempt < 2; attempt++)
     {
-       if(oac_uri_obs_spaceDevNameIsTaken(subListHandle, i))
-       {
+        if(tx->recordsQty == 0) // new message
+        {
+            memset(tx->buf, 0, OAC_URI_OBS_TX_BUFFER_SIZE);
+            tx->buf[0] = OAC_URI_OBS_NOTIFY_FORMAT_VERSION;
+            otapp_msg_tlv_builderInit(&tx->builder, tx->buf + OAC_URI_OBS_NOTIFY_FORMAT_SIZE, OAC_URI_OBS_TX_BUFFER_SIZE - OAC_URI_OBS_NOTIFY_FORMAT_SIZE, OT_APP_MSG_TLV_BUILDER_TRUSTED);
+        }
+
+        result = otapp_msg_tlv_builderAdd(&tx->builder, OAC_URI_OBS_NOTIFY_KEY_PATTERN + tx->recordsQty, OAC_URI_OBS_TOKEN_LENGTH + dataSize, record);
+        if(result == OT_APP_MSG_TLV_OK)
+        {
+            tx->recordsQty++;
+            if(tx->recordsQty >= tx->recordsMax)
+            {
+                oac_uri_obs_txFlush(tx);
+            }
+            return OAC_URI_OBS_OK;
+        }
+
+        if(result != OT_APP_MSG_TLV_ERROR_NO_SPACE || tx->recordsQty == 0)
+        {
+            break;
+        }
+        oac_uri_obs_txFlush(tx); // bufor pelny: wyslij i zacznij nowa wiadomosc
+    }
+
+    return OAC_URI_OBS_ERROR;
+}
+
+// wszystkie rekordy dla adresu IP wpisu tabDevId: kolejne wpisy listy z tym samym adresem tez
+// tx == NULL: tylko policz rekordy
+PRIVATE uint16_t oac_uri_obs_notifyDestination(oac_uri_observer_t *subListHandle, int8_t tabDevId, const oac_uri_obs_notifyItem_t *items, uint8_t itemsQty, oac_uri_obs_tx_t *tx)
+{
+    const otIp6Address *ipAddr = &subListHandle[tabDevId].ipAddr;
+    uint16_t numOfnotifications = 0;
+
+    for(int8_t i = tabDevId; i < OAC_URI_OBS_SUBSCRIBERS_MAX_NUM; i++)
+    {
+        if(!oac_uri_obs_spaceDevNameIsTaken(subListHandle, i) || oac_uri_obs_ipAddrIsSame(subListHandle, i, ipAddr) != OAC_URI_OBS_IS)
+        {
+            continue;
+        }
+
+        for(uint8_t n = 0; n < itemsQty; n++)
+        {
+            // checking whether the current IP ADDR is not same as the excluded one
+            if(items[n].excludedIpAddr != NULL && oac_uri_obs_ipAddrIsSame(subListHandle, i, items[n].excludedIpAddr) == OAC_URI_OBS_IS)
+            {
+                continue;
+            }
+
             for(uint8_t j = 0; j < OAC_URI_OBS_PAIRED_URI_MAX; j++)
             {
-                if(oac_uri_obs_spaceUriIsTaken(subListHandle, i, j))
+                if(!oac_uri_obs_spaceUriIsTaken(subListHandle, i, j) || subListHandle[i].uri[j].uriIndex != items[n].uriIndex)
+                {
+                    continue;
+                }
+
+                if(tx == NULL || oac_uri_obs_txRecordAdd(tx, subListHandle[i].uri[j].token, items[n].data, items[n].dataSize) == OAC_URI_OBS_OK)
                 {
-                    if(subListHandle[i].uri[j].uriIndex == uriIndex)
-                    {
-                        if(excludedIpAddr != NULL) // there is nothing to exclude
-                        {
-                            // checking whether the current IP ADDR index is not same as te exclude one
-                            if(oac_uri_obs_ipAddrIsSame(subListHandle, i, excludedIpAddr) == OAC_URI_OBS_IS)
-                            {
-                                continue;
-                            }
-                        }
-                                                
-                        // clear tx buffer
-                        memset(oac_txRxBuffer, 0, sizeof(oac_txRxBuffer)); 
-
-                        // copy token to tx buffer
-                        memcpy(oac_txRxBuffer, subListHandle[i].uri[j].token, OAC_URI_OBS_TOKEN_LENGTH);
-                        dataSendSize = OAC_URI_OBS_TOKEN_LENGTH;
-
-                        // increase tx buffer ptr about token lenght
-                        // copy dataToNotify to tx buffer 
-                        memcpy(oac_txRxBuffer + OAC_URI_OBS_TOKEN_LENGTH, dataToNotify, dataSize);
-                        dataSendSize += dataSize;
-                        // send data to subscriber
-                        otapp_coapSendPutUri_subscribed_uris(&subListHandle[i].ipAddr, oac_txRxBuffer, dataSendSize);
-                        numOfnotifications++;
-                        
-                    }
+                    numOfnotifications++;
                 }
             }
-            
-       }
+        }
     }
-        
+
     return numOfnotifications;
 }
 
+PRIVATE int8_t oac_uri_obs_ipAddrIsFirst(oac_uri_observer_t *subListHandle, int8_t tabDevId)
+{
+    for(int8_t k = 0; k < tabDevId; k++)
+    {
+        if(oac_uri_obs_spaceDevNameIsTaken(subListHandle, k) && oac_uri_obs_ipAddrIsSame(subListHandle, k, &subListHandle[tabDevId].ipAddr) == OAC_URI_OBS_IS)
+        {
+            return OAC_URI_OBS_IS_NOT; // adres obsluzony juz przy wczesniejszym wpisie
+        }
+    }
+    return OAC_URI_OBS_IS;
+}
+
+void oac_uri_obs_notifyModeSet(oac_uri_obs_notifyMode_t mode, const otIp6Address *groupAddr)
+{
+    oac_uri_obs_lock(oac_obsMutex);
+    oac_notifyMode = mode;
+    if(groupAddr != NULL)
+    {
+        memcpy(&oac_notifyGroupAddr, groupAddr, sizeof(oac_notifyGroupAddr));
+    }
+    oac_uri_obs_unlock(oac_obsMutex);
+}
+
+// one notify cycle over subListHandle, messages built in txBuf
+PRIVATE int8_t oac_uri_obs_notifyBatchOn(oac_uri_observer_t *subListHandle, const oac_uri_obs_notifyItem_t *items, uint8_t itemsQty, uint8_t *txBuf, oac_uri_obs_notifyMode_t mode, const otIp6Address *groupAddr)
+{
+    uint16_t numOfnotifications = 0;
+    uint8_t destinations = 0;
+    oac_uri_obs_tx_t tx;
+
+    if(subListHandle == NULL || items == NULL || itemsQty == 0)
+    {
+        return OAC_URI_OBS_ERROR;
+    }
+
+    for(uint8_t n = 0; n < itemsQty; n++)
+    {
+        if(items[n].data == NULL || items[n].uriIndex == 0 || items[n].dataSize > OAC_URI_OBS_BUFFER_SIZE)
+        {
+            return OAC_URI_OBS_ERROR;
+        }
+    }
+
+    memset(&tx, 0, sizeof(tx));
+    tx.buf        = txBuf;
+    tx.recordsMax = OAC_URI_OBS_NOTIFY_RECORDS_MAX;
+
+    if(mode == OAC_URI_OBS_NOTIFY_MODE_MULTICAST)
+    {
+        for(int8_t i = 0; i < OAC_URI_OBS_SUBSCRIBERS_MAX_NUM; i++)
+        {
+            if(oac_uri_obs_spaceDevNameIsTaken(subListHandle, i) && oac_uri_obs_ipAddrIsFirst(subListHandle, i) == OAC_URI_OBS_IS &&
+               oac_uri_obs_notifyDestination(subListHandle, i, items, itemsQty, NULL) > 0)
+            {
+                destinations++;
+            }
+        }
+
+        // jedna wiadomosc do grupy, odbiorcy filtruja rekordy po swoich tokenach
+        if(destinations >= OAC_URI_OBS_NOTIFY_MULTICAST_MIN)
+        {
+            tx.dstAddr    = groupAddr;
+            tx.recordsMax = UINT8_MAX;
+            tx.multicast  = 1;
+        }
+    }
+
+    for(int8_t i = 0; i < OAC_URI_OBS_SUBSCRIBERS_MAX_NUM; i++)
+    {
+        if(!oac_uri_obs_spaceDevNameIsTaken(subListHandle, i) || oac_uri_obs_ipAddrIsFirst(subListHandle, i) != OAC_URI_OBS_IS)
+        {
+            continue;
+        }
+
+        if(!tx.multicast)
+        {
+            tx.dstAddr = &subListHandle[i].ipAddr;
+        }
+        numOfnotifications += oac_uri_obs_notifyDestination(subListHandle, i, items, itemsQty, &tx);
+
+        if(!tx.multicast)
+        {
+            oac_uri_obs_txFlush(&tx);
+        }
+    }
+    oac_uri_obs_txFlush(&tx);
+
+    return (numOfnotifications > INT8_MAX) ? INT8_MAX : (int8_t)numOfnotifications;
+}
+
+int8_t oac_uri_obs_notifyBatch(oac_uri_observer_t *subListHandle, const oac_uri_obs_notifyItem_t *items, uint8_t itemsQty)
+{
+    oac_uri_obs_notifyMode_t mode;
+    int8_t result;
+
+    if(subListHandle == NULL)
+    {
+        return OAC_URI_OBS_ERROR;
+    }
+
+    // copy under the list mutex, sends without it: subscribe in the tasklet does not wait for the fan-out
+    oac_uri_obs_lock(oac_snapMutex);
+    oac_uri_obs_lock(oac_obsMutex);
+    memcpy(oac_obsSnapList, subListHandle, sizeof(oac_obsSnapList));
+    memcpy(&oac_snapGroupAddr, &oac_notifyGroupAddr, sizeof(oac_snapGroupAddr));
+    mode = oac_notifyMode;
+    oac_uri_obs_unlock(oac_obsMutex);
+
+    result = oac_uri_obs_notifyBatchOn(oac_obsSnapList, items, itemsQty, oac_snapTxBuffer, mode, &oac_snapGroupAddr);
+    oac_uri_obs_unlock(oac_snapMutex);
+    return result;
+}
+
+int8_t oac_uri_obs_notify(oac_uri_observer_t *subListHandle, const otIp6Address *excludedIpAddr, oacu_uriIndex_t uriIndex, const uint8_t *dataToNotify, uint16_t dataSize)
+{
+    const oac_uri_obs_notifyItem_t item = {
+        .excludedIpAddr = excludedIpAddr,
+        .data           = dataToNotify,
+        .dataSize       = dataSize,
+        .uriIndex       = uriIndex,
+    };
+    int8_t result;
+
+    // live list, sends under the list mutex: lock order OpenThread lock -> list mutex, only the tasklet
+    oac_uri_obs_lock(oac_obsMutex);
+    result = oac_uri_obs_notifyBatchOn(subListHandle, &item, 1, oac_txRxBuffer, oac_notifyMode, &oac_notifyGroupAddr);
+    oac_uri_obs_unlock(oac_obsMutex);
+    return result;
+}
+
 int8_t oac_uri_obs_parseMessageFromNotify(const uint8_t *inBuffer, const uint16_t dataSize, oac_uri_dataPacket_t *out)
 {
     if(inBuffer == NULL || out == NULL || dataSize == 0 || dataSize <= OAC_URI_OBS_TOKEN_LENGTH)
@@ -674,6 +923,54 @@ int8_t oac_uri_obs_parseMessageFromNotify(const uint8_t *inBuffer, const uint16_
     return OAC_URI_OBS_OK;
 }
 
+int8_t oac_uri_obs_parseNotify(const uint8_t *inBuffer, const uint16_t dataSize, oac_uri_dataPacket_t *packetsOut, uint8_t packetsMax, oac_uri_obs_tokenFilter_t tokenFilter)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+    int8_t result;
+    uint8_t packetsQty = 0;
+    uint16_t recordsQty = 0;
+
+    if(inBuffer == NULL || packetsOut == NULL || packetsMax == 0)
+    {
+        return OAC_URI_OBS_ERROR;
+    }
+
+    // inny uklad (np. stary pojedynczy rekord token | data) jest odrzucany, nie parsowany jako TLV
+    if(dataSize <= OAC_URI_OBS_NOTIFY_FORMAT_SIZE || inBuffer[0] != OAC_URI_OBS_NOTIFY_FORMAT_VERSION)
+    {
+        return OAC_URI_OBS_ERROR;
+    }
+
+    result = otapp_msg_tlv_iterFirst(&iter, inBuffer + OAC_URI_OBS_NOTIFY_FORMAT_SIZE, dataSize - OAC_URI_OBS_NOTIFY_FORMAT_SIZE, &item);
+    while (result == OT_APP_MSG_TLV_OK)
+    {
+        if(item.length <= OAC_URI_OBS_TOKEN_LENGTH || item.length > OAC_URI_OBS_NOTIFY_RECORD_SIZE)
+        {
+            return OAC_URI_OBS_ERROR;
+        }
+
+        // multicast: rekordy innych odbiorcow sa pomijane
+        if(tokenFilter == NULL || tokenFilter(item.value) == OAC_URI_OBS_IS)
+        {
+            if(packetsQty >= packetsMax || oac_uri_obs_parseMessageFromNotify(item.value, item.length, &packetsOut[packetsQty]) != OAC_URI_OBS_OK)
+            {
+                return OAC_URI_OBS_ERROR;
+            }
+            packetsQty++;
+        }
+        recordsQty++;
+        result = otapp_msg_tlv_iterNext(&iter, &item);
+    }
+
+    if(result != OT_APP_MSG_TLV_END || recordsQty == 0)
+    {
+        return OAC_URI_OBS_ERROR;
+    }
+
+    return packetsQty;
+}
+
 int8_t oac_uri_obs_sendSubscribeRequestUpdate(const otIp6Address *ipAddr, const char *aUriPath, uint8_t *tokenIn)
 {
     otapp_coapSendSubscribeRequestUpdate(ipAddr, aUriPath, tokenIn);
@@ -685,7 +982,7 @@ int8_t oac_uri_obs_sendSubscribeRequest(const otIp6Address *ipAddr, const char *
     return OAC_URI_OBS_OK;
 }
 
-int8_t oac_uri_obs_deleteAll(oac_uri_observer_t *subListHandle)
+PRIVATE int8_t oac_uri_obs_deleteAllLocked(oac_uri_observer_t *subListHandle)
 {
     if(subListHandle == NULL)
     {
@@ -700,6 +997,16 @@ int8_t oac_uri_obs_deleteAll(oac_uri_observer_t *subListHandle)
     return OAC_URI_OBS_OK;
 }
 
+int8_t oac_uri_obs_deleteAll(oac_uri_observer_t *subListHandle)
+{
+    int8_t result;
+
+    oac_uri_obs_lock(oac_obsMutex);
+    result = oac_uri_obs_deleteAllLocked(subListHandle);
+    oac_uri_obs_unlock(oac_obsMutex);
+    return result;
+}
+
 
 
 #ifdef UNIT_TEST
@@ -264,4 +264,36 @@ int8_t otapp_deviceNameIsMatching(const char *deviceFullName)
     }
 
     return OTAPP_DEVICENAME_IS_NOT;
-}
\ No newline at end of file
+}
+
+int8_t otapp_deviceNameGroupAddressGet(const char *deviceNameFull, otIp6Address *addrOut)
+{
+    static const uint8_t prefix[] = OTAPP_DEVICENAME_GROUP_ADDR_PREFIX;
+    uint32_t hash = 2166136261u; // FNV-1a 32
+    uint8_t i;
+
+    if(deviceNameFull == NULL || addrOut == NULL)
+    {
+        return OTAPP_DEVICENAME_ERROR;
+    }
+
+    // GroupName: do pierwszego '_'
+    for (i = 0; deviceNameFull[i] != '\0' && deviceNameFull[i] != '_' && i < OTAPP_DEVICENAME_SIZE; i++)
+    {
+        hash ^= (uint8_t)deviceNameFull[i];
+        hash *= 16777619u;
+    }
+
+    if(i == 0 || deviceNameFull[i] != '_')
+    {
+        return OTAPP_DEVICENAME_ERROR;
+    }
+
+    memcpy(addrOut->mFields.m8, prefix, sizeof(prefix));
+    addrOut->mFields.m8[12] = (uint8_t)(hash >> 24);
+    addrOut->mFields.m8[13] = (uint8_t)(hash >> 16);
+    addrOut->mFields.m8[14] = (uint8_t)(hash >> 8);
+    addrOut->mFields.m8[15] = (uint8_t)hash;
+
+    return OTAPP_DEVICENAME_OK;
+}
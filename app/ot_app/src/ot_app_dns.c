@@ -32,24 +32,25 @@ PRIVATE otapp_pair_queueItem_t queueItem;
 
 PRIVATE int8_t otapp_dnsPairDevice(const otDnsAddressResponse *aResponse)
 {
-    char *charBuff = (char*)otapp_buf_getWriteOnly_ptr(OTAPP_BUF_KEY_1, OTAPP_BUF_KEY_1_SIZE);
+    OTAPP_BUF_SLAB_SCOPED(block); // freed on every return
+    uint16_t blockSize = 0;
 
-    if(charBuff == NULL)
+    block = otapp_buf_slabAllocTimed(OTAPP_DNS_SRV_NAME_SIZE, OTAPP_BUF_ACQ_ZERO, OTAPP_BUF_SLAB_WAIT_TICKS, &blockSize);
+    if(block == NULL)
     {
         return OTAPP_DNS_ERROR;
     }
+    char *charBuff = (char*)block;
     
     if(otDnsAddressResponseGetAddress(aResponse, 0, &queueItem.ipAddress, NULL) != OT_ERROR_NONE)
     {
-        otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
         return OTAPP_DNS_ERROR;
     }
     
-    otDnsAddressResponseGetHostName(aResponse, charBuff, OTAPP_CHAR_BUFFER_SIZE);
+    otDnsAddressResponseGetHostName(aResponse, charBuff, blockSize);
     
     if(otapp_hostNameToDeviceNameFull(charBuff) != OTAPP_DEVICENAME_OK)
     {
-        otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
         return OTAPP_DNS_ERROR;
     }
     
@@ -58,8 +59,6 @@ PRIVATE int8_t otapp_dnsPairDevice(const otDnsAddressResponse *aResponse)
 
     OTAPP_PRINTF(TAG, "DNS: Add item to queue\n");
     otapp_pair_addToQueue(&queueItem);
-   
-    otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
 
     return OTAPP_DNS_OK;
 }
@@ -102,13 +101,16 @@ void otapp_dnsClientBrowseResponseCallback(otError aError, const otDnsBrowseResp
     if (aError == OT_ERROR_NONE)
     {        
         uint16_t index = 0;
-        char *buffer = (char*)otapp_buf_getWriteOnly_ptr(OTAPP_BUF_KEY_1, OTAPP_BUF_KEY_1_SIZE);
+        OTAPP_BUF_SLAB_SCOPED(block); // freed on every return
+        uint16_t blockSize = 0;
 
-        if(buffer == NULL)
+        block = otapp_buf_slabAllocTimed(OTAPP_DNS_SRV_NAME_SIZE, OTAPP_BUF_ACQ_ZERO, OTAPP_BUF_SLAB_WAIT_TICKS, &blockSize);
+        if(block == NULL)
         {
-            OTAPP_PRINTF(TAG, "ERROR NULL PTR FROM getWriteOnly_ptr()");
+            OTAPP_PRINTF(TAG, "ERROR NULL PTR FROM slabAllocTimed()");
             return;
         }
+        char *buffer = (char*)block;
         
         otDnsBrowseResponseGetServiceName(aResponse, buffer, OTAPP_DNS_SRV_NAME_SIZE);    
         OTAPP_PRINTF(TAG, "DNS browse response for %s \n", buffer);        
@@ -118,15 +120,13 @@ void otapp_dnsClientBrowseResponseCallback(otError aError, const otDnsBrowseResp
             if(index == OTAPP_PAIRED_DEVICES_MAX)
             {
                 OTAPP_PRINTF(TAG, "OTAPP_PAIRED_DEVICES_MAX has been reached");
-                otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
                 return;
             }
 
             OTAPP_PRINTF(TAG, "Device full name (label): %s \n", buffer);
 
-            if(otapp_deviceNameFullAddDomain(buffer, OTAPP_CHAR_BUFFER_SIZE) != OTAPP_DEVICENAME_OK)
+            if(otapp_deviceNameFullAddDomain(buffer, blockSize) != OTAPP_DEVICENAME_OK)
             {
-                otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
                 return ;
             }
             otapp_dnsClientResolve(otapp_getOpenThreadInstancePtr(), buffer);
@@ -134,7 +134,6 @@ void otapp_dnsClientBrowseResponseCallback(otError aError, const otDnsBrowseResp
             OTAPP_PRINTF(TAG, "\n");
             index++;
         }
-        otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
     }
 }
 
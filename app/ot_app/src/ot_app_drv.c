@@ -22,6 +22,8 @@
 
 #include "ot_app_drv.h"
 #include "ot_app_port_nvs.h"
+#include "ot_app_coap_coalesce.h"
+#include "ot_app_coap_transport.h"
 
 static ot_app_devDrv_t ot_app_devDrv = {
     .obs_subscribedUri_clb = NULL,      
@@ -57,6 +59,10 @@ static ot_app_devDrv_t ot_app_devDrv = {
     
     .api.coap = {
         .sendBytePut = otapp_coap_clientSendPutByte,
+        .sendBytePutTransport = otapp_coap_clientSendPutByteTransport,
+        .sendBytePutCoalesce = otapp_coap_coalescePut,
+        .nonStreamNext = otapp_coap_nonStreamNext,
+        .nonStreamStop = otapp_coap_nonStreamStop,
         .sendByteGet = otapp_coap_clientSendGetByte,
         .sendResponse = otapp_coap_sendResponse,
         .readPayload = otapp_coapReadPayload,
@@ -25,7 +25,11 @@
 
 
 #define OT_APP_MSG_TLV_SIZE             (sizeof(otapp_msg_tlv_t))
-#define OT_APP_MSG_TLV_RESERVED_BYTES   2  // two first bytes in buffer has been reserved for pUsedBytes(used bytes in buffer for keys)
+#define OT_APP_MSG_TLV_RESERVED_BYTES   OT_APP_MSG_TLV_RESERVED_SIZE  // two first bytes in buffer has been reserved for pUsedBytes(used bytes in buffer for keys)
+
+#define OT_APP_MSG_TLV_HDR_COMPACT      0x8000  // reserved header bit 15: compact format
+#define OT_APP_MSG_TLV_HDR_USED_MASK    0x7FFF  // reserved header bits 0..14: used bytes
+#define OT_APP_MSG_TLV_VARINT_MAX       3       // u16 in 7-bit groups
 
 typedef struct {
     uint16_t key;
@@ -39,141 +43,381 @@ int8_t otapp_msg_tlv_writenBytesGet(const uint8_t *buffer, const uint16_t buffer
         return OT_APP_MSG_TLV_ERROR;
     } 
     uint16_t *writtenBytes = (uint16_t*)buffer; 
-    *writtenBytesOut = *writtenBytes;
+    *writtenBytesOut = *writtenBytes & OT_APP_MSG_TLV_HDR_USED_MASK;
 
     return OT_APP_MSG_TLV_OK;
 }   
 
 static int8_t otapp_msg_tlv_writenBytesSet(uint8_t *buffer, const uint16_t bufferSize, uint16_t *writtenBytesIn)
 {
-    if(buffer == NULL || writtenBytesIn == NULL || bufferSize < (OT_APP_MSG_TLV_SIZE + OT_APP_MSG_TLV_RESERVED_BYTES))
+    if(buffer == NULL || writtenBytesIn == NULL || bufferSize < (OT_APP_MSG_TLV_SIZE + OT_APP_MSG_TLV_RESERVED_BYTES) ||
+       *writtenBytesIn > OT_APP_MSG_TLV_HDR_USED_MASK)
     {
         return OT_APP_MSG_TLV_ERROR;
     } 
 
     uint16_t *writtenBytes = (uint16_t*)buffer;     
-    *writtenBytes = *writtenBytesIn;
+    *writtenBytes = (*writtenBytes & OT_APP_MSG_TLV_HDR_COMPACT) | *writtenBytesIn; // format bit stays
 
     return OT_APP_MSG_TLV_OK;
 }   
 
-int8_t otapp_msg_tlv_keyAdd(uint8_t *buffer, const uint16_t bufferSize, const uint16_t key, const uint16_t valueLengthIn, uint8_t *valueIn)
+static uint8_t otapp_msg_tlv_formatRead(const uint8_t *buffer)
 {
-    if(buffer == NULL || valueIn == NULL || valueLengthIn == 0 || bufferSize < (OT_APP_MSG_TLV_SIZE + valueLengthIn + OT_APP_MSG_TLV_RESERVED_BYTES))
+    return (*(const uint16_t*)buffer & OT_APP_MSG_TLV_HDR_COMPACT) ? OT_APP_MSG_TLV_FORMAT_COMPACT : OT_APP_MSG_TLV_FORMAT_CLASSIC;
+}
+
+uint16_t otapp_msg_tlv_reservedEncode(const uint16_t usedBytes, const uint8_t format)
+{
+    return (usedBytes & OT_APP_MSG_TLV_HDR_USED_MASK) | ((format == OT_APP_MSG_TLV_FORMAT_COMPACT) ? OT_APP_MSG_TLV_HDR_COMPACT : 0);
+}
+
+void otapp_msg_tlv_reservedDecode(const uint16_t reserved, uint16_t *usedBytesOut, uint8_t *formatOut)
+{
+    *usedBytesOut = reserved & OT_APP_MSG_TLV_HDR_USED_MASK;
+    *formatOut = (reserved & OT_APP_MSG_TLV_HDR_COMPACT) ? OT_APP_MSG_TLV_FORMAT_COMPACT : OT_APP_MSG_TLV_FORMAT_CLASSIC;
+}
+
+int8_t otapp_msg_tlv_formatSet(uint8_t *buffer, const uint16_t bufferSize, const uint8_t format)
+{
+    uint16_t usedBytes = 0;
+
+    if(format > OT_APP_MSG_TLV_FORMAT_COMPACT || otapp_msg_tlv_writenBytesGet(buffer, bufferSize, &usedBytes) == OT_APP_MSG_TLV_ERROR)
     {
         return OT_APP_MSG_TLV_ERROR;
-    } 
+    }
 
-    int8_t error;
+    if(usedBytes != 0) // blocks already written in the other format
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
 
-    const uint16_t usableBufferSize = bufferSize - OT_APP_MSG_TLV_RESERVED_BYTES;
-    const uint16_t newBlockLength = OT_APP_MSG_TLV_SIZE + valueLengthIn;
-  
+    *(uint16_t*)buffer = (format == OT_APP_MSG_TLV_FORMAT_COMPACT) ? OT_APP_MSG_TLV_HDR_COMPACT : 0;
+    return OT_APP_MSG_TLV_OK;
+}
+
+int8_t otapp_msg_tlv_formatGet(const uint8_t *buffer, const uint16_t bufferSize, uint8_t *formatOut)
+{
     uint16_t usedBytes = 0;
 
-    error = otapp_msg_tlv_writenBytesGet(buffer, bufferSize, &usedBytes);
-    if(error == OT_APP_MSG_TLV_ERROR || usedBytes > usableBufferSize) // check error and buffer overflow
+    if(formatOut == NULL || otapp_msg_tlv_writenBytesGet(buffer, bufferSize, &usedBytes) == OT_APP_MSG_TLV_ERROR)
     {
         return OT_APP_MSG_TLV_ERROR;
-    } 
-   
-    uint8_t *pWrite = buffer + OT_APP_MSG_TLV_RESERVED_BYTES + usedBytes;  // Pointer to next free byte for writing
-    
-    if(newBlockLength <= (usableBufferSize - usedBytes)) // checking if there is free space in the buffer for new block of key
+    }
+
+    *formatOut = otapp_msg_tlv_formatRead(buffer);
+    return OT_APP_MSG_TLV_OK;
+}
+
+/*
+ * Block header codec.
+ * classic: [key u16][length u16]
+ * compact: [varint(key - previous key)][varint(length)], varint = 7 bits per byte, LSB group first
+ */
+static uint8_t otapp_msg_tlv_varintSize(const uint16_t value)
+{
+    return (value < 0x80) ? 1 : ((value < 0x4000) ? 2 : 3);
+}
+
+static uint8_t otapp_msg_tlv_varintEncode(uint8_t *pWrite, uint16_t value)
+{
+    uint8_t n = 0;
+
+    while (value >= 0x80)
+    {
+        pWrite[n++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    pWrite[n++] = (uint8_t)value;
+
+    return n;
+}
+
+static uint8_t otapp_msg_tlv_varintDecode(const uint8_t *pRead, const uint16_t left, uint16_t *valueOut)
+{
+    uint32_t value = 0;
+
+    for (uint8_t n = 0; n < OT_APP_MSG_TLV_VARINT_MAX && n < left; n++)
     {
-        if(usedBytes > OT_APP_MSG_TLV_SIZE) // checking if there is anything in the buffer and if currently adding key does not already exist there
+        value |= (uint32_t)(pRead[n] & 0x7F) << (7 * n);
+
+        if((pRead[n] & 0x80) == 0)
         {
-            if(otapp_msg_tlv_keyGet(buffer, bufferSize, key, NULL, NULL) == OT_APP_MSG_TLV_KEY_EXIST)
+            if(value > UINT16_MAX || (n > 0 && pRead[n] == 0)) // overflow or not the shortest encoding
             {
-                return OT_APP_MSG_TLV_KEY_EXIST;
+                return 0;
             }
+            *valueOut = (uint16_t)value;
+            return n + 1;
         }
+    }
+    return 0;
+}
 
+uint8_t otapp_msg_tlv_hdrSize(const uint8_t format, const uint16_t key, const uint16_t prevKey, const uint16_t length)
+{
+    if(format == OT_APP_MSG_TLV_FORMAT_CLASSIC)
+    {
+        return OT_APP_MSG_TLV_SIZE;
+    }
+    return otapp_msg_tlv_varintSize((uint16_t)(key - prevKey)) + otapp_msg_tlv_varintSize(length);
+}
+
+uint8_t otapp_msg_tlv_hdrEncode(uint8_t *pWrite, const uint8_t format, const uint16_t key, const uint16_t prevKey, const uint16_t length)
+{
+    if(format == OT_APP_MSG_TLV_FORMAT_CLASSIC)
+    {
         otapp_msg_tlv_t * currentBlock = (otapp_msg_tlv_t *)pWrite;
         currentBlock->key = key;
-        currentBlock->length = valueLengthIn;
+        currentBlock->length = length;
+        return OT_APP_MSG_TLV_SIZE;
+    }
 
-        memcpy((uint8_t*)(pWrite + OT_APP_MSG_TLV_SIZE), valueIn, valueLengthIn);
-        
-        usedBytes += newBlockLength; // Update used bytes in buffer
-        if(otapp_msg_tlv_writenBytesSet(buffer, bufferSize, &usedBytes) == OT_APP_MSG_TLV_ERROR)
+    uint8_t n = otapp_msg_tlv_varintEncode(pWrite, (uint16_t)(key - prevKey));
+    return n + otapp_msg_tlv_varintEncode(pWrite + n, length);
+}
+
+uint8_t otapp_msg_tlv_hdrDecode(const uint8_t *pRead, const uint16_t left, const uint8_t format, const uint16_t prevKey, uint16_t *keyOut, uint16_t *lengthOut)
+{
+    if(format == OT_APP_MSG_TLV_FORMAT_CLASSIC)
+    {
+        if(left < OT_APP_MSG_TLV_SIZE)
         {
-            return OT_APP_MSG_TLV_ERROR;
+            return 0;
         }
+        const otapp_msg_tlv_t *block = (const otapp_msg_tlv_t *)pRead;
+        *keyOut = block->key;
+        *lengthOut = block->length;
+        return OT_APP_MSG_TLV_SIZE;
+    }
 
-        return OT_APP_MSG_TLV_OK;
-    }else // there is no space for another key
+    uint16_t keyDelta;
+    uint8_t n = otapp_msg_tlv_varintDecode(pRead, left, &keyDelta);
+    if(n == 0)
     {
-        error = OT_APP_MSG_TLV_ERROR_NO_SPACE;
+        return 0;
     }
 
-    return error;
+    uint8_t m = otapp_msg_tlv_varintDecode(pRead + n, left - n, lengthOut);
+    if(m == 0)
+    {
+        return 0;
+    }
+
+    *keyOut = prevKey + keyDelta;
+    return n + m;
+}
+
+static int8_t otapp_msg_tlv_iterInit(otapp_msg_tlv_iter_t *iter, const uint8_t *buffer, const uint16_t bufferSize)
+{
+    uint16_t usedBytes = 0;
+
+    if(iter == NULL || otapp_msg_tlv_writenBytesGet(buffer, bufferSize, &usedBytes) == OT_APP_MSG_TLV_ERROR)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    if(usedBytes > (bufferSize - OT_APP_MSG_TLV_RESERVED_BYTES)) // check for buffer overflow
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    iter->buffer  = buffer;
+    iter->offset  = OT_APP_MSG_TLV_RESERVED_BYTES;
+    iter->end     = OT_APP_MSG_TLV_RESERVED_BYTES + usedBytes;
+    iter->prevKey = 0;
+    iter->format  = otapp_msg_tlv_formatRead(buffer);
+
+    return OT_APP_MSG_TLV_OK;
 }
 
-int8_t otapp_msg_tlv_keyGet(uint8_t *buffer, const uint16_t bufferSize, const uint16_t key, uint16_t *valueLengthOut, uint8_t *valueOut)
+int8_t otapp_msg_tlv_iterPeek(const otapp_msg_tlv_iter_t *iter, otapp_msg_tlv_item_t *itemOut)
+{
+    if(iter == NULL || iter->buffer == NULL)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    if(iter->offset >= iter->end)
+    {
+        return OT_APP_MSG_TLV_END;
+    }
+
+    const uint16_t left = iter->end - iter->offset;
+    uint16_t key;
+    uint16_t length;
+    uint8_t hdrSize;
+
+    hdrSize = otapp_msg_tlv_hdrDecode(iter->buffer + iter->offset, left, iter->format, iter->prevKey, &key, &length);
+    if(hdrSize == 0 || length > (left - hdrSize)) // block header or value crosses written data
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    if(itemOut != NULL)
+    {
+        itemOut->key    = key;
+        itemOut->length = length;
+        itemOut->value  = iter->buffer + iter->offset + hdrSize;
+    }
+
+    return OT_APP_MSG_TLV_OK;
+}
+
+int8_t otapp_msg_tlv_iterNext(otapp_msg_tlv_iter_t *iter, otapp_msg_tlv_item_t *itemOut)
+{
+    otapp_msg_tlv_item_t item;
+    int8_t result;
+
+    result = otapp_msg_tlv_iterPeek(iter, &item);
+    if(result != OT_APP_MSG_TLV_OK)
+    {
+        return result;
+    }
+
+    iter->offset  = (uint16_t)(item.value - iter->buffer) + item.length;
+    iter->prevKey = item.key;
+
+    if(itemOut != NULL)
+    {
+        *itemOut = item;
+    }
+
+    return OT_APP_MSG_TLV_OK;
+}
+
+int8_t otapp_msg_tlv_iterFirst(otapp_msg_tlv_iter_t *iter, const uint8_t *buffer, const uint16_t bufferSize, otapp_msg_tlv_item_t *itemOut)
+{
+    if(otapp_msg_tlv_iterInit(iter, buffer, bufferSize) != OT_APP_MSG_TLV_OK)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    return otapp_msg_tlv_iterNext(iter, itemOut);
+}
+
+/*
+ * Single pass search. On KEY_EXIST the iterator stands after the found block, on KEY_NO_EXIST at the end.
+ * blockOffsetOut / prevKeyOut: position of the found block (or the append position) and the key before it.
+ */
+static int8_t otapp_msg_tlv_keyFind(const uint8_t *buffer, const uint16_t bufferSize, const uint16_t key, otapp_msg_tlv_iter_t *iter,
+                                    otapp_msg_tlv_item_t *itemOut, uint16_t *blockOffsetOut, uint16_t *prevKeyOut)
+{
+    int8_t result;
+
+    if(otapp_msg_tlv_iterInit(iter, buffer, bufferSize) != OT_APP_MSG_TLV_OK)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    do
+    {
+        *blockOffsetOut = iter->offset;
+        *prevKeyOut = iter->prevKey;
+
+        result = otapp_msg_tlv_iterNext(iter, itemOut);
+        if(result == OT_APP_MSG_TLV_OK && itemOut->key == key)
+        {
+            return OT_APP_MSG_TLV_KEY_EXIST;
+        }
+    } while (result == OT_APP_MSG_TLV_OK);
+
+    return (result == OT_APP_MSG_TLV_END) ? OT_APP_MSG_TLV_KEY_NO_EXIST : OT_APP_MSG_TLV_ERROR;
+}
+
+int8_t otapp_msg_tlv_keyAdd(uint8_t *buffer, const uint16_t bufferSize, const uint16_t key, const uint16_t valueLengthIn, const uint8_t *valueIn)
+{
+    if(buffer == NULL || valueIn == NULL || valueLengthIn == 0 || bufferSize < (OT_APP_MSG_TLV_SIZE + valueLengthIn + OT_APP_MSG_TLV_RESERVED_BYTES))
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    } 
+
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+    uint16_t blockOffset;
+    uint16_t prevKey;
+    int8_t keyResult;
+
+    keyResult = otapp_msg_tlv_keyFind(buffer, bufferSize, key, &iter, &item, &blockOffset, &prevKey);
+    if(keyResult == OT_APP_MSG_TLV_ERROR) // check error and buffer overflow
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    if(keyResult == OT_APP_MSG_TLV_KEY_EXIST) // go to the end, the new block would be encoded after the last key
+    {
+        while (otapp_msg_tlv_iterNext(&iter, NULL) == OT_APP_MSG_TLV_OK);
+    }
+    prevKey = iter.prevKey;
+
+    const uint16_t usableBufferSize = bufferSize - OT_APP_MSG_TLV_RESERVED_BYTES;
+    uint16_t usedBytes = iter.end - OT_APP_MSG_TLV_RESERVED_BYTES;
+    const uint16_t newBlockLength = otapp_msg_tlv_hdrSize(iter.format, key, prevKey, valueLengthIn) + valueLengthIn;
+
+    if(newBlockLength > (usableBufferSize - usedBytes)) // there is no space for another key
+    {
+        return OT_APP_MSG_TLV_ERROR_NO_SPACE;
+    }
+
+    if(keyResult == OT_APP_MSG_TLV_KEY_EXIST)
+    {
+        return OT_APP_MSG_TLV_KEY_EXIST;
+    }
+
+    uint8_t *pWrite = buffer + iter.end;  // Pointer to next free byte for writing
+    pWrite += otapp_msg_tlv_hdrEncode(pWrite, iter.format, key, prevKey, valueLengthIn);
+    memcpy(pWrite, valueIn, valueLengthIn);
+
+    usedBytes += newBlockLength; // Update used bytes in buffer
+    return otapp_msg_tlv_writenBytesSet(buffer, bufferSize, &usedBytes);
+}
+
+int8_t otapp_msg_tlv_keyGet(const uint8_t *buffer, const uint16_t bufferSize, const uint16_t key, uint16_t *valueLengthOut, uint8_t *valueOut)
 {
-    // if(buffer == NULL || valueOut == NULL || valueLengthOut == NULL || bufferSize < (OT_APP_MSG_TLV_SIZE + OT_APP_MSG_TLV_RESERVED_BYTES))
     if(buffer == NULL ||  bufferSize < (OT_APP_MSG_TLV_SIZE + OT_APP_MSG_TLV_RESERVED_BYTES))
     {
         return OT_APP_MSG_TLV_ERROR;
     } 
 
-    const uint16_t usableBufferSize = bufferSize - OT_APP_MSG_TLV_RESERVED_BYTES; 
-    otapp_msg_tlv_t *currentBlock = (otapp_msg_tlv_t*)(buffer + OT_APP_MSG_TLV_RESERVED_BYTES);
-    uint16_t keyValueLen;
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+    uint16_t blockOffset;
+    uint16_t prevKey;
     uint16_t usedBytes;
+    int8_t result;
 
     if(otapp_msg_tlv_writenBytesGet(buffer, bufferSize, &usedBytes) == OT_APP_MSG_TLV_ERROR)
     {
         return OT_APP_MSG_TLV_ERROR;
     } 
 
-    if(usedBytes > usableBufferSize) // check for buffer overflow
+    if(usedBytes > (bufferSize - OT_APP_MSG_TLV_RESERVED_BYTES)) // check for buffer overflow
     {
         return OT_APP_MSG_TLV_ERROR;    
     }
 
-    if(usedBytes < OT_APP_MSG_TLV_SIZE + OT_APP_MSG_TLV_RESERVED_BYTES) // check empty buffer
+    if(usedBytes == 0) // check empty buffer
     {
         return OT_APP_MSG_TLV_EMPTY_BUFFER;
     }
 
-    uint16_t currentBytes = OT_APP_MSG_TLV_SIZE;
+    result = otapp_msg_tlv_keyFind(buffer, bufferSize, key, &iter, &item, &blockOffset, &prevKey);
+    if(result != OT_APP_MSG_TLV_KEY_EXIST)
+    {
+        return result;
+    }
 
-    while (currentBytes <= usedBytes)
+    if(valueOut != NULL)
     {
-        if(currentBlock->key == key)
-        {
-            if(currentBlock->length > (usableBufferSize - currentBytes))
-            {
-                return OT_APP_MSG_TLV_ERROR;
-            }
-            
-            if(valueOut == NULL)
-            {
-                return OT_APP_MSG_TLV_KEY_EXIST;
-            }else
-            {
-                memcpy(valueOut, currentBlock + 1, currentBlock->length); // (currentBlock + 1) --> pointer arithmetic will point to the beginning of key value 
-
-                if(valueLengthOut != NULL)
-                {
-                    *valueLengthOut = currentBlock->length;
-                }
-                
-                return OT_APP_MSG_TLV_KEY_EXIST;
-            }            
-        }else
-        {
-            keyValueLen = currentBlock->length;
+        memcpy(valueOut, item.value, item.length);
+    }
 
-            currentBytes += keyValueLen + OT_APP_MSG_TLV_SIZE;                             // first, increase bytes by length of key and key struct
-            currentBlock = (otapp_msg_tlv_t *)((uint8_t *)currentBlock + keyValueLen);     // second, increase ptr by the size of previous keyValue length
-            currentBlock ++;                                                               // next, increase ptr to next key struct
-        }
+    if(valueLengthOut != NULL)
+    {
+        *valueLengthOut = item.length;
     }
-    
-    return OT_APP_MSG_TLV_KEY_NO_EXIST;
+
+    return OT_APP_MSG_TLV_KEY_EXIST;
 }
 
 int8_t otapp_msg_tlv_getBufferTotalFreeSpace(const uint8_t *buffer, const uint16_t bufferSize, uint16_t *freeBufSpaceOut)
@@ -211,26 +455,319 @@ int8_t otapp_msg_tlv_getBufferTotalUsedSpace(const uint8_t *buffer, const uint16
     return OT_APP_MSG_TLV_OK;
 }
 
-uint16_t otapp_msg_tlv_calcualeBuffer(uint8_t keyDataLength, uint8_t cnt)
+#define OT_APP_MSG_TLV_FILTER_BIT(key)  ((key) & (OT_APP_MSG_TLV_BUILDER_BITMAP_BITS - 1))
+
+static void otapp_msg_tlv_filterSet(otapp_msg_tlv_builder_t *builder, const uint16_t key)
 {
-    static uint16_t counter;
-    if(cnt == 0)
+    const uint16_t bit = OT_APP_MSG_TLV_FILTER_BIT(key);
+    builder->keyFilter[bit / 32] |= (1UL << (bit % 32));
+}
+
+static uint8_t otapp_msg_tlv_filterHit(const otapp_msg_tlv_builder_t *builder, const uint16_t key)
+{
+    const uint16_t bit = OT_APP_MSG_TLV_FILTER_BIT(key);
+    return (builder->keyFilter[bit / 32] & (1UL << (bit % 32))) != 0;
+}
+
+static uint8_t otapp_msg_tlv_keyScan(const uint8_t *buffer, const uint16_t bufferSize, const uint16_t key)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+    uint16_t blockOffset;
+    uint16_t prevKey;
+
+    return otapp_msg_tlv_keyFind(buffer, bufferSize, key, &iter, &item, &blockOffset, &prevKey) == OT_APP_MSG_TLV_KEY_EXIST;
+}
+
+int8_t otapp_msg_tlv_builderInit(otapp_msg_tlv_builder_t *builder, uint8_t *buffer, const uint16_t bufferSize, const uint8_t strict)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+    int8_t result;
+
+    if(builder == NULL || otapp_msg_tlv_iterInit(&iter, buffer, bufferSize) != OT_APP_MSG_TLV_OK) // validates buffer and writtenBytes
     {
-        counter = OT_APP_MSG_TLV_RESERVED_BYTES;
-    } 
+        return OT_APP_MSG_TLV_ERROR;
+    }
 
-    counter += (OT_APP_MSG_TLV_SIZE + keyDataLength);
-    
-    return counter;
+    memset(builder, 0, sizeof(otapp_msg_tlv_builder_t));
+    builder->buffer     = buffer;
+    builder->bufferSize = bufferSize;
+    builder->usedBytes  = iter.end - OT_APP_MSG_TLV_RESERVED_BYTES;
+    builder->strict     = strict;
+    builder->format     = iter.format;
+
+    // one pass over keys already in the buffer: last key (compact key delta) and the key filter
+    while ((result = otapp_msg_tlv_iterNext(&iter, &item)) == OT_APP_MSG_TLV_OK)
+    {
+        if(strict != OT_APP_MSG_TLV_BUILDER_TRUSTED)
+        {
+            otapp_msg_tlv_filterSet(builder, item.key);
+        }
+    }
+    builder->lastKey = iter.prevKey;
+
+    return (result == OT_APP_MSG_TLV_END) ? OT_APP_MSG_TLV_OK : OT_APP_MSG_TLV_ERROR;
+}
+
+int8_t otapp_msg_tlv_builderAdd(otapp_msg_tlv_builder_t *builder, const uint16_t key, const uint16_t valueLengthIn, const uint8_t *valueIn)
+{
+    if(builder == NULL || builder->buffer == NULL || valueIn == NULL || valueLengthIn == 0)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    const uint16_t usableBufferSize = builder->bufferSize - OT_APP_MSG_TLV_RESERVED_BYTES;
+    const uint8_t hdrSize = otapp_msg_tlv_hdrSize(builder->format, key, builder->lastKey, valueLengthIn);
+
+    if(valueLengthIn > usableBufferSize || (uint32_t)hdrSize + valueLengthIn > (uint32_t)(usableBufferSize - builder->usedBytes))
+    {
+        return OT_APP_MSG_TLV_ERROR_NO_SPACE;
+    }
+
+    if(builder->strict != OT_APP_MSG_TLV_BUILDER_TRUSTED)
+    {
+        if(otapp_msg_tlv_filterHit(builder, key) && otapp_msg_tlv_keyScan(builder->buffer, builder->bufferSize, key))
+        {
+            return OT_APP_MSG_TLV_KEY_EXIST;
+        }
+        otapp_msg_tlv_filterSet(builder, key);
+    }
+
+    uint8_t *pWrite = builder->buffer + OT_APP_MSG_TLV_RESERVED_BYTES + builder->usedBytes;
+    pWrite += otapp_msg_tlv_hdrEncode(pWrite, builder->format, key, builder->lastKey, valueLengthIn);
+    memcpy(pWrite, valueIn, valueLengthIn);
+
+    builder->lastKey = key;
+    builder->usedBytes += hdrSize + valueLengthIn;
+    return otapp_msg_tlv_writenBytesSet(builder->buffer, builder->bufferSize, &builder->usedBytes);
+}
+
+int8_t otapp_msg_tlv_keyDelete(uint8_t *buffer, const uint16_t bufferSize, const uint16_t key)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+    otapp_msg_tlv_item_t next;
+    uint16_t blockOffset;
+    uint16_t prevKey;
+    uint16_t newEnd;
+    int8_t result;
+
+    result = otapp_msg_tlv_keyFind(buffer, bufferSize, key, &iter, &item, &blockOffset, &prevKey);
+    if(result != OT_APP_MSG_TLV_KEY_EXIST)
+    {
+        return result;
+    }
+
+    result = otapp_msg_tlv_iterPeek(&iter, &next);
+    if(result == OT_APP_MSG_TLV_ERROR)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    if(result == OT_APP_MSG_TLV_OK)
+    {
+        // next block gets a new header (compact: key delta from the block before the deleted one).
+        // It grows by max 2 bytes, the deleted block has min 3, so the data never moves past the old end.
+        const uint16_t nextValueOffset = (uint16_t)(next.value - buffer);
+        const uint16_t tailLength = iter.end - nextValueOffset;
+        const uint8_t nextHdrSize = otapp_msg_tlv_hdrSize(iter.format, next.key, prevKey, next.length);
+
+        memmove(buffer + blockOffset + nextHdrSize, buffer + nextValueOffset, tailLength);
+        otapp_msg_tlv_hdrEncode(buffer + blockOffset, iter.format, next.key, prevKey, next.length);
+        newEnd = blockOffset + nextHdrSize + tailLength;
+    }else
+    {
+        newEnd = blockOffset; // last block
+    }
+
+    memset(buffer + newEnd, 0, iter.end - newEnd); // free space stays zeroed like in a new buffer
+
+    uint16_t usedBytes = newEnd - OT_APP_MSG_TLV_RESERVED_BYTES;
+    return otapp_msg_tlv_writenBytesSet(buffer, bufferSize, &usedBytes);
+}
+
+int8_t otapp_msg_tlv_keyUpdate(uint8_t *buffer, const uint16_t bufferSize, const uint16_t key, const uint16_t valueLengthIn, const uint8_t *valueIn)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+    uint16_t blockOffset;
+    uint16_t prevKey;
+    int8_t result;
+
+    if(valueIn == NULL || valueLengthIn == 0)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    result = otapp_msg_tlv_keyFind(buffer, bufferSize, key, &iter, &item, &blockOffset, &prevKey);
+    if(result != OT_APP_MSG_TLV_KEY_EXIST)
+    {
+        return result;
+    }
+
+    if(valueLengthIn == item.length) // same size: in place, nothing moves
+    {
+        memcpy((uint8_t *)item.value, valueIn, valueLengthIn);
+        return OT_APP_MSG_TLV_OK;
+    }
+
+    const uint16_t usableBufferSize = bufferSize - OT_APP_MSG_TLV_RESERVED_BYTES;
+    const uint16_t oldBlockEnd = iter.offset;
+    const uint16_t tailLength = iter.end - oldBlockEnd;
+    const uint8_t hdrSize = otapp_msg_tlv_hdrSize(iter.format, key, prevKey, valueLengthIn);
+    const uint32_t newBlockEnd = (uint32_t)blockOffset + hdrSize + valueLengthIn;
+    const uint32_t newEnd = newBlockEnd + tailLength;
+
+    if(newEnd > (uint32_t)OT_APP_MSG_TLV_RESERVED_BYTES + usableBufferSize)
+    {
+        return OT_APP_MSG_TLV_ERROR_NO_SPACE;
+    }
+
+    memmove(buffer + newBlockEnd, buffer + oldBlockEnd, tailLength); // shift the blocks after this one
+    if(newEnd < iter.end)
+    {
+        memset(buffer + newEnd, 0, iter.end - newEnd);
+    }
+
+    otapp_msg_tlv_hdrEncode(buffer + blockOffset, iter.format, key, prevKey, valueLengthIn);
+    memcpy(buffer + blockOffset + hdrSize, valueIn, valueLengthIn);
+
+    uint16_t usedBytes = (uint16_t)newEnd - OT_APP_MSG_TLV_RESERVED_BYTES;
+    return otapp_msg_tlv_writenBytesSet(buffer, bufferSize, &usedBytes);
 }
-// todo feature
-// int8_t otapp_msg_tlv_keyDelete(uint8_t *buffer, const uint16_t bufferSize, const uint16_t key)
-// {
 
-// }
+int8_t otapp_msg_tlv_builderAddFn(void *addCtx, const uint16_t key, const uint16_t valueLengthIn, const uint8_t *valueIn)
+{
+    return otapp_msg_tlv_builderAdd((otapp_msg_tlv_builder_t *)addCtx, key, valueLengthIn, valueIn);
+}
 
-// int8_t otapp_msg_tlv_keyUpdate(uint8_t *buffer, const uint16_t bufferSize, const uint16_t key, const uint16_t keyLenght, uint8_t *keyValue)
-// {
+// value of one field: pointer and length, OT_APP_MSG_TLV_ERROR when a string is longer than maxLength
+static int8_t otapp_msg_tlv_schemaFieldValue(const otapp_msg_tlv_field_t *field, const uint8_t *record, const uint8_t **valueOut, uint16_t *lengthOut)
+{
+    const uint8_t *value = record + field->offset;
+    const uint8_t *strEnd;
 
-// }
+    if(field->type == OT_APP_MSG_TLV_FIELD_BYTES)
+    {
+        *valueOut  = value;
+        *lengthOut = field->maxLength;
+        return OT_APP_MSG_TLV_OK;
+    }
+
+    if(field->type == OT_APP_MSG_TLV_FIELD_STR_PTR)
+    {
+        memcpy(&value, value, sizeof(value));
+        if(value == NULL)
+        {
+            return OT_APP_MSG_TLV_ERROR;
+        }
+    }
+
+    strEnd = memchr(value, '\0', (size_t)field->maxLength + 1);
+    if(strEnd == NULL)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    *valueOut  = value;
+    *lengthOut = (uint16_t)(strEnd - value);
+    return OT_APP_MSG_TLV_OK;
+}
+
+uint16_t otapp_msg_tlv_schemaSize(const otapp_msg_tlv_schema_t *schema, const void *records, const uint8_t recordsQty)
+{
+    const uint8_t *value;
+    uint16_t length;
+    uint32_t size = 0;
+
+    if(schema == NULL || records == NULL)
+    {
+        return 0;
+    }
+
+    for (uint8_t r = 0; r < recordsQty; r++)
+    {
+        const uint8_t *record = (const uint8_t *)records + (size_t)r * schema->recordSize;
+
+        for (uint8_t f = 0; f < schema->fieldsQty; f++)
+        {
+            if(otapp_msg_tlv_schemaFieldValue(&schema->fields[f], record, &value, &length) != OT_APP_MSG_TLV_OK)
+            {
+                return 0;
+            }
+            size += OT_APP_MSG_TLV_BLOCK_SIZE_MAX(length);
+        }
+    }
+
+    return (size > UINT16_MAX) ? 0 : (uint16_t)size;
+}
 
+int8_t otapp_msg_tlv_schemaEncode(const otapp_msg_tlv_schema_t *schema, const void *records, const uint8_t recordsQty, otapp_msg_tlv_addFn_t addFn, void *addCtx)
+{
+    const uint8_t *value;
+    uint16_t length;
+    uint16_t key;
+    int8_t result;
+
+    if(schema == NULL || records == NULL || addFn == NULL)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    key = schema->keyBase;
+    for (uint8_t r = 0; r < recordsQty; r++)
+    {
+        const uint8_t *record = (const uint8_t *)records + (size_t)r * schema->recordSize;
+
+        for (uint8_t f = 0; f < schema->fieldsQty; f++)
+        {
+            key++;
+            if(otapp_msg_tlv_schemaFieldValue(&schema->fields[f], record, &value, &length) != OT_APP_MSG_TLV_OK)
+            {
+                return OT_APP_MSG_TLV_ERROR;
+            }
+
+            result = addFn(addCtx, key, length, value);
+            if(result != OT_APP_MSG_TLV_OK)
+            {
+                return result;
+            }
+        }
+    }
+
+    return OT_APP_MSG_TLV_OK;
+}
+
+int8_t otapp_msg_tlv_schemaFieldGet(const otapp_msg_tlv_schema_t *schema, void *records, const uint8_t recordsQty, const uint16_t key, const uint16_t length,
+                                    void **dstOut, uint8_t *recordOut, uint8_t *fieldOut)
+{
+    uint16_t keyIndex;
+    uint8_t record;
+    uint8_t field;
+
+    if(schema == NULL || records == NULL || dstOut == NULL || schema->fieldsQty == 0)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    if(key <= schema->keyBase || (uint32_t)(key - schema->keyBase) > (uint32_t)recordsQty * schema->fieldsQty)
+    {
+        return OT_APP_MSG_TLV_KEY_NO_EXIST;
+    }
+
+    keyIndex = key - schema->keyBase - 1;
+    record   = keyIndex / schema->fieldsQty;
+    field    = keyIndex % schema->fieldsQty;
+
+    if(length > schema->fields[field].maxLength || schema->fields[field].type == OT_APP_MSG_TLV_FIELD_STR_PTR)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    *dstOut = (uint8_t *)records + (size_t)record * schema->recordSize + schema->fields[field].offset;
+    if(recordOut != NULL) *recordOut = record;
+    if(fieldOut != NULL)  *fieldOut = field;
+
+    return OT_APP_MSG_TLV_OK;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file ot_app_msg_tlv_msg.c
+ * @author Jan Łukaszewicz (pldevluk@gmail.com)
+ * @brief
+ * @version 0.1
+ * @date 17-10-2026
+ *
+ * @copyright The MIT License (MIT) Copyright (c) 2026
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ */
+#include "ot_app_msg_tlv_msg.h"
+
+#define OT_APP_MSG_TLV_MSG_USED_MAX     0x7FFF  // writtenBytes field of the reserved header
+
+// append the part of [pos, pos + length) which lies in the window
+static int8_t otapp_msg_tlv_msgWriterOut(otapp_msg_tlv_msgWriter_t *writer, const uint32_t pos, const uint8_t *data, const uint16_t length)
+{
+    const uint32_t start = (pos > writer->windowStart) ? pos : writer->windowStart;
+    const uint32_t end   = (pos + length < writer->windowEnd) ? pos + length : writer->windowEnd;
+
+    if(start >= end)
+    {
+        return OT_APP_MSG_TLV_OK;
+    }
+
+    if(otMessageAppend(writer->message, &data[start - pos], (uint16_t)(end - start)) != OT_ERROR_NONE)
+    {
+        return OT_APP_MSG_TLV_ERROR_NO_SPACE;
+    }
+    return OT_APP_MSG_TLV_OK;
+}
+
+int8_t otapp_msg_tlv_msgWriterInit(otapp_msg_tlv_msgWriter_t *writer, otMessage *message, const uint8_t format)
+{
+    if(message == NULL)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+    return otapp_msg_tlv_msgWriterInitWindow(writer, message, format, 0, UINT16_MAX);
+}
+
+int8_t otapp_msg_tlv_msgWriterInitWindow(otapp_msg_tlv_msgWriter_t *writer, otMessage *message, const uint8_t format, const uint16_t windowOffset, const uint16_t windowSize)
+{
+    if(writer == NULL || format > OT_APP_MSG_TLV_FORMAT_COMPACT || (message == NULL && windowSize != 0))
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    // reserved header is patched in Finish(), it must be in the window whole or not at all
+    if(windowSize != 0 && windowOffset < OT_APP_MSG_TLV_RESERVED_SIZE &&
+       (windowOffset != 0 || windowSize < OT_APP_MSG_TLV_RESERVED_SIZE))
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    const uint16_t reserved = otapp_msg_tlv_reservedEncode(0, format);
+    const uint32_t windowEnd = (uint32_t)windowOffset + windowSize;
+
+    writer->message      = message;
+    writer->headerOffset = (message != NULL) ? otMessageGetLength(message) : 0;
+    writer->usedBytes    = 0;
+    writer->lastKey      = 0;
+    writer->windowStart  = windowOffset;
+    writer->windowEnd    = (windowEnd > UINT16_MAX) ? UINT16_MAX : (uint16_t)windowEnd;
+    writer->format       = format;
+
+    return otapp_msg_tlv_msgWriterOut(writer, 0, (const uint8_t *)&reserved, sizeof(reserved));
+}
+
+int8_t otapp_msg_tlv_msgWriterAdd(otapp_msg_tlv_msgWriter_t *writer, const uint16_t key, const uint16_t valueLengthIn, const uint8_t *valueIn)
+{
+    uint8_t hdr[OT_APP_MSG_TLV_HDR_SIZE_MAX];
+    uint8_t hdrSize;
+
+    if(writer == NULL || valueIn == NULL || valueLengthIn == 0)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    hdrSize = otapp_msg_tlv_hdrEncode(hdr, writer->format, key, writer->lastKey, valueLengthIn);
+
+    if((uint32_t)writer->usedBytes + hdrSize + valueLengthIn > OT_APP_MSG_TLV_MSG_USED_MAX)
+    {
+        return OT_APP_MSG_TLV_ERROR_NO_SPACE;
+    }
+
+    const uint32_t pos = OT_APP_MSG_TLV_RESERVED_SIZE + writer->usedBytes;
+
+    if(otapp_msg_tlv_msgWriterOut(writer, pos, hdr, hdrSize) != OT_APP_MSG_TLV_OK ||
+       otapp_msg_tlv_msgWriterOut(writer, pos + hdrSize, valueIn, valueLengthIn) != OT_APP_MSG_TLV_OK)
+    {
+        return OT_APP_MSG_TLV_ERROR_NO_SPACE;
+    }
+
+    writer->lastKey = key;
+    writer->usedBytes += hdrSize + valueLengthIn;
+
+    return OT_APP_MSG_TLV_OK;
+}
+
+int8_t otapp_msg_tlv_msgWriterAddFn(void *addCtx, const uint16_t key, const uint16_t valueLengthIn, const uint8_t *valueIn)
+{
+    return otapp_msg_tlv_msgWriterAdd((otapp_msg_tlv_msgWriter_t *)addCtx, key, valueLengthIn, valueIn);
+}
+
+int8_t otapp_msg_tlv_msgWriterFinish(otapp_msg_tlv_msgWriter_t *writer, uint16_t *totalSizeOut)
+{
+    if(writer == NULL)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    const uint16_t reserved = otapp_msg_tlv_reservedEncode(writer->usedBytes, writer->format);
+
+    // header outside the window (next blocks, size pass): nothing to patch
+    if(writer->windowStart == 0 && writer->windowEnd >= OT_APP_MSG_TLV_RESERVED_SIZE &&
+       otMessageWrite(writer->message, writer->headerOffset, &reserved, sizeof(reserved)) != sizeof(reserved))
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    if(totalSizeOut != NULL)
+    {
+        *totalSizeOut = OT_APP_MSG_TLV_RESERVED_SIZE + writer->usedBytes;
+    }
+
+    return OT_APP_MSG_TLV_OK;
+}
+
+int8_t otapp_msg_tlv_msgReaderInit(otapp_msg_tlv_msgReader_t *reader, const otMessage *message, const uint16_t offset)
+{
+    uint16_t reserved = 0;
+    uint16_t usedBytes;
+    uint8_t format;
+
+    if(reader == NULL || message == NULL)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    if(otMessageRead(message, offset, &reserved, sizeof(reserved)) != sizeof(reserved))
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    otapp_msg_tlv_reservedDecode(reserved, &usedBytes, &format);
+
+    const uint32_t end = (uint32_t)offset + OT_APP_MSG_TLV_RESERVED_SIZE + usedBytes;
+    if(end > otMessageGetLength(message)) // TLV data longer than the message
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    reader->message = message;
+    reader->offset  = offset + OT_APP_MSG_TLV_RESERVED_SIZE;
+    reader->end     = (uint16_t)end;
+    reader->prevKey = 0;
+    reader->format  = format;
+
+    return OT_APP_MSG_TLV_OK;
+}
+
+int8_t otapp_msg_tlv_msgReaderNext(otapp_msg_tlv_msgReader_t *reader, otapp_msg_tlv_msgItem_t *itemOut)
+{
+    uint8_t hdr[OT_APP_MSG_TLV_HDR_SIZE_MAX];
+    uint16_t hdrRead;
+    uint16_t key;
+    uint16_t length;
+    uint8_t hdrSize;
+
+    if(reader == NULL || reader->message == NULL || itemOut == NULL)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    if(reader->offset >= reader->end)
+    {
+        return OT_APP_MSG_TLV_END;
+    }
+
+    const uint16_t left = reader->end - reader->offset;
+
+    // header has variable size (compact): read what may be a header, decode tells how much it was
+    hdrRead = (left < sizeof(hdr)) ? left : sizeof(hdr);
+    if(otMessageRead(reader->message, reader->offset, hdr, hdrRead) != hdrRead)
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    hdrSize = otapp_msg_tlv_hdrDecode(hdr, hdrRead, reader->format, reader->prevKey, &key, &length);
+    if(hdrSize == 0 || length > (left - hdrSize)) // block header or value crosses TLV data
+    {
+        return OT_APP_MSG_TLV_ERROR;
+    }
+
+    itemOut->key         = key;
+    itemOut->length      = length;
+    itemOut->valueOffset = reader->offset + hdrSize;
+
+    reader->offset  = itemOut->valueOffset + length;
+    reader->prevKey = key;
+
+    return OT_APP_MSG_TLV_OK;
+}
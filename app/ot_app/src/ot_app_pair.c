@@ -24,7 +24,7 @@
 
  #include "ot_app_drv.h"
  #include "ot_app_msg_tlv.h"
- #include "ot_app_buffer.h"
+ #include "ot_app_msg_tlv_msg.h"
 
 #include "string.h"
 
@@ -500,20 +500,47 @@ static inline int8_t otapp_pair_uriCheckString(const char* uri)
 #define OTAPP_PAIR_KEY_PATTERN      0xAA00
 #define OTAPP_PAIR_KEY_URIS_COUNT   OTAPP_PAIR_KEY_PATTERN
 
+#define OTAPP_PAIR_URI_ENC_FIELD(encMember, encType, decMember, decType, maxLength) OT_APP_MSG_TLV_SCHEMA_FIELD(otapp_coap_uri_t, encMember, encType, maxLength)
+#define OTAPP_PAIR_URI_DEC_FIELD(encMember, encType, decMember, decType, maxLength) OT_APP_MSG_TLV_SCHEMA_FIELD(otapp_pair_resUrisParseData_t, decMember, decType, maxLength)
+#define OTAPP_PAIR_URI_DEC_CHECK(encMember, encType, decMember, decType, maxLength) OT_APP_MSG_TLV_SCHEMA_FIELD_CHECK(otapp_pair_resUrisParseData_t, decMember, decType, maxLength)
+
+OTAPP_PAIR_URI_TLV_SCHEMA(OTAPP_PAIR_URI_DEC_CHECK)
+
+static const otapp_msg_tlv_field_t otapp_pair_uriEncFields[] = { OTAPP_PAIR_URI_TLV_SCHEMA(OTAPP_PAIR_URI_ENC_FIELD) };
+static const otapp_msg_tlv_field_t otapp_pair_uriDecFields[] = { OTAPP_PAIR_URI_TLV_SCHEMA(OTAPP_PAIR_URI_DEC_FIELD) };
+
+static const otapp_msg_tlv_schema_t otapp_pair_uriEncSchema = OT_APP_MSG_TLV_SCHEMA(otapp_coap_uri_t, otapp_pair_uriEncFields, OTAPP_PAIR_KEY_PATTERN);
+static const otapp_msg_tlv_schema_t otapp_pair_uriDecSchema = OT_APP_MSG_TLV_SCHEMA(otapp_pair_resUrisParseData_t, otapp_pair_uriDecFields, OTAPP_PAIR_KEY_PATTERN);
+
+// found-fields mask of one decoded URI, bit per schema field
+#define OTAPP_PAIR_URI_FIELDS_ALL   ((1U << (sizeof(otapp_pair_uriDecFields) / sizeof(otapp_pair_uriDecFields[0]))) - 1)
+#define OTAPP_PAIR_URI_PARSE_ALIGN  _Alignof(otapp_pair_resUrisParseData_t)
+
 uint16_t otapp_pair_uriResourcesCalculateBufSize(otapp_coap_uri_t *uri, uint8_t uriSize)
 {
     if(uri == NULL) return 0;
-    uint16_t count = 0;
 
-    otapp_msg_tlv_calcualeBuffer(sizeof(uint8_t), 0);
+    uint16_t recordsSize = otapp_msg_tlv_schemaSize(&otapp_pair_uriEncSchema, uri, uriSize);
+    if(recordsSize == 0) return 0;
+
+    return OT_APP_MSG_TLV_RESERVED_SIZE + OT_APP_MSG_TLV_BLOCK_SIZE_MAX(sizeof(uint8_t)) + recordsSize;
+}
+
+// the same key layout for a RAM buffer (builder) and for an otMessage (msgWriter)
+PRIVATE int8_t otapp_pair_uriResourcesWrite(otapp_coap_uri_t *uri, uint8_t uriSize, otapp_msg_tlv_addFn_t tlvAdd, void *tlvCtx)
+{
+    // quantity_of_uris | uri1_dt | uri1_path | uri2_dt | uri2_path | uri3_dt | uri3_path | ...
+    if(tlvAdd(tlvCtx, OTAPP_PAIR_KEY_URIS_COUNT, sizeof(uriSize), &uriSize) != OT_APP_MSG_TLV_OK)
+    {
+        return OTAPP_PAIR_ERROR;
+    }
 
-    for (uint8_t i = 0; i < uriSize; i++)
+    if(otapp_msg_tlv_schemaEncode(&otapp_pair_uriEncSchema, uri, uriSize, tlvAdd, tlvCtx) != OT_APP_MSG_TLV_OK)
     {
-        otapp_msg_tlv_calcualeBuffer(sizeof(uri->devType), 1);
-        count = otapp_msg_tlv_calcualeBuffer(strlen(uri[i].resource.mUriPath), 1);
+        return OTAPP_PAIR_ERROR;
     }
-    
-    return count;
+
+    return OTAPP_PAIR_OK;
 }
 
 int8_t otapp_pair_uriResourcesCreate(otapp_coap_uri_t *uri, uint8_t uriSize, uint8_t *bufferOut, uint16_t *bufferSizeInOut)
@@ -523,17 +550,24 @@ int8_t otapp_pair_uriResourcesCreate(otapp_coap_uri_t *uri, uint8_t uriSize, uin
         return OTAPP_PAIR_ERROR;
     }
     uint16_t writtenBufSpace;
-    // Add TLV block containing the number of available URIs
-    otapp_msg_tlv_keyAdd(bufferOut, *bufferSizeInOut, OTAPP_PAIR_KEY_URIS_COUNT, sizeof(uriSize), &uriSize);
+    otapp_msg_tlv_builder_t builder;
 
-    // Iterate through the list and append device types and URI paths as TLV blocks
-    for (size_t i = 0; i < uriSize; i++) // quantity_of_uris | uri1_dt | uri1_path | uri2_dt | uri2_path | uri3_dt | uri3_path | ...
-    {   
-        // Add device type using an incremented key
-        otapp_msg_tlv_keyAdd(bufferOut, *bufferSizeInOut, OTAPP_PAIR_KEY_PATTERN + 2*i + 1, sizeof(uri[i].devType), (uint8_t *)&uri[i].devType);
+#if OTAPP_PAIR_TLV_COMPACT
+    if(otapp_msg_tlv_formatSet(bufferOut, *bufferSizeInOut, OT_APP_MSG_TLV_FORMAT_COMPACT) != OT_APP_MSG_TLV_OK)
+    {
+        return OTAPP_PAIR_ERROR;
+    }
+#endif
 
-        // Add URI path string as the subsequent TLV block
-        otapp_msg_tlv_keyAdd(bufferOut, *bufferSizeInOut, OTAPP_PAIR_KEY_PATTERN + 2*i + 2, strlen(uri[i].resource.mUriPath), (uint8_t *)uri[i].resource.mUriPath);
+    // keys are generated below and unique, no duplicate scan needed
+    if(otapp_msg_tlv_builderInit(&builder, bufferOut, *bufferSizeInOut, OT_APP_MSG_TLV_BUILDER_TRUSTED) != OT_APP_MSG_TLV_OK)
+    {
+        return OTAPP_PAIR_ERROR;
+    }
+
+    if(otapp_pair_uriResourcesWrite(uri, uriSize, otapp_msg_tlv_builderAddFn, &builder) != OTAPP_PAIR_OK)
+    {
+        return OTAPP_PAIR_ERROR;
     }
 
     // Retrieve the final count of written bytes from the buffer header
@@ -547,71 +581,152 @@ int8_t otapp_pair_uriResourcesCreate(otapp_coap_uri_t *uri, uint8_t uriSize, uin
     return OTAPP_PAIR_OK;
 }
 
+int8_t otapp_pair_uriResourcesAppend(otapp_coap_uri_t *uri, uint8_t uriSize, otMessage *messageOut, uint16_t *appendedSizeOut)
+{
+    if(messageOut == NULL)
+    {
+        return OTAPP_PAIR_ERROR;
+    }
+    return otapp_pair_uriResourcesAppendWindow(uri, uriSize, messageOut, 0, UINT16_MAX, appendedSizeOut);
+}
+
+int8_t otapp_pair_uriResourcesAppendWindow(otapp_coap_uri_t *uri, uint8_t uriSize, otMessage *messageOut, uint16_t windowOffset, uint16_t windowSize, uint16_t *totalSizeOut)
+{
+    if(uri == NULL || uriSize == 0 || uriSize > OTAPP_PAIR_URI_MAX)
+    {
+        return OTAPP_PAIR_ERROR;
+    }
+    otapp_msg_tlv_msgWriter_t writer;
+
+    if(otapp_msg_tlv_msgWriterInitWindow(&writer, messageOut, OTAPP_PAIR_TLV_COMPACT ? OT_APP_MSG_TLV_FORMAT_COMPACT : OT_APP_MSG_TLV_FORMAT_CLASSIC, windowOffset, windowSize) != OT_APP_MSG_TLV_OK)
+    {
+        return OTAPP_PAIR_ERROR;
+    }
+
+    if(otapp_pair_uriResourcesWrite(uri, uriSize, otapp_msg_tlv_msgWriterAddFn, &writer) != OTAPP_PAIR_OK)
+    {
+        return OTAPP_PAIR_ERROR;
+    }
+
+    if(otapp_msg_tlv_msgWriterFinish(&writer, totalSizeOut) != OT_APP_MSG_TLV_OK)
+    {
+        return OTAPP_PAIR_ERROR;
+    }
+
+    return OTAPP_PAIR_OK;
+}
+
 uint16_t otapp_pair_uriParseMessageCalculateBufSize(uint16_t aMessagePayloadSize)
 {
-    uint16_t count = 0;
-    uint16_t uriMaxSize = 0;
-    const uint16_t structSize = sizeof(otapp_pair_resUrisParseData_t);
+    if(aMessagePayloadSize > OTAPP_PAIR_URI_TLV_SIZE_MAX(OTAPP_PAIRED_URI_MAX)) return 0;
 
-    otapp_msg_tlv_calcualeBuffer(sizeof(uint8_t), 0);
+    return aMessagePayloadSize + (OTAPP_PAIR_URI_PARSE_ALIGN - 1) + (OTAPP_PAIRED_URI_MAX * sizeof(otapp_pair_resUrisParseData_t));
+}
+
+// dstOut == NULL: obcy klucz, pominac
+PRIVATE int8_t otapp_pair_uriFieldGet(otapp_pair_resUrisParseData_t *urisData, uint8_t *fieldsFound, uint8_t urisCount, uint16_t key, uint16_t length, void **dstOut)
+{
+    uint8_t record;
+    uint8_t field;
 
-    for (uint8_t i = 0; i < OTAPP_PAIRED_URI_MAX; i++)
+    *dstOut = NULL;
+    switch (otapp_msg_tlv_schemaFieldGet(&otapp_pair_uriDecSchema, urisData, urisCount, key, length, dstOut, &record, &field))
     {
-        otapp_msg_tlv_calcualeBuffer(sizeof(uint32_t), 1);
-        uriMaxSize = otapp_msg_tlv_calcualeBuffer(OTAPP_URI_MAX_NAME_LENGHT, 1);
+        case OT_APP_MSG_TLV_OK:
+            fieldsFound[record] |= (uint8_t)(1U << field);
+            return OTAPP_PAIR_OK;
+
+        case OT_APP_MSG_TLV_KEY_NO_EXIST:
+            *dstOut = NULL;
+            return OTAPP_PAIR_OK;
+
+        default:
+            return OTAPP_PAIR_ERROR;
     }
-    
-    if(aMessagePayloadSize > uriMaxSize) return 0;
+}
 
-    count = aMessagePayloadSize + (OTAPP_PAIRED_URI_MAX * structSize);
-    return count;
+PRIVATE int8_t otapp_pair_uriFieldsCheck(otapp_pair_resUrisParseData_t *urisData, const uint8_t *fieldsFound, uint8_t urisCount)
+{
+    for (uint8_t i = 0; i < urisCount; i++)
+    {
+        if(fieldsFound[i] != OTAPP_PAIR_URI_FIELDS_ALL)
+        {
+            return OTAPP_PAIR_ERROR;
+        }
+        urisData[i].obs = 1; // every URI of the well-known/core list is observable
+    }
+    return OTAPP_PAIR_OK;
 }
 
 otapp_pair_resUrisParseData_t *otapp_pair_uriParseMessage(uint8_t *buffer, const uint16_t bufferSize, int8_t *resultOut, uint16_t *dataSizeOut)
 {  
     int8_t result;
     uint16_t usedBufSpace = 0;    
-    uint8_t urisCount; 
-    uint16_t keyLength;
-    uint16_t keyLengthCmp;
+    uint8_t urisCount = 0; 
+    void *dst;
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
     otapp_pair_resUrisParseData_t *urisData;
+    uint8_t fieldsFound[OTAPP_PAIR_URI_MAX] = {0};
     const uint16_t structSize = sizeof(otapp_pair_resUrisParseData_t);
 
-    result = otapp_msg_tlv_keyGet(buffer, bufferSize, OTAPP_PAIR_KEY_URIS_COUNT, NULL, &urisCount);
-    otapp_msg_tlv_getBufferTotalUsedSpace(buffer, bufferSize, &usedBufSpace); 
+    *resultOut = OTAPP_PAIR_ERROR;
 
-    if(usedBufSpace == 0 || result != OT_APP_MSG_TLV_KEY_EXIST)
+    if(dataSizeOut == NULL)
     {
-        *resultOut = OTAPP_PAIR_ERROR;
         return NULL;
     }
 
-    if((structSize * urisCount) > (bufferSize - usedBufSpace)) // sprawdzenie czy dostarczony buffer pomiesci dodatkowo sparsowane dane uris
+    // ilosc uris jest potrzebna przed zapisem danych, uriResourcesCreate() zapisuje ja jako pierwszy blok
+    result = otapp_msg_tlv_iterFirst(&iter, buffer, bufferSize, &item);
+    while (result == OT_APP_MSG_TLV_OK && item.key != OTAPP_PAIR_KEY_URIS_COUNT)
+    {
+        result = otapp_msg_tlv_iterNext(&iter, &item);
+    }
+
+    if(result != OT_APP_MSG_TLV_OK || item.length != sizeof(urisCount) || item.value[0] > OTAPP_PAIR_URI_MAX)
+    {
+        return NULL;
+    }
+    urisCount = item.value[0];
+
+    if(otapp_msg_tlv_getBufferTotalUsedSpace(buffer, bufferSize, &usedBufSpace) != OT_APP_MSG_TLV_OK)
+    {
+        return NULL;
+    }
+
+    // struktury leza za danymi TLV: wyrownanie adresu, dlugosc TLV jest dowolna
+    usedBufSpace += (uint16_t)((OTAPP_PAIR_URI_PARSE_ALIGN - ((uintptr_t)(buffer + usedBufSpace) % OTAPP_PAIR_URI_PARSE_ALIGN)) % OTAPP_PAIR_URI_PARSE_ALIGN);
+
+    if(usedBufSpace > bufferSize || (structSize * urisCount) > (uint16_t)(bufferSize - usedBufSpace)) // sprawdzenie czy dostarczony buffer pomiesci dodatkowo sparsowane dane uris
     {
-        *resultOut = OTAPP_PAIR_ERROR;
         return NULL;
     }
 
     urisData = (otapp_pair_resUrisParseData_t*)(buffer + usedBufSpace);
+    memset(urisData, 0, structSize * urisCount);
 
-    for (uint8_t i = 0; i < urisCount; i++)
+    if(otapp_msg_tlv_iterFirst(&iter, buffer, bufferSize, &item) != OT_APP_MSG_TLV_OK)
+    {
+        return NULL;
+    }
+
+    // jedno przejscie po buforze
+    do
     {
-        result = otapp_msg_tlv_keyGet(buffer, bufferSize, OTAPP_PAIR_KEY_PATTERN + 2*i + 1, &keyLength, (uint8_t*)&urisData[i].devTypeUriFn);
-        keyLengthCmp = sizeof(urisData->devTypeUriFn);
-        if(result != OT_APP_MSG_TLV_KEY_EXIST || keyLength > keyLengthCmp)
+        if(otapp_pair_uriFieldGet(urisData, fieldsFound, urisCount, item.key, item.length, &dst) != OTAPP_PAIR_OK)
         {
-            *resultOut = OTAPP_PAIR_ERROR;
             return NULL;
         }
-
-        result = otapp_msg_tlv_keyGet(buffer, bufferSize, OTAPP_PAIR_KEY_PATTERN + 2*i + 2, &keyLength, (uint8_t*)&urisData[i].uri);
-        keyLengthCmp = sizeof(urisData->uri);
-        if(result != OT_APP_MSG_TLV_KEY_EXIST || keyLength > keyLengthCmp)
+        if(dst != NULL)
         {
-            *resultOut = OTAPP_PAIR_ERROR;
-            return NULL;
+            memcpy(dst, item.value, item.length);
         }
-        urisData[i].obs = 1;       
+    } while ((result = otapp_msg_tlv_iterNext(&iter, &item)) == OT_APP_MSG_TLV_OK);
+
+    if(result != OT_APP_MSG_TLV_END || otapp_pair_uriFieldsCheck(urisData, fieldsFound, urisCount) != OTAPP_PAIR_OK)
+    {
+        return NULL;
     }
     
     *dataSizeOut = urisCount;
@@ -619,6 +734,59 @@ otapp_pair_resUrisParseData_t *otapp_pair_uriParseMessage(uint8_t *buffer, const
     return urisData;
 }
 
+int8_t otapp_pair_uriParseOtMessage(const otMessage *message, uint16_t offset, otapp_pair_resUrisParseData_t *urisOut, uint8_t urisOutMax, uint16_t *dataSizeOut)
+{
+    int8_t result;
+    uint8_t urisCount = 0;
+    uint8_t fieldsFound[OTAPP_PAIR_URI_MAX] = {0};
+    void *dst;
+    otapp_msg_tlv_msgReader_t reader;
+    otapp_msg_tlv_msgItem_t item;
+
+    if(message == NULL || urisOut == NULL || dataSizeOut == NULL)
+    {
+        return OTAPP_PAIR_ERROR;
+    }
+
+    // ilosc uris jest potrzebna przed zapisem danych
+    if(otapp_msg_tlv_msgReaderInit(&reader, message, offset) != OT_APP_MSG_TLV_OK)
+    {
+        return OTAPP_PAIR_ERROR;
+    }
+    while ((result = otapp_msg_tlv_msgReaderNext(&reader, &item)) == OT_APP_MSG_TLV_OK && item.key != OTAPP_PAIR_KEY_URIS_COUNT);
+
+    if(result != OT_APP_MSG_TLV_OK || item.length != sizeof(urisCount) ||
+       otMessageRead(message, item.valueOffset, &urisCount, sizeof(urisCount)) != sizeof(urisCount) ||
+       urisCount > urisOutMax || urisCount > OTAPP_PAIR_URI_MAX)
+    {
+        return OTAPP_PAIR_ERROR;
+    }
+
+    memset(urisOut, 0, sizeof(otapp_pair_resUrisParseData_t) * urisCount);
+
+    // drugie przejscie: wartosci czytane z wiadomosci prosto do urisOut
+    otapp_msg_tlv_msgReaderInit(&reader, message, offset);
+    while ((result = otapp_msg_tlv_msgReaderNext(&reader, &item)) == OT_APP_MSG_TLV_OK)
+    {
+        if(otapp_pair_uriFieldGet(urisOut, fieldsFound, urisCount, item.key, item.length, &dst) != OTAPP_PAIR_OK)
+        {
+            return OTAPP_PAIR_ERROR;
+        }
+        if(dst != NULL && otMessageRead(message, item.valueOffset, dst, item.length) != item.length)
+        {
+            return OTAPP_PAIR_ERROR;
+        }
+    }
+
+    if(result != OT_APP_MSG_TLV_END || otapp_pair_uriFieldsCheck(urisOut, fieldsFound, urisCount) != OTAPP_PAIR_OK)
+    {
+        return OTAPP_PAIR_ERROR;
+    }
+
+    *dataSizeOut = urisCount;
+    return OTAPP_PAIR_OK;
+}
+
 PRIVATE int8_t otapp_pair_uriTokenIsValid(const oacu_token_t *token)
 {
     uint8_t count = 0;
@@ -827,44 +995,18 @@ void otapp_pair_responseHandlerUriWellKnown(void *pairedDevice, otMessage *aMess
 
     if(pairedDevice == NULL){ OTAPP_PRINTF(TAG, " ERROR HandlerUriWellKnown: \n"); return; } 
 
-    int8_t result = 0;    
-    uint8_t *buffer = NULL; 
-    uint16_t bufferSize = 0;
-    uint16_t readBytes = 0;    
-    uint16_t messageLength = 0;
-    uint16_t messageOffset = 0;
-    
     otapp_pair_Device_t *device = (otapp_pair_Device_t*)pairedDevice;
     static oacu_token_t token[OAC_URI_OBS_TOKEN_LENGTH];
-    otapp_pair_resUrisParseData_t *parsedData = NULL;
+    otapp_pair_resUrisParseData_t parsedData[OTAPP_PAIR_URI_MAX];
     uint16_t parsedDataSize = 0; // number of uri structures to add to the list 
 
     
     OTAPP_PRINTF(TAG, "responseHandlerUriWellKnown IN \n");
     if (aMessage)
     {
-        messageOffset = otMessageGetOffset(aMessage);
-        messageLength = otMessageGetLength(aMessage) - messageOffset;
-
-        bufferSize = otapp_pair_uriParseMessageCalculateBufSize(messageLength);
-        if(bufferSize == 0){ OTAPP_PRINTF(TAG, " ERROR HandlerUriWellKnown: bufferSize = 0 \n"); return; }
-
-        buffer = otapp_buf_getWriteOnly_ptr(OTAPP_BUF_KEY_1, bufferSize);
-        if(buffer == NULL) { OTAPP_PRINTF(TAG, " ERROR HandlerUriWellKnown: NULL BUF \n"); return; } 
-
-        readBytes = otMessageRead(aMessage, messageOffset, buffer, messageLength);
-
-        if(readBytes == 0 || readBytes != messageLength) 
-        {
-            otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
-            OTAPP_PRINTF(TAG, " ERROR HandlerUriWellKnown: \n");
-            return;
-        }
-        
-        parsedData = otapp_pair_uriParseMessage(buffer, bufferSize, &result, &parsedDataSize);
-        if(parsedData == NULL || result != OTAPP_PAIR_OK)
+        // TLV is decoded straight from the message, no payload copy
+        if(otapp_pair_uriParseOtMessage(aMessage, otMessageGetOffset(aMessage), parsedData, OTAPP_PAIR_URI_MAX, &parsedDataSize) != OTAPP_PAIR_OK)
         {
-            otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
             OTAPP_PRINTF(TAG, " ERROR HandlerUriWellKnown: \n");
             return;
         }
@@ -881,7 +1023,6 @@ void otapp_pair_responseHandlerUriWellKnown(void *pairedDevice, otMessage *aMess
                 otapp_pair_uriAdd(&device->urisList[i], &parsedData[i], NULL);
             }
         }
-        otapp_buf_writeUnlock(OTAPP_BUF_KEY_1);
         otapp_pair_observerPairedDeviceNotify(device); 
     }else
     {
@@ -79,6 +79,7 @@ typedef struct{
     otapp_pair_Device_t *dev;
     char        eui[OT_BTN_EUI_BUF_SIZE]; 
     ad_btn_btnIteams_t  btn;
+    otapp_coap_nonStream_t dimStream;       // long press: NON updates with periodic CON checkpoint
     uint8_t         isTaken             : 1;  // flag of availability on the list
     
 }ad_btn_t;
@@ -509,7 +510,7 @@ static uint32_t ad_btn_uriStateSetNewRgb(uint8_t btnListId, otapp_deviceType_t u
     return ad_btn_uriStateSetNewValue(btnListId, uriDevType);
 }
 
-static void ad_btn_coapSend(uint8_t btnListId, uint32_t *newState, otapp_deviceType_t uriDevType)
+static void ad_btn_coapSend(uint8_t btnListId, uint32_t *newState, otapp_deviceType_t uriDevType, otapp_coap_transport_t transport)
 {
     otIp6Address *ipAddr;
     char *uriPath;
@@ -520,13 +521,15 @@ static void ad_btn_coapSend(uint8_t btnListId, uint32_t *newState, otapp_deviceT
     uriPath = btnList[btnListId].dev->urisList[uriListId].uri;
 
     // send coap message
-    drv->api.coap.sendBytePut(ipAddr,uriPath, (uint8_t*)newState, sizeof(newState), ad_btn_coapResHandle, NULL);    
+    // latest value wins: a new state replaces the one waiting behind the request in flight
+    drv->api.coap.sendBytePutCoalesce(ipAddr,uriPath, (uint8_t*)newState, sizeof(newState), transport, ad_btn_coapResHandle, NULL);    
 }
 
-static int8_t ad_btn_event(uint16_t gpioNum, otapp_deviceType_t uriDevType, ad_btn_uriState_callback uriStateClb, char * btnName)
+static int8_t ad_btn_event(uint16_t gpioNum, otapp_deviceType_t uriDevType, ad_btn_uriState_callback uriStateClb, char * btnName, uint8_t isStream)
 {
     int8_t btnListId, result;
     uint32_t newState; 
+    otapp_coap_transport_t transport = OTAPP_COAP_TRANSPORT_CON;
 
     btnListId = ad_btn_getBtnId(gpioNum);
     if(btnListId == AD_BUTTON_ERROR) return AD_BUTTON_ERROR;
@@ -540,7 +543,11 @@ static int8_t ad_btn_event(uint16_t gpioNum, otapp_deviceType_t uriDevType, ad_b
         // togle light and save uriState
         newState = uriStateClb(btnListId, uriDevType);
 
-        ad_btn_coapSend(btnListId, &newState, uriDevType);
+        if(isStream) // repeated event (long press)
+        {
+            transport = drv->api.coap.nonStreamNext(&btnList[btnListId].dimStream);
+        }
+        ad_btn_coapSend(btnListId, &newState, uriDevType, transport);
 
         OTAPP_PRINTF(TAG, "%s: send state: %ld  \n",btnName, newState);
     }
@@ -578,7 +585,7 @@ static void ad_btn_eventOneClick(uint16_t gpioNum)
             // togle light and save uriState
             newState = ad_btn_uriStateSetNewTogle(btnListId, OTAPP_LIGHTING_ON_OFF); 
 
-            ad_btn_coapSend(btnListId, &newState, OTAPP_LIGHTING_ON_OFF);
+            ad_btn_coapSend(btnListId, &newState, OTAPP_LIGHTING_ON_OFF, OTAPP_COAP_TRANSPORT_CON);
 
             OTAPP_PRINTF(TAG, "oneClick: send state: %ld  \n", newState);
         }
@@ -603,18 +610,31 @@ static void ad_btn_oneClick(uint16_t gpioNum)
 
 static void ad_btn_doubleClick(uint16_t gpioNum)
 {
-    ad_btn_event(gpioNum, OTAPP_LIGHTING_RGB, ad_btn_uriStateSetNewRgb, "doubleClick");
+    ad_btn_event(gpioNum, OTAPP_LIGHTING_RGB, ad_btn_uriStateSetNewRgb, "doubleClick", 0);
 }
 
 static void ad_btn_longPressStart(uint16_t gpioNum)
 {    
     ad_btn_resetStart(&ad_btn_resHandle, gpioNum, OT_BTN_OB_LONG_PRESS);    
-    ad_btn_event(gpioNum, OTAPP_LIGHTING_DIMM, ad_btn_uriStateSetNewDimm, "longPress");    
+    ad_btn_event(gpioNum, OTAPP_LIGHTING_DIMM, ad_btn_uriStateSetNewDimm, "longPress", 1); // repeated every tick: NON stream
 }
 
 static void ad_btn_longPressStop(uint16_t gpioNum)
 {    
+    int8_t btnListId;
+    uint32_t dimState;
+
     ad_btn_resetStop(&ad_btn_resHandle, gpioNum); // stop reset sequence
+
+    btnListId = ad_btn_getBtnId(gpioNum);
+    if(btnListId == AD_BUTTON_ERROR) return;
+
+    // last NON step could be lost: final value as CON checkpoint, next long press starts a new stream
+    if(drv->api.coap.nonStreamStop(&btnList[btnListId].dimStream) && ad_btn_isTaken(btnListId) == 1)
+    {
+        dimState = ad_btn_uriStateGet(btnListId, OTAPP_LIGHTING_DIMM);
+        ad_btn_coapSend(btnListId, &dimState, OTAPP_LIGHTING_DIMM, OTAPP_COAP_TRANSPORT_CON);
+    }
 }
 
 
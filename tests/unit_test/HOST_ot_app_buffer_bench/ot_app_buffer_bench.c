@@ -0,0 +1,205 @@
+/**
+ * @file ot_app_buffer_bench.c
+ * @brief Host contention benchmark of ot_app_buffer (pthread semaphore mock).
+ *
+ * Every operation (append, getData, write pointer acquire) is run with 1..16 threads on one key
+ * and with several payload sizes. Each call is timed separately, the output is CSV on stdout:
+ *
+ *   op,threads,payload,ops,ops_per_sec,p50_ns,p99_ns,p999_ns
+ *
+ * Usage: HOST_ot_app_buffer_bench [--quick]
+ *   --quick  fewer operations per run (smoke run)
+ *
+ * Compare two CSV files (before / after a locking change) to spot regressions.
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "ot_app_buffer.h"
+#include "mock_freertos_semaphore_pthread.h"
+
+#define BENCH_KEY               OTAPP_BUF_KEY_1
+#define BENCH_OPS_TOTAL         200000  // per run, split between the threads
+#define BENCH_OPS_TOTAL_QUICK   20000
+#define BENCH_PAYLOAD_MAX       256
+
+typedef enum {
+    BENCH_OP_APPEND = 0,
+    BENCH_OP_GET_DATA,
+    BENCH_OP_WRITE_PTR,
+} bench_op_t;
+
+static const char *bench_opName[] = { "append", "getData", "writePtr" };
+static const uint8_t bench_threads[] = { 1, 2, 4, 8, 16 };
+static const uint16_t bench_payload[] = { 8, 64, 256 };
+
+#define BENCH_ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+typedef struct {
+    bench_op_t op;
+    uint16_t payload;
+    uint32_t ops;
+    uint64_t *lat_ns;           // ops samples of this thread
+    pthread_barrier_t *start;
+    uint64_t t_start_ns;        // wall time of the first / after the last op
+    uint64_t t_end_ns;
+} bench_thread_t;
+
+static uint8_t bench_data[BENCH_PAYLOAD_MAX];
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int bench_cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void bench_one_op(bench_op_t op, uint16_t payload, uint8_t *out)
+{
+    uint16_t outLen = 0;
+    uint8_t *ptr = NULL;
+
+    switch (op)
+    {
+    case BENCH_OP_APPEND:
+        if(otapp_buf_append(BENCH_KEY, bench_data, payload) == OTAPP_BUF_ERROR_OVERFLOW)
+        {
+            otapp_buff_clear(BENCH_KEY);
+        }
+        break;
+
+    case BENCH_OP_GET_DATA:
+        otapp_buf_getData(BENCH_KEY, out, BENCH_PAYLOAD_MAX, &outLen);
+        break;
+
+    case BENCH_OP_WRITE_PTR:
+        // acquire cost under contention: retry until the slot is ours
+        while((ptr = otapp_buf_getWriteOnly_ptrNoClear(BENCH_KEY, payload)) == NULL)
+        {
+            sched_yield();
+        }
+        memcpy(ptr, bench_data, payload);
+        otapp_buf_writeUnlock(BENCH_KEY);
+        break;
+    }
+}
+
+static void* bench_thread(void *arg)
+{
+    bench_thread_t *t = (bench_thread_t*)arg;
+    uint8_t out[BENCH_PAYLOAD_MAX];
+
+    pthread_barrier_wait(t->start);
+
+    t->t_start_ns = bench_now_ns();
+    for (uint32_t i = 0; i < t->ops; i++)
+    {
+        uint64_t t0 = bench_now_ns();
+        bench_one_op(t->op, t->payload, out);
+        t->lat_ns[i] = bench_now_ns() - t0;
+    }
+    t->t_end_ns = bench_now_ns();
+    return NULL;
+}
+
+static void bench_prepare(bench_op_t op, uint16_t payload)
+{
+    otapp_buf_writeUnlock(BENCH_KEY);
+    otapp_buff_clear(BENCH_KEY);
+
+    if(op == BENCH_OP_GET_DATA)
+    {
+        otapp_buf_append(BENCH_KEY, bench_data, payload);
+    }
+}
+
+static void bench_run(bench_op_t op, uint8_t threads, uint16_t payload, uint32_t opsTotal)
+{
+    pthread_t thread[16];
+    bench_thread_t ctx[16];
+    pthread_barrier_t start;
+    uint32_t opsPerThread = opsTotal / threads;
+    uint32_t samples = opsPerThread * threads;
+    uint64_t *lat = malloc(sizeof(uint64_t) * samples);
+
+    if(lat == NULL) return;
+
+    bench_prepare(op, payload);
+    pthread_barrier_init(&start, NULL, threads + 1);
+
+    for (uint8_t i = 0; i < threads; i++)
+    {
+        ctx[i] = (bench_thread_t){ .op = op, .payload = payload, .ops = opsPerThread,
+                                   .lat_ns = &lat[i * opsPerThread], .start = &start };
+        pthread_create(&thread[i], NULL, bench_thread, &ctx[i]);
+    }
+
+    pthread_barrier_wait(&start);
+
+    // throughput window: first op of any thread .. last op of any thread
+    uint64_t first = UINT64_MAX, last = 0;
+    for (uint8_t i = 0; i < threads; i++)
+    {
+        pthread_join(thread[i], NULL);
+        if(ctx[i].t_start_ns < first) first = ctx[i].t_start_ns;
+        if(ctx[i].t_end_ns > last) last = ctx[i].t_end_ns;
+    }
+    uint64_t elapsed = last - first;
+    pthread_barrier_destroy(&start);
+
+    qsort(lat, samples, sizeof(uint64_t), bench_cmp_u64);
+
+    printf("%s,%u,%u,%u,%.0f,%llu,%llu,%llu\n", bench_opName[op], threads, payload, samples,
+           (double)samples * 1e9 / (double)(elapsed ? elapsed : 1),
+           (unsigned long long)lat[(samples - 1) * 50 / 100],
+           (unsigned long long)lat[(samples - 1) * 99 / 100],
+           (unsigned long long)lat[(uint64_t)(samples - 1) * 999 / 1000]);
+    fflush(stdout);
+
+    free(lat);
+}
+
+int main(int argc, const char **argv)
+{
+    uint32_t opsTotal = BENCH_OPS_TOTAL;
+
+    if(argc > 1 && strcmp(argv[1], "--quick") == 0)
+    {
+        opsTotal = BENCH_OPS_TOTAL_QUICK;
+    }
+
+    for (uint16_t i = 0; i < BENCH_PAYLOAD_MAX; i++)
+    {
+        bench_data[i] = (uint8_t)i;
+    }
+
+    mock_rtos_pthread_mutex_onOff(1);
+    otapp_buffer_init();
+
+    printf("op,threads,payload,ops,ops_per_sec,p50_ns,p99_ns,p999_ns\n");
+
+    for (uint8_t op = BENCH_OP_APPEND; op <= BENCH_OP_WRITE_PTR; op++)
+    {
+        for (uint8_t p = 0; p < BENCH_ARRAY_SIZE(bench_payload); p++)
+        {
+            for (uint8_t t = 0; t < BENCH_ARRAY_SIZE(bench_threads); t++)
+            {
+                bench_run((bench_op_t)op, bench_threads[t], bench_payload[p], opsTotal);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "unity_fixture.h"
+#include <string.h>
+#include <stdint.h>
+
+#include "ot_app_buffer.h"
+
+// built without OTAPP_BUF_POISON, as the firmware: cleared bytes are zero, no-clear bytes are left as they were
+
+static uint16_t test_otapp_buf_key = OTAPP_BUF_KEY_1;
+
+static const uint8_t data[16] = {
+    0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0xCC, 0xDD,
+    0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0xCC, 0xDD
+    };
+
+static void test_ot_app_buff_assertFilled(const uint8_t *ptr, uint8_t byte, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX8(byte, ptr[i]);
+    }
+}
+
+TEST_GROUP(ot_app_buffer_default);
+
+TEST_SETUP(ot_app_buffer_default)
+{
+    /* Init before every test */
+    otapp_buffer_init();
+    otapp_buff_clear(test_otapp_buf_key);
+    otapp_buf_writeUnlock(test_otapp_buf_key);
+}
+
+TEST_TEAR_DOWN(ot_app_buffer_default)
+{
+    /* Cleanup after every test */
+}
+
+TEST(ot_app_buffer_default, given_written_slot_when_call_clear_then_slot_zeroed)
+{
+    uint8_t *dataPtr = NULL;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_key, data, sizeof(data)));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buff_clear(test_otapp_buf_key));
+    TEST_ASSERT_EQUAL(0, otapp_buf_getCurrentLenSize(test_otapp_buf_key));
+
+    // no-clear acquisition shows what clear left in the slot
+    dataPtr = otapp_buf_getWriteOnly_ptrNoClear(test_otapp_buf_key, sizeof(data));
+    TEST_ASSERT_NOT_NULL(dataPtr);
+    test_ot_app_buff_assertFilled(dataPtr, 0x00, sizeof(data));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_writeUnlock(test_otapp_buf_key));
+}
+
+TEST(ot_app_buffer_default, given_written_slot_when_call_leaseWriteEx_no_clear_then_bytes_kept)
+{
+    otapp_buf_lease_t lease = OTAPP_BUF_LEASE_INIT;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), sizeof(data), &lease));
+    memcpy(lease.data, data, sizeof(data));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&lease));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, 
+        otapp_buf_leaseWriteEx(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), sizeof(data), 0, OTAPP_BUF_ACQ_NO_CLEAR, &lease));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(data, lease.data, sizeof(data));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&lease));
+
+    // default acquisition zeroes
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), sizeof(data), &lease));
+    test_ot_app_buff_assertFilled(lease.data, 0x00, sizeof(data));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&lease));
+}
+
+TEST(ot_app_buffer_default, given_freed_block_when_call_slabAllocEx_no_clear_then_bytes_kept)
+{
+    uint8_t *block = otapp_buf_slabAllocEx(32, OTAPP_BUF_ACQ_NO_CLEAR, NULL);
+    uint8_t *again = NULL;
+
+    TEST_ASSERT_NOT_NULL(block);
+    memset(block, 0x11, 32);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabFree(block));
+
+    // the free list link lives in the first bytes of a free block
+    again = otapp_buf_slabAllocEx(32, OTAPP_BUF_ACQ_NO_CLEAR, NULL);
+    TEST_ASSERT_EQUAL_PTR(block, again);
+    test_ot_app_buff_assertFilled(again + sizeof(void*), 0x11, 32 - sizeof(void*));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabFree(again));
+
+    again = otapp_buf_slabAlloc(32, NULL);
+    TEST_ASSERT_EQUAL_PTR(block, again);
+    test_ot_app_buff_assertFilled(again, 0x00, 32);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabFree(again));
+}
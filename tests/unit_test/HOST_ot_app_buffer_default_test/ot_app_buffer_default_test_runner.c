@@ -0,0 +1,8 @@
+#include "unity_fixture.h"
+
+TEST_GROUP_RUNNER(ot_app_buffer_default)
+{
+   RUN_TEST_CASE(ot_app_buffer_default, given_written_slot_when_call_clear_then_slot_zeroed);
+   RUN_TEST_CASE(ot_app_buffer_default, given_written_slot_when_call_leaseWriteEx_no_clear_then_bytes_kept);
+   RUN_TEST_CASE(ot_app_buffer_default, given_freed_block_when_call_slabAllocEx_no_clear_then_bytes_kept);
+}
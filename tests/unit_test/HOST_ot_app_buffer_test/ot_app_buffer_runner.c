@@ -34,6 +34,69 @@ TEST_GROUP_RUNNER(ot_app_buffer)
    RUN_TEST_CASE(ot_app_buffer, buffer_should_survive_multithreaded_race_condition_when_mutex_on_retorn_ok);
    RUN_TEST_CASE(ot_app_buffer, buffer_should_not_survive_multithreaded_race_condition_when_mutex_off_return_error);
 
+   // SPSC ring slot
+   RUN_TEST_CASE(ot_app_buffer, given_ring_key_when_append_and_getData_return_fifo_order);
+   RUN_TEST_CASE(ot_app_buffer, given_ring_key_when_data_wraps_return_ok);
+   RUN_TEST_CASE(ot_app_buffer, given_full_ring_key_when_append_return_overflow);
+   RUN_TEST_CASE(ot_app_buffer, given_ring_key_when_call_zero_copy_api_return_error);
+   RUN_TEST_CASE(ot_app_buffer, ring_should_survive_producer_consumer_threads_without_mutex_return_ok);
+
+   // striped per-slot locking
+   RUN_TEST_CASE(ot_app_buffer, given_two_keys_when_call_appendFromKey_return_ok);
+   RUN_TEST_CASE(ot_app_buffer, given_false_args_when_call_appendFromKey_return_error);
+   RUN_TEST_CASE(ot_app_buffer, given_too_much_data_when_call_appendFromKey_return_overflow);
+   RUN_TEST_CASE(ot_app_buffer, given_write_locked_key_when_call_appendFromKey_return_write_lock);
+   RUN_TEST_CASE(ot_app_buffer, appendFromKey_in_opposite_directions_should_not_deadlock);
+   RUN_TEST_CASE(ot_app_buffer, given_bombers_spread_over_keys_when_append_then_no_append_is_lost);
+
+   // compile-time slot handles
+   RUN_TEST_CASE(ot_app_buffer, given_config_keys_when_call_keyToSlot_return_table_index);
+   RUN_TEST_CASE(ot_app_buffer, given_invalid_slot_when_call_slot_api_return_error);
+   RUN_TEST_CASE(ot_app_buffer, given_slot_handle_when_call_slot_api_return_same_data_as_key_api);
+
+   // zero-copy leases
+   RUN_TEST_CASE(ot_app_buffer, given_read_leases_when_acquire_many_readers_share_data);
+   RUN_TEST_CASE(ot_app_buffer, given_read_lease_when_acquire_writer_return_write_lock);
+   RUN_TEST_CASE(ot_app_buffer, given_write_lease_when_acquire_reader_return_write_lock);
+   RUN_TEST_CASE(ot_app_buffer, given_false_args_when_call_lease_return_error);
+   RUN_TEST_CASE(ot_app_buffer, given_scoped_write_lease_when_scope_ends_release_and_commit_data);
+   RUN_TEST_CASE(ot_app_buffer, given_reduced_write_lease_when_release_commit_lease_len_unlike_writeUnlock);
+   RUN_TEST_CASE(ot_app_buffer, given_leaked_lease_when_call_reportLeaks_return_held_count);
+
+   // slab allocator
+   RUN_TEST_CASE(ot_app_buffer, given_small_size_when_call_slabAlloc_return_smallest_class_block);
+   RUN_TEST_CASE(ot_app_buffer, given_exhausted_class_when_call_slabAlloc_fall_back_then_fail);
+   RUN_TEST_CASE(ot_app_buffer, given_false_ptr_when_call_slabFree_return_error);
+   RUN_TEST_CASE(ot_app_buffer, given_scoped_slab_block_when_scope_ends_block_is_freed);
+   RUN_TEST_CASE(ot_app_buffer, slab_should_give_private_blocks_to_concurrent_threads);
+
+   // write wait queue
+   RUN_TEST_CASE(ot_app_buffer, given_held_slot_when_call_leaseWriteTimed_return_timeout);
+   RUN_TEST_CASE(ot_app_buffer, given_released_slot_when_writers_wait_hand_off_in_fifo_order);
+   RUN_TEST_CASE(ot_app_buffer, given_full_wait_queue_when_call_leaseWriteTimed_return_write_lock);
+   RUN_TEST_CASE(ot_app_buffer, given_locked_key_when_unlocked_during_wait_getWriteOnly_ptrTimed_return_ok);
+   RUN_TEST_CASE(ot_app_buffer, given_locked_key_when_waiting_forever_writer_is_woken_by_unlock);
+   RUN_TEST_CASE(ot_app_buffer, given_exhausted_class_when_call_slabAllocTimed_return_timeout);
+   RUN_TEST_CASE(ot_app_buffer, given_exhausted_class_when_block_freed_during_wait_slabAllocTimed_return_it);
+
+   // scatter-gather
+   RUN_TEST_CASE(ot_app_buffer, given_fragments_when_call_appendv_return_concatenated_data);
+   RUN_TEST_CASE(ot_app_buffer, given_too_long_vector_when_call_appendv_return_overflow_and_copy_nothing);
+   RUN_TEST_CASE(ot_app_buffer, given_false_args_when_call_appendv_and_getDatav_return_error);
+   RUN_TEST_CASE(ot_app_buffer, given_slot_data_when_call_getDatav_scatter_over_fragments);
+   RUN_TEST_CASE(ot_app_buffer, given_ring_key_when_call_appendv_and_getDatav_wrap_return_fifo_order);
+   RUN_TEST_CASE(ot_app_buffer, appendv_records_should_not_interleave_between_threads);
+
+   // no-clear acquisition / poisoning
+   RUN_TEST_CASE(ot_app_buffer, given_cleared_slot_when_call_getWriteOnly_ptrNoClear_return_poisoned_bytes);
+   RUN_TEST_CASE(ot_app_buffer, given_no_clear_flag_when_call_leaseWriteEx_return_poisoned_bytes);
+   RUN_TEST_CASE(ot_app_buffer, given_no_clear_flag_when_call_slabAllocEx_return_poisoned_block);
+
+   // telemetry
+   RUN_TEST_CASE(ot_app_buffer, given_appends_and_rejections_when_call_getStats_return_counters);
+   RUN_TEST_CASE(ot_app_buffer, given_bombers_on_one_key_when_call_getStats_count_contention_within_acquisitions);
+   RUN_TEST_CASE(ot_app_buffer, given_ring_key_when_call_getStats_return_peak_and_overflow);
+
    
 }
 
@@ -2,6 +2,9 @@
 #include <pthread.h>
 #include <unistd.h> // for usleep()
 #include <sched.h>  // for sched_yield()
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
 
 #include "ot_app_buffer.h"
 #include "mock_freertos_semaphore_pthread.h"
@@ -12,6 +15,9 @@
 
 #define TEST_OTAPP_BUF_KEY_NOT_EXIST    0x3001
 static uint16_t test_otapp_buf_key = OTAPP_BUF_KEY_1;
+static uint16_t test_otapp_buf_ring_key = OTAPP_BUF_KEY_4;
+
+#define TEST_OT_APP_BUF_RING_BYTES 100000
 
 #define TEST_OT_APP_BUF_SIZE 32
 static const uint8_t data[32] = {
@@ -31,6 +37,7 @@ TEST_SETUP(ot_app_buffer)
     otapp_buffer_init();
     otapp_buff_clear(test_otapp_buf_key);
     otapp_buf_writeUnlock(test_otapp_buf_key);
+    otapp_buff_clear(test_otapp_buf_ring_key);
 }
 
 TEST_TEAR_DOWN(ot_app_buffer)
@@ -49,7 +56,8 @@ static int8_t test_ot_app_buff_appendByte(uint16_t cnt, uint8_t byte)
 }
 static void* buffer_bomber_thread(void* arg) 
 {
-    (void)arg;
+    // arg: optional pointer to the key under attack (NULL = test_otapp_buf_key)
+    uint16_t key = (arg != NULL) ? *(uint16_t*)arg : test_otapp_buf_key;
     uint8_t data_chunk = 0xAA; // one byte of data
     
     // Each thread tries to write WRITES_PER_THREAD bytes (1 byte each). 
@@ -57,7 +65,7 @@ static void* buffer_bomber_thread(void* arg)
     // return OTAPP_BUF_ERROR_OVERFLOW and don't corrupt the buffer!
     for(int i = 0; i < WRITES_PER_THREAD; i++) 
     {        
-        otapp_buf_append(test_otapp_buf_key, &data_chunk, 1); 
+        otapp_buf_append(key, &data_chunk, 1); 
 
         sched_yield(); 
         // usleep(1);
@@ -86,6 +94,31 @@ uint16_t test_ot_app_buff_start_multithreaded_race_condition(uint8_t mutexState)
     return otapp_buf_getCurrentLenSize(test_otapp_buf_key);    
 }
 
+#define TEST_OT_APP_BUF_BOMBER_THREADS 6
+static const uint16_t test_otapp_buf_keys[] = {OTAPP_BUF_KEY_1, OTAPP_BUF_KEY_2, OTAPP_BUF_KEY_3};
+
+// runs TEST_OT_APP_BUF_BOMBER_THREADS bombers spread round-robin over keysQty keys
+static void test_ot_app_buff_start_bomber_on_keys(uint8_t keysQty)
+{
+    pthread_t thread[TEST_OT_APP_BUF_BOMBER_THREADS];
+    uint16_t  threadKey[TEST_OT_APP_BUF_BOMBER_THREADS];
+
+    for (uint8_t k = 0; k < keysQty; k++)
+    {
+        otapp_buff_clear(test_otapp_buf_keys[k]);
+    }
+
+    for (uint8_t i = 0; i < TEST_OT_APP_BUF_BOMBER_THREADS; i++)
+    {
+        threadKey[i] = test_otapp_buf_keys[i % keysQty];
+        pthread_create(&thread[i], NULL, buffer_bomber_thread, &threadKey[i]);
+    }
+    for (uint8_t i = 0; i < TEST_OT_APP_BUF_BOMBER_THREADS; i++)
+    {
+        pthread_join(thread[i], NULL);
+    }
+}
+
 // otapp_buf_append
 TEST(ot_app_buffer, given_false_args_when_call_append_return_error)
 {
@@ -367,4 +400,1062 @@ TEST(ot_app_buffer, buffer_should_not_survive_multithreaded_race_condition_when_
 
     TEST_ASSERT_NOT_EQUAL_MESSAGE(maxSize, finalLen, 
         "Race error! Either the Bounds Check was interrupted or the len variable increments were lost.");
-}
\ No newline at end of file
+}
+
+//////////////////////////////
+// SPSC ring slot
+static void* ring_producer_thread(void* arg) 
+{
+    (void)arg;
+    uint8_t chunk[3];
+    uint32_t seq = 0;
+    
+    while(seq < TEST_OT_APP_BUF_RING_BYTES) 
+    {
+        uint16_t len = (TEST_OT_APP_BUF_RING_BYTES - seq) < sizeof(chunk) ? (TEST_OT_APP_BUF_RING_BYTES - seq) : sizeof(chunk);
+        for (uint16_t i = 0; i < len; i++)
+        {
+            chunk[i] = (uint8_t)(seq + i);
+        }
+
+        if(otapp_buf_append(test_otapp_buf_ring_key, chunk, len) == OTAPP_BUF_OK)
+        {
+            seq += len;
+        }else
+        {
+            sched_yield(); 
+        }
+    }    
+    return NULL;
+}
+
+static void* ring_consumer_thread(void* arg) 
+{
+    uint32_t *errors = (uint32_t*)arg;
+    uint8_t chunk[5];
+    uint16_t readLen = 0;
+    uint32_t seq = 0;
+    
+    while(seq < TEST_OT_APP_BUF_RING_BYTES) 
+    {
+        if(otapp_buf_getData(test_otapp_buf_ring_key, chunk, sizeof(chunk), &readLen) == OTAPP_BUF_OK)
+        {
+            for (uint16_t i = 0; i < readLen; i++)
+            {
+                if(chunk[i] != (uint8_t)(seq + i)) (*errors)++;
+            }
+            seq += readLen;
+        }else
+        {
+            sched_yield(); 
+        }
+    }    
+    return NULL;
+}
+
+TEST(ot_app_buffer, given_ring_key_when_append_and_getData_return_fifo_order)
+{
+    uint8_t dataRead[TEST_OT_APP_BUF_SIZE];
+    uint16_t readLen = 0;
+    int8_t result;
+
+    result = otapp_buf_append(test_otapp_buf_ring_key, data, 4);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, result);
+    result = otapp_buf_append(test_otapp_buf_ring_key, &data[4], 4);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, result);
+    TEST_ASSERT_EQUAL(8, otapp_buf_getCurrentLenSize(test_otapp_buf_ring_key));
+
+    // partial read leaves the rest in the ring
+    result = otapp_buf_getData(test_otapp_buf_ring_key, dataRead, 3, &readLen);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, result);
+    TEST_ASSERT_EQUAL(3, readLen);
+    TEST_ASSERT_EQUAL_INT8_ARRAY(data, dataRead, 3);
+    TEST_ASSERT_EQUAL(5, otapp_buf_getCurrentLenSize(test_otapp_buf_ring_key));
+
+    result = otapp_buf_getData(test_otapp_buf_ring_key, dataRead, sizeof(dataRead), &readLen);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, result);
+    TEST_ASSERT_EQUAL(5, readLen);
+    TEST_ASSERT_EQUAL_INT8_ARRAY(&data[3], dataRead, 5);
+
+    result = otapp_buf_getData(test_otapp_buf_ring_key, dataRead, sizeof(dataRead), &readLen);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, result);
+}
+
+TEST(ot_app_buffer, given_ring_key_when_data_wraps_return_ok)
+{
+    uint8_t dataRead[TEST_OT_APP_BUF_SIZE];
+    uint16_t readLen = 0;
+    uint16_t maxSize = otapp_buf_getMaxSize(test_otapp_buf_ring_key);
+
+    // move the read/write position close to the end of the slot
+    for (uint16_t i = 0; i < maxSize - 10; i++)
+    {
+        TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_ring_key, data, 1));
+        TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getData(test_otapp_buf_ring_key, dataRead, 1, &readLen));
+    }
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_ring_key, data, TEST_OT_APP_BUF_SIZE));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getData(test_otapp_buf_ring_key, dataRead, sizeof(dataRead), &readLen));
+    TEST_ASSERT_EQUAL(TEST_OT_APP_BUF_SIZE, readLen);
+    TEST_ASSERT_EQUAL_INT8_ARRAY(data, dataRead, TEST_OT_APP_BUF_SIZE);
+}
+
+TEST(ot_app_buffer, given_full_ring_key_when_append_return_overflow)
+{
+    uint16_t maxSize = otapp_buf_getMaxSize(test_otapp_buf_ring_key);
+
+    for (uint16_t i = 0; i < maxSize; i++)
+    {
+        TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_ring_key, data, 1));
+    }
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_OVERFLOW, otapp_buf_append(test_otapp_buf_ring_key, data, 1));
+    TEST_ASSERT_EQUAL(maxSize, otapp_buf_getCurrentLenSize(test_otapp_buf_ring_key));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buff_clear(test_otapp_buf_ring_key));
+    TEST_ASSERT_EQUAL(0, otapp_buf_getCurrentLenSize(test_otapp_buf_ring_key));
+}
+
+TEST(ot_app_buffer, given_ring_key_when_call_zero_copy_api_return_error)
+{
+    uint16_t bufSizeOut = 0;
+
+    TEST_ASSERT_EQUAL(NULL, otapp_buf_getWriteOnly_ptr(test_otapp_buf_ring_key, 4));
+    TEST_ASSERT_EQUAL(NULL, otapp_buf_getReadOnly_ptr(test_otapp_buf_ring_key, &bufSizeOut));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_MODE, otapp_buf_writeUnlock(test_otapp_buf_ring_key));
+}
+
+TEST(ot_app_buffer, ring_should_survive_producer_consumer_threads_without_mutex_return_ok)
+{
+    pthread_t producer, consumer;
+    uint32_t errors = 0;
+
+    // ring slot does not use the pool mutex at all
+    mock_rtos_pthread_mutex_onOff(TEST_OT_APP_BUF_MUTEX_OFF);
+
+    pthread_create(&consumer, NULL, ring_consumer_thread, &errors);
+    pthread_create(&producer, NULL, ring_producer_thread, NULL);
+
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+
+    TEST_ASSERT_EQUAL_MESSAGE(0, errors, "SPSC ring delivered corrupted or reordered bytes.");
+    TEST_ASSERT_EQUAL(0, otapp_buf_getCurrentLenSize(test_otapp_buf_ring_key));
+}
+
+//////////////////////////////
+// striped per-slot locking
+static void* appendFromKey_thread(void* arg) 
+{
+    const uint16_t *keys = (const uint16_t*)arg; // {dst, src}
+    
+    for(int i = 0; i < WRITES_PER_THREAD; i++) 
+    {        
+        otapp_buf_appendFromKey(keys[0], keys[1]); 
+    }    
+    return NULL;
+}
+
+TEST(ot_app_buffer, given_two_keys_when_call_appendFromKey_return_ok)
+{
+    uint8_t dataRead[8];
+    uint16_t readLen = 0;
+
+    otapp_buff_clear(OTAPP_BUF_KEY_2);
+    otapp_buff_clear(OTAPP_BUF_KEY_3);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(OTAPP_BUF_KEY_2, data, 4));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(OTAPP_BUF_KEY_3, &data[4], 4));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_appendFromKey(OTAPP_BUF_KEY_2, OTAPP_BUF_KEY_3));
+    TEST_ASSERT_EQUAL(4, otapp_buf_getCurrentLenSize(OTAPP_BUF_KEY_3));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getData(OTAPP_BUF_KEY_2, dataRead, sizeof(dataRead), &readLen));
+    TEST_ASSERT_EQUAL(8, readLen);
+    TEST_ASSERT_EQUAL_INT8_ARRAY(data, dataRead, 8);
+}
+
+TEST(ot_app_buffer, given_false_args_when_call_appendFromKey_return_error)
+{
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_appendFromKey(0, OTAPP_BUF_KEY_2));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_appendFromKey(OTAPP_BUF_KEY_2, OTAPP_BUF_KEY_2));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_KEY_NOT_FOUND, otapp_buf_appendFromKey(OTAPP_BUF_KEY_2, TEST_OTAPP_BUF_KEY_NOT_EXIST));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_MODE, otapp_buf_appendFromKey(OTAPP_BUF_KEY_2, test_otapp_buf_ring_key));
+}
+
+TEST(ot_app_buffer, given_too_much_data_when_call_appendFromKey_return_overflow)
+{
+    otapp_buff_clear(OTAPP_BUF_KEY_2);
+    otapp_buff_clear(OTAPP_BUF_KEY_3);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(OTAPP_BUF_KEY_2, data, TEST_OT_APP_BUF_SIZE + 8));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(OTAPP_BUF_KEY_3, data, TEST_OT_APP_BUF_SIZE));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_OVERFLOW, otapp_buf_appendFromKey(OTAPP_BUF_KEY_2, OTAPP_BUF_KEY_3));
+    TEST_ASSERT_EQUAL(TEST_OT_APP_BUF_SIZE + 8, otapp_buf_getCurrentLenSize(OTAPP_BUF_KEY_2));
+}
+
+TEST(ot_app_buffer, given_write_locked_key_when_call_appendFromKey_return_write_lock)
+{
+    otapp_buff_clear(OTAPP_BUF_KEY_2);
+    otapp_buff_clear(OTAPP_BUF_KEY_3);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(OTAPP_BUF_KEY_2, data, 4));
+
+    // source still being written through the raw pointer
+    TEST_ASSERT_NOT_NULL(otapp_buf_getWriteOnly_ptr(OTAPP_BUF_KEY_3, 4));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_WRITE_LOCK, otapp_buf_appendFromKey(OTAPP_BUF_KEY_2, OTAPP_BUF_KEY_3));
+    TEST_ASSERT_EQUAL(4, otapp_buf_getCurrentLenSize(OTAPP_BUF_KEY_2));
+
+    // destination locked
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_WRITE_LOCK, otapp_buf_appendFromKey(OTAPP_BUF_KEY_3, OTAPP_BUF_KEY_2));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_writeUnlock(OTAPP_BUF_KEY_3));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(OTAPP_BUF_KEY_3, &data[4], 4));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_appendFromKey(OTAPP_BUF_KEY_2, OTAPP_BUF_KEY_3));
+    TEST_ASSERT_EQUAL(8, otapp_buf_getCurrentLenSize(OTAPP_BUF_KEY_2));
+}
+
+TEST(ot_app_buffer, appendFromKey_in_opposite_directions_should_not_deadlock)
+{
+    pthread_t thread1, thread2;
+    const uint16_t keys_2_3[] = {OTAPP_BUF_KEY_2, OTAPP_BUF_KEY_3};
+    const uint16_t keys_3_2[] = {OTAPP_BUF_KEY_3, OTAPP_BUF_KEY_2};
+
+    otapp_buff_clear(OTAPP_BUF_KEY_2);
+    otapp_buff_clear(OTAPP_BUF_KEY_3);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(OTAPP_BUF_KEY_2, data, 1));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(OTAPP_BUF_KEY_3, data, 1));
+
+    // both threads lock {KEY_2, KEY_3} in opposite argument order - the lock order rule must prevent a deadlock
+    pthread_create(&thread1, NULL, appendFromKey_thread, (void*)keys_2_3);
+    pthread_create(&thread2, NULL, appendFromKey_thread, (void*)keys_3_2);
+    pthread_join(thread1, NULL);
+    pthread_join(thread2, NULL);
+
+    TEST_ASSERT_TRUE(otapp_buf_getCurrentLenSize(OTAPP_BUF_KEY_2) <= OTAPP_BUF_KEY_2_SIZE);
+    TEST_ASSERT_TRUE(otapp_buf_getCurrentLenSize(OTAPP_BUF_KEY_3) <= OTAPP_BUF_KEY_3_SIZE);
+}
+
+// correctness of the striped slot locks only, host scheduling makes throughput too noisy to assert
+TEST(ot_app_buffer, given_bombers_spread_over_keys_when_append_then_no_append_is_lost)
+{
+    const uint8_t keysQtyMax = sizeof(test_otapp_buf_keys) / sizeof(test_otapp_buf_keys[0]);
+
+    for (uint8_t keysQty = 1; keysQty <= keysQtyMax; keysQty++)
+    {
+        test_ot_app_buff_start_bomber_on_keys(keysQty);
+
+        // correctness: no lost increments and no overflow on any key
+        for (uint8_t k = 0; k < keysQty; k++)
+        {
+            uint16_t key = test_otapp_buf_keys[k];
+            uint32_t threadsOnKey = 0;
+            for (uint8_t i = 0; i < TEST_OT_APP_BUF_BOMBER_THREADS; i++)
+            {
+                if(i % keysQty == k) threadsOnKey++;
+            }
+            uint32_t expected = threadsOnKey * WRITES_PER_THREAD;
+            if(expected > otapp_buf_getMaxSize(key)) expected = otapp_buf_getMaxSize(key);
+
+            TEST_ASSERT_EQUAL_MESSAGE(expected, otapp_buf_getCurrentLenSize(key), "Race error on striped slot lock.");
+        }
+    }
+
+    otapp_buff_clear(OTAPP_BUF_KEY_2);
+    otapp_buff_clear(OTAPP_BUF_KEY_3);
+}
+
+//////////////////////////////
+// compile-time slot handles
+TEST(ot_app_buffer, given_config_keys_when_call_keyToSlot_return_table_index)
+{
+    TEST_ASSERT_EQUAL(0, OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), otapp_buf_keyToSlot(OTAPP_BUF_KEY_1));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_2), otapp_buf_keyToSlot(OTAPP_BUF_KEY_2));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_3), otapp_buf_keyToSlot(OTAPP_BUF_KEY_3));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_4), otapp_buf_keyToSlot(OTAPP_BUF_KEY_4));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_SLOT_INVALID, otapp_buf_keyToSlot(0));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_SLOT_INVALID, otapp_buf_keyToSlot(TEST_OTAPP_BUF_KEY_NOT_EXIST));
+}
+
+TEST(ot_app_buffer, given_invalid_slot_when_call_slot_api_return_error)
+{
+    uint8_t dataRead[4];
+    uint16_t readLen = 0;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_KEY_NOT_FOUND, otapp_buf_slot_append(OTAPP_BUF_SLOT_INVALID, data, 4));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_KEY_NOT_FOUND, otapp_buf_slot_getData(OTAPP_BUF_SLOT_INVALID, dataRead, 4, &readLen));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_KEY_NOT_FOUND, otapp_buf_slot_writeUnlock(OTAPP_BUF_SLOT_INVALID));
+    TEST_ASSERT_EQUAL(NULL, otapp_buf_slot_getWriteOnly_ptr(OTAPP_BUF_SLOT_INVALID, 4));
+    TEST_ASSERT_EQUAL(NULL, otapp_buf_slot_getReadOnly_ptr(OTAPP_BUF_SLOT_INVALID, &readLen));
+    TEST_ASSERT_EQUAL(0, otapp_buf_slot_getCurrentLenSize(OTAPP_BUF_SLOT_INVALID));
+}
+
+TEST(ot_app_buffer, given_slot_handle_when_call_slot_api_return_same_data_as_key_api)
+{
+    uint8_t dataRead[8];
+    uint16_t readLen = 0;
+    uint8_t *dataPtr = NULL;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slot_append(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), data, 8));
+    TEST_ASSERT_EQUAL(8, otapp_buf_getCurrentLenSize(test_otapp_buf_key));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getData(test_otapp_buf_key, dataRead, sizeof(dataRead), &readLen));
+    TEST_ASSERT_EQUAL_INT8_ARRAY(data, dataRead, 8);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slot_clear(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1)));
+    TEST_ASSERT_EQUAL(0, otapp_buf_slot_getCurrentLenSize(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1)));
+
+    dataPtr = otapp_buf_slot_getWriteOnly_ptr(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 8);
+    TEST_ASSERT_NOT_EQUAL(NULL, dataPtr);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_WRITE_LOCK, otapp_buf_append(test_otapp_buf_key, data, 1));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slot_writeUnlock(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1)));
+}
+
+//////////////////////////////
+// zero-copy leases
+static void test_ot_app_buff_scopedWriteLease(uint16_t len)
+{
+    OTAPP_BUF_LEASE_SCOPED(lease);
+
+    if(otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), len, &lease) != OTAPP_BUF_OK) return;
+    memcpy(lease.data, data, len);
+} // lease released here
+
+TEST(ot_app_buffer, given_read_leases_when_acquire_many_readers_share_data)
+{
+    otapp_buf_lease_t lease1 = OTAPP_BUF_LEASE_INIT;
+    otapp_buf_lease_t lease2 = OTAPP_BUF_LEASE_INIT;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_key, data, 8));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRead(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), &lease1));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRead(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), &lease2));
+    TEST_ASSERT_EQUAL_PTR(lease1.data, lease2.data);
+    TEST_ASSERT_EQUAL(8, lease1.len);
+    TEST_ASSERT_EQUAL_INT8_ARRAY(data, lease2.data, 8);
+    TEST_ASSERT_EQUAL(2, otapp_buf_leaseReportLeaks());
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&lease1));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&lease2));
+    TEST_ASSERT_EQUAL(0, otapp_buf_leaseReportLeaks());
+}
+
+TEST(ot_app_buffer, given_read_lease_when_acquire_writer_return_write_lock)
+{
+    otapp_buf_lease_t reader = OTAPP_BUF_LEASE_INIT;
+    otapp_buf_lease_t writer = OTAPP_BUF_LEASE_INIT;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRead(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), &reader));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_WRITE_LOCK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 4, &writer));
+    TEST_ASSERT_EQUAL(NULL, otapp_buf_getWriteOnly_ptr(test_otapp_buf_key, 4));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_WRITE_LOCK, otapp_buff_clear(test_otapp_buf_key));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&reader));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 4, &writer));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&writer));
+}
+
+TEST(ot_app_buffer, given_write_lease_when_acquire_reader_return_write_lock)
+{
+    otapp_buf_lease_t reader = OTAPP_BUF_LEASE_INIT;
+    otapp_buf_lease_t writer = OTAPP_BUF_LEASE_INIT;
+    otapp_buf_lease_t writer2 = OTAPP_BUF_LEASE_INIT;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 4, &writer));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_WRITE_LOCK, otapp_buf_leaseRead(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), &reader));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_WRITE_LOCK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 4, &writer2));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_WRITE_LOCK, otapp_buf_append(test_otapp_buf_key, data, 1));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&writer));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&writer)); // second release is a no-op
+}
+
+TEST(ot_app_buffer, given_false_args_when_call_lease_return_error)
+{
+    otapp_buf_lease_t lease = OTAPP_BUF_LEASE_INIT;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_leaseRead(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), NULL));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 0, &lease));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_OVERFLOW, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), OTAPP_BUF_KEY_1_SIZE + 1, &lease));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_KEY_NOT_FOUND, otapp_buf_leaseRead(OTAPP_BUF_SLOT_INVALID, &lease));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_MODE, otapp_buf_leaseRead(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_4), &lease));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_leaseRelease(NULL));
+}
+
+TEST(ot_app_buffer, given_scoped_write_lease_when_scope_ends_release_and_commit_data)
+{
+    otapp_buf_lease_t reader = OTAPP_BUF_LEASE_INIT;
+
+    test_ot_app_buff_scopedWriteLease(8);
+
+    TEST_ASSERT_EQUAL(0, otapp_buf_leaseReportLeaks());
+    TEST_ASSERT_EQUAL(8, otapp_buf_getCurrentLenSize(test_otapp_buf_key));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRead(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), &reader));
+    TEST_ASSERT_EQUAL(8, reader.len);
+    TEST_ASSERT_EQUAL_INT8_ARRAY(data, reader.data, 8);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&reader));
+}
+
+TEST(ot_app_buffer, given_reduced_write_lease_when_release_commit_lease_len_unlike_writeUnlock)
+{
+    otapp_buf_lease_t writer = OTAPP_BUF_LEASE_INIT;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 8, &writer));
+    writer.len = 3; // partial write
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&writer));
+    TEST_ASSERT_EQUAL(3, otapp_buf_getCurrentLenSize(test_otapp_buf_key));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 8, &writer));
+    writer.len = 0; // nothing stays in the slot
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&writer));
+    TEST_ASSERT_EQUAL(0, otapp_buf_getCurrentLenSize(test_otapp_buf_key));
+
+    // zero-copy pointer: the reservation is dropped on unlock
+    TEST_ASSERT_NOT_NULL(otapp_buf_getWriteOnly_ptr(test_otapp_buf_key, 8));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_writeUnlock(test_otapp_buf_key));
+    TEST_ASSERT_EQUAL(0, otapp_buf_getCurrentLenSize(test_otapp_buf_key));
+}
+
+TEST(ot_app_buffer, given_leaked_lease_when_call_reportLeaks_return_held_count)
+{
+    otapp_buf_lease_t leaked = OTAPP_BUF_LEASE_INIT;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_2), 4, &leaked));
+    TEST_ASSERT_EQUAL(1, otapp_buf_leaseReportLeaks());
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&leaked));
+    TEST_ASSERT_EQUAL(0, otapp_buf_leaseReportLeaks());
+    otapp_buff_clear(OTAPP_BUF_KEY_2);
+}
+
+//////////////////////////////
+// slab allocator
+static void* slab_worker_thread(void* arg) 
+{
+    uint32_t *errors = (uint32_t*)arg;
+    uint8_t pattern = (uint8_t)(uintptr_t)pthread_self();
+    
+    for(int i = 0; i < WRITES_PER_THREAD / 10; i++) 
+    {        
+        uint16_t blockSize = 0;
+        uint8_t *block = otapp_buf_slabAlloc(48, &blockSize);
+        if(block == NULL)
+        {
+            sched_yield();
+            continue;
+        }
+
+        memset(block, pattern, blockSize);
+        sched_yield();
+        for (uint16_t j = 0; j < blockSize; j++)
+        {
+            if(block[j] != pattern) { (*errors)++; break; }
+        }
+
+        if(otapp_buf_slabFree(block) != OTAPP_BUF_OK) (*errors)++;
+    }    
+    return NULL;
+}
+
+TEST(ot_app_buffer, given_small_size_when_call_slabAlloc_return_smallest_class_block)
+{
+    otapp_buf_slabStats_t stats;
+    uint16_t blockSize = 0;
+
+    uint8_t *block = otapp_buf_slabAlloc(10, &blockSize);
+    TEST_ASSERT_NOT_NULL(block);
+    TEST_ASSERT_EQUAL(64, blockSize);
+    TEST_ASSERT_EQUAL(0, ((uintptr_t)block) % 4);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabGetStats(OTAPP_BUF_SLAB_64, &stats));
+    TEST_ASSERT_EQUAL(1, stats.blocks_used);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabFree(block));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabGetStats(OTAPP_BUF_SLAB_64, &stats));
+    TEST_ASSERT_EQUAL(0, stats.blocks_used);
+}
+
+TEST(ot_app_buffer, given_exhausted_class_when_call_slabAlloc_fall_back_then_fail)
+{
+    otapp_buf_slabStats_t stats64, stats256, statsBefore;
+    uint8_t *block[6] = {NULL};
+    uint16_t blockSize = 0;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabGetStats(OTAPP_BUF_SLAB_64, &statsBefore));
+
+    // 4 x 64 + 2 x 256 blocks
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        block[i] = otapp_buf_slabAlloc(64, &blockSize);
+        TEST_ASSERT_NOT_NULL(block[i]);
+        TEST_ASSERT_EQUAL(i < 4 ? 64 : 256, blockSize);
+    }
+    TEST_ASSERT_NULL(otapp_buf_slabAlloc(64, NULL));
+    TEST_ASSERT_NULL(otapp_buf_slabAlloc(OTAPP_BUF_SLAB_SIZE, NULL)); // bigger than any class
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabGetStats(OTAPP_BUF_SLAB_64, &stats64));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabGetStats(OTAPP_BUF_SLAB_256, &stats256));
+    TEST_ASSERT_EQUAL(4, stats64.blocks_peak);
+    TEST_ASSERT_EQUAL(2, stats256.blocks_used);
+    TEST_ASSERT_EQUAL(statsBefore.fail_cnt + 1, stats64.fail_cnt);
+
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabFree(block[i]));
+    }
+}
+
+TEST(ot_app_buffer, given_false_ptr_when_call_slabFree_return_error)
+{
+    uint8_t local[8];
+    uint8_t *block = otapp_buf_slabAlloc(100, NULL);
+    TEST_ASSERT_NOT_NULL(block);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_slabFree(NULL));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_slabFree(local));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_slabFree(block + 1));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabFree(block));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_slabFree(block)); // double free
+
+    TEST_ASSERT_NULL(otapp_buf_slabAlloc(0, NULL));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_slabGetStats(OTAPP_BUF_SLAB_CLASSES_QTY, NULL));
+}
+
+static void test_ot_app_buff_scopedSlab(uint8_t **blockOut)
+{
+    OTAPP_BUF_SLAB_SCOPED(block);
+
+    block = otapp_buf_slabAlloc(32, NULL);
+    *blockOut = block;
+} // block freed here
+
+TEST(ot_app_buffer, given_scoped_slab_block_when_scope_ends_block_is_freed)
+{
+    otapp_buf_slabStats_t stats;
+    uint8_t *block = NULL;
+
+    test_ot_app_buff_scopedSlab(&block);
+    TEST_ASSERT_NOT_NULL(block);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabGetStats(OTAPP_BUF_SLAB_64, &stats));
+    TEST_ASSERT_EQUAL(0, stats.blocks_used);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_slabFree(block)); // already freed
+}
+
+TEST(ot_app_buffer, slab_should_give_private_blocks_to_concurrent_threads)
+{
+    pthread_t thread[4];
+    uint32_t errors = 0;
+    otapp_buf_slabStats_t stats;
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        pthread_create(&thread[i], NULL, slab_worker_thread, &errors);
+    }
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        pthread_join(thread[i], NULL);
+    }
+
+    TEST_ASSERT_EQUAL_MESSAGE(0, errors, "Slab block shared between threads or lost.");
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabGetStats(OTAPP_BUF_SLAB_64, &stats));
+    TEST_ASSERT_EQUAL(0, stats.blocks_used);
+}
+
+//////////////////////////////
+// write wait queue
+#define TEST_OT_APP_BUF_WAIT_TICKS  2000 // 1 tick = 1 ms in the pthread mock
+
+typedef struct {
+    uint8_t id;
+    int8_t  result;
+    uint8_t *order;     // shared acquire order log
+    uint8_t *orderCnt;
+} test_waiter_t;
+
+static void* lease_waiter_thread(void* arg) 
+{
+    test_waiter_t *w = (test_waiter_t*)arg;
+    otapp_buf_lease_t lease = OTAPP_BUF_LEASE_INIT;
+
+    w->result = otapp_buf_leaseWriteTimed(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 4, TEST_OT_APP_BUF_WAIT_TICKS, &lease);
+    if(w->result == OTAPP_BUF_OK)
+    {
+        w->order[(*w->orderCnt)++] = w->id; // slot is held, no race on the log
+        usleep(2000);
+        otapp_buf_leaseRelease(&lease);
+    }
+    return NULL;
+}
+
+static void test_ot_app_buff_waitForWaiters(uint8_t waiters)
+{
+    otapp_buf_waitStats_t stats;
+
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        otapp_buf_slot_getWaitStats(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), &stats);
+        if(stats.waiters == waiters) return;
+        usleep(1000);
+    }
+    TEST_FAIL_MESSAGE("waiters not queued");
+}
+
+TEST(ot_app_buffer, given_held_slot_when_call_leaseWriteTimed_return_timeout)
+{
+    otapp_buf_lease_t holder = OTAPP_BUF_LEASE_INIT;
+    otapp_buf_lease_t lease = OTAPP_BUF_LEASE_INIT;
+    otapp_buf_waitStats_t before, after;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slot_getWaitStats(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), &before));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 4, &holder));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_TIMEOUT, otapp_buf_leaseWriteTimed(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 4, 10, &lease));
+    TEST_ASSERT_EQUAL(NULL, otapp_buf_getWriteOnly_ptrTimed(test_otapp_buf_key, 4, 10));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_WRITE_LOCK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 4, &lease));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slot_getWaitStats(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), &after));
+    TEST_ASSERT_EQUAL(before.contention_cnt + 3, after.contention_cnt);
+    TEST_ASSERT_EQUAL(before.timeout_cnt + 2, after.timeout_cnt);
+    TEST_ASSERT_EQUAL(0, after.waiters);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&holder));
+}
+
+TEST(ot_app_buffer, given_released_slot_when_writers_wait_hand_off_in_fifo_order)
+{
+    otapp_buf_lease_t holder = OTAPP_BUF_LEASE_INIT;
+    otapp_buf_lease_t lease = OTAPP_BUF_LEASE_INIT;
+    otapp_buf_waitStats_t stats;
+    pthread_t thread[3];
+    test_waiter_t waiter[3];
+    uint8_t order[3] = {0};
+    uint8_t orderCnt = 0;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 4, &holder));
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        waiter[i] = (test_waiter_t){ .id = i + 1, .result = OTAPP_BUF_ERROR, .order = order, .orderCnt = &orderCnt };
+        pthread_create(&thread[i], NULL, lease_waiter_thread, &waiter[i]);
+        test_ot_app_buff_waitForWaiters(i + 1);
+    }
+
+    // the queue is not empty, a new caller cannot overtake it
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&holder));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_WRITE_LOCK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 4, &lease));
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        pthread_join(thread[i], NULL);
+        TEST_ASSERT_EQUAL(OTAPP_BUF_OK, waiter[i].result);
+    }
+
+    TEST_ASSERT_EQUAL(3, orderCnt);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(((uint8_t[]){1, 2, 3}), order, 3);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slot_getWaitStats(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), &stats));
+    TEST_ASSERT_EQUAL(0, stats.waiters);
+    TEST_ASSERT_TRUE(stats.waiters_peak >= 3);
+    TEST_ASSERT_TRUE(stats.wait_max_ticks > 0);
+}
+
+TEST(ot_app_buffer, given_full_wait_queue_when_call_leaseWriteTimed_return_write_lock)
+{
+    otapp_buf_lease_t holder = OTAPP_BUF_LEASE_INIT;
+    otapp_buf_lease_t lease = OTAPP_BUF_LEASE_INIT;
+    otapp_buf_waitStats_t before, after;
+    pthread_t thread[OTAPP_BUF_WAITERS_MAX];
+    test_waiter_t waiter[OTAPP_BUF_WAITERS_MAX];
+    uint8_t order[OTAPP_BUF_WAITERS_MAX] = {0};
+    uint8_t orderCnt = 0;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slot_getWaitStats(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), &before));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 4, &holder));
+
+    for (uint8_t i = 0; i < OTAPP_BUF_WAITERS_MAX; i++)
+    {
+        waiter[i] = (test_waiter_t){ .id = i + 1, .result = OTAPP_BUF_ERROR, .order = order, .orderCnt = &orderCnt };
+        pthread_create(&thread[i], NULL, lease_waiter_thread, &waiter[i]);
+    }
+    test_ot_app_buff_waitForWaiters(OTAPP_BUF_WAITERS_MAX);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_WRITE_LOCK, 
+        otapp_buf_leaseWriteTimed(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 4, TEST_OT_APP_BUF_WAIT_TICKS, &lease));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&holder));
+    for (uint8_t i = 0; i < OTAPP_BUF_WAITERS_MAX; i++)
+    {
+        pthread_join(thread[i], NULL);
+        TEST_ASSERT_EQUAL(OTAPP_BUF_OK, waiter[i].result);
+    }
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slot_getWaitStats(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), &after));
+    TEST_ASSERT_EQUAL(before.queue_full_cnt + 1, after.queue_full_cnt);
+    TEST_ASSERT_EQUAL(before.timeout_cnt, after.timeout_cnt);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_KEY_NOT_FOUND, otapp_buf_slot_getWaitStats(OTAPP_BUF_SLOT_INVALID, &after));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_slot_getWaitStats(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), NULL));
+}
+
+static void* write_unlock_thread(void* arg) 
+{
+    (void)arg;
+    usleep(5000);
+    otapp_buf_writeUnlock(test_otapp_buf_key);
+    return NULL;
+}
+
+TEST(ot_app_buffer, given_locked_key_when_unlocked_during_wait_getWriteOnly_ptrTimed_return_ok)
+{
+    pthread_t thread;
+
+    TEST_ASSERT_NOT_NULL(otapp_buf_getWriteOnly_ptr(test_otapp_buf_key, 4));
+    pthread_create(&thread, NULL, write_unlock_thread, NULL);
+
+    uint8_t *ptr = otapp_buf_getWriteOnly_ptrTimed(test_otapp_buf_key, 8, TEST_OT_APP_BUF_WAIT_TICKS);
+    pthread_join(thread, NULL);
+
+    TEST_ASSERT_NOT_NULL(ptr);
+    TEST_ASSERT_EQUAL(8, otapp_buf_getCurrentLenSize(test_otapp_buf_key));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_writeUnlock(test_otapp_buf_key));
+}
+
+TEST(ot_app_buffer, given_locked_key_when_waiting_forever_writer_is_woken_by_unlock)
+{
+    pthread_t thread;
+    otapp_buf_waitStats_t stats;
+
+    TEST_ASSERT_NOT_NULL(otapp_buf_getWriteOnly_ptr(test_otapp_buf_key, 4));
+    pthread_create(&thread, NULL, write_unlock_thread, NULL);
+
+    // no timeout and no poll period: only the notification of writeUnlock() can end this wait
+    uint8_t *ptr = otapp_buf_getWriteOnly_ptrTimed(test_otapp_buf_key, 8, OTAPP_BUF_WAIT_FOREVER);
+    pthread_join(thread, NULL);
+
+    TEST_ASSERT_NOT_NULL(ptr);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slot_getWaitStats(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), &stats));
+    TEST_ASSERT_EQUAL(0, stats.waiters);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_writeUnlock(test_otapp_buf_key));
+}
+
+static void* slab_free_thread(void* arg) 
+{
+    usleep(5000);
+    otapp_buf_slabFree((uint8_t*)arg);
+    return NULL;
+}
+
+TEST(ot_app_buffer, given_exhausted_class_when_call_slabAllocTimed_return_timeout)
+{
+    otapp_buf_slabStats_t before, after;
+    uint8_t *blockA = otapp_buf_slabAlloc(200, NULL);
+    uint8_t *blockB = otapp_buf_slabAlloc(200, NULL);
+
+    TEST_ASSERT_NOT_NULL(blockA);
+    TEST_ASSERT_NOT_NULL(blockB);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabGetStats(OTAPP_BUF_SLAB_256, &before));
+
+    TEST_ASSERT_NULL(otapp_buf_slabAllocTimed(200, OTAPP_BUF_ACQ_ZERO, 10, NULL));
+    TEST_ASSERT_NULL(otapp_buf_slabAllocTimed(300, OTAPP_BUF_ACQ_ZERO, 10, NULL)); // larger than every class
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabGetStats(OTAPP_BUF_SLAB_256, &after));
+    TEST_ASSERT_EQUAL(before.fail_cnt + 1, after.fail_cnt);
+    TEST_ASSERT_EQUAL(before.timeout_cnt + 1, after.timeout_cnt);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabFree(blockA));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabFree(blockB));
+}
+
+TEST(ot_app_buffer, given_exhausted_class_when_block_freed_during_wait_slabAllocTimed_return_it)
+{
+    pthread_t thread;
+    uint16_t blockSize = 0;
+    uint8_t *blockA = otapp_buf_slabAlloc(200, NULL);
+    uint8_t *blockB = otapp_buf_slabAlloc(200, NULL);
+
+    TEST_ASSERT_NOT_NULL(blockA);
+    TEST_ASSERT_NOT_NULL(blockB);
+    pthread_create(&thread, NULL, slab_free_thread, blockB);
+
+    uint8_t *block = otapp_buf_slabAllocTimed(200, OTAPP_BUF_ACQ_ZERO, TEST_OT_APP_BUF_WAIT_TICKS, &blockSize);
+    pthread_join(thread, NULL);
+
+    TEST_ASSERT_EQUAL_PTR(blockB, block);
+    TEST_ASSERT_EQUAL(256, blockSize);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabFree(blockA));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabFree(block));
+}
+
+//////////////////////////////
+// scatter-gather
+static void* appendv_thread(void* arg) 
+{
+    uint8_t id = *(uint8_t*)arg;
+    uint8_t a = id, b = id, c = id;
+    otapp_buf_iov_t iov[3] = { {&a, 1}, {&b, 1}, {&c, 1} };
+
+    for(int i = 0; i < WRITES_PER_THREAD; i++) 
+    {        
+        if(otapp_buf_appendv(test_otapp_buf_key, iov, 3) == OTAPP_BUF_ERROR_OVERFLOW) break;
+        sched_yield(); 
+    }    
+    return NULL;
+}
+
+TEST(ot_app_buffer, given_fragments_when_call_appendv_return_concatenated_data)
+{
+    uint8_t token[2] = {0x01, 0x02};
+    uint8_t header[3] = {0x10, 0x11, 0x12};
+    uint8_t value[4] = {0xA0, 0xA1, 0xA2, 0xA3};
+    const uint8_t expected[9] = {0x01, 0x02, 0x10, 0x11, 0x12, 0xA0, 0xA1, 0xA2, 0xA3};
+    otapp_buf_iov_t iov[3] = { {token, 2}, {header, 3}, {value, 4} };
+    uint8_t out[16];
+    uint16_t outLen = 0;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_appendv(test_otapp_buf_key, iov, 3));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getData(test_otapp_buf_key, out, sizeof(out), &outLen));
+    TEST_ASSERT_EQUAL(9, outLen);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, out, 9);
+}
+
+TEST(ot_app_buffer, given_too_long_vector_when_call_appendv_return_overflow_and_copy_nothing)
+{
+    uint8_t big[OTAPP_BUF_KEY_1_SIZE];
+    otapp_buf_iov_t iov[2] = { {data, 8}, {big, OTAPP_BUF_KEY_1_SIZE - 4} };
+
+    memset(big, 0x55, sizeof(big));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_OVERFLOW, otapp_buf_appendv(test_otapp_buf_key, iov, 2));
+    TEST_ASSERT_EQUAL(0, otapp_buf_getCurrentLenSize(test_otapp_buf_key));
+}
+
+TEST(ot_app_buffer, given_false_args_when_call_appendv_and_getDatav_return_error)
+{
+    uint8_t out[8];
+    uint16_t outLen = 0;
+    otapp_buf_iov_t iov[2] = { {data, 4}, {NULL, 4} };
+    otapp_buf_iovOut_t iovOut[1] = { {out, sizeof(out)} };
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_appendv(test_otapp_buf_key, NULL, 1));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_appendv(test_otapp_buf_key, iov, 0));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_appendv(test_otapp_buf_key, iov, 2)); // NULL fragment
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_appendv(0, iov, 1));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_KEY_NOT_FOUND, otapp_buf_appendv(TEST_OTAPP_BUF_KEY_NOT_EXIST, iov, 1));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_getDatav(test_otapp_buf_key, iovOut, 1, NULL));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_getDatav(test_otapp_buf_key, iovOut, 1, &outLen)); // empty slot
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_key, data, 16));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_getDatav(test_otapp_buf_key, iovOut, 1, &outLen)); // does not fit
+    TEST_ASSERT_EQUAL(0, outLen);
+}
+
+TEST(ot_app_buffer, given_slot_data_when_call_getDatav_scatter_over_fragments)
+{
+    uint8_t token[2], header[4], value[8];
+    otapp_buf_iovOut_t iov[3] = { {token, sizeof(token)}, {header, sizeof(header)}, {value, sizeof(value)} };
+    uint16_t outLen = 0;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_key, data, 10));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getDatav(test_otapp_buf_key, iov, 3, &outLen));
+
+    TEST_ASSERT_EQUAL(10, outLen);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&data[0], token, 2);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&data[2], header, 4);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&data[6], value, 4); // last fragment filled partially
+}
+
+TEST(ot_app_buffer, given_ring_key_when_call_appendv_and_getDatav_wrap_return_fifo_order)
+{
+    uint8_t out[OTAPP_BUF_KEY_4_SIZE];
+    uint8_t part1[20], part2[30];
+    uint16_t outLen = 0;
+    otapp_buf_iov_t iovIn[2] = { {data, 32}, {data, 16} };
+    otapp_buf_iovOut_t iovOut[2] = { {part1, sizeof(part1)}, {part2, sizeof(part2)} };
+
+    // move the ring position so the vector wraps around the slot end
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_ring_key, data, 40));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getData(test_otapp_buf_ring_key, out, sizeof(out), &outLen));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_appendv(test_otapp_buf_ring_key, iovIn, 2));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_OVERFLOW, otapp_buf_appendv(test_otapp_buf_ring_key, iovIn, 2));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getDatav(test_otapp_buf_ring_key, iovOut, 2, &outLen));
+    TEST_ASSERT_EQUAL(48, outLen);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, part1, 20);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&data[20], part2, 12);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(data, &part2[12], 16);
+}
+
+TEST(ot_app_buffer, appendv_records_should_not_interleave_between_threads)
+{
+    pthread_t thread[4];
+    uint8_t id[4] = {1, 2, 3, 4};
+    static uint8_t out[OTAPP_BUF_KEY_1_SIZE];
+    uint16_t outLen = 0;
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        pthread_create(&thread[i], NULL, appendv_thread, &id[i]);
+    }
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        pthread_join(thread[i], NULL);
+    }
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getData(test_otapp_buf_key, out, sizeof(out), &outLen));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_KEY_1_SIZE - (OTAPP_BUF_KEY_1_SIZE % 3), outLen);
+    for (uint16_t i = 0; i < outLen; i += 3)
+    {
+        TEST_ASSERT_EQUAL(out[i], out[i + 1]);
+        TEST_ASSERT_EQUAL(out[i], out[i + 2]);
+    }
+}
+
+//////////////////////////////
+// no-clear acquisition / poisoning
+static void test_ot_app_buff_assertFilled(const uint8_t *ptr, uint8_t byte, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX8(byte, ptr[i]);
+    }
+}
+
+TEST(ot_app_buffer, given_cleared_slot_when_call_getWriteOnly_ptrNoClear_return_poisoned_bytes)
+{
+    uint8_t *dataPtr = NULL;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_key, data, 16));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buff_clear(test_otapp_buf_key));
+    TEST_ASSERT_EQUAL(0, otapp_buf_getCurrentLenSize(test_otapp_buf_key));
+
+    dataPtr = otapp_buf_getWriteOnly_ptrNoClear(test_otapp_buf_key, 16);
+    TEST_ASSERT_NOT_NULL(dataPtr);
+    TEST_ASSERT_EQUAL(16, otapp_buf_getCurrentLenSize(test_otapp_buf_key));
+    test_ot_app_buff_assertFilled(dataPtr, OTAPP_BUF_POISON_BYTE, 16);
+    TEST_ASSERT_EQUAL(NULL, otapp_buf_getWriteOnly_ptrNoClear(test_otapp_buf_key, 16)); // still locked
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_writeUnlock(test_otapp_buf_key));
+
+    // default acquisition still zeroes
+    dataPtr = otapp_buf_getWriteOnly_ptr(test_otapp_buf_key, 16);
+    TEST_ASSERT_NOT_NULL(dataPtr);
+    test_ot_app_buff_assertFilled(dataPtr, 0x00, 16);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_writeUnlock(test_otapp_buf_key));
+}
+
+TEST(ot_app_buffer, given_no_clear_flag_when_call_leaseWriteEx_return_poisoned_bytes)
+{
+    otapp_buf_lease_t lease = OTAPP_BUF_LEASE_INIT;
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, 
+        otapp_buf_leaseWriteEx(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 8, 0, OTAPP_BUF_ACQ_NO_CLEAR, &lease));
+    test_ot_app_buff_assertFilled(lease.data, OTAPP_BUF_POISON_BYTE, 8);
+    memcpy(lease.data, data, 8);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&lease));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), 8, &lease));
+    test_ot_app_buff_assertFilled(lease.data, 0x00, 8);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_leaseRelease(&lease));
+}
+
+TEST(ot_app_buffer, given_no_clear_flag_when_call_slabAllocEx_return_poisoned_block)
+{
+    uint16_t blockSize = 0;
+    uint8_t *block = otapp_buf_slabAllocEx(32, OTAPP_BUF_ACQ_NO_CLEAR, &blockSize);
+
+    TEST_ASSERT_NOT_NULL(block);
+    TEST_ASSERT_EQUAL(64, blockSize);
+    // the free list link lives in the first bytes of a free block
+    test_ot_app_buff_assertFilled(block + sizeof(void*), OTAPP_BUF_POISON_BYTE, 32 - sizeof(void*));
+
+    memset(block, 0x11, 32);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabFree(block));
+    test_ot_app_buff_assertFilled(block + sizeof(void*), OTAPP_BUF_POISON_BYTE, 32 - sizeof(void*)); // use-after-free is visible
+
+    block = otapp_buf_slabAlloc(32, NULL);
+    TEST_ASSERT_NOT_NULL(block);
+    test_ot_app_buff_assertFilled(block, 0x00, 32);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_slabFree(block));
+}
+
+//////////////////////////////
+// telemetry
+TEST(ot_app_buffer, given_appends_and_rejections_when_call_getStats_return_counters)
+{
+    otapp_buf_stats_t stats;
+    otapp_buf_lease_t lease = OTAPP_BUF_LEASE_INIT;
+
+    otapp_buf_resetStats();
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getStats(test_otapp_buf_key, &stats));
+    TEST_ASSERT_EQUAL(test_otapp_buf_key, stats.key);
+    TEST_ASSERT_EQUAL(OTAPP_BUF_KEY_1_SIZE, stats.max_size);
+    TEST_ASSERT_EQUAL(0, stats.peak_len);
+    TEST_ASSERT_EQUAL(0, stats.acquire_cnt);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_key, data, 10));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_key, data, 20));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buff_clear(test_otapp_buf_key));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_key, data, 5));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_OVERFLOW, otapp_buf_leaseWrite(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), OTAPP_BUF_KEY_1_SIZE + 1, &lease));
+    TEST_ASSERT_EQUAL(NULL, otapp_buf_getWriteOnly_ptr(test_otapp_buf_key, OTAPP_BUF_KEY_1_SIZE + 1));
+
+    TEST_ASSERT_NOT_NULL(otapp_buf_getWriteOnly_ptr(test_otapp_buf_key, 8));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_WRITE_LOCK, otapp_buf_append(test_otapp_buf_key, data, 1));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_WRITE_LOCK, otapp_buf_leaseRead(OTAPP_BUF_SLOT(OTAPP_BUF_KEY_1), &lease));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_writeUnlock(test_otapp_buf_key));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getStats(test_otapp_buf_key, &stats));
+    TEST_ASSERT_EQUAL(30, stats.peak_len);
+    TEST_ASSERT_EQUAL(2, stats.overflow_cnt);
+    TEST_ASSERT_EQUAL(2, stats.busy_reject_cnt);
+    TEST_ASSERT_TRUE(stats.acquire_cnt >= 6);
+    TEST_ASSERT_EQUAL(0, stats.contended_cnt); // single thread
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_key, data, 4));
+    otapp_buf_resetStats();
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getStats(test_otapp_buf_key, &stats));
+    TEST_ASSERT_EQUAL(4, stats.peak_len); // restarts from the current fill level
+    TEST_ASSERT_EQUAL(0, stats.overflow_cnt);
+    TEST_ASSERT_EQUAL(0, stats.busy_reject_cnt);
+}
+
+// how many takes collide depends on the host scheduler (none on a single core), only the bounds are checked
+TEST(ot_app_buffer, given_bombers_on_one_key_when_call_getStats_count_contention_within_acquisitions)
+{
+    otapp_buf_stats_t stats;
+
+    otapp_buf_resetStats();
+    test_ot_app_buff_start_bomber_on_keys(1);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getStats(test_otapp_buf_keys[0], &stats));
+    TEST_ASSERT_TRUE(stats.acquire_cnt >= TEST_OT_APP_BUF_BOMBER_THREADS * WRITES_PER_THREAD);
+    TEST_ASSERT_TRUE(stats.contended_cnt <= stats.acquire_cnt);
+}
+
+TEST(ot_app_buffer, given_ring_key_when_call_getStats_return_peak_and_overflow)
+{
+    otapp_buf_stats_t stats;
+    uint8_t out[OTAPP_BUF_KEY_4_SIZE];
+    uint16_t outLen = 0;
+
+    otapp_buf_resetStats();
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_ring_key, data, 32));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_ring_key, data, 16));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_OVERFLOW, otapp_buf_append(test_otapp_buf_ring_key, data, 32));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getData(test_otapp_buf_ring_key, out, sizeof(out), &outLen));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_append(test_otapp_buf_ring_key, data, 8));
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_OK, otapp_buf_getStats(test_otapp_buf_ring_key, &stats));
+    TEST_ASSERT_EQUAL(48, stats.peak_len);
+    TEST_ASSERT_EQUAL(1, stats.overflow_cnt);
+    TEST_ASSERT_EQUAL(0, stats.acquire_cnt);
+
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR, otapp_buf_getStats(test_otapp_buf_ring_key, NULL));
+    TEST_ASSERT_EQUAL(OTAPP_BUF_ERROR_KEY_NOT_FOUND, otapp_buf_getStats(TEST_OTAPP_BUF_KEY_NOT_EXIST, &stats));
+}
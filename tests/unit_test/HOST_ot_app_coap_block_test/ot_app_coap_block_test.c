@@ -0,0 +1,394 @@
+#include "unity_fixture.h"
+#include "ot_app_coap_block.h"
+#include "string.h"
+
+#define TEST_BLOCK_MSG_SIZE     1200
+#define TEST_BLOCK_COAP_HDR     8       // response payload offset
+
+// otMessage backed by a flat array
+typedef struct {
+    otMessage message;
+    uint8_t data[TEST_BLOCK_MSG_SIZE];
+    uint16_t length;
+    uint16_t offset;
+} test_block_message_t;
+
+FAKE_VALUE_FUNC5(otError, test_block_sendGet, const otIp6Address *, const char *, const otapp_coap_block_t *, otCoapResponseHandler, void *);
+FAKE_VALUE_FUNC0(otMessage *, test_block_messageNew);
+FAKE_VOID_FUNC4(test_block_userResponse, void *, otMessage *, const otMessageInfo *, otError);
+
+static const otIp6Address test_block_ipAddr = {.mFields.m8 = {0xfd, 0x00, 0, 0, 0, 0, 0, 0, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x01}};
+static const char *test_block_uri = ".well-known/core";
+static uint8_t test_block_context;
+
+static test_block_message_t test_block_response;
+static test_block_message_t test_block_body;
+static uint8_t test_block_representation[TEST_BLOCK_MSG_SIZE];
+
+// server side of the exchange
+static otapp_coap_block_t test_block_requested;
+static otCoapResponseHandler test_block_handler;
+static void *test_block_handlerContext;
+static otCoapOption test_block_option;
+static uint8_t test_block_optionValue[4];
+static uint8_t test_block_hasOption;
+
+// user handler: copy of the representation it got
+static uint8_t test_block_userData[TEST_BLOCK_MSG_SIZE];
+static uint16_t test_block_userLength;
+
+static test_block_message_t *test_block_messageGet(const otMessage *aMessage)
+{
+    return (aMessage == &test_block_body.message) ? &test_block_body : &test_block_response;
+}
+
+static uint16_t test_block_messageGetLength(const otMessage *aMessage)
+{
+    return test_block_messageGet(aMessage)->length;
+}
+
+static uint16_t test_block_messageGetOffset(const otMessage *aMessage)
+{
+    return test_block_messageGet(aMessage)->offset;
+}
+
+static uint16_t test_block_messageRead(const otMessage *aMessage, uint16_t aOffset, void *aBuf, uint16_t aLength)
+{
+    test_block_message_t *msg = test_block_messageGet(aMessage);
+
+    if(aOffset >= msg->length) return 0;
+    if(aLength > msg->length - aOffset) aLength = msg->length - aOffset;
+    memcpy(aBuf, &msg->data[aOffset], aLength);
+    return aLength;
+}
+
+static otError test_block_messageAppend(otMessage *aMessage, const void *aBuf, uint16_t aLength)
+{
+    test_block_message_t *msg = test_block_messageGet(aMessage);
+
+    if(aLength > TEST_BLOCK_MSG_SIZE - msg->length) return OT_ERROR_NO_BUFS;
+    memcpy(&msg->data[msg->length], aBuf, aLength);
+    msg->length += aLength;
+    return OT_ERROR_NONE;
+}
+
+static otMessage *test_block_messageNewBody(void)
+{
+    memset(&test_block_body, 0, sizeof(test_block_body));
+    return &test_block_body.message;
+}
+
+static otError test_block_sendGetStore(const otIp6Address *peer_addr, const char *aUriPath, const otapp_coap_block_t *block2, otCoapResponseHandler responseHandler, void *aContext)
+{
+    UNUSED(peer_addr);
+    UNUSED(aUriPath);
+
+    memset(&test_block_requested, 0, sizeof(test_block_requested));
+    if(block2 != NULL) test_block_requested = *block2;
+    test_block_handler        = responseHandler;
+    test_block_handlerContext = aContext;
+    return OT_ERROR_NONE;
+}
+
+static void test_block_userResponseStore(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo, otError aResult)
+{
+    UNUSED(aContext);
+    UNUSED(aMessageInfo);
+    UNUSED(aResult);
+
+    test_block_userLength = 0;
+    if(aMessage != NULL)
+    {
+        test_block_userLength = test_block_messageGetLength(aMessage) - test_block_messageGetOffset(aMessage);
+        test_block_messageRead(aMessage, test_block_messageGetOffset(aMessage), test_block_userData, test_block_userLength);
+    }
+}
+
+static const otCoapOption *test_block_optionGet(otCoapOptionIterator *aIterator, uint16_t aOption)
+{
+    UNUSED(aIterator);
+    return (test_block_hasOption && aOption == OT_COAP_OPTION_BLOCK2) ? &test_block_option : NULL;
+}
+
+static otError test_block_optionValueGet(otCoapOptionIterator *aIterator, void *aValue)
+{
+    UNUSED(aIterator);
+    memcpy(aValue, test_block_optionValue, test_block_option.mLength);
+    return OT_ERROR_NONE;
+}
+
+// Block2 option of the response, shortest uint encoding
+static void test_block_optionSet(uint32_t num, uint8_t more, uint8_t szx)
+{
+    const otapp_coap_block_t block = {.num = num, .more = more, .szx = szx};
+    uint32_t value = otapp_coap_blockEncode(&block);
+
+    test_block_hasOption = 1;
+    test_block_option.mNumber = OT_COAP_OPTION_BLOCK2;
+    test_block_option.mLength = (value > 0xFFFF) ? 3 : (value > 0xFF) ? 2 : (value > 0) ? 1 : 0;
+    for (uint8_t i = 0; i < test_block_option.mLength; i++)
+    {
+        test_block_optionValue[i] = (uint8_t)(value >> (8 * (test_block_option.mLength - 1 - i)));
+    }
+}
+
+// server answers the last request with the block it asked for, szx: block size of the server
+static void test_block_serverRespond(uint16_t totalSize, uint8_t szx)
+{
+    const uint32_t size = OTAPP_COAP_BLOCK_SIZE(szx);
+    const uint32_t offset = test_block_requested.num * OTAPP_COAP_BLOCK_SIZE(test_block_requested.szx);
+    const uint8_t more = (offset + size < totalSize);
+    const uint16_t payloadSize = more ? size : (uint16_t)(totalSize - offset);
+
+    test_block_optionSet(offset / size, more, szx);
+
+    memset(&test_block_response, 0, sizeof(test_block_response));
+    test_block_response.offset = TEST_BLOCK_COAP_HDR;
+    test_block_response.length = TEST_BLOCK_COAP_HDR + payloadSize;
+    memcpy(&test_block_response.data[TEST_BLOCK_COAP_HDR], &test_block_representation[offset], payloadSize);
+
+    test_block_handler(test_block_handlerContext, &test_block_response.message, NULL, OT_ERROR_NONE);
+}
+
+TEST_GROUP(ot_app_coap_block);
+
+TEST_SETUP(ot_app_coap_block)
+{
+    /* Init before every test */
+    RESET_FAKE(test_block_sendGet);
+    RESET_FAKE(test_block_messageNew);
+    RESET_FAKE(test_block_userResponse);
+    RESET_FAKE(otCoapOptionIteratorInit);
+    RESET_FAKE(otCoapOptionIteratorGetFirstOptionMatching);
+    RESET_FAKE(otCoapOptionIteratorGetOptionValue);
+    RESET_FAKE(otMessageGetLength);
+    RESET_FAKE(otMessageGetOffset);
+    RESET_FAKE(otMessageRead);
+    RESET_FAKE(otMessageAppend);
+    RESET_FAKE(otMessageFree);
+    FFF_RESET_HISTORY();
+
+    test_block_sendGet_fake.custom_fake                 = test_block_sendGetStore;
+    test_block_messageNew_fake.custom_fake              = test_block_messageNewBody;
+    test_block_userResponse_fake.custom_fake            = test_block_userResponseStore;
+    otCoapOptionIteratorGetFirstOptionMatching_fake.custom_fake = test_block_optionGet;
+    otCoapOptionIteratorGetOptionValue_fake.custom_fake = test_block_optionValueGet;
+    otMessageGetLength_fake.custom_fake                 = test_block_messageGetLength;
+    otMessageGetOffset_fake.custom_fake                 = test_block_messageGetOffset;
+    otMessageRead_fake.custom_fake                      = test_block_messageRead;
+    otMessageAppend_fake.custom_fake                    = test_block_messageAppend;
+
+    test_block_hasOption = 0;
+    test_block_userLength = 0;
+    for (uint16_t i = 0; i < TEST_BLOCK_MSG_SIZE; i++)
+    {
+        test_block_representation[i] = (uint8_t)(i * 7 + 1);
+    }
+
+    otapp_coap_blockInit(test_block_sendGet, test_block_messageNew);
+}
+
+TEST_TEAR_DOWN(ot_app_coap_block)
+{
+    /* Cleanup after every test */
+}
+
+TEST(ot_app_coap_block, GivenBlock_WhenEncodeAndDecode_ThenSameValue)
+{
+    const otapp_coap_block_t block_ = {.num = 5, .more = 1, .szx = 2};
+    otapp_coap_block_t decoded_;
+
+    TEST_ASSERT_EQUAL_HEX32(0x5A, otapp_coap_blockEncode(&block_));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_OK, otapp_coap_blockDecode(0x5A, &decoded_));
+    TEST_ASSERT_EQUAL(5, decoded_.num);
+    TEST_ASSERT_EQUAL(1, decoded_.more);
+    TEST_ASSERT_EQUAL(2, decoded_.szx);
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_ERROR, otapp_coap_blockDecode(0x07, &decoded_));           // szx 7 reserved
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_ERROR, otapp_coap_blockDecode(0x1000000, &decoded_));      // num above 20 bits
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_ERROR, otapp_coap_blockDecode(0x5A, NULL));
+}
+
+TEST(ot_app_coap_block, GivenBlock2Option_WhenCallBlock2Get_ThenDecoded)
+{
+    otapp_coap_block_t block_;
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_NONE, otapp_coap_block2Get(&test_block_response.message, &block_));
+
+    test_block_optionSet(300, 1, 2); // 2 byte option
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_OK, otapp_coap_block2Get(&test_block_response.message, &block_));
+    TEST_ASSERT_EQUAL(300, block_.num);
+    TEST_ASSERT_EQUAL(1, block_.more);
+    TEST_ASSERT_EQUAL(2, block_.szx);
+
+    test_block_optionSet(0, 0, 0); // empty option: value 0
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_OK, otapp_coap_block2Get(&test_block_response.message, &block_));
+    TEST_ASSERT_EQUAL(0, block_.num);
+    TEST_ASSERT_EQUAL(0, block_.szx);
+
+    test_block_option.mLength = 4;
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_ERROR, otapp_coap_block2Get(&test_block_response.message, &block_));
+}
+
+TEST(ot_app_coap_block, GivenRepresentationSize_WhenCallBlock2Window_ThenBlockSelected)
+{
+    otapp_coap_block_t block_;
+    otapp_coap_block_t request_ = {.num = 3, .more = 0, .szx = 2};
+    uint16_t offset_, size_;
+
+    // request without Block2, fits into one block
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_NONE, otapp_coap_block2Window(NULL, 60, &block_, &offset_, &size_));
+    TEST_ASSERT_EQUAL(60, size_);
+
+    // request without Block2, server starts with block 0
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_OK, otapp_coap_block2Window(NULL, 200, &block_, &offset_, &size_));
+    TEST_ASSERT_EQUAL(0, block_.num);
+    TEST_ASSERT_EQUAL(1, block_.more);
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_SZX_DEFAULT, block_.szx);
+    TEST_ASSERT_EQUAL(0, offset_);
+    TEST_ASSERT_EQUAL(64, size_);
+
+    // last block
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_OK, otapp_coap_block2Window(&request_, 200, &block_, &offset_, &size_));
+    TEST_ASSERT_EQUAL(3, block_.num);
+    TEST_ASSERT_EQUAL(0, block_.more);
+    TEST_ASSERT_EQUAL(192, offset_);
+    TEST_ASSERT_EQUAL(8, size_);
+
+    // bigger block requested: server block size, number scaled to the same offset
+    request_.num = 1;
+    request_.szx = 6;
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_OK, otapp_coap_block2Window(&request_, 1100, &block_, &offset_, &size_));
+    TEST_ASSERT_EQUAL(16, block_.num);
+    TEST_ASSERT_EQUAL(1, block_.more);
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_SZX_DEFAULT, block_.szx);
+    TEST_ASSERT_EQUAL(1024, offset_);
+    TEST_ASSERT_EQUAL(64, size_);
+
+    // behind the end
+    request_.num = 4;
+    request_.szx = 2;
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_ERROR, otapp_coap_block2Window(&request_, 200, &block_, &offset_, &size_));
+}
+
+TEST(ot_app_coap_block, GivenThreeBlocks_WhenRequest_ThenHandlerGetsWholeRepresentation)
+{
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_OK, otapp_coap_block2Request(&test_block_ipAddr, test_block_uri, test_block_userResponse, &test_block_context));
+    TEST_ASSERT_EQUAL(1, otapp_coap_blockTransfersGet());
+    TEST_ASSERT_EQUAL(0, test_block_requested.num);
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_SZX_DEFAULT, test_block_requested.szx);
+
+    test_block_serverRespond(150, 2);
+    TEST_ASSERT_EQUAL(1, test_block_requested.num);
+    test_block_serverRespond(150, 2);
+    TEST_ASSERT_EQUAL(2, test_block_requested.num);
+    TEST_ASSERT_EQUAL(0, test_block_userResponse_fake.call_count);
+    test_block_serverRespond(150, 2);
+
+    TEST_ASSERT_EQUAL(3, test_block_sendGet_fake.call_count);
+    TEST_ASSERT_EQUAL(1, test_block_userResponse_fake.call_count);
+    TEST_ASSERT_EQUAL_PTR(&test_block_context, test_block_userResponse_fake.arg0_val);
+    TEST_ASSERT_EQUAL_PTR(&test_block_body.message, test_block_userResponse_fake.arg1_val);
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, test_block_userResponse_fake.arg3_val);
+    TEST_ASSERT_EQUAL(150, test_block_userLength);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(test_block_representation, test_block_userData, 150);
+
+    TEST_ASSERT_EQUAL(1, otMessageFree_fake.call_count);
+    TEST_ASSERT_EQUAL_PTR(&test_block_body.message, otMessageFree_fake.arg0_val);
+    TEST_ASSERT_EQUAL(0, otapp_coap_blockTransfersGet());
+}
+
+TEST(ot_app_coap_block, GivenServerSmallerBlocks_WhenRequest_ThenNextBlockWithServerSize)
+{
+    otapp_coap_block2Request(&test_block_ipAddr, test_block_uri, test_block_userResponse, &test_block_context);
+
+    test_block_serverRespond(100, 1); // 32 byte blocks
+    TEST_ASSERT_EQUAL(1, test_block_requested.num);
+    TEST_ASSERT_EQUAL(1, test_block_requested.szx);
+
+    while (test_block_userResponse_fake.call_count == 0 && test_block_sendGet_fake.call_count < 10)
+    {
+        test_block_serverRespond(100, 1);
+    }
+
+    TEST_ASSERT_EQUAL(4, test_block_sendGet_fake.call_count);
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, test_block_userResponse_fake.arg3_val);
+    TEST_ASSERT_EQUAL(100, test_block_userLength);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(test_block_representation, test_block_userData, 100);
+}
+
+TEST(ot_app_coap_block, GivenOneBlockOrNoOption_WhenRequest_ThenHandlerGetsResponse)
+{
+    // whole representation in block 0
+    otapp_coap_block2Request(&test_block_ipAddr, test_block_uri, test_block_userResponse, &test_block_context);
+    test_block_serverRespond(40, 2);
+
+    TEST_ASSERT_EQUAL_PTR(&test_block_response.message, test_block_userResponse_fake.arg1_val);
+    TEST_ASSERT_EQUAL(40, test_block_userLength);
+
+    // server without Block2 support
+    otapp_coap_block2Request(&test_block_ipAddr, test_block_uri, test_block_userResponse, &test_block_context);
+    test_block_serverRespond(40, 2);
+    test_block_hasOption = 0;
+    test_block_handler(test_block_handlerContext, &test_block_response.message, NULL, OT_ERROR_NONE);
+
+    TEST_ASSERT_EQUAL(2, test_block_userResponse_fake.call_count);
+    TEST_ASSERT_EQUAL_PTR(&test_block_response.message, test_block_userResponse_fake.arg1_val);
+    TEST_ASSERT_EQUAL(0, test_block_messageNew_fake.call_count);
+    TEST_ASSERT_EQUAL(0, otMessageFree_fake.call_count);
+    TEST_ASSERT_EQUAL(0, otapp_coap_blockTransfersGet());
+}
+
+TEST(ot_app_coap_block, GivenUnexpectedBlock_WhenResponse_ThenHandlerGetsParseError)
+{
+    otapp_coap_block2Request(&test_block_ipAddr, test_block_uri, test_block_userResponse, &test_block_context);
+    test_block_serverRespond(200, 2);
+
+    test_block_requested.num = 2; // server skips block 1
+    test_block_serverRespond(200, 2);
+
+    TEST_ASSERT_EQUAL(1, test_block_userResponse_fake.call_count);
+    TEST_ASSERT_NULL(test_block_userResponse_fake.arg1_val);
+    TEST_ASSERT_EQUAL(OT_ERROR_PARSE, test_block_userResponse_fake.arg3_val);
+    TEST_ASSERT_EQUAL(1, otMessageFree_fake.call_count);
+    TEST_ASSERT_EQUAL(0, otapp_coap_blockTransfersGet());
+
+    // response is late, transfer already closed
+    test_block_handler(test_block_handlerContext, &test_block_response.message, NULL, OT_ERROR_NONE);
+    TEST_ASSERT_EQUAL(1, test_block_userResponse_fake.call_count);
+}
+
+TEST(ot_app_coap_block, GivenTimeout_WhenResponse_ThenHandlerGetsError)
+{
+    otapp_coap_block2Request(&test_block_ipAddr, test_block_uri, test_block_userResponse, &test_block_context);
+    test_block_serverRespond(200, 2);
+
+    test_block_handler(test_block_handlerContext, NULL, NULL, OT_ERROR_GENERIC);
+
+    TEST_ASSERT_EQUAL(1, test_block_userResponse_fake.call_count);
+    TEST_ASSERT_NULL(test_block_userResponse_fake.arg1_val);
+    TEST_ASSERT_EQUAL(OT_ERROR_GENERIC, test_block_userResponse_fake.arg3_val);
+    TEST_ASSERT_EQUAL(1, otMessageFree_fake.call_count);
+    TEST_ASSERT_EQUAL(0, otapp_coap_blockTransfersGet());
+}
+
+TEST(ot_app_coap_block, GivenFullTransferTable_WhenRequest_ThenPlainGet)
+{
+    for (uint8_t i = 0; i < OTAPP_COAP_BLOCK_TRANSFERS_MAX; i++)
+    {
+        TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_OK, otapp_coap_block2Request(&test_block_ipAddr, test_block_uri, test_block_userResponse, &test_block_context));
+    }
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_TRANSFERS_MAX, otapp_coap_blockTransfersGet());
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_OK, otapp_coap_block2Request(&test_block_ipAddr, test_block_uri, test_block_userResponse, &test_block_context));
+    TEST_ASSERT_NULL(test_block_sendGet_fake.arg2_val);
+    TEST_ASSERT_EQUAL_PTR(test_block_userResponse, test_block_sendGet_fake.arg3_val);
+    TEST_ASSERT_EQUAL_PTR(&test_block_context, test_block_sendGet_fake.arg4_val);
+
+    // send error: transfer released
+    otapp_coap_blockInit(test_block_sendGet, test_block_messageNew);
+    test_block_sendGet_fake.custom_fake = NULL;
+    test_block_sendGet_fake.return_val = OT_ERROR_NO_BUFS;
+    TEST_ASSERT_EQUAL(OTAPP_COAP_BLOCK_ERROR, otapp_coap_block2Request(&test_block_ipAddr, test_block_uri, test_block_userResponse, &test_block_context));
+    TEST_ASSERT_EQUAL(0, otapp_coap_blockTransfersGet());
+}
@@ -0,0 +1,14 @@
+#include "unity_fixture.h"
+
+TEST_GROUP_RUNNER(ot_app_coap_block)
+{
+   RUN_TEST_CASE(ot_app_coap_block, GivenBlock_WhenEncodeAndDecode_ThenSameValue);
+   RUN_TEST_CASE(ot_app_coap_block, GivenBlock2Option_WhenCallBlock2Get_ThenDecoded);
+   RUN_TEST_CASE(ot_app_coap_block, GivenRepresentationSize_WhenCallBlock2Window_ThenBlockSelected);
+   RUN_TEST_CASE(ot_app_coap_block, GivenThreeBlocks_WhenRequest_ThenHandlerGetsWholeRepresentation);
+   RUN_TEST_CASE(ot_app_coap_block, GivenServerSmallerBlocks_WhenRequest_ThenNextBlockWithServerSize);
+   RUN_TEST_CASE(ot_app_coap_block, GivenOneBlockOrNoOption_WhenRequest_ThenHandlerGetsResponse);
+   RUN_TEST_CASE(ot_app_coap_block, GivenUnexpectedBlock_WhenResponse_ThenHandlerGetsParseError);
+   RUN_TEST_CASE(ot_app_coap_block, GivenTimeout_WhenResponse_ThenHandlerGetsError);
+   RUN_TEST_CASE(ot_app_coap_block, GivenFullTransferTable_WhenRequest_ThenPlainGet);
+}
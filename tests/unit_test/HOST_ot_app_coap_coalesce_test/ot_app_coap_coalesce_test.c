@@ -0,0 +1,271 @@
+#include "unity_fixture.h"
+#include "ot_app_coap_coalesce.h"
+#include "mock_ot_app_port_openthread.h"
+#include "string.h"
+#include <pthread.h>
+#include <unistd.h>
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC7(otError, test_coalesce_send, const otIp6Address *, const char *, const uint8_t *, uint16_t, otapp_coap_transport_t, otCoapResponseHandler, void *);
+FAKE_VOID_FUNC4(test_coalesce_userResponse, void *, otMessage *, const otMessageInfo *, otError);
+
+static const otIp6Address test_coalesce_ipAddr = {.mFields.m8 = {0xfd, 0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01}};
+static const otIp6Address test_coalesce_ipAddr2 = {.mFields.m8 = {0xfd, 0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02}};
+static const char *test_coalesce_uriDimm = "light/dimm";
+static const char *test_coalesce_uriRgb = "light/rgb";
+
+static uint32_t test_coalesce_lastValue; // payload of the last send, pending value is sent from a local buffer
+static otError test_coalesce_sendError;  // result of the send, e.g. OT_ERROR_NO_BUFS
+
+static otError test_coalesce_sendCustom(const otIp6Address *peer_addr, const char *aUriPath, const uint8_t *payloadMsg, uint16_t payloadMsgSize, otapp_coap_transport_t transport, otCoapResponseHandler responseHandler, void *aContext)
+{
+    (void)peer_addr; (void)aUriPath; (void)payloadMsgSize; (void)transport; (void)responseHandler; (void)aContext;
+    if(test_coalesce_sendError == OT_ERROR_NONE)
+    {
+        memcpy(&test_coalesce_lastValue, payloadMsg, sizeof(test_coalesce_lastValue));
+    }
+    return test_coalesce_sendError;
+}
+
+// response of the request in flight (ACK or timeout)
+static void test_coalesce_responseLast(otError result)
+{
+    otCoapResponseHandler handler = test_coalesce_send_fake.arg5_val;
+    TEST_ASSERT_NOT_NULL(handler);
+    handler(test_coalesce_send_fake.arg6_val, NULL, NULL, result);
+}
+
+static int8_t test_coalesce_put(const otIp6Address *ipAddr, const char *uri, uint32_t value, otapp_coap_transport_t transport)
+{
+    return otapp_coap_coalescePut(ipAddr, uri, (uint8_t *)&value, sizeof(value), transport, test_coalesce_userResponse, NULL);
+}
+
+TEST_GROUP(ot_app_coap_coalesce);
+
+TEST_SETUP(ot_app_coap_coalesce)
+{
+    /* Init before every test */
+    RESET_FAKE(test_coalesce_send);
+    RESET_FAKE(test_coalesce_userResponse);
+    test_coalesce_send_fake.custom_fake = test_coalesce_sendCustom;
+    test_coalesce_lastValue = 0;
+    test_coalesce_sendError = OT_ERROR_NONE;
+    otapp_coap_coalesceInit(test_coalesce_send);
+}
+
+TEST_TEAR_DOWN(ot_app_coap_coalesce)
+{
+    /* Cleanup after every test */
+}
+
+TEST(ot_app_coap_coalesce, GivenIncorrectArgs_WhenCallingCoalescePut_ThenReturnError)
+{
+    uint8_t payload_[OTAPP_COAP_COALESCE_PAYLOAD_MAX + 1] = {0};
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_ERROR, otapp_coap_coalescePut(NULL, test_coalesce_uriDimm, payload_, 4, OTAPP_COAP_TRANSPORT_CON, NULL, NULL));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_ERROR, otapp_coap_coalescePut(&test_coalesce_ipAddr, NULL, payload_, 4, OTAPP_COAP_TRANSPORT_CON, NULL, NULL));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_ERROR, otapp_coap_coalescePut(&test_coalesce_ipAddr, test_coalesce_uriDimm, NULL, 4, OTAPP_COAP_TRANSPORT_CON, NULL, NULL));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_ERROR, otapp_coap_coalescePut(&test_coalesce_ipAddr, test_coalesce_uriDimm, payload_, 0, OTAPP_COAP_TRANSPORT_CON, NULL, NULL));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_ERROR, otapp_coap_coalescePut(&test_coalesce_ipAddr, test_coalesce_uriDimm, payload_, sizeof(payload_), OTAPP_COAP_TRANSPORT_CON, NULL, NULL));
+
+    otapp_coap_coalesceInit(NULL);
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_ERROR, otapp_coap_coalescePut(&test_coalesce_ipAddr, test_coalesce_uriDimm, payload_, 4, OTAPP_COAP_TRANSPORT_CON, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, test_coalesce_send_fake.call_count);
+}
+
+TEST(ot_app_coap_coalesce, GivenIdleTarget_WhenCallingCoalescePut_ThenSendNow)
+{
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_OK, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 10, OTAPP_COAP_TRANSPORT_CON));
+    TEST_ASSERT_EQUAL(1, test_coalesce_send_fake.call_count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&test_coalesce_ipAddr, test_coalesce_send_fake.arg0_val, OT_IP6_ADDRESS_SIZE);
+    TEST_ASSERT_EQUAL_STRING(test_coalesce_uriDimm, test_coalesce_send_fake.arg1_val);
+    TEST_ASSERT_EQUAL(OTAPP_COAP_TRANSPORT_CON, test_coalesce_send_fake.arg4_val);
+    TEST_ASSERT_EQUAL(10, test_coalesce_lastValue);
+
+    // user handler called through the slot
+    test_coalesce_responseLast(OT_ERROR_NONE);
+    TEST_ASSERT_EQUAL(1, test_coalesce_userResponse_fake.call_count);
+
+    // exchange ended: next value sent now
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_OK, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 11, OTAPP_COAP_TRANSPORT_CON));
+    TEST_ASSERT_EQUAL(2, test_coalesce_send_fake.call_count);
+}
+
+TEST(ot_app_coap_coalesce, GivenConInFlight_WhenCallingCoalescePut_ThenLatestValueWins)
+{
+    test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 10, OTAPP_COAP_TRANSPORT_CON);
+
+    for (uint32_t value = 11; value <= 20; value++)
+    {
+        TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_PENDING, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, value, OTAPP_COAP_TRANSPORT_CON));
+    }
+    TEST_ASSERT_EQUAL(1, test_coalesce_send_fake.call_count);
+    TEST_ASSERT_EQUAL(1, otapp_coap_coalescePendingGet());
+
+    // timeout of the request in flight: only the newest value is sent
+    test_coalesce_responseLast(OT_ERROR_GENERIC);
+    TEST_ASSERT_EQUAL(2, test_coalesce_send_fake.call_count);
+    TEST_ASSERT_EQUAL(20, test_coalesce_lastValue);
+    TEST_ASSERT_EQUAL(0, otapp_coap_coalescePendingGet());
+
+    test_coalesce_responseLast(OT_ERROR_NONE);
+    TEST_ASSERT_EQUAL(2, test_coalesce_send_fake.call_count);
+    TEST_ASSERT_EQUAL(2, test_coalesce_userResponse_fake.call_count);
+}
+
+TEST(ot_app_coap_coalesce, GivenPendingCon_WhenNewerNonValue_ThenPendingStaysCon)
+{
+    test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 10, OTAPP_COAP_TRANSPORT_CON);
+    test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 11, OTAPP_COAP_TRANSPORT_CON); // checkpoint
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_PENDING, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 12, OTAPP_COAP_TRANSPORT_NON));
+
+    test_coalesce_responseLast(OT_ERROR_NONE);
+    TEST_ASSERT_EQUAL(2, test_coalesce_send_fake.call_count);
+    TEST_ASSERT_EQUAL(OTAPP_COAP_TRANSPORT_CON, test_coalesce_send_fake.arg4_val);
+    TEST_ASSERT_EQUAL(12, test_coalesce_lastValue);
+}
+
+TEST(ot_app_coap_coalesce, GivenNonStream_WhenCallingCoalescePut_ThenNotBlocked)
+{
+    for (uint32_t value = 1; value <= 3; value++)
+    {
+        TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_OK, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, value, OTAPP_COAP_TRANSPORT_NON));
+    }
+    TEST_ASSERT_EQUAL(3, test_coalesce_send_fake.call_count);
+    TEST_ASSERT_EQUAL(OTAPP_COAP_TRANSPORT_NON, test_coalesce_send_fake.arg4_val);
+    TEST_ASSERT_EQUAL_PTR(test_coalesce_userResponse, test_coalesce_send_fake.arg5_val);
+    TEST_ASSERT_EQUAL(0, otapp_coap_coalescePendingGet());
+}
+
+TEST(ot_app_coap_coalesce, GivenTwoTargets_WhenCallingCoalescePut_ThenSeparateSlots)
+{
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_OK, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 10, OTAPP_COAP_TRANSPORT_CON));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_OK, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriRgb, 20, OTAPP_COAP_TRANSPORT_CON));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_OK, test_coalesce_put(&test_coalesce_ipAddr2, test_coalesce_uriDimm, 30, OTAPP_COAP_TRANSPORT_CON));
+    TEST_ASSERT_EQUAL(3, test_coalesce_send_fake.call_count);
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_PENDING, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriRgb, 21, OTAPP_COAP_TRANSPORT_CON));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_PENDING, test_coalesce_put(&test_coalesce_ipAddr2, test_coalesce_uriDimm, 31, OTAPP_COAP_TRANSPORT_CON));
+    TEST_ASSERT_EQUAL(2, otapp_coap_coalescePendingGet());
+}
+
+TEST(ot_app_coap_coalesce, GivenAllSlotsBusy_WhenCallingCoalescePut_ThenSendDirectly)
+{
+    otIp6Address ipAddr_ = test_coalesce_ipAddr;
+
+    for (uint8_t i = 0; i < OTAPP_COAP_COALESCE_SLOTS_MAX; i++)
+    {
+        ipAddr_.mFields.m8[15] = 0x10 + i;
+        TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_OK, test_coalesce_put(&ipAddr_, test_coalesce_uriDimm, i, OTAPP_COAP_TRANSPORT_CON));
+    }
+
+    ipAddr_.mFields.m8[15] = 0xFF;
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_OK, test_coalesce_put(&ipAddr_, test_coalesce_uriDimm, 99, OTAPP_COAP_TRANSPORT_CON));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_SLOTS_MAX + 1, test_coalesce_send_fake.call_count);
+    TEST_ASSERT_EQUAL_PTR(test_coalesce_userResponse, test_coalesce_send_fake.arg5_val); // not tracked
+}
+
+TEST(ot_app_coap_coalesce, GivenSendFails_WhenCallingCoalescePut_ThenErrorAndSlotNotInFlight)
+{
+    test_coalesce_sendError = OT_ERROR_NO_BUFS;
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_ERROR, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 10, OTAPP_COAP_TRANSPORT_CON));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_ERROR, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 11, OTAPP_COAP_TRANSPORT_NON));
+    TEST_ASSERT_EQUAL(2, test_coalesce_send_fake.call_count);
+    TEST_ASSERT_EQUAL(0, otapp_coap_coalescePendingGet());
+    TEST_ASSERT_EQUAL(0, test_coalesce_userResponse_fake.call_count);
+
+    // nothing in flight: the next value is sent now, not stored as pending
+    test_coalesce_sendError = OT_ERROR_NONE;
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_OK, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 12, OTAPP_COAP_TRANSPORT_CON));
+    TEST_ASSERT_EQUAL(3, test_coalesce_send_fake.call_count);
+    TEST_ASSERT_EQUAL(12, test_coalesce_lastValue);
+}
+
+TEST(ot_app_coap_coalesce, GivenPendingSendFails_WhenRequestInFlightEnds_ThenErrorToHandler)
+{
+    test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 10, OTAPP_COAP_TRANSPORT_CON);
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_PENDING, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 11, OTAPP_COAP_TRANSPORT_CON));
+
+    test_coalesce_sendError = OT_ERROR_NO_BUFS;
+    test_coalesce_responseLast(OT_ERROR_NONE);
+    TEST_ASSERT_EQUAL(2, test_coalesce_send_fake.call_count);
+    TEST_ASSERT_EQUAL(0, otapp_coap_coalescePendingGet());
+
+    // first: response of the request in flight, second: send error of the pending value
+    TEST_ASSERT_EQUAL(2, test_coalesce_userResponse_fake.call_count);
+    TEST_ASSERT_EQUAL(OT_ERROR_NONE, test_coalesce_userResponse_fake.arg3_history[0]);
+    TEST_ASSERT_EQUAL(OT_ERROR_NO_BUFS, test_coalesce_userResponse_fake.arg3_history[1]);
+    TEST_ASSERT_NULL(test_coalesce_userResponse_fake.arg1_history[1]);
+
+    // slot is free again
+    test_coalesce_sendError = OT_ERROR_NONE;
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_OK, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 12, OTAPP_COAP_TRANSPORT_CON));
+    TEST_ASSERT_EQUAL(12, test_coalesce_lastValue);
+}
+
+TEST(ot_app_coap_coalesce, GivenAllSlotsBusyAndSendFails_WhenCallingCoalescePut_ThenError)
+{
+    otIp6Address ipAddr_ = test_coalesce_ipAddr;
+
+    for (uint8_t i = 0; i < OTAPP_COAP_COALESCE_SLOTS_MAX; i++)
+    {
+        ipAddr_.mFields.m8[15] = 0x10 + i;
+        TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_OK, test_coalesce_put(&ipAddr_, test_coalesce_uriDimm, i, OTAPP_COAP_TRANSPORT_CON));
+    }
+
+    test_coalesce_sendError = OT_ERROR_NO_BUFS;
+    ipAddr_.mFields.m8[15] = 0xFF;
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_ERROR, test_coalesce_put(&ipAddr_, test_coalesce_uriDimm, 99, OTAPP_COAP_TRANSPORT_CON));
+}
+
+// drv task puts while the OpenThread tasklet is inside the response handler of the slot
+static pthread_t test_coalesce_thread;
+static volatile int8_t test_coalesce_threadResult;
+static volatile uint8_t test_coalesce_threadStarted;
+
+static void *test_coalesce_putThread(void *arg)
+{
+    (void)arg;
+    test_coalesce_threadResult = test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 30, OTAPP_COAP_TRANSPORT_CON);
+    return NULL;
+}
+
+static void test_coalesce_userResponsePut(void *aContext, otMessage *aMessage, const otMessageInfo *aMessageInfo, otError aResult)
+{
+    (void)aContext; (void)aMessage; (void)aMessageInfo; (void)aResult;
+    if(!test_coalesce_threadStarted)
+    {
+        test_coalesce_threadStarted = 1;
+        pthread_create(&test_coalesce_thread, NULL, test_coalesce_putThread, NULL);
+        usleep(20 * 1000); // put tries to preempt the tasklet between isInFlight = 0 and the pending send
+    }
+}
+
+TEST(ot_app_coap_coalesce, GivenPutFromOtherTask_WhenResponseHandled_ThenLatestValueSentLast)
+{
+    test_coalesce_threadResult = OTAPP_COAP_COALESCE_ERROR;
+    test_coalesce_threadStarted = 0;
+    test_coalesce_userResponse_fake.custom_fake = test_coalesce_userResponsePut;
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_OK, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 10, OTAPP_COAP_TRANSPORT_CON));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_PENDING, test_coalesce_put(&test_coalesce_ipAddr, test_coalesce_uriDimm, 20, OTAPP_COAP_TRANSPORT_CON));
+
+    // tasklet: ACK of 10 under the OpenThread lock, put of 30 waits for it
+    otapp_port_openthread_lock();
+    test_coalesce_responseLast(OT_ERROR_NONE);
+    otapp_port_openthread_unlock();
+    pthread_join(test_coalesce_thread, NULL);
+
+    TEST_ASSERT_EQUAL(1, test_coalesce_threadStarted);
+    TEST_ASSERT_EQUAL(2, test_coalesce_send_fake.call_count);
+    TEST_ASSERT_EQUAL(20, test_coalesce_lastValue);
+    TEST_ASSERT_EQUAL(OTAPP_COAP_COALESCE_PENDING, test_coalesce_threadResult);
+    TEST_ASSERT_EQUAL(1, otapp_coap_coalescePendingGet());
+
+    // ACK of 20: the newest value goes last
+    test_coalesce_responseLast(OT_ERROR_NONE);
+    TEST_ASSERT_EQUAL(3, test_coalesce_send_fake.call_count);
+    TEST_ASSERT_EQUAL(30, test_coalesce_lastValue);
+    TEST_ASSERT_EQUAL(0, otapp_coap_coalescePendingGet());
+}
@@ -0,0 +1,16 @@
+#include "unity_fixture.h"
+
+TEST_GROUP_RUNNER(ot_app_coap_coalesce)
+{
+   RUN_TEST_CASE(ot_app_coap_coalesce, GivenIncorrectArgs_WhenCallingCoalescePut_ThenReturnError);
+   RUN_TEST_CASE(ot_app_coap_coalesce, GivenIdleTarget_WhenCallingCoalescePut_ThenSendNow);
+   RUN_TEST_CASE(ot_app_coap_coalesce, GivenConInFlight_WhenCallingCoalescePut_ThenLatestValueWins);
+   RUN_TEST_CASE(ot_app_coap_coalesce, GivenPendingCon_WhenNewerNonValue_ThenPendingStaysCon);
+   RUN_TEST_CASE(ot_app_coap_coalesce, GivenNonStream_WhenCallingCoalescePut_ThenNotBlocked);
+   RUN_TEST_CASE(ot_app_coap_coalesce, GivenTwoTargets_WhenCallingCoalescePut_ThenSeparateSlots);
+   RUN_TEST_CASE(ot_app_coap_coalesce, GivenAllSlotsBusy_WhenCallingCoalescePut_ThenSendDirectly);
+   RUN_TEST_CASE(ot_app_coap_coalesce, GivenSendFails_WhenCallingCoalescePut_ThenErrorAndSlotNotInFlight);
+   RUN_TEST_CASE(ot_app_coap_coalesce, GivenPendingSendFails_WhenRequestInFlightEnds_ThenErrorToHandler);
+   RUN_TEST_CASE(ot_app_coap_coalesce, GivenAllSlotsBusyAndSendFails_WhenCallingCoalescePut_ThenError);
+   RUN_TEST_CASE(ot_app_coap_coalesce, GivenPutFromOtherTask_WhenResponseHandled_ThenLatestValueSentLast);
+}
@@ -0,0 +1,261 @@
+#include "unity_fixture.h"
+#include "ot_app_coap_notify.h"
+#include "string.h"
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC2(int8_t, test_notify_batch, const oac_uri_obs_notifyItem_t *, uint8_t);
+
+static const otIp6Address test_notify_ipAddr = {.mFields.m8 = {0xfd, 0x00, 0, 0, 0, 0, 0, 0, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x01}};
+static uint8_t test_notify_data[4] = {0x01, 0x02, 0x03, 0x04};
+
+// items are on the stack of otapp_coap_notifyRun(), checked inside the fake
+static oac_uri_obs_notifyItem_t test_notify_items[OTAPP_COAP_NOTIFY_BATCH_MAX];
+static uint8_t test_notify_itemsData[OTAPP_COAP_NOTIFY_BATCH_MAX][OAC_URI_OBS_BUFFER_SIZE];
+static otIp6Address test_notify_itemsAddr[OTAPP_COAP_NOTIFY_BATCH_MAX];
+
+static int8_t test_notify_batchCopy(const oac_uri_obs_notifyItem_t *items, uint8_t itemsQty)
+{
+    for (uint8_t i = 0; i < itemsQty; i++)
+    {
+        test_notify_items[i] = items[i];
+        memcpy(test_notify_itemsData[i], items[i].data, items[i].dataSize);
+        if(items[i].excludedIpAddr != NULL) test_notify_itemsAddr[i] = *items[i].excludedIpAddr;
+    }
+    return (int8_t)itemsQty;
+}
+
+TEST_GROUP(ot_app_coap_notify);
+
+TEST_SETUP(ot_app_coap_notify)
+{
+    /* Init before every test */
+    RESET_FAKE(test_notify_batch);
+    FFF_RESET_HISTORY();
+    memset(test_notify_items, 0, sizeof(test_notify_items));
+    test_notify_batch_fake.custom_fake = test_notify_batchCopy;
+    otapp_coap_notifyInit(test_notify_batch);
+}
+
+TEST_TEAR_DOWN(ot_app_coap_notify)
+{
+    /* Cleanup after every test */
+}
+
+TEST(ot_app_coap_notify, GivenIncorrectArgs_WhenCallingJobSet_ThenReturnError)
+{
+    otapp_coap_notifyJob_t job_;
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_ERROR, otapp_coap_notifyJobSet(NULL, &test_notify_ipAddr, 1, test_notify_data, 4, 0));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_ERROR, otapp_coap_notifyJobSet(&job_, &test_notify_ipAddr, 1, NULL, 4, 0));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_ERROR, otapp_coap_notifyJobSet(&job_, &test_notify_ipAddr, 1, test_notify_data, OAC_URI_OBS_BUFFER_SIZE + 1, 0));
+}
+
+TEST(ot_app_coap_notify, GivenRequestData_WhenJobSet_ThenDataCopied)
+{
+    otapp_coap_notifyJob_t job_;
+    otIp6Address ipAddr_ = test_notify_ipAddr;
+    uint8_t data_[4] = {0x01, 0x02, 0x03, 0x04};
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_OK, otapp_coap_notifyJobSet(&job_, &ipAddr_, 3, data_, sizeof(data_), 500));
+
+    // request buffers are reused after the handler returns
+    memset(&ipAddr_, 0, sizeof(ipAddr_));
+    memset(data_, 0, sizeof(data_));
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&test_notify_ipAddr, &job_.excludedIpAddr, OT_IP6_ADDRESS_SIZE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(test_notify_data, job_.data, sizeof(test_notify_data));
+    TEST_ASSERT_EQUAL(1, job_.isExcluded);
+    TEST_ASSERT_EQUAL(4, job_.dataSize);
+    TEST_ASSERT_EQUAL(3, job_.uriIndex);
+    TEST_ASSERT_EQUAL(500, job_.postTimeMs);
+}
+
+TEST(ot_app_coap_notify, GivenNullExcludedAddr_WhenRun_ThenItemWithoutExcluded)
+{
+    otapp_coap_notifyJob_t job_;
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_OK, otapp_coap_notifyJobSet(&job_, NULL, 2, test_notify_data, 4, 0));
+    TEST_ASSERT_EQUAL(1, otapp_coap_notifyRun(&job_, 1, 0));
+
+    TEST_ASSERT_EQUAL(1, test_notify_batch_fake.call_count);
+    TEST_ASSERT_NULL(test_notify_items[0].excludedIpAddr);
+    TEST_ASSERT_EQUAL(2, test_notify_items[0].uriIndex);
+}
+
+TEST(ot_app_coap_notify, GivenNotInitialized_WhenRun_ThenReturnError)
+{
+    otapp_coap_notifyJob_t job_;
+
+    otapp_coap_notifyJobSet(&job_, &test_notify_ipAddr, 1, test_notify_data, 4, 0);
+    otapp_coap_notifyInit(NULL);
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_ERROR, otapp_coap_notifyRun(&job_, 1, 0));
+    TEST_ASSERT_EQUAL(0, test_notify_batch_fake.call_count);
+    TEST_ASSERT_EQUAL(0, otapp_coap_notifyStatsGet()->done);
+}
+
+TEST(ot_app_coap_notify, GivenSeveralJobs_WhenRun_ThenOneBatchCall)
+{
+    otapp_coap_notifyJob_t jobs_[3];
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        uint8_t data_[2] = {0xA0, i};
+        TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_OK, otapp_coap_notifyJobSet(&jobs_[i], &test_notify_ipAddr, i + 1, data_, sizeof(data_), 0));
+    }
+
+    TEST_ASSERT_EQUAL(3, otapp_coap_notifyRun(jobs_, 3, 10));
+
+    TEST_ASSERT_EQUAL(1, test_notify_batch_fake.call_count);
+    TEST_ASSERT_EQUAL(3, test_notify_batch_fake.arg1_val);
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_EQUAL(i + 1, test_notify_items[i].uriIndex);
+        TEST_ASSERT_EQUAL(2, test_notify_items[i].dataSize);
+        TEST_ASSERT_EQUAL_HEX8(i, test_notify_itemsData[i][1]);
+        TEST_ASSERT_NOT_NULL(test_notify_items[i].excludedIpAddr);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(&test_notify_ipAddr, &test_notify_itemsAddr[i], OT_IP6_ADDRESS_SIZE);
+    }
+    TEST_ASSERT_EQUAL(3, otapp_coap_notifyStatsGet()->done);
+    TEST_ASSERT_EQUAL(1, otapp_coap_notifyStatsGet()->cycles);
+}
+
+TEST(ot_app_coap_notify, GivenTooManyJobs_WhenRun_ThenReturnError)
+{
+    otapp_coap_notifyJob_t jobs_[OTAPP_COAP_NOTIFY_BATCH_MAX + 1];
+
+    memset(jobs_, 0, sizeof(jobs_));
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_ERROR, otapp_coap_notifyRun(jobs_, OTAPP_COAP_NOTIFY_BATCH_MAX + 1, 0));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_ERROR, otapp_coap_notifyRun(jobs_, 0, 0));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_ERROR, otapp_coap_notifyRun(NULL, 1, 0));
+    TEST_ASSERT_EQUAL(0, test_notify_batch_fake.call_count);
+}
+
+TEST(ot_app_coap_notify, GivenJobsPosted_WhenRun_ThenLagStats)
+{
+    otapp_coap_notifyJob_t jobs_[2];
+    const otapp_coap_notifyStats_t *stats_;
+
+    otapp_coap_notifyJobSet(&jobs_[0], &test_notify_ipAddr, 1, test_notify_data, 4, 1000);
+    otapp_coap_notifyJobSet(&jobs_[1], &test_notify_ipAddr, 1, test_notify_data, 4, 1030);
+    otapp_coap_notifyRun(jobs_, 2, 1050);
+
+    otapp_coap_notifyJobSet(&jobs_[0], &test_notify_ipAddr, 1, test_notify_data, 4, UINT32_MAX - 4); // tick wrap
+    otapp_coap_notifyRun(jobs_, 1, 5);
+
+    stats_ = otapp_coap_notifyStatsGet();
+    TEST_ASSERT_EQUAL(3, stats_->done);
+    TEST_ASSERT_EQUAL(2, stats_->cycles);
+    TEST_ASSERT_EQUAL(10, stats_->lagLastMs);
+    TEST_ASSERT_EQUAL(50, stats_->lagMaxMs);
+    TEST_ASSERT_EQUAL(50 + 20 + 10, stats_->lagSumMs);
+}
+
+TEST(ot_app_coap_notify, GivenIncorrectArgs_WhenPost_ThenReturnError)
+{
+    otapp_coap_notifyJob_t jobs_[OTAPP_COAP_NOTIFY_BATCH_MAX];
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_ERROR, otapp_coap_notifyPost(&test_notify_ipAddr, 1, NULL, 4, 0));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_ERROR, otapp_coap_notifyPost(&test_notify_ipAddr, 1, test_notify_data, OAC_URI_OBS_BUFFER_SIZE + 1, 0));
+    TEST_ASSERT_EQUAL(0, otapp_coap_notifyTake(jobs_, OTAPP_COAP_NOTIFY_BATCH_MAX));
+    TEST_ASSERT_EQUAL(0, otapp_coap_notifyTake(NULL, OTAPP_COAP_NOTIFY_BATCH_MAX));
+    TEST_ASSERT_EQUAL(0, otapp_coap_notifyStatsGet()->posted);
+}
+
+TEST(ot_app_coap_notify, GivenSameUriPostedTwice_WhenTake_ThenLatestValueOnce)
+{
+    otapp_coap_notifyJob_t jobs_[OTAPP_COAP_NOTIFY_BATCH_MAX];
+    uint8_t data1_[1] = {0x01};
+    uint8_t data2_[1] = {0x02};
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_OK, otapp_coap_notifyPost(&test_notify_ipAddr, 3, data1_, 1, 100));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_MERGED, otapp_coap_notifyPost(NULL, 3, data2_, 1, 120));
+
+    TEST_ASSERT_EQUAL(1, otapp_coap_notifyTake(jobs_, OTAPP_COAP_NOTIFY_BATCH_MAX));
+    TEST_ASSERT_EQUAL(3, jobs_[0].uriIndex);
+    TEST_ASSERT_EQUAL_HEX8(0x02, jobs_[0].data[0]);
+    TEST_ASSERT_EQUAL(0, jobs_[0].isExcluded);
+    TEST_ASSERT_EQUAL(100, jobs_[0].postTimeMs); // lag from the first value not notified
+}
+
+TEST(ot_app_coap_notify, GivenPostDuringCycle_WhenTake_ThenNextCycleOnly)
+{
+    otapp_coap_notifyJob_t jobs_[OTAPP_COAP_NOTIFY_BATCH_MAX];
+    uint8_t data1_[1] = {0x01};
+    uint8_t data2_[1] = {0x02};
+
+    otapp_coap_notifyPost(&test_notify_ipAddr, 3, data1_, 1, 100);
+    TEST_ASSERT_EQUAL(1, otapp_coap_notifyTake(jobs_, OTAPP_COAP_NOTIFY_BATCH_MAX));
+
+    // older value of uri 3 is being sent: the new one must not overtake it, nor be merged into it
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_OK, otapp_coap_notifyPost(&test_notify_ipAddr, 3, data2_, 1, 110));
+    TEST_ASSERT_EQUAL(0, otapp_coap_notifyTake(jobs_, OTAPP_COAP_NOTIFY_BATCH_MAX));
+    TEST_ASSERT_EQUAL_HEX8(0x01, jobs_[0].data[0]);
+
+    otapp_coap_notifyDone();
+    TEST_ASSERT_EQUAL(1, otapp_coap_notifyTake(jobs_, OTAPP_COAP_NOTIFY_BATCH_MAX));
+    TEST_ASSERT_EQUAL_HEX8(0x02, jobs_[0].data[0]);
+    TEST_ASSERT_EQUAL(110, jobs_[0].postTimeMs);
+}
+
+TEST(ot_app_coap_notify, GivenSlotsOfOtherUris_WhenPost_ThenFullAndSameUriStillMerged)
+{
+    for (uint8_t i = 0; i < OTAPP_COAP_NOTIFY_QUEUE_LENGTH; i++)
+    {
+        TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_OK, otapp_coap_notifyPost(&test_notify_ipAddr, i + 1, test_notify_data, 4, i));
+    }
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_FULL, otapp_coap_notifyPost(&test_notify_ipAddr, OTAPP_COAP_NOTIFY_QUEUE_LENGTH + 1, test_notify_data, 4, 50));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_MERGED, otapp_coap_notifyPost(&test_notify_ipAddr, 1, test_notify_data, 4, 50));
+    TEST_ASSERT_EQUAL(1, otapp_coap_notifyStatsGet()->overflow);
+}
+
+TEST(ot_app_coap_notify, GivenPostsOutOfSlotOrder_WhenTake_ThenOldestFirstInBatches)
+{
+    otapp_coap_notifyJob_t jobs_[OTAPP_COAP_NOTIFY_BATCH_MAX];
+    const uint32_t postMs_[6] = {UINT32_MAX - 10, UINT32_MAX - 5, 2, 7, 9, 12}; // tick wrap between posts
+
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        otapp_coap_notifyPost(&test_notify_ipAddr, i + 1, test_notify_data, 4, postMs_[i]);
+    }
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_NOTIFY_BATCH_MAX, otapp_coap_notifyTake(jobs_, OTAPP_COAP_NOTIFY_BATCH_MAX));
+    for (uint8_t i = 0; i < OTAPP_COAP_NOTIFY_BATCH_MAX; i++)
+    {
+        TEST_ASSERT_EQUAL(i + 1, jobs_[i].uriIndex);
+    }
+    otapp_coap_notifyDone();
+
+    TEST_ASSERT_EQUAL(2, otapp_coap_notifyTake(jobs_, OTAPP_COAP_NOTIFY_BATCH_MAX));
+    TEST_ASSERT_EQUAL(5, jobs_[0].uriIndex);
+    TEST_ASSERT_EQUAL(6, jobs_[1].uriIndex);
+}
+
+TEST(ot_app_coap_notify, GivenPostsAndTake_WhenStatsGet_ThenDepthAndCounters)
+{
+    otapp_coap_notifyJob_t jobs_[OTAPP_COAP_NOTIFY_BATCH_MAX];
+    const otapp_coap_notifyStats_t *stats_;
+
+    otapp_coap_notifyPost(&test_notify_ipAddr, 1, test_notify_data, 4, 0);
+    otapp_coap_notifyPost(&test_notify_ipAddr, 2, test_notify_data, 4, 0);
+    otapp_coap_notifyPost(&test_notify_ipAddr, 3, test_notify_data, 4, 0);
+    otapp_coap_notifyPost(&test_notify_ipAddr, 2, test_notify_data, 4, 0);
+
+    stats_ = otapp_coap_notifyStatsGet();
+    TEST_ASSERT_EQUAL(4, stats_->posted);
+    TEST_ASSERT_EQUAL(1, stats_->merged);
+    TEST_ASSERT_EQUAL(3, stats_->depth);
+    TEST_ASSERT_EQUAL(3, stats_->depthMax);
+
+    otapp_coap_notifyTake(jobs_, 2);
+    TEST_ASSERT_EQUAL(1, stats_->depth);
+    TEST_ASSERT_EQUAL(3, stats_->depthMax);
+
+    otapp_coap_notifyInit(test_notify_batch);
+    TEST_ASSERT_EQUAL(0, stats_->posted);
+    TEST_ASSERT_EQUAL(0, stats_->depthMax);
+    TEST_ASSERT_EQUAL(0, otapp_coap_notifyTake(jobs_, OTAPP_COAP_NOTIFY_BATCH_MAX));
+}
@@ -0,0 +1,13 @@
+#include "unity_fixture.h"
+
+static void run_all_tests(void);
+
+int main(int argc, const char **argv)
+{
+   return UnityMain(argc, argv, run_all_tests);
+}
+
+static void run_all_tests(void)
+{
+   RUN_TEST_GROUP(ot_app_coap_notify);
+}
@@ -0,0 +1,18 @@
+#include "unity_fixture.h"
+
+TEST_GROUP_RUNNER(ot_app_coap_notify)
+{
+   RUN_TEST_CASE(ot_app_coap_notify, GivenIncorrectArgs_WhenCallingJobSet_ThenReturnError);
+   RUN_TEST_CASE(ot_app_coap_notify, GivenRequestData_WhenJobSet_ThenDataCopied);
+   RUN_TEST_CASE(ot_app_coap_notify, GivenNullExcludedAddr_WhenRun_ThenItemWithoutExcluded);
+   RUN_TEST_CASE(ot_app_coap_notify, GivenNotInitialized_WhenRun_ThenReturnError);
+   RUN_TEST_CASE(ot_app_coap_notify, GivenSeveralJobs_WhenRun_ThenOneBatchCall);
+   RUN_TEST_CASE(ot_app_coap_notify, GivenTooManyJobs_WhenRun_ThenReturnError);
+   RUN_TEST_CASE(ot_app_coap_notify, GivenJobsPosted_WhenRun_ThenLagStats);
+   RUN_TEST_CASE(ot_app_coap_notify, GivenIncorrectArgs_WhenPost_ThenReturnError);
+   RUN_TEST_CASE(ot_app_coap_notify, GivenSameUriPostedTwice_WhenTake_ThenLatestValueOnce);
+   RUN_TEST_CASE(ot_app_coap_notify, GivenPostDuringCycle_WhenTake_ThenNextCycleOnly);
+   RUN_TEST_CASE(ot_app_coap_notify, GivenSlotsOfOtherUris_WhenPost_ThenFullAndSameUriStillMerged);
+   RUN_TEST_CASE(ot_app_coap_notify, GivenPostsOutOfSlotOrder_WhenTake_ThenOldestFirstInBatches);
+   RUN_TEST_CASE(ot_app_coap_notify, GivenPostsAndTake_WhenStatsGet_ThenDepthAndCounters);
+}
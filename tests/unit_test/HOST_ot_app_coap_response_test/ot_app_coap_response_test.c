@@ -0,0 +1,112 @@
+#include "unity_fixture.h"
+#include "ot_app_coap_response.h"
+#include "string.h"
+
+#define TEST_RESPONSE_MSG_ID_INVALID    ((otapp_coap_messageId_t)(OTAPP_MESSAGE_BAD_OPTION + 1))
+
+static otapp_coap_response_t test_response;
+
+TEST_GROUP(ot_app_coap_response);
+
+TEST_SETUP(ot_app_coap_response)
+{
+    /* Init before every test */
+    memset(&test_response, 0xA5, sizeof(test_response));
+}
+
+TEST_TEAR_DOWN(ot_app_coap_response)
+{
+    /* Cleanup after every test */
+}
+
+// responseResolve()
+TEST(ot_app_coap_response, GivenIncorrectArgs_WhenCallingResponseResolve_ThenReturnError)
+{
+    TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_ERROR, otapp_coap_responseResolve(OTAPP_MESSAGE_OK, OT_COAP_CODE_GET, OT_COAP_TYPE_CONFIRMABLE, NULL));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_ERROR, otapp_coap_responseResolve(TEST_RESPONSE_MSG_ID_INVALID, OT_COAP_CODE_GET, OT_COAP_TYPE_CONFIRMABLE, &test_response));
+}
+
+TEST(ot_app_coap_response, GivenConRequest_WhenCallingResponseResolve_ThenPiggybackedAck)
+{
+    TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_OK, otapp_coap_responseResolve(OTAPP_MESSAGE_OK, OT_COAP_CODE_GET, OT_COAP_TYPE_CONFIRMABLE, &test_response));
+    TEST_ASSERT_EQUAL(OT_COAP_TYPE_ACKNOWLEDGMENT, test_response.type);
+
+    // error responses too, also 4.05
+    TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_OK, otapp_coap_responseResolve(OTAPP_MESSAGE_ERROR, OT_COAP_CODE_POST, OT_COAP_TYPE_CONFIRMABLE, &test_response));
+    TEST_ASSERT_EQUAL(OT_COAP_TYPE_ACKNOWLEDGMENT, test_response.type);
+}
+
+TEST(ot_app_coap_response, GivenNonRequest_WhenCallingResponseResolve_ThenNonResponse)
+{
+    TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_OK, otapp_coap_responseResolve(OTAPP_MESSAGE_OK, OT_COAP_CODE_PUT, OT_COAP_TYPE_NON_CONFIRMABLE, &test_response));
+    TEST_ASSERT_EQUAL(OT_COAP_TYPE_NON_CONFIRMABLE, test_response.type);
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_OK, otapp_coap_responseResolve(OTAPP_MESSAGE_OK, OT_COAP_CODE_DELETE, OT_COAP_TYPE_NON_CONFIRMABLE, &test_response));
+    TEST_ASSERT_EQUAL(OT_COAP_TYPE_NON_CONFIRMABLE, test_response.type);
+}
+
+TEST(ot_app_coap_response, GivenGetRequest_WhenCallingResponseResolve_ThenContentWithPayload)
+{
+    TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_OK, otapp_coap_responseResolve(OTAPP_MESSAGE_OK, OT_COAP_CODE_GET, OT_COAP_TYPE_CONFIRMABLE, &test_response));
+    TEST_ASSERT_EQUAL(OT_COAP_CODE_CONTENT, test_response.code);
+    TEST_ASSERT_EQUAL(strlen("OK"), test_response.payloadLength);
+    TEST_ASSERT_EQUAL_MEMORY("OK", test_response.payload, test_response.payloadLength);
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_OK, otapp_coap_responseResolve(OTAPP_MESSAGE_TEST, OT_COAP_CODE_GET, OT_COAP_TYPE_CONFIRMABLE, &test_response));
+    TEST_ASSERT_EQUAL(OT_COAP_CODE_CONTENT, test_response.code);
+    TEST_ASSERT_EQUAL(strlen("Hello coap !!"), test_response.payloadLength);
+    TEST_ASSERT_EQUAL_MEMORY("Hello coap !!", test_response.payload, test_response.payloadLength);
+}
+
+TEST(ot_app_coap_response, GivenPutRequest_WhenCallingResponseResolve_ThenChangedWithoutPayload)
+{
+    TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_OK, otapp_coap_responseResolve(OTAPP_MESSAGE_OK, OT_COAP_CODE_PUT, OT_COAP_TYPE_CONFIRMABLE, &test_response));
+    TEST_ASSERT_EQUAL(OT_COAP_CODE_CHANGED, test_response.code);
+    TEST_ASSERT_NULL(test_response.payload);
+    TEST_ASSERT_EQUAL(0, test_response.payloadLength);
+}
+
+TEST(ot_app_coap_response, GivenOtherMethod_WhenCallingResponseResolve_ThenMethodNotAllowed)
+{
+    const otCoapCode methods_[] = {OT_COAP_CODE_POST, OT_COAP_CODE_DELETE};
+
+    for (uint8_t i = 0; i < sizeof(methods_) / sizeof(methods_[0]); i++)
+    {
+        TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_OK, otapp_coap_responseResolve(OTAPP_MESSAGE_OK, methods_[i], OT_COAP_TYPE_CONFIRMABLE, &test_response));
+        TEST_ASSERT_EQUAL(OT_COAP_CODE_METHOD_NOT_ALLOWED, test_response.code);
+        TEST_ASSERT_NULL(test_response.payload);
+        TEST_ASSERT_EQUAL(0, test_response.payloadLength);
+    }
+}
+
+TEST(ot_app_coap_response, GivenErrorMessage_WhenCallingResponseResolve_ThenBadRequest)
+{
+    TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_OK, otapp_coap_responseResolve(OTAPP_MESSAGE_ERROR, OT_COAP_CODE_GET, OT_COAP_TYPE_CONFIRMABLE, &test_response));
+    TEST_ASSERT_EQUAL(OT_COAP_CODE_BAD_REQUEST, test_response.code);
+    TEST_ASSERT_EQUAL(strlen("ERROR"), test_response.payloadLength);
+    TEST_ASSERT_EQUAL_MEMORY("ERROR", test_response.payload, test_response.payloadLength);
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_OK, otapp_coap_responseResolve(OTAPP_MESSAGE_ERROR, OT_COAP_CODE_PUT, OT_COAP_TYPE_CONFIRMABLE, &test_response));
+    TEST_ASSERT_EQUAL(OT_COAP_CODE_BAD_REQUEST, test_response.code);
+    TEST_ASSERT_NULL(test_response.payload);
+}
+
+TEST(ot_app_coap_response, GivenBadOptionMessage_WhenCallingResponseResolve_ThenBadOption)
+{
+    TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_OK, otapp_coap_responseResolve(OTAPP_MESSAGE_BAD_OPTION, OT_COAP_CODE_GET, OT_COAP_TYPE_CONFIRMABLE, &test_response));
+    TEST_ASSERT_EQUAL(OT_COAP_CODE_BAD_OPTION, test_response.code);
+    TEST_ASSERT_EQUAL(OT_COAP_TYPE_ACKNOWLEDGMENT, test_response.type);
+    TEST_ASSERT_NOT_NULL(test_response.payload);
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_RESPONSE_OK, otapp_coap_responseResolve(OTAPP_MESSAGE_BAD_OPTION, OT_COAP_CODE_PUT, OT_COAP_TYPE_NON_CONFIRMABLE, &test_response));
+    TEST_ASSERT_EQUAL(OT_COAP_CODE_BAD_OPTION, test_response.code);
+    TEST_ASSERT_EQUAL(OT_COAP_TYPE_NON_CONFIRMABLE, test_response.type);
+}
+
+// getMessage()
+TEST(ot_app_coap_response, GivenMsgId_WhenCallingGetMessage_ThenPayload)
+{
+    TEST_ASSERT_EQUAL_STRING("OK", otapp_coap_getMessage(OTAPP_MESSAGE_OK));
+    TEST_ASSERT_EQUAL_STRING("ERROR", otapp_coap_getMessage(OTAPP_MESSAGE_ERROR));
+    TEST_ASSERT_NULL(otapp_coap_getMessage(TEST_RESPONSE_MSG_ID_INVALID));
+}
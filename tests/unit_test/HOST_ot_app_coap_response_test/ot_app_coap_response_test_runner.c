@@ -0,0 +1,17 @@
+#include "unity_fixture.h"
+
+TEST_GROUP_RUNNER(ot_app_coap_response)
+{
+   // responseResolve()
+   RUN_TEST_CASE(ot_app_coap_response, GivenIncorrectArgs_WhenCallingResponseResolve_ThenReturnError);
+   RUN_TEST_CASE(ot_app_coap_response, GivenConRequest_WhenCallingResponseResolve_ThenPiggybackedAck);
+   RUN_TEST_CASE(ot_app_coap_response, GivenNonRequest_WhenCallingResponseResolve_ThenNonResponse);
+   RUN_TEST_CASE(ot_app_coap_response, GivenGetRequest_WhenCallingResponseResolve_ThenContentWithPayload);
+   RUN_TEST_CASE(ot_app_coap_response, GivenPutRequest_WhenCallingResponseResolve_ThenChangedWithoutPayload);
+   RUN_TEST_CASE(ot_app_coap_response, GivenOtherMethod_WhenCallingResponseResolve_ThenMethodNotAllowed);
+   RUN_TEST_CASE(ot_app_coap_response, GivenErrorMessage_WhenCallingResponseResolve_ThenBadRequest);
+   RUN_TEST_CASE(ot_app_coap_response, GivenBadOptionMessage_WhenCallingResponseResolve_ThenBadOption);
+
+   // getMessage()
+   RUN_TEST_CASE(ot_app_coap_response, GivenMsgId_WhenCallingGetMessage_ThenPayload);
+}
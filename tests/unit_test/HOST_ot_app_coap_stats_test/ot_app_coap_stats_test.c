@@ -0,0 +1,188 @@
+#include "unity_fixture.h"
+#include "ot_app_coap_stats.h"
+#include "string.h"
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VOID_FUNC4(test_stats_userResponse, void *, otMessage *, const otMessageInfo *, otError);
+
+static const otIp6Address test_stats_ipAddr = {.mFields.m8 = {0xfd, 0x00, 0, 0, 0, 0, 0, 0, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x01}};
+static const otIp6Address test_stats_ipAddr2 = {.mFields.m8 = {0xfd, 0x00, 0, 0, 0, 0, 0, 0, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x02}};
+static uint8_t test_stats_token[4] = {0xA1, 0xB2, 0xC3, 0xD4};
+static uint8_t test_stats_context;
+
+// token: i in the last byte
+static otapp_coap_statsRequest_t *test_stats_start(const otIp6Address *ipAddr, uint8_t i, uint32_t nowMs)
+{
+    uint8_t token_[4] = {0x10, 0x20, 0x30, i};
+    return otapp_coap_statsRequestStart(ipAddr, token_, sizeof(token_), test_stats_userResponse, &test_stats_context, nowMs);
+}
+
+TEST_GROUP(ot_app_coap_stats);
+
+TEST_SETUP(ot_app_coap_stats)
+{
+    /* Init before every test */
+    RESET_FAKE(test_stats_userResponse);
+    otapp_coap_statsInit();
+}
+
+TEST_TEAR_DOWN(ot_app_coap_stats)
+{
+    /* Cleanup after every test */
+}
+
+TEST(ot_app_coap_stats, GivenIncorrectArgs_WhenCallingRequestStart_ThenReturnNull)
+{
+    uint8_t tokenLong_[OTAPP_COAP_STATS_TOKEN_MAX + 1] = {0};
+
+    TEST_ASSERT_NULL(otapp_coap_statsRequestStart(NULL, test_stats_token, 4, NULL, NULL, 0));
+    TEST_ASSERT_NULL(otapp_coap_statsRequestStart(&test_stats_ipAddr, NULL, 4, NULL, NULL, 0));
+    TEST_ASSERT_NULL(otapp_coap_statsRequestStart(&test_stats_ipAddr, test_stats_token, 0, NULL, NULL, 0));
+    TEST_ASSERT_NULL(otapp_coap_statsRequestStart(&test_stats_ipAddr, tokenLong_, sizeof(tokenLong_), NULL, NULL, 0));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_STATS_ERROR, otapp_coap_statsRequestEnd(NULL, OT_ERROR_NONE, 0, NULL, NULL));
+    TEST_ASSERT_EQUAL(0, otapp_coap_statsInFlightGet());
+    TEST_ASSERT_NULL(otapp_coap_statsPeerGet(0));
+    TEST_ASSERT_NULL(otapp_coap_statsPeerGet(OTAPP_COAP_STATS_PEERS_MAX + 1));
+}
+
+TEST(ot_app_coap_stats, GivenSentRequest_WhenResponse_ThenRttInHistogram)
+{
+    otapp_coap_statsRequest_t *request_;
+    const otapp_coap_statsPeer_t *peer_;
+    otCoapResponseHandler handler_ = NULL;
+    void *context_ = NULL;
+
+    request_ = otapp_coap_statsRequestStart(&test_stats_ipAddr, test_stats_token, 4, test_stats_userResponse, &test_stats_context, 1000);
+    TEST_ASSERT_NOT_NULL(request_);
+    TEST_ASSERT_EQUAL(1, otapp_coap_statsInFlightGet());
+    TEST_ASSERT_EQUAL_PTR(request_, otapp_coap_statsRequestGet(test_stats_token, 4));
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_STATS_OK, otapp_coap_statsRequestEnd(request_, OT_ERROR_NONE, 1150, &handler_, &context_));
+    TEST_ASSERT_EQUAL_PTR(test_stats_userResponse, handler_);
+    TEST_ASSERT_EQUAL_PTR(&test_stats_context, context_);
+    TEST_ASSERT_EQUAL(0, otapp_coap_statsInFlightGet());
+    TEST_ASSERT_NULL(otapp_coap_statsRequestGet(test_stats_token, 4));
+
+    peer_ = otapp_coap_statsPeerGet(0);
+    TEST_ASSERT_NOT_NULL(peer_);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&test_stats_ipAddr, &peer_->peerAddr, OT_IP6_ADDRESS_SIZE);
+    TEST_ASSERT_EQUAL(1, peer_->sent);
+    TEST_ASSERT_EQUAL(1, peer_->completed);
+    TEST_ASSERT_EQUAL(0, peer_->retransmits);
+    TEST_ASSERT_EQUAL(150, peer_->rttMin);
+    TEST_ASSERT_EQUAL(150, peer_->rttMax);
+    TEST_ASSERT_EQUAL(1, peer_->rttHist[2]); // 101..200 ms
+    TEST_ASSERT_EQUAL(0, otapp_coap_statsLossPermille(peer_));
+}
+
+TEST(ot_app_coap_stats, GivenSentRequest_WhenTimeout_ThenLostAndLossRate)
+{
+    const otapp_coap_statsPeer_t *peer_;
+
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        otapp_coap_statsRequestEnd(test_stats_start(&test_stats_ipAddr, i, 0), (i == 0) ? OT_ERROR_GENERIC : OT_ERROR_NONE, 40, NULL, NULL);
+    }
+
+    peer_ = otapp_coap_statsPeerGet(0);
+    TEST_ASSERT_EQUAL(4, peer_->sent);
+    TEST_ASSERT_EQUAL(3, peer_->completed);
+    TEST_ASSERT_EQUAL(1, peer_->lost);
+    TEST_ASSERT_EQUAL(OTAPP_COAP_STATS_MAX_RETRANSMIT, peer_->retransmits);
+    TEST_ASSERT_EQUAL(3, peer_->rttHist[0]);
+    TEST_ASSERT_EQUAL(250, otapp_coap_statsLossPermille(peer_));
+}
+
+TEST(ot_app_coap_stats, GivenLateResponse_WhenRequestEnd_ThenRetransmitsEstimated)
+{
+    const otapp_coap_statsPeer_t *peer_;
+
+    otapp_coap_statsRequestEnd(test_stats_start(&test_stats_ipAddr, 0, 0), OT_ERROR_NONE, 2500, NULL, NULL);  // after 1st retransmission
+    peer_ = otapp_coap_statsPeerGet(0);
+    TEST_ASSERT_EQUAL(1, peer_->retransmits);
+
+    otapp_coap_statsRequestEnd(test_stats_start(&test_stats_ipAddr, 1, 0), OT_ERROR_NONE, 7000, NULL, NULL);  // after 2nd
+    TEST_ASSERT_EQUAL(3, peer_->retransmits);
+    TEST_ASSERT_EQUAL(1, peer_->rttHist[OTAPP_COAP_STATS_RTT_BUCKETS - 2]); // 2001..5000 ms
+    TEST_ASSERT_EQUAL(1, peer_->rttHist[OTAPP_COAP_STATS_RTT_BUCKETS - 1]); // above 5000 ms
+    TEST_ASSERT_EQUAL(2500, peer_->rttMin);
+    TEST_ASSERT_EQUAL(7000, peer_->rttMax);
+    TEST_ASSERT_EQUAL(9500, peer_->rttSum);
+
+    // tick counter wraps
+    otapp_coap_statsRequestEnd(test_stats_start(&test_stats_ipAddr, 2, UINT32_MAX - 9), OT_ERROR_NONE, 10, NULL, NULL);
+    TEST_ASSERT_EQUAL(20, peer_->rttMin);
+}
+
+TEST(ot_app_coap_stats, GivenClosedRequest_WhenRequestEndAgain_ThenReturnError)
+{
+    otapp_coap_statsRequest_t *request_ = test_stats_start(&test_stats_ipAddr, 0, 0);
+    otapp_coap_statsRequest_t fake_;
+
+    TEST_ASSERT_EQUAL(OTAPP_COAP_STATS_OK, otapp_coap_statsRequestEnd(request_, OT_ERROR_NONE, 10, NULL, NULL));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_STATS_ERROR, otapp_coap_statsRequestEnd(request_, OT_ERROR_NONE, 10, NULL, NULL));
+
+    memset(&fake_, 0, sizeof(fake_));
+    fake_.isTaken = 1;
+    TEST_ASSERT_EQUAL(OTAPP_COAP_STATS_ERROR, otapp_coap_statsRequestEnd(&fake_, OT_ERROR_NONE, 10, NULL, NULL));
+    TEST_ASSERT_EQUAL(1, otapp_coap_statsPeerGet(0)->completed);
+}
+
+TEST(ot_app_coap_stats, GivenTokenInFlight_WhenRequestStart_ThenUntracked)
+{
+    TEST_ASSERT_NOT_NULL(test_stats_start(&test_stats_ipAddr, 0, 0));
+    TEST_ASSERT_NULL(test_stats_start(&test_stats_ipAddr, 0, 0));
+    TEST_ASSERT_EQUAL(1, otapp_coap_statsUntrackedGet());
+    TEST_ASSERT_EQUAL(1, otapp_coap_statsInFlightGet());
+}
+
+TEST(ot_app_coap_stats, GivenFullTable_WhenRequestStart_ThenUntracked)
+{
+    for (uint8_t i = 0; i < OTAPP_COAP_STATS_INFLIGHT_MAX; i++)
+    {
+        TEST_ASSERT_NOT_NULL(test_stats_start(&test_stats_ipAddr, i, 0));
+    }
+
+    TEST_ASSERT_NULL(test_stats_start(&test_stats_ipAddr, 0xFF, 0));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_STATS_INFLIGHT_MAX, otapp_coap_statsInFlightGet());
+    TEST_ASSERT_EQUAL(1, otapp_coap_statsUntrackedGet());
+    TEST_ASSERT_EQUAL(OTAPP_COAP_STATS_INFLIGHT_MAX, otapp_coap_statsPeerGet(0)->sent);
+}
+
+TEST(ot_app_coap_stats, GivenFullPeerTable_WhenRequestStart_ThenOtherPeers)
+{
+    otIp6Address ipAddr_ = test_stats_ipAddr;
+    const otapp_coap_statsPeer_t *other_;
+
+    for (uint8_t i = 0; i < OTAPP_COAP_STATS_PEERS_MAX + 2; i++)
+    {
+        ipAddr_.mFields.m8[15] = 0x40 + i;
+        otapp_coap_statsRequestEnd(test_stats_start(&ipAddr_, i, 0), OT_ERROR_NONE, 5, NULL, NULL);
+    }
+
+    other_ = otapp_coap_statsPeerGet(OTAPP_COAP_STATS_PEERS_MAX);
+    TEST_ASSERT_NOT_NULL(other_);
+    TEST_ASSERT_EQUAL(2, other_->completed);
+    TEST_ASSERT_EQUAL(5, other_->rttMin);
+    const otIp6Address unspecified_ = {0};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&unspecified_, &other_->peerAddr, OT_IP6_ADDRESS_SIZE);
+
+    // known peer keeps its own entry
+    otapp_coap_statsRequestEnd(test_stats_start(&test_stats_ipAddr2, 0x80, 0), OT_ERROR_NONE, 5, NULL, NULL);
+    TEST_ASSERT_EQUAL(3, other_->completed);
+    ipAddr_.mFields.m8[15] = 0x40;
+    otapp_coap_statsRequestEnd(test_stats_start(&ipAddr_, 0x81, 0), OT_ERROR_NONE, 5, NULL, NULL);
+    TEST_ASSERT_EQUAL(2, otapp_coap_statsPeerGet(0)->completed);
+}
+
+TEST(ot_app_coap_stats, GivenCanceledRequest_WhenRequestStart_ThenEntryFree)
+{
+    otapp_coap_statsRequest_t *request_ = test_stats_start(&test_stats_ipAddr, 0, 0);
+
+    otapp_coap_statsRequestCancel(request_);
+    TEST_ASSERT_EQUAL(0, otapp_coap_statsInFlightGet());
+    TEST_ASSERT_EQUAL(0, otapp_coap_statsPeerGet(0)->sent);
+    TEST_ASSERT_NOT_NULL(test_stats_start(&test_stats_ipAddr, 0, 0));
+    otapp_coap_statsRequestCancel(NULL);
+}
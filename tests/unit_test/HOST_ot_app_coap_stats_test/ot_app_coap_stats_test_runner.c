@@ -0,0 +1,14 @@
+#include "unity_fixture.h"
+
+TEST_GROUP_RUNNER(ot_app_coap_stats)
+{
+   RUN_TEST_CASE(ot_app_coap_stats, GivenIncorrectArgs_WhenCallingRequestStart_ThenReturnNull);
+   RUN_TEST_CASE(ot_app_coap_stats, GivenSentRequest_WhenResponse_ThenRttInHistogram);
+   RUN_TEST_CASE(ot_app_coap_stats, GivenSentRequest_WhenTimeout_ThenLostAndLossRate);
+   RUN_TEST_CASE(ot_app_coap_stats, GivenLateResponse_WhenRequestEnd_ThenRetransmitsEstimated);
+   RUN_TEST_CASE(ot_app_coap_stats, GivenClosedRequest_WhenRequestEndAgain_ThenReturnError);
+   RUN_TEST_CASE(ot_app_coap_stats, GivenTokenInFlight_WhenRequestStart_ThenUntracked);
+   RUN_TEST_CASE(ot_app_coap_stats, GivenFullTable_WhenRequestStart_ThenUntracked);
+   RUN_TEST_CASE(ot_app_coap_stats, GivenFullPeerTable_WhenRequestStart_ThenOtherPeers);
+   RUN_TEST_CASE(ot_app_coap_stats, GivenCanceledRequest_WhenRequestStart_ThenEntryFree);
+}
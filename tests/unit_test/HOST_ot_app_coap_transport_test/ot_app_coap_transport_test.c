@@ -0,0 +1,83 @@
+#include "unity_fixture.h"
+#include "ot_app_coap_transport.h"
+#include "string.h"
+
+static otapp_coap_nonStream_t test_transport_stream;
+
+TEST_GROUP(ot_app_coap_transport);
+
+TEST_SETUP(ot_app_coap_transport)
+{
+    /* Init before every test */
+    memset(&test_transport_stream, 0, sizeof(test_transport_stream));
+}
+
+TEST_TEAR_DOWN(ot_app_coap_transport)
+{
+    /* Cleanup after every test */
+}
+
+// nonStreamNext() / nonStreamStop()
+TEST(ot_app_coap_transport, GivenNullStream_WhenCallingNonStream_ThenCon)
+{
+    TEST_ASSERT_EQUAL(OTAPP_COAP_TRANSPORT_CON, otapp_coap_nonStreamNext(NULL));
+    TEST_ASSERT_EQUAL(0, otapp_coap_nonStreamStop(NULL));
+}
+
+TEST(ot_app_coap_transport, GivenNonStream_WhenCallingNonStreamNext_ThenConEveryCheckpointInterval)
+{
+    // two full intervals: NON ... NON CON, NON ... NON CON
+    for (uint8_t round = 0; round < 2; round++)
+    {
+        for (uint8_t i = 1; i < OTAPP_COAP_NON_CHECKPOINT_INTERVAL; i++)
+        {
+            TEST_ASSERT_EQUAL(OTAPP_COAP_TRANSPORT_NON, otapp_coap_nonStreamNext(&test_transport_stream));
+        }
+        TEST_ASSERT_EQUAL(OTAPP_COAP_TRANSPORT_CON, otapp_coap_nonStreamNext(&test_transport_stream));
+    }
+}
+
+TEST(ot_app_coap_transport, GivenLastUpdateNon_WhenCallingNonStreamStop_ThenFinalValueCon)
+{
+    TEST_ASSERT_EQUAL(OTAPP_COAP_TRANSPORT_NON, otapp_coap_nonStreamNext(&test_transport_stream));
+    TEST_ASSERT_EQUAL(OTAPP_COAP_TRANSPORT_NON, otapp_coap_nonStreamNext(&test_transport_stream));
+    TEST_ASSERT_EQUAL(1, otapp_coap_nonStreamStop(&test_transport_stream));
+
+    // stopped: new stream, full interval before the next checkpoint
+    TEST_ASSERT_EQUAL(0, otapp_coap_nonStreamStop(&test_transport_stream));
+    for (uint8_t i = 1; i < OTAPP_COAP_NON_CHECKPOINT_INTERVAL; i++)
+    {
+        TEST_ASSERT_EQUAL(OTAPP_COAP_TRANSPORT_NON, otapp_coap_nonStreamNext(&test_transport_stream));
+    }
+    TEST_ASSERT_EQUAL(OTAPP_COAP_TRANSPORT_CON, otapp_coap_nonStreamNext(&test_transport_stream));
+}
+
+TEST(ot_app_coap_transport, GivenLastUpdateCheckpoint_WhenCallingNonStreamStop_ThenNoFinalValue)
+{
+    // no update at all
+    TEST_ASSERT_EQUAL(0, otapp_coap_nonStreamStop(&test_transport_stream));
+
+    // last update was the CON checkpoint, the peer has confirmed it
+    for (uint8_t i = 0; i < OTAPP_COAP_NON_CHECKPOINT_INTERVAL; i++)
+    {
+        otapp_coap_nonStreamNext(&test_transport_stream);
+    }
+    TEST_ASSERT_EQUAL(0, otapp_coap_nonStreamStop(&test_transport_stream));
+}
+
+// transportType() / responseType()
+TEST(ot_app_coap_transport, GivenTransport_WhenCallingTransportType_ThenCoapType)
+{
+    TEST_ASSERT_EQUAL(OT_COAP_TYPE_CONFIRMABLE, otapp_coap_transportType(OTAPP_COAP_TRANSPORT_CON));
+    TEST_ASSERT_EQUAL(OT_COAP_TYPE_NON_CONFIRMABLE, otapp_coap_transportType(OTAPP_COAP_TRANSPORT_NON));
+}
+
+TEST(ot_app_coap_transport, GivenNonRequest_WhenCallingResponseType_ThenNonResponse)
+{
+    TEST_ASSERT_EQUAL(OT_COAP_TYPE_NON_CONFIRMABLE, otapp_coap_responseType(OT_COAP_TYPE_NON_CONFIRMABLE));
+}
+
+TEST(ot_app_coap_transport, GivenConRequest_WhenCallingResponseType_ThenPiggybackedAck)
+{
+    TEST_ASSERT_EQUAL(OT_COAP_TYPE_ACKNOWLEDGMENT, otapp_coap_responseType(OT_COAP_TYPE_CONFIRMABLE));
+}
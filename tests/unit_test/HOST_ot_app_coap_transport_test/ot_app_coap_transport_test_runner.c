@@ -0,0 +1,15 @@
+#include "unity_fixture.h"
+
+TEST_GROUP_RUNNER(ot_app_coap_transport)
+{
+   // nonStreamNext() / nonStreamStop()
+   RUN_TEST_CASE(ot_app_coap_transport, GivenNullStream_WhenCallingNonStream_ThenCon);
+   RUN_TEST_CASE(ot_app_coap_transport, GivenNonStream_WhenCallingNonStreamNext_ThenConEveryCheckpointInterval);
+   RUN_TEST_CASE(ot_app_coap_transport, GivenLastUpdateNon_WhenCallingNonStreamStop_ThenFinalValueCon);
+   RUN_TEST_CASE(ot_app_coap_transport, GivenLastUpdateCheckpoint_WhenCallingNonStreamStop_ThenNoFinalValue);
+
+   // transportType() / responseType()
+   RUN_TEST_CASE(ot_app_coap_transport, GivenTransport_WhenCallingTransportType_ThenCoapType);
+   RUN_TEST_CASE(ot_app_coap_transport, GivenNonRequest_WhenCallingResponseType_ThenNonResponse);
+   RUN_TEST_CASE(ot_app_coap_transport, GivenConRequest_WhenCallingResponseType_ThenPiggybackedAck);
+}
@@ -1,7 +1,10 @@
 #include "unity_fixture.h"
 #include "ot_app_coap_uri_obs.h"
 #include "mock_ip6.h"
+#include "mock_freertos_semaphore_pthread.h"
 #include "string.h"
+#include <pthread.h>
+#include <unistd.h>
 
 #define TEST_OBS_LIST_INDEX_0           0
 #define TEST_OBS_LIST_INDEX_MAX         (OAC_URI_OBS_SUBSCRIBERS_MAX_NUM - 1)
@@ -87,7 +90,9 @@ TEST_GROUP(ot_app_coap_uri_obs);
 TEST_SETUP(ot_app_coap_uri_obs)
 {
     /* Init before every test */
+    oac_uri_obs_init();
     oac_uri_obs_deleteAll(TEST_OBS_HANDLE);    
+    oac_uri_obs_notifyModeSet(OAC_URI_OBS_NOTIFY_MODE_UNICAST, NULL);
 }
 
 TEST_TEAR_DOWN(ot_app_coap_uri_obs)
@@ -1126,6 +1131,7 @@ TEST(ot_app_coap_uri_obs, GivenTrueArgs_WhenSubscribeListIsFullCallingNotify_The
 {
     oacu_result_t result_;
     uint8_t data_[OAC_URI_OBS_BUFFER_SIZE];
+    oac_uri_dataPacket_t packets_[OAC_URI_OBS_NOTIFY_RECORDS_MAX];
     oac_uri_observer_t *subList = oac_uri_obs_getSubListHandle();
 
     for (uint16_t i = 0; i < OAC_URI_OBS_BUFFER_SIZE ; i++)
@@ -1133,16 +1139,23 @@ TEST(ot_app_coap_uri_obs, GivenTrueArgs_WhenSubscribeListIsFullCallingNotify_The
         data_[i] = i;
     }
     
+    RESET_FAKE(otapp_coapSendPutUri_subscribed_uris);
     test_obs_fillListExampleData(subList);
     test_obs_fillTxBuffer(subList, data_, OAC_URI_OBS_BUFFER_SIZE);
 
     result_ = oac_uri_obs_notify(subList, NULL, TEST_OBS_URI_INDEX_2, data_, OAC_URI_OBS_BUFFER_SIZE);
     TEST_ASSERT_EQUAL(20, result_);
 
-    TEST_ASSERT_EQUAL(20, otapp_coapSendPutUri_subscribed_uris_fake.call_count);                                                // check count of calls
+    // all 20 entries have the same ip addr: records are packed, OAC_URI_OBS_NOTIFY_RECORDS_MAX per message
+    TEST_ASSERT_EQUAL(20 / OAC_URI_OBS_NOTIFY_RECORDS_MAX, otapp_coapSendPutUri_subscribed_uris_fake.call_count);             // check count of calls
     TEST_ASSERT_EQUAL_UINT8_ARRAY(&subList[0].ipAddr, otapp_coapSendPutUri_subscribed_uris_fake.arg0_val, OT_IP6_ADDRESS_SIZE); // check ipAddr
-    TEST_ASSERT_EQUAL_UINT8_ARRAY(txRxBuffer, otapp_coapSendPutUri_subscribed_uris_fake.arg1_val, otapp_coapSendPutUri_subscribed_uris_fake.arg2_val); // check created buffer
-   
+
+    result_ = oac_uri_obs_parseNotify(otapp_coapSendPutUri_subscribed_uris_fake.arg1_val, otapp_coapSendPutUri_subscribed_uris_fake.arg2_val, packets_, OAC_URI_OBS_NOTIFY_RECORDS_MAX, NULL);
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_NOTIFY_RECORDS_MAX, result_);
+    for (uint8_t i = 0; i < OAC_URI_OBS_NOTIFY_RECORDS_MAX; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(txRxBuffer, &packets_[i], OAC_URI_OBS_NOTIFY_RECORD_SIZE); // token | data
+    }
 }
 
 TEST(ot_app_coap_uri_obs, CheckNotify_GivenTrueArgs_WhenCallingNotify_ThenReturnOk)
@@ -1162,9 +1175,10 @@ TEST(ot_app_coap_uri_obs, CheckNotify_GivenTrueArgs_WhenCallingNotify_ThenReturn
     dataFromNotify = otapp_coapSendPutUri_subscribed_uris_fake.arg1_val;
     uint16_t readBytes = otapp_coapSendPutUri_subscribed_uris_fake.arg2_val;
 
-    result_ = oac_uri_obs_parseMessageFromNotify(dataFromNotify, readBytes, &test_obs_dataPacketOut);
-    TEST_ASSERT_EQUAL(OAC_URI_OBS_OK, result_); 
+    result_ = oac_uri_obs_parseNotify(dataFromNotify, readBytes, &test_obs_dataPacketOut, 1, NULL);
+    TEST_ASSERT_EQUAL(1, result_); 
     TEST_ASSERT_EQUAL_UINT8_ARRAY(&test_obs_obsTrue.ipAddr, ipAddrFromNotify, OT_IP6_ADDRESS_SIZE);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(test_obs_obsTrue.uri->token, test_obs_dataPacketOut.token, OAC_URI_OBS_TOKEN_LENGTH);
     
     TEST_ASSERT_EQUAL(data_, test_obs_dataPacketOut.buffer[0]);
     
@@ -1188,13 +1202,301 @@ TEST(ot_app_coap_uri_obs, CheckNotify_GivenTwoSubscribersOneWillExclude_WhenCall
     dataFromNotify = otapp_coapSendPutUri_subscribed_uris_fake.arg1_val;
     uint16_t readBytes = otapp_coapSendPutUri_subscribed_uris_fake.arg2_val;
 
-    result_ = oac_uri_obs_parseMessageFromNotify(dataFromNotify, readBytes, &test_obs_dataPacketOut);
-    TEST_ASSERT_EQUAL(OAC_URI_OBS_OK, result_); 
+    result_ = oac_uri_obs_parseNotify(dataFromNotify, readBytes, &test_obs_dataPacketOut, 1, NULL);
+    TEST_ASSERT_EQUAL(1, result_); 
     
     TEST_ASSERT_EQUAL_UINT8_ARRAY(&test_obs_obsTrue.ipAddr, ipAddrFromNotify, OT_IP6_ADDRESS_SIZE);    
     TEST_ASSERT_EQUAL(data_, test_obs_dataPacketOut.buffer[0]);
 }
 
+// notifyBatch()
+TEST(ot_app_coap_uri_obs, GivenNullArgs_WhenCallingNotifyBatch_ThenReturnError)
+{
+    uint8_t data_ = 255;
+    oac_uri_obs_notifyItem_t items_[] = {
+        {.excludedIpAddr = NULL, .data = &data_, .dataSize = 1, .uriIndex = TEST_OBS_URI_INDEX_1},
+        {.excludedIpAddr = NULL, .data = NULL,   .dataSize = 1, .uriIndex = TEST_OBS_URI_INDEX_2},
+    };
+
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_ERROR, oac_uri_obs_notifyBatch(NULL, items_, 1));
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_ERROR, oac_uri_obs_notifyBatch(TEST_OBS_HANDLE, NULL, 1));
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_ERROR, oac_uri_obs_notifyBatch(TEST_OBS_HANDLE, items_, 0));
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_ERROR, oac_uri_obs_notifyBatch(TEST_OBS_HANDLE, items_, 2)); // second item without data
+}
+
+TEST(ot_app_coap_uri_obs, GivenOneSubscriberWithThreeUris_WhenCallingNotifyBatch_ThenOneMessage)
+{
+    oacu_result_t result_;
+    uint8_t data_[3] = {11, 22, 33};
+    oacu_token_t tokens_[3][OAC_URI_OBS_TOKEN_LENGTH] = {{0xA1, 1, 1, 1}, {0xA2, 2, 2, 2}, {0xA3, 3, 3, 3}};
+    oac_uri_dataPacket_t packets_[OAC_URI_OBS_NOTIFY_RECORDS_MAX];
+    oac_uri_obs_notifyItem_t items_[3];
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        oac_uri_obs_subscribe(TEST_OBS_HANDLE, tokens_[i], TEST_OBS_URI_INDEX_1 + i, &test_obs_obsTrue.ipAddr, test_obs_obsTrue.deviceNameFull);
+        items_[i] = (oac_uri_obs_notifyItem_t){.excludedIpAddr = NULL, .data = &data_[i], .dataSize = 1, .uriIndex = TEST_OBS_URI_INDEX_1 + i};
+    }
+    RESET_FAKE(otapp_coapSendPutUri_subscribed_uris);
+
+    result_ = oac_uri_obs_notifyBatch(TEST_OBS_HANDLE, items_, 3);
+    TEST_ASSERT_EQUAL(3, result_);
+    TEST_ASSERT_EQUAL(1, otapp_coapSendPutUri_subscribed_uris_fake.call_count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&test_obs_obsTrue.ipAddr, otapp_coapSendPutUri_subscribed_uris_fake.arg0_val, OT_IP6_ADDRESS_SIZE);
+
+    result_ = oac_uri_obs_parseNotify(otapp_coapSendPutUri_subscribed_uris_fake.arg1_val, otapp_coapSendPutUri_subscribed_uris_fake.arg2_val, packets_, OAC_URI_OBS_NOTIFY_RECORDS_MAX, NULL);
+    TEST_ASSERT_EQUAL(3, result_);
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(tokens_[i], packets_[i].token, OAC_URI_OBS_TOKEN_LENGTH);
+        TEST_ASSERT_EQUAL(data_[i], packets_[i].buffer[0]);
+    }
+}
+
+TEST(ot_app_coap_uri_obs, GivenTwoSubscribers_WhenCallingNotifyBatch_ThenOneMessagePerIpAddr)
+{
+    oacu_result_t result_;
+    uint8_t data_[2] = {11, 22};
+    oac_uri_obs_notifyItem_t items_[] = {
+        {.excludedIpAddr = NULL, .data = &data_[0], .dataSize = 1, .uriIndex = test_obs_obsTrue.uri->uriIndex},
+        {.excludedIpAddr = NULL, .data = &data_[1], .dataSize = 1, .uriIndex = test_obs_obsTrue2.uri->uriIndex},
+    };
+
+    oac_uri_obs_subscribe(TEST_OBS_HANDLE, test_obs_obsTrue.uri->token, test_obs_obsTrue.uri->uriIndex, &test_obs_obsTrue.ipAddr, test_obs_obsTrue.deviceNameFull);
+    oac_uri_obs_subscribe(TEST_OBS_HANDLE, test_obs_obsTrue.uri->token, test_obs_obsTrue2.uri->uriIndex, &test_obs_obsTrue.ipAddr, test_obs_obsTrue.deviceNameFull);
+    oac_uri_obs_subscribe(TEST_OBS_HANDLE, test_obs_obsTrue2.uri->token, test_obs_obsTrue2.uri->uriIndex, &test_obs_obsTrue2.ipAddr, test_obs_obsTrue2.deviceNameFull);
+    RESET_FAKE(otapp_coapSendPutUri_subscribed_uris);
+
+    result_ = oac_uri_obs_notifyBatch(TEST_OBS_HANDLE, items_, 2);
+    TEST_ASSERT_EQUAL(3, result_);
+    TEST_ASSERT_EQUAL(2, otapp_coapSendPutUri_subscribed_uris_fake.call_count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&test_obs_obsTrue2.ipAddr, otapp_coapSendPutUri_subscribed_uris_fake.arg0_val, OT_IP6_ADDRESS_SIZE); // last message
+
+    // excluded requester
+    RESET_FAKE(otapp_coapSendPutUri_subscribed_uris);
+    items_[0].excludedIpAddr = &test_obs_obsTrue.ipAddr;
+    result_ = oac_uri_obs_notifyBatch(TEST_OBS_HANDLE, items_, 2);
+    TEST_ASSERT_EQUAL(2, result_);
+    TEST_ASSERT_EQUAL(2, otapp_coapSendPutUri_subscribed_uris_fake.call_count);
+}
+
+static const otIp6Address test_obs_groupAddr = {.mFields.m8 = {0xff, 0x03, 0, 0, 0, 0, 0, 0, 0, 0, 0x6f, 0x61, 0x12, 0x34, 0x56, 0x78}};
+static const oacu_token_t *test_obs_filterToken;
+
+static int8_t test_obs_tokenFilter(const oacu_token_t *token)
+{
+    return (memcmp(token, test_obs_filterToken, OAC_URI_OBS_TOKEN_LENGTH) == 0) ? OAC_URI_OBS_IS : OAC_URI_OBS_IS_NOT;
+}
+
+TEST(ot_app_coap_uri_obs, GivenMulticastModeAndTwoSubscribers_WhenCallingNotifyBatch_ThenOneGroupMessage)
+{
+    oacu_result_t result_;
+    uint8_t data_[2] = {11, 22};
+    oac_uri_dataPacket_t packets_[OAC_URI_OBS_NOTIFY_RECORDS_MAX];
+    oac_uri_obs_notifyItem_t items_[] = {
+        {.excludedIpAddr = NULL, .data = &data_[0], .dataSize = 1, .uriIndex = test_obs_obsTrue.uri->uriIndex},
+        {.excludedIpAddr = NULL, .data = &data_[1], .dataSize = 1, .uriIndex = test_obs_obsTrue2.uri->uriIndex},
+    };
+
+    oac_uri_obs_subscribe(TEST_OBS_HANDLE, test_obs_obsTrue.uri->token, test_obs_obsTrue.uri->uriIndex, &test_obs_obsTrue.ipAddr, test_obs_obsTrue.deviceNameFull);
+    oac_uri_obs_subscribe(TEST_OBS_HANDLE, test_obs_obsTrue2.uri->token, test_obs_obsTrue2.uri->uriIndex, &test_obs_obsTrue2.ipAddr, test_obs_obsTrue2.deviceNameFull);
+    oac_uri_obs_notifyModeSet(OAC_URI_OBS_NOTIFY_MODE_MULTICAST, &test_obs_groupAddr);
+    RESET_FAKE(otapp_coapSendPutUri_subscribed_uris);
+    RESET_FAKE(otapp_coapSendPutUri_subscribed_urisMulticast);
+
+    result_ = oac_uri_obs_notifyBatch(TEST_OBS_HANDLE, items_, 2);
+    TEST_ASSERT_EQUAL(2, result_);
+    TEST_ASSERT_EQUAL(0, otapp_coapSendPutUri_subscribed_uris_fake.call_count);
+    TEST_ASSERT_EQUAL(1, otapp_coapSendPutUri_subscribed_urisMulticast_fake.call_count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&test_obs_groupAddr, otapp_coapSendPutUri_subscribed_urisMulticast_fake.arg0_val, OT_IP6_ADDRESS_SIZE);
+
+    // all records in the group message
+    result_ = oac_uri_obs_parseNotify(otapp_coapSendPutUri_subscribed_urisMulticast_fake.arg1_val, otapp_coapSendPutUri_subscribed_urisMulticast_fake.arg2_val, packets_, OAC_URI_OBS_NOTIFY_RECORDS_MAX, NULL);
+    TEST_ASSERT_EQUAL(2, result_);
+
+    // receiver keeps only own record
+    test_obs_filterToken = test_obs_obsTrue2.uri->token;
+    result_ = oac_uri_obs_parseNotify(otapp_coapSendPutUri_subscribed_urisMulticast_fake.arg1_val, otapp_coapSendPutUri_subscribed_urisMulticast_fake.arg2_val, packets_, 1, test_obs_tokenFilter);
+    TEST_ASSERT_EQUAL(1, result_);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(test_obs_obsTrue2.uri->token, packets_[0].token, OAC_URI_OBS_TOKEN_LENGTH);
+    TEST_ASSERT_EQUAL(data_[1], packets_[0].buffer[0]);
+
+    // not subscribed receiver
+    test_obs_filterToken = test_obs_token_4Byte_2;
+    result_ = oac_uri_obs_parseNotify(otapp_coapSendPutUri_subscribed_urisMulticast_fake.arg1_val, otapp_coapSendPutUri_subscribed_urisMulticast_fake.arg2_val, packets_, 1, test_obs_tokenFilter);
+    TEST_ASSERT_EQUAL(0, result_);
+}
+
+TEST(ot_app_coap_uri_obs, GivenMulticastModeAndOneDestination_WhenCallingNotifyBatch_ThenUnicast)
+{
+    oacu_result_t result_;
+    uint8_t data_[2] = {11, 22};
+    oac_uri_obs_notifyItem_t items_[] = {
+        {.excludedIpAddr = NULL, .data = &data_[0], .dataSize = 1, .uriIndex = test_obs_obsTrue.uri->uriIndex},
+        {.excludedIpAddr = NULL, .data = &data_[1], .dataSize = 1, .uriIndex = test_obs_obsTrue2.uri->uriIndex},
+    };
+
+    oac_uri_obs_subscribe(TEST_OBS_HANDLE, test_obs_obsTrue.uri->token, test_obs_obsTrue.uri->uriIndex, &test_obs_obsTrue.ipAddr, test_obs_obsTrue.deviceNameFull);
+    oac_uri_obs_subscribe(TEST_OBS_HANDLE, test_obs_obsTrue2.uri->token, test_obs_obsTrue2.uri->uriIndex, &test_obs_obsTrue2.ipAddr, test_obs_obsTrue2.deviceNameFull);
+    oac_uri_obs_notifyModeSet(OAC_URI_OBS_NOTIFY_MODE_MULTICAST, &test_obs_groupAddr);
+    RESET_FAKE(otapp_coapSendPutUri_subscribed_uris);
+    RESET_FAKE(otapp_coapSendPutUri_subscribed_urisMulticast);
+
+    // second subscriber is the requester: one destination left
+    items_[1].excludedIpAddr = &test_obs_obsTrue2.ipAddr;
+    result_ = oac_uri_obs_notifyBatch(TEST_OBS_HANDLE, items_, 2);
+    TEST_ASSERT_EQUAL(1, result_);
+    TEST_ASSERT_EQUAL(0, otapp_coapSendPutUri_subscribed_urisMulticast_fake.call_count);
+    TEST_ASSERT_EQUAL(1, otapp_coapSendPutUri_subscribed_uris_fake.call_count);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(&test_obs_obsTrue.ipAddr, otapp_coapSendPutUri_subscribed_uris_fake.arg0_val, OT_IP6_ADDRESS_SIZE);
+}
+
+// second task (OT tasklet) subscribes while the notify task is inside the notify cycle
+static volatile int8_t test_obs_threadResult;
+static volatile uint8_t test_obs_threadDone;
+static volatile uint8_t test_obs_threadDoneDuringSend;
+static pthread_t test_obs_thread;
+
+static void *test_obs_subscribeThread(void *arg)
+{
+    (void)arg;
+    test_obs_threadResult = oac_uri_obs_subscribe(TEST_OBS_HANDLE, test_obs_obsTrue2.uri->token, test_obs_obsTrue.uri->uriIndex, &test_obs_obsTrue2.ipAddr, test_obs_obsTrue2.deviceNameFull);
+    test_obs_threadDone = 1;
+    return NULL;
+}
+
+static void test_obs_sendWithSubscribe(const otIp6Address *ipAddr, const uint8_t *data, uint16_t dataSize)
+{
+    (void)ipAddr;
+    (void)data;
+    (void)dataSize;
+
+    pthread_create(&test_obs_thread, NULL, test_obs_subscribeThread, NULL);
+    usleep(20 * 1000);
+    test_obs_threadDoneDuringSend = test_obs_threadDone;
+}
+
+TEST(ot_app_coap_uri_obs, GivenSubscribeFromOtherTask_WhenCallingNotifyBatch_ThenSubscribeNotBlocked)
+{
+    oacu_result_t result_;
+    uint8_t data_ = 11;
+    oac_uri_obs_notifyItem_t item_ = {.excludedIpAddr = NULL, .data = &data_, .dataSize = 1, .uriIndex = test_obs_obsTrue.uri->uriIndex};
+
+    test_obs_threadResult = OAC_URI_OBS_ERROR;
+    test_obs_threadDone = 0;
+    test_obs_threadDoneDuringSend = 0;
+
+    oac_uri_obs_subscribe(TEST_OBS_HANDLE, test_obs_obsTrue.uri->token, test_obs_obsTrue.uri->uriIndex, &test_obs_obsTrue.ipAddr, test_obs_obsTrue.deviceNameFull);
+    RESET_FAKE(otapp_coapSendPutUri_subscribed_uris);
+    otapp_coapSendPutUri_subscribed_uris_fake.custom_fake = test_obs_sendWithSubscribe;
+    mock_rtos_pthread_mutex_onOff(1);
+
+    result_ = oac_uri_obs_notifyBatch(TEST_OBS_HANDLE, &item_, 1);
+    pthread_join(test_obs_thread, NULL);
+    mock_rtos_pthread_mutex_onOff(0);
+
+    // sent from the copy of the list: the subscribe ran during the send, the new subscriber is not in this cycle
+    TEST_ASSERT_EQUAL(1, result_);
+    TEST_ASSERT_EQUAL(1, otapp_coapSendPutUri_subscribed_uris_fake.call_count);
+    TEST_ASSERT_EQUAL(1, test_obs_threadDoneDuringSend);
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_ADDED_NEW_DEVICE, test_obs_threadResult);
+    TEST_ASSERT_EQUAL(1, oac_uri_obs_devNameFullIsExist(TEST_OBS_HANDLE, test_obs_obsTrue2.deviceNameFull));
+
+    RESET_FAKE(otapp_coapSendPutUri_subscribed_uris);
+    result_ = oac_uri_obs_notifyBatch(TEST_OBS_HANDLE, &item_, 1);
+    TEST_ASSERT_EQUAL(2, result_);
+    TEST_ASSERT_EQUAL(2, otapp_coapSendPutUri_subscribed_uris_fake.call_count);
+}
+
+TEST(ot_app_coap_uri_obs, GivenSubscribeFromOtherTask_WhenCallingNotify_ThenSubscribeWaitsForCycle)
+{
+    oacu_result_t result_;
+    uint8_t data_ = 11;
+
+    test_obs_threadResult = OAC_URI_OBS_ERROR;
+    test_obs_threadDone = 0;
+    test_obs_threadDoneDuringSend = 1;
+
+    oac_uri_obs_subscribe(TEST_OBS_HANDLE, test_obs_obsTrue.uri->token, test_obs_obsTrue.uri->uriIndex, &test_obs_obsTrue.ipAddr, test_obs_obsTrue.deviceNameFull);
+    RESET_FAKE(otapp_coapSendPutUri_subscribed_uris);
+    otapp_coapSendPutUri_subscribed_uris_fake.custom_fake = test_obs_sendWithSubscribe;
+    mock_rtos_pthread_mutex_onOff(1);
+
+    result_ = oac_uri_obs_notify(TEST_OBS_HANDLE, NULL, test_obs_obsTrue.uri->uriIndex, &data_, 1);
+    pthread_join(test_obs_thread, NULL);
+    mock_rtos_pthread_mutex_onOff(0);
+
+    // inline notify sends from the live list, the subscribe waits for the end of the cycle
+    TEST_ASSERT_EQUAL(1, result_);
+    TEST_ASSERT_EQUAL(1, otapp_coapSendPutUri_subscribed_uris_fake.call_count);
+    TEST_ASSERT_EQUAL(0, test_obs_threadDoneDuringSend);
+
+    TEST_ASSERT_EQUAL(1, test_obs_threadDone);
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_ADDED_NEW_DEVICE, test_obs_threadResult);
+    TEST_ASSERT_EQUAL(1, oac_uri_obs_devNameFullIsExist(TEST_OBS_HANDLE, test_obs_obsTrue2.deviceNameFull));
+}
+
+// parseNotify()
+TEST(ot_app_coap_uri_obs, GivenIncorrectArgs_WhenParseNotify_ThenReturnError)
+{
+    uint8_t data_ = 254;
+    uint8_t garbage_[8] = {0xFF, 0xFF, 1, 2, 3, 4, 5, 6};
+    oac_uri_dataPacket_t packets_[OAC_URI_OBS_NOTIFY_RECORDS_MAX];
+    oacu_token_t tokens_[2][OAC_URI_OBS_TOKEN_LENGTH] = {{0xA1, 1, 1, 1}, {0xA2, 2, 2, 2}};
+    oac_uri_obs_notifyItem_t items_[2];
+
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_ERROR, oac_uri_obs_parseNotify(NULL, 8, packets_, OAC_URI_OBS_NOTIFY_RECORDS_MAX, NULL));
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_ERROR, oac_uri_obs_parseNotify(garbage_, sizeof(garbage_), NULL, OAC_URI_OBS_NOTIFY_RECORDS_MAX, NULL));
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_ERROR, oac_uri_obs_parseNotify(garbage_, sizeof(garbage_), packets_, OAC_URI_OBS_NOTIFY_RECORDS_MAX, NULL));
+
+    // two records, space for one
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        oac_uri_obs_subscribe(TEST_OBS_HANDLE, tokens_[i], TEST_OBS_URI_INDEX_1 + i, &test_obs_obsTrue.ipAddr, test_obs_obsTrue.deviceNameFull);
+        items_[i] = (oac_uri_obs_notifyItem_t){.excludedIpAddr = NULL, .data = &data_, .dataSize = 1, .uriIndex = TEST_OBS_URI_INDEX_1 + i};
+    }
+    TEST_ASSERT_EQUAL(2, oac_uri_obs_notifyBatch(TEST_OBS_HANDLE, items_, 2));
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_ERROR, oac_uri_obs_parseNotify(otapp_coapSendPutUri_subscribed_uris_fake.arg1_val, otapp_coapSendPutUri_subscribed_uris_fake.arg2_val, packets_, 1, NULL));
+}
+
+TEST(ot_app_coap_uri_obs, GivenNotify_WhenCheckPayload_ThenFirstByteIsFormatVersion)
+{
+    uint8_t data_ = 254;
+
+    oac_uri_obs_subscribe(TEST_OBS_HANDLE, test_obs_obsTrue.uri->token, test_obs_obsTrue.uri->uriIndex, &test_obs_obsTrue.ipAddr, test_obs_obsTrue.deviceNameFull);
+    RESET_FAKE(otapp_coapSendPutUri_subscribed_uris);
+    TEST_ASSERT_EQUAL(1, oac_uri_obs_notify(TEST_OBS_HANDLE, NULL, test_obs_obsTrue.uri->uriIndex, &data_, 1));
+
+    TEST_ASSERT_EQUAL(1, otapp_coapSendPutUri_subscribed_uris_fake.call_count);
+    TEST_ASSERT_EQUAL_HEX8(OAC_URI_OBS_NOTIFY_FORMAT_VERSION, otapp_coapSendPutUri_subscribed_uris_fake.arg1_val[0]);
+}
+
+TEST(ot_app_coap_uri_obs, GivenOtherFormatByte_WhenParseNotify_ThenReturnError)
+{
+    uint8_t data_ = 254;
+    uint8_t payload_[OAC_URI_OBS_TX_BUFFER_SIZE];
+    uint16_t payloadSize_;
+    oac_uri_dataPacket_t packets_[OAC_URI_OBS_NOTIFY_RECORDS_MAX];
+    uint8_t legacyRecord_[OAC_URI_OBS_TOKEN_LENGTH + 1] = {0xA1, 1, 1, 1, 254};
+
+    // old layout: one bare record token | data
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_ERROR, oac_uri_obs_parseNotify(legacyRecord_, sizeof(legacyRecord_), packets_, OAC_URI_OBS_NOTIFY_RECORDS_MAX, NULL));
+
+    oac_uri_obs_subscribe(TEST_OBS_HANDLE, test_obs_obsTrue.uri->token, test_obs_obsTrue.uri->uriIndex, &test_obs_obsTrue.ipAddr, test_obs_obsTrue.deviceNameFull);
+    TEST_ASSERT_EQUAL(1, oac_uri_obs_notify(TEST_OBS_HANDLE, NULL, test_obs_obsTrue.uri->uriIndex, &data_, 1));
+    payloadSize_ = otapp_coapSendPutUri_subscribed_uris_fake.arg2_val;
+    memcpy(payload_, otapp_coapSendPutUri_subscribed_uris_fake.arg1_val, payloadSize_);
+    TEST_ASSERT_EQUAL(1, oac_uri_obs_parseNotify(payload_, payloadSize_, packets_, OAC_URI_OBS_NOTIFY_RECORDS_MAX, NULL));
+
+    // next format version, same TLV
+    payload_[0] = OAC_URI_OBS_NOTIFY_FORMAT_VERSION + 1;
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_ERROR, oac_uri_obs_parseNotify(payload_, payloadSize_, packets_, OAC_URI_OBS_NOTIFY_RECORDS_MAX, NULL));
+
+    // format byte only
+    payload_[0] = OAC_URI_OBS_NOTIFY_FORMAT_VERSION;
+    TEST_ASSERT_EQUAL(OAC_URI_OBS_ERROR, oac_uri_obs_parseNotify(payload_, OAC_URI_OBS_NOTIFY_FORMAT_SIZE, packets_, OAC_URI_OBS_NOTIFY_RECORDS_MAX, NULL));
+}
+
 // parseMessage()
 TEST(ot_app_coap_uri_obs, GivenNullArgs_WhenParseMessage_ThenReturnError)
 {
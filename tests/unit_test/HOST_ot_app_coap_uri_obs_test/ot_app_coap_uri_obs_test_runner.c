@@ -155,6 +155,20 @@ TEST_GROUP_RUNNER(ot_app_coap_uri_obs)
    RUN_TEST_CASE(ot_app_coap_uri_obs, CheckNotify_GivenTrueArgs_WhenCallingNotify_ThenReturnOk);
    RUN_TEST_CASE(ot_app_coap_uri_obs, CheckNotify_GivenTwoSubscribersOneWillExclude_WhenCallingNotify_ThenReturnOk);
 
+   // notifyBatch()
+   RUN_TEST_CASE(ot_app_coap_uri_obs, GivenNullArgs_WhenCallingNotifyBatch_ThenReturnError);
+   RUN_TEST_CASE(ot_app_coap_uri_obs, GivenOneSubscriberWithThreeUris_WhenCallingNotifyBatch_ThenOneMessage);
+   RUN_TEST_CASE(ot_app_coap_uri_obs, GivenTwoSubscribers_WhenCallingNotifyBatch_ThenOneMessagePerIpAddr);
+   RUN_TEST_CASE(ot_app_coap_uri_obs, GivenMulticastModeAndTwoSubscribers_WhenCallingNotifyBatch_ThenOneGroupMessage);
+   RUN_TEST_CASE(ot_app_coap_uri_obs, GivenMulticastModeAndOneDestination_WhenCallingNotifyBatch_ThenUnicast);
+   RUN_TEST_CASE(ot_app_coap_uri_obs, GivenSubscribeFromOtherTask_WhenCallingNotifyBatch_ThenSubscribeNotBlocked);
+   RUN_TEST_CASE(ot_app_coap_uri_obs, GivenSubscribeFromOtherTask_WhenCallingNotify_ThenSubscribeWaitsForCycle);
+
+   // parseNotify()
+   RUN_TEST_CASE(ot_app_coap_uri_obs, GivenIncorrectArgs_WhenParseNotify_ThenReturnError);
+   RUN_TEST_CASE(ot_app_coap_uri_obs, GivenNotify_WhenCheckPayload_ThenFirstByteIsFormatVersion);
+   RUN_TEST_CASE(ot_app_coap_uri_obs, GivenOtherFormatByte_WhenParseNotify_ThenReturnError);
+
    // parseMessage()
    RUN_TEST_CASE(ot_app_coap_uri_obs, GivenNullArgs_WhenParseMessage_ThenReturnError);
    RUN_TEST_CASE(ot_app_coap_uri_obs, GivenTrueArg_WhenParseMessage_ThenReturnPtrToStract);
@@ -23,6 +23,7 @@
 #define MOCK_FREERTOS_QUEUE_H_
 
 #include "stdint.h"
+#include "stddef.h"
 
 #define xQueueCreate    fq_mock_xQueueCreate
 #define xQueueSend      fq_mock_xQueueSend
@@ -5,7 +5,7 @@
 
 typedef void* SemaphoreHandle_t;
 // #define xSemaphoreTake(sem, timeout)    (pdTRUE)
-#define xSemaphoreGive(sem)             ((void)0)
+#define xSemaphoreGive(sem)             ((void)(sem))
 #define xSemaphoreCreateMutex() ((SemaphoreHandle_t)1)
 
 #ifndef pdTRUE
@@ -30,6 +30,40 @@ static inline int xSemaphoreTake(SemaphoreHandle_t sem, TickType_t timeout)
     return pdTRUE;  // Zwracamy sukces, na wypadek gdybyś użył tego w if()
 }
 
+// simulated tick counter, a delay only moves the time forward
+static TickType_t mock_freertos_tickCount = 0;
+
+static inline TickType_t xTaskGetTickCount(void)
+{
+    return mock_freertos_tickCount;
+}
+
+static inline void vTaskDelay(TickType_t ticks)
+{
+    mock_freertos_tickCount += ticks;
+}
+
+// single task: nobody can notify a waiter, so the wait always runs to its timeout
+typedef void* TaskHandle_t;
+
+static inline TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return (TaskHandle_t)1;
+}
+
+static inline uint32_t ulTaskNotifyTake(int clearCountOnExit, TickType_t ticks)
+{
+    (void)clearCountOnExit;
+    mock_freertos_tickCount += ticks;
+    return 0;
+}
+
+static inline int xTaskNotifyGive(TaskHandle_t task)
+{
+    (void)task;
+    return pdTRUE;
+}
+
 #define HRO_SEC_NOINIT /* nothing */
 
 #endif  /* MOCK_FREERTOS_SEMAPHORE_H_ */
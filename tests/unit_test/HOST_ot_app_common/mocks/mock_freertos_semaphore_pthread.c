@@ -1,40 +1,140 @@
 #include "mock_freertos_semaphore_pthread.h"
 #include <pthread.h>
+#include <time.h>
 
-static pthread_mutex_t real_host_mutex; 
-static int is_mutex_initialized = 0;
+#define MOCK_RTOS_PTHREAD_MUTEX_MAX 16
+
+// every xSemaphoreCreateMutex() call gets its own host mutex, so striped locks really run in parallel
+static pthread_mutex_t real_host_mutex[MOCK_RTOS_PTHREAD_MUTEX_MAX]; 
+static uint8_t real_host_mutex_cnt = 0;
 static uint8_t mock_rtos_pthread_mutex_enable = 0;
 
 SemaphoreHandle_t xSemaphoreCreateMutex(void) 
 {
-    if (!is_mutex_initialized) 
+    if (real_host_mutex_cnt >= MOCK_RTOS_PTHREAD_MUTEX_MAX) 
     {
-
-        pthread_mutex_init(&real_host_mutex, NULL);
-        is_mutex_initialized = 1;
+        return NULL;
     }
-    return (SemaphoreHandle_t)1; 
+
+    pthread_mutex_init(&real_host_mutex[real_host_mutex_cnt], NULL);
+    
+    return (SemaphoreHandle_t)&real_host_mutex[real_host_mutex_cnt++]; 
 }
 
 int xSemaphoreTake(SemaphoreHandle_t sem, TickType_t timeout) 
 {
-    (void)sem; (void)timeout;
+    if(sem == NULL) return pdFALSE;
 
     if(mock_rtos_pthread_mutex_enable)
     {
-        pthread_mutex_lock(&real_host_mutex); 
+        // 0: no wait, any other timeout blocks until the mutex is free
+        if(timeout == 0) return (pthread_mutex_trylock((pthread_mutex_t*)sem) == 0) ? pdTRUE : pdFALSE;
+
+        pthread_mutex_lock((pthread_mutex_t*)sem); 
     }
     return pdTRUE;
 }
 
 void xSemaphoreGive(SemaphoreHandle_t sem) 
 {
-    (void)sem;
-    
-    pthread_mutex_unlock(&real_host_mutex);
+    if(sem == NULL) return;
+
+    if(mock_rtos_pthread_mutex_enable)
+    {
+        pthread_mutex_unlock((pthread_mutex_t*)sem);
+    }
 }
 
 void mock_rtos_pthread_mutex_onOff(uint8_t onOff)
 {
     mock_rtos_pthread_mutex_enable = onOff;
-}
\ No newline at end of file
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (TickType_t)(ts.tv_sec * 1000u + ts.tv_nsec / 1000000u);
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    struct timespec ts = { .tv_sec = ticks / 1000u, .tv_nsec = (long)(ticks % 1000u) * 1000000L };
+    nanosleep(&ts, NULL);
+}
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t  cond;
+    uint32_t        count;
+    uint8_t         initialized;
+} mock_rtos_pthread_task_t;
+
+// the waiter is removed from every wait queue before its thread ends, so the handle never dangles
+static __thread mock_rtos_pthread_task_t mock_rtos_pthread_task;
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    mock_rtos_pthread_task_t *task = &mock_rtos_pthread_task;
+
+    if(!task->initialized)
+    {
+        pthread_condattr_t attr;
+        pthread_condattr_init(&attr);
+        pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+        pthread_cond_init(&task->cond, &attr);
+        pthread_condattr_destroy(&attr);
+        pthread_mutex_init(&task->lock, NULL);
+        task->count = 0;
+        task->initialized = 1;
+    }
+    return (TaskHandle_t)task;
+}
+
+uint32_t ulTaskNotifyTake(int clearCountOnExit, TickType_t ticks)
+{
+    mock_rtos_pthread_task_t *task = (mock_rtos_pthread_task_t*)xTaskGetCurrentTaskHandle();
+    struct timespec deadline;
+    uint32_t value;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec  += ticks / 1000u;
+    deadline.tv_nsec += (long)(ticks % 1000u) * 1000000L;
+    if(deadline.tv_nsec >= 1000000000L)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    pthread_mutex_lock(&task->lock);
+    while(task->count == 0)
+    {
+        if(ticks == portMAX_DELAY)
+        {
+            pthread_cond_wait(&task->cond, &task->lock);
+        }else if(pthread_cond_timedwait(&task->cond, &task->lock, &deadline) != 0)
+        {
+            break; // timeout
+        }
+    }
+    value = task->count;
+    if(clearCountOnExit) task->count = 0;
+    else if(task->count) task->count--;
+    pthread_mutex_unlock(&task->lock);
+
+    return value;
+}
+
+int xTaskNotifyGive(TaskHandle_t handle)
+{
+    mock_rtos_pthread_task_t *task = (mock_rtos_pthread_task_t*)handle;
+
+    if(task == NULL) return pdFALSE;
+
+    pthread_mutex_lock(&task->lock);
+    task->count++;
+    pthread_cond_signal(&task->cond);
+    pthread_mutex_unlock(&task->lock);
+
+    return pdTRUE;
+}
@@ -16,4 +16,15 @@ void xSemaphoreGive(SemaphoreHandle_t sem);
 
 void mock_rtos_pthread_mutex_onOff(uint8_t onOff);
 
+// 1 tick = 1 ms of host monotonic time
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t ticks);
+
+// task notification (index 0), every host thread is one task
+typedef void* TaskHandle_t;
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+uint32_t ulTaskNotifyTake(int clearCountOnExit, TickType_t ticks);
+int xTaskNotifyGive(TaskHandle_t task);
+
 #endif  /* MOCK_FREERTOS_SEMAPHORE_PTHREAD_H_ */
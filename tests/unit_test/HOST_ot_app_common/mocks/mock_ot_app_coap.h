@@ -58,8 +58,36 @@ typedef enum otCoapOptionType
     OT_COAP_OPTION_PROXY_SCHEME   = 39, ///< Proxy-Scheme
     OT_COAP_OPTION_SIZE1          = 60, ///< Size1
 } otCoapOptionType;
+typedef enum otCoapType
+{
+    OT_COAP_TYPE_CONFIRMABLE     = 0, ///< Confirmable
+    OT_COAP_TYPE_NON_CONFIRMABLE = 1, ///< Non-confirmable
+    OT_COAP_TYPE_ACKNOWLEDGMENT  = 2, ///< Acknowledgment
+    OT_COAP_TYPE_RESET           = 3, ///< Reset
+} otCoapType;
+
+#define OT_COAP_CODE(c, d) ((((c)&0x7) << 5) | ((d)&0x1f))
+typedef enum otCoapCode
+{
+    OT_COAP_CODE_EMPTY              = OT_COAP_CODE(0, 0),  ///< Empty message code
+    OT_COAP_CODE_GET                = OT_COAP_CODE(0, 1),  ///< Get
+    OT_COAP_CODE_POST               = OT_COAP_CODE(0, 2),  ///< Post
+    OT_COAP_CODE_PUT                = OT_COAP_CODE(0, 3),  ///< Put
+    OT_COAP_CODE_DELETE             = OT_COAP_CODE(0, 4),  ///< Delete
+    OT_COAP_CODE_CHANGED            = OT_COAP_CODE(2, 4),  ///< Changed
+    OT_COAP_CODE_CONTENT            = OT_COAP_CODE(2, 5),  ///< Content
+    OT_COAP_CODE_BAD_REQUEST        = OT_COAP_CODE(4, 0),  ///< Bad Request
+    OT_COAP_CODE_BAD_OPTION         = OT_COAP_CODE(4, 2),  ///< Bad Option
+    OT_COAP_CODE_NOT_FOUND          = OT_COAP_CODE(4, 4),  ///< Not Found
+    OT_COAP_CODE_METHOD_NOT_ALLOWED = OT_COAP_CODE(4, 5),  ///< Method Not Allowed
+    OT_COAP_CODE_INTERNAL_ERROR     = OT_COAP_CODE(5, 0),  ///< Internal Server Error
+} otCoapCode;
+
 typedef enum otError
 {
+    OT_ERROR_NONE = 0,
+    OT_ERROR_NO_BUFS = 3,
+    OT_ERROR_PARSE = 6,
     OT_ERROR_GENERIC = 255,
 }otError;
 
@@ -98,6 +126,7 @@ DECLARE_FAKE_VALUE_FUNC1(const uint8_t *, otCoapMessageGetToken, const otMessage
 DECLARE_FAKE_VALUE_FUNC(const char *, otapp_coap_getUriNameFromDefault, otapp_coap_uriIndex_t);
 DECLARE_FAKE_VOID_FUNC3(otapp_coapSendGetUri_Well_known, const otIp6Address *, otCoapResponseHandler, void *);
 DECLARE_FAKE_VOID_FUNC3(otapp_coapSendPutUri_subscribed_uris, const otIp6Address *,  const uint8_t *, uint16_t);
+DECLARE_FAKE_VOID_FUNC3(otapp_coapSendPutUri_subscribed_urisMulticast, const otIp6Address *,  const uint8_t *, uint16_t);
 DECLARE_FAKE_VOID_FUNC3(otapp_coapSendSubscribeRequest, const otIp6Address *,  const char *, uint8_t *);
 DECLARE_FAKE_VOID_FUNC3(otapp_coapSendSubscribeRequestUpdate, const otIp6Address *,  const char *, uint8_t *);
 // DECLARE_FAKE_VALUE_FUNC3(int8_t, otapp_coapReadPayload, otMessage *, uint8_t *, uint16_t);
@@ -0,0 +1,26 @@
+#include "mock_ot_app_port_openthread.h"
+#include <pthread.h>
+
+static pthread_mutex_t mock_ot_lock;
+static pthread_once_t mock_ot_lockOnce = PTHREAD_ONCE_INIT;
+
+static void mock_ot_lockInit(void)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&mock_ot_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+void otapp_port_openthread_lock(void)
+{
+    pthread_once(&mock_ot_lockOnce, mock_ot_lockInit);
+    pthread_mutex_lock(&mock_ot_lock);
+}
+
+void otapp_port_openthread_unlock(void)
+{
+    pthread_mutex_unlock(&mock_ot_lock);
+}
@@ -0,0 +1,10 @@
+#ifndef MOCK_OT_APP_PORT_OPENTHREAD_H_
+#define MOCK_OT_APP_PORT_OPENTHREAD_H_
+
+#include <stdint.h>
+
+// host OpenThread API lock: recursive mutex like esp_openthread_lock, every host thread is one task
+void otapp_port_openthread_lock(void);
+void otapp_port_openthread_unlock(void);
+
+#endif  /* MOCK_OT_APP_PORT_OPENTHREAD_H_ */
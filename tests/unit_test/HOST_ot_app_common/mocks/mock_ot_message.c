@@ -27,3 +27,6 @@
 DEFINE_FAKE_VALUE_FUNC1(uint16_t, otMessageGetLength, const otMessage *);
 DEFINE_FAKE_VALUE_FUNC1(uint16_t, otMessageGetOffset, const otMessage *);
 DEFINE_FAKE_VALUE_FUNC4(uint16_t, otMessageRead, const otMessage *, uint16_t, void *, uint16_t);
+DEFINE_FAKE_VALUE_FUNC3(otError, otMessageAppend, otMessage *, const void *, uint16_t);
+DEFINE_FAKE_VALUE_FUNC4(int, otMessageWrite, otMessage *, uint16_t, const void *, uint16_t);
+DEFINE_FAKE_VOID_FUNC1(otMessageFree, otMessage *);
@@ -23,6 +23,7 @@
 #define MOCK_OT_MESSAGE_H_
 #include "fff.h"
 #include "mock_ip6.h"
+#include "mock_ot_app_coap.h"
 
 
 
@@ -30,5 +31,8 @@
 DECLARE_FAKE_VALUE_FUNC1(uint16_t, otMessageGetLength, const otMessage *);
 DECLARE_FAKE_VALUE_FUNC1(uint16_t, otMessageGetOffset, const otMessage *);
 DECLARE_FAKE_VALUE_FUNC4(uint16_t, otMessageRead, const otMessage *, uint16_t, void *, uint16_t);
+DECLARE_FAKE_VALUE_FUNC3(otError, otMessageAppend, otMessage *, const void *, uint16_t);
+DECLARE_FAKE_VALUE_FUNC4(int, otMessageWrite, otMessage *, uint16_t, const void *, uint16_t);
+DECLARE_FAKE_VOID_FUNC1(otMessageFree, otMessage *);
 
 #endif  /* MOCK_OT_MESSAGE_H_ */
@@ -391,4 +391,28 @@ TEST(ot_app_deviceName, GivenTrueArgs_WhenIsCallingDeviceNameFullToEUI_ThenRetur
     TEST_ASSERT_EQUAL(OTAPP_DEVICENAME_OK, result);
     TEST_ASSERT_EQUAL_STRING(deviceNameFull_device1_type0_fakeAddr_eui, EuiPtrStr);
     
-}
\ No newline at end of file
+}
+
+TEST(ot_app_deviceName, GivenNullArgs_WhenIsCallingGroupAddressGet_ThenReturnError)
+{
+    otIp6Address addr;
+
+    TEST_ASSERT_EQUAL(OTAPP_DEVICENAME_ERROR, otapp_deviceNameGroupAddressGet(NULL, &addr));
+    TEST_ASSERT_EQUAL(OTAPP_DEVICENAME_ERROR, otapp_deviceNameGroupAddressGet(deviceNameFull_device1_type0_fakeAddr, NULL));
+    TEST_ASSERT_EQUAL(OTAPP_DEVICENAME_ERROR, otapp_deviceNameGroupAddressGet("_1_0011223344556677", &addr));
+    TEST_ASSERT_EQUAL(OTAPP_DEVICENAME_ERROR, otapp_deviceNameGroupAddressGet("device1", &addr));
+}
+
+TEST(ot_app_deviceName, GivenSameAndOtherGroup_WhenIsCallingGroupAddressGet_ThenSameGroupSameAddr)
+{
+    const uint8_t prefix[] = OTAPP_DEVICENAME_GROUP_ADDR_PREFIX;
+    otIp6Address addr1, addr2, addrOther;
+
+    TEST_ASSERT_EQUAL(OTAPP_DEVICENAME_OK, otapp_deviceNameGroupAddressGet(deviceNameFull_device1_type0_fakeAddr, &addr1));
+    TEST_ASSERT_EQUAL(OTAPP_DEVICENAME_OK, otapp_deviceNameGroupAddressGet(ut_dn_createDeviceNameFull(deviceName_device1, UT_DN_OK_DEVICE_TYPE_3_LIGHT), &addr2));
+    TEST_ASSERT_EQUAL(OTAPP_DEVICENAME_OK, otapp_deviceNameGroupAddressGet(deviceNameFull_not_same, &addrOther));
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(prefix, addr1.mFields.m8, sizeof(prefix));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(addr1.mFields.m8, addr2.mFields.m8, OT_IP6_ADDRESS_SIZE);
+    TEST_ASSERT_FALSE(memcmp(addr1.mFields.m8, addrOther.mFields.m8, OT_IP6_ADDRESS_SIZE) == 0);
+}
@@ -60,5 +60,8 @@ TEST_GROUP_RUNNER(ot_app_deviceName)
    RUN_TEST_CASE(ot_app_deviceName, GivenTooShortDevNameArgs_WhenIsCallingDeviceNameFullToEUI_ThenReturnERROR);
    RUN_TEST_CASE(ot_app_deviceName, GivenTrueArgs_WhenIsCallingDeviceNameFullToEUI_ThenReturnOK);
 
+   RUN_TEST_CASE(ot_app_deviceName, GivenNullArgs_WhenIsCallingGroupAddressGet_ThenReturnError);
+   RUN_TEST_CASE(ot_app_deviceName, GivenSameAndOtherGroup_WhenIsCallingGroupAddressGet_ThenSameGroupSameAddr);
+
 }
 
@@ -19,8 +19,44 @@ TEST_GROUP_RUNNER(ot_app_msg_tlv)
    RUN_TEST_CASE(ot_app_msg_tlv, GivenTrueKeyAndReadExistKeyWithoutReadValueAndValSize_WhenCallKeyGet_ThenReturnKeyExist);
    RUN_TEST_CASE(ot_app_msg_tlv, GivenEmptyBuffer_WhenCallKeyGet_ThenReturn);
 
-   RUN_TEST_CASE(ot_app_msg_tlv, GivenKeyDataLen_WhenCallalCualeBuffer_ThenReturnOK);
-   RUN_TEST_CASE(ot_app_msg_tlv, GivenKeyDataLenDouble_WhenCallalCualeBuffer_ThenReturnOK);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenRecords_WhenCallSchemaSize_ThenSameAsWrittenBytes);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenSchemaEncodedRecords_WhenCallSchemaFieldGet_ThenSameRecords);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenTooLongValue_WhenCallSchemaEncodeOrFieldGet_ThenReturnError);
+
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenNullPtr_WhenCallIterFirst_ThenReturnError);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenEmptyBuffer_WhenCallIterFirst_ThenReturnEnd);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenTwoKeys_WhenIterate_ThenReturnKeysInOrder);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenTwoKeys_WhenCallIterPeek_ThenIteratorNotMoved);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenCorruptedLength_WhenIterate_ThenReturnError);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenWrittenBytesBiggerThanBuffer_WhenCallIterFirst_ThenReturnError);
+
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenNullPtr_WhenCallBuilderInit_ThenReturnError);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenTrustedBuilder_WhenCallBuilderAdd_ThenSameLayoutAsKeyAdd);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenStrictBuilder_WhenAddSameKeyTwice_ThenReturnKeyExist);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenStrictBuilderAndFilterCollision_WhenCallBuilderAdd_ThenReturnOk);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenBufferFilledByKeyAdd_WhenStrictBuilderAddSameKey_ThenReturnKeyExist);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenBufSizeForOneKey_WhenCallBuilderAddTwice_ThenReturnErrorNoSpace);
+
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenNotExistKey_WhenCallKeyDelete_ThenReturnKeyNoExist);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenMiddleKey_WhenCallKeyDelete_ThenBufferCompacted);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenSameLength_WhenCallKeyUpdate_ThenValueChangedInPlace);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenOtherLength_WhenCallKeyUpdate_ThenSameAsRebuiltBuffer);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenNoSpaceForBiggerValue_WhenCallKeyUpdate_ThenReturnErrorNoSpace);
+
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenNotEmptyBuffer_WhenCallFormatSet_ThenReturnError);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenCompactFormat_WhenCallKeyAdd_ThenHeadersShorter);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenCompactFormat_WhenCallKeyGetAndIterate_ThenSameValues);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenCompactFormat_WhenCallBuilderAdd_ThenSameLayoutAsKeyAdd);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenCompactFormat_WhenCallKeyDeleteAndUpdate_ThenSameAsRebuiltBuffer);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenCompactFormatWithCorruptedVarint_WhenIterate_ThenReturnError);
+
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenMsgWriter_WhenAddKeys_ThenSameBytesAsKeyAdd);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenMsgWriterOutput_WhenCallMsgReader_ThenSameItemsAsIter);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenNoMessageBuffers_WhenCallMsgWriterAdd_ThenReturnErrorNoSpace);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenWrittenBytesBiggerThanMessage_WhenCallMsgReaderInit_ThenReturnError);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenCorruptedLength_WhenCallMsgReaderNext_ThenReturnError);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenMsgWriterWindows_WhenAppendAllBlocks_ThenSameBytesAsKeyAdd);
+   RUN_TEST_CASE(ot_app_msg_tlv, GivenEmptyWindow_WhenCallMsgWriter_ThenOnlySizeCounted);
 }
 
 
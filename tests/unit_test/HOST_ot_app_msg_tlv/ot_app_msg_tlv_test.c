@@ -1,10 +1,12 @@
 #include "unity_fixture.h"
 #include "string.h"
 #include "ot_app_msg_tlv.h"
+#include "ot_app_msg_tlv_msg.h"
 
 #define TEST_MSG_TLV_BUF_SIZE 256
 #define TEST_MSG_TLV_KEY_1  0xAAA1
 #define TEST_MSG_TLV_KEY_2  0xEEBB
+#define TEST_MSG_TLV_KEY_3  0x0C03
 #define TEST_MSG_TLV_ONE_KEY_LENGTH_BYTES 4
 #define TEST_MSG_TLV_RESERVED_BYTES 2
 #define TEST_MSG_TLV_RESERVED_BYTES_FOR_1_KEY_INFO (TEST_MSG_TLV_ONE_KEY_LENGTH_BYTES + TEST_MSG_TLV_RESERVED_BYTES)
@@ -14,6 +16,14 @@
 static uint8_t buffer[TEST_MSG_TLV_BUF_SIZE];
 static uint8_t value[10] = {1,2,3,4,5,6,7,8,9,10};
 
+DEFINE_FFF_GLOBALS;
+
+// otMessage backed by a flat array, first TEST_MSG_TLV_MSG_OFFSET bytes simulate the CoAP header
+#define TEST_MSG_TLV_MSG_OFFSET     4
+static otMessage testMessage;
+static uint8_t testMessageData[TEST_MSG_TLV_BUF_SIZE];
+static uint16_t testMessageLength;
+
 void test_msg_tlv_clearBuffer(void)
 {
     memset(buffer, 0, TEST_MSG_TLV_BUF_SIZE);
@@ -25,6 +35,12 @@ TEST_SETUP(ot_app_msg_tlv)
 {
     /* Init before every test */
     test_msg_tlv_clearBuffer();
+
+    RESET_FAKE(otMessageGetLength);
+    RESET_FAKE(otMessageRead);
+    RESET_FAKE(otMessageAppend);
+    RESET_FAKE(otMessageWrite);
+    FFF_RESET_HISTORY();
 }
 
 TEST_TEAR_DOWN(ot_app_msg_tlv)
@@ -194,46 +210,689 @@ TEST(ot_app_msg_tlv, GivenEmptyBuffer_WhenCallKeyGet_ThenReturn)
     TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_EMPTY_BUFFER, result);
 }
 
-// otapp_msg_tlv_calcualeBuffer
-TEST(ot_app_msg_tlv, GivenKeyDataLen_WhenCallalCualeBuffer_ThenReturnOK)
+// otapp_msg_tlv_schemaSize / schemaEncode / schemaFieldGet
+typedef struct {
+    char name[12];
+    int16_t temp;
+    uint8_t flags;
+} test_msg_tlv_record_t;
+
+#define TEST_MSG_TLV_SCHEMA_KEY_BASE    0x1000
+#define TEST_MSG_TLV_RECORDS_QTY        3
+
+#define TEST_MSG_TLV_SCHEMA(X) \
+    X(temp,  OT_APP_MSG_TLV_FIELD_BYTES, sizeof(int16_t)) \
+    X(name,  OT_APP_MSG_TLV_FIELD_STR,   11) \
+    X(flags, OT_APP_MSG_TLV_FIELD_BYTES, sizeof(uint8_t))
+
+#define TEST_MSG_TLV_FIELD(member, type, maxLength)     OT_APP_MSG_TLV_SCHEMA_FIELD(test_msg_tlv_record_t, member, type, maxLength)
+#define TEST_MSG_TLV_CHECK(member, type, maxLength)     OT_APP_MSG_TLV_SCHEMA_FIELD_CHECK(test_msg_tlv_record_t, member, type, maxLength)
+#define TEST_MSG_TLV_SIZE_MAX(member, type, maxLength)  + OT_APP_MSG_TLV_BLOCK_SIZE_MAX(maxLength)
+
+TEST_MSG_TLV_SCHEMA(TEST_MSG_TLV_CHECK)
+
+static const otapp_msg_tlv_field_t testRecordFields[] = { TEST_MSG_TLV_SCHEMA(TEST_MSG_TLV_FIELD) };
+static const otapp_msg_tlv_schema_t testRecordSchema = OT_APP_MSG_TLV_SCHEMA(test_msg_tlv_record_t, testRecordFields, TEST_MSG_TLV_SCHEMA_KEY_BASE);
+
+static const test_msg_tlv_record_t testRecords[TEST_MSG_TLV_RECORDS_QTY] = {
+    {"kitchen", 215, 0x01},
+    {"bedroom_01", -40, 0x00},
+    {"a", 0, 0xFF},
+};
+
+// compile time worst case, no runtime probing
+#define TEST_MSG_TLV_RECORDS_SIZE_MAX   (OT_APP_MSG_TLV_RESERVED_SIZE + TEST_MSG_TLV_RECORDS_QTY * (0 TEST_MSG_TLV_SCHEMA(TEST_MSG_TLV_SIZE_MAX)))
+
+TEST(ot_app_msg_tlv, GivenRecords_WhenCallSchemaSize_ThenSameAsWrittenBytes)
+{
+    uint8_t schemaBuffer[TEST_MSG_TLV_RECORDS_SIZE_MAX] = {0};
+    otapp_msg_tlv_builder_t builder;
+    uint16_t usedBytes = 0;
+    uint16_t schemaSize;
+
+    schemaSize = otapp_msg_tlv_schemaSize(&testRecordSchema, testRecords, TEST_MSG_TLV_RECORDS_QTY);
+
+    otapp_msg_tlv_builderInit(&builder, schemaBuffer, sizeof(schemaBuffer), OT_APP_MSG_TLV_BUILDER_TRUSTED);
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_schemaEncode(&testRecordSchema, testRecords, TEST_MSG_TLV_RECORDS_QTY, otapp_msg_tlv_builderAddFn, &builder));
+    otapp_msg_tlv_getBufferTotalUsedSpace(schemaBuffer, sizeof(schemaBuffer), &usedBytes);
+
+    TEST_ASSERT_EQUAL(usedBytes, OT_APP_MSG_TLV_RESERVED_SIZE + schemaSize);
+    TEST_ASSERT_EQUAL(0, otapp_msg_tlv_schemaSize(NULL, testRecords, TEST_MSG_TLV_RECORDS_QTY));
+}
+
+TEST(ot_app_msg_tlv, GivenSchemaEncodedRecords_WhenCallSchemaFieldGet_ThenSameRecords)
 {
-    const uint8_t keysQty = 3;
-    const uint16_t valueLengthStart = 5;
-    uint16_t bufferSizExpected = TEST_MSG_TLV_RESERVED_BYTES;
-    uint16_t  bufferSizCalculated = 0;
+    test_msg_tlv_record_t decoded[TEST_MSG_TLV_RECORDS_QTY];
+    otapp_msg_tlv_builder_t builder;
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+    void *dst;
+    uint8_t record, field;
+    int8_t result;
+
+    otapp_msg_tlv_builderInit(&builder, buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_BUILDER_TRUSTED);
+    otapp_msg_tlv_builderAdd(&builder, TEST_MSG_TLV_KEY_1, 1, value); // key outside the schema
+    otapp_msg_tlv_schemaEncode(&testRecordSchema, testRecords, TEST_MSG_TLV_RECORDS_QTY, otapp_msg_tlv_builderAddFn, &builder);
+
+    // keys: base + 3*record + field + 1
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_KEY_EXIST, otapp_msg_tlv_keyGet(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_SCHEMA_KEY_BASE + 3 * 2 + 2 + 1, NULL, NULL));
+
+    memset(decoded, 0, sizeof(decoded));
+    result = otapp_msg_tlv_iterFirst(&iter, buffer, TEST_MSG_TLV_BUF_SIZE, &item);
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_KEY_NO_EXIST, otapp_msg_tlv_schemaFieldGet(&testRecordSchema, decoded, TEST_MSG_TLV_RECORDS_QTY, item.key, item.length, &dst, NULL, NULL));
 
-    for (uint8_t i = 0; i < keysQty; i++)
+    while ((result = otapp_msg_tlv_iterNext(&iter, &item)) == OT_APP_MSG_TLV_OK)
     {
-        bufferSizExpected += (TEST_MSG_TLV_ONE_KEY_LENGTH_BYTES + (valueLengthStart * i + 1));
+        TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_schemaFieldGet(&testRecordSchema, decoded, TEST_MSG_TLV_RECORDS_QTY, item.key, item.length, &dst, &record, &field));
+        TEST_ASSERT_EQUAL_HEX16(TEST_MSG_TLV_SCHEMA_KEY_BASE + record * 3 + field + 1, item.key);
+        memcpy(dst, item.value, item.length);
+    }
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_END, result);
 
-        bufferSizCalculated = otapp_msg_tlv_calcualeBuffer((valueLengthStart * i + 1), i);
+    for (uint8_t i = 0; i < TEST_MSG_TLV_RECORDS_QTY; i++)
+    {
+        TEST_ASSERT_EQUAL_STRING(testRecords[i].name, decoded[i].name);
+        TEST_ASSERT_EQUAL_INT16(testRecords[i].temp, decoded[i].temp);
+        TEST_ASSERT_EQUAL_HEX8(testRecords[i].flags, decoded[i].flags);
     }
-    
-    TEST_ASSERT_EQUAL(bufferSizExpected, bufferSizCalculated);
 }
 
-TEST(ot_app_msg_tlv, GivenKeyDataLenDouble_WhenCallalCualeBuffer_ThenReturnOK)
+TEST(ot_app_msg_tlv, GivenTooLongValue_WhenCallSchemaEncodeOrFieldGet_ThenReturnError)
+{
+    test_msg_tlv_record_t record = { .temp = 1 };
+    otapp_msg_tlv_builder_t builder;
+    void *dst;
+
+    memset(record.name, 'x', sizeof(record.name)); // no '\0' within maxLength
+
+    otapp_msg_tlv_builderInit(&builder, buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_BUILDER_TRUSTED);
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_schemaEncode(&testRecordSchema, &record, 1, otapp_msg_tlv_builderAddFn, &builder));
+    TEST_ASSERT_EQUAL(0, otapp_msg_tlv_schemaSize(&testRecordSchema, &record, 1));
+
+    // name (field 1) of record 0 longer than 11 bytes, key of record 1 with only 1 record
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_schemaFieldGet(&testRecordSchema, &record, 1, TEST_MSG_TLV_SCHEMA_KEY_BASE + 2, 12, &dst, NULL, NULL));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_KEY_NO_EXIST, otapp_msg_tlv_schemaFieldGet(&testRecordSchema, &record, 1, TEST_MSG_TLV_SCHEMA_KEY_BASE + 4, 2, &dst, NULL, NULL));
+}
+
+// otapp_msg_tlv_iterFirst / iterNext / iterPeek
+TEST(ot_app_msg_tlv, GivenNullPtr_WhenCallIterFirst_ThenReturnError)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_iterFirst(NULL, buffer, TEST_MSG_TLV_BUF_SIZE, &item));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_iterFirst(&iter, NULL, TEST_MSG_TLV_BUF_SIZE, &item));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_iterFirst(&iter, buffer, TEST_MSG_TLV_RESERVED_BYTES, &item));
+}
+
+TEST(ot_app_msg_tlv, GivenEmptyBuffer_WhenCallIterFirst_ThenReturnEnd)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_END, otapp_msg_tlv_iterFirst(&iter, buffer, TEST_MSG_TLV_BUF_SIZE, &item));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_END, otapp_msg_tlv_iterNext(&iter, &item));
+}
+
+TEST(ot_app_msg_tlv, GivenTwoKeys_WhenIterate_ThenReturnKeysInOrder)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+
+    otapp_msg_tlv_keyAdd(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, 10, value);
+    otapp_msg_tlv_keyAdd(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_2, 3, value);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_iterFirst(&iter, buffer, TEST_MSG_TLV_BUF_SIZE, &item));
+    TEST_ASSERT_EQUAL_HEX16(TEST_MSG_TLV_KEY_1, item.key);
+    TEST_ASSERT_EQUAL(10, item.length);
+    TEST_ASSERT_EQUAL_PTR(buffer + TEST_MSG_TLV_RESERVED_BYTES_FOR_1_KEY_INFO, item.value);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(value, item.value, 10);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_iterNext(&iter, &item));
+    TEST_ASSERT_EQUAL_HEX16(TEST_MSG_TLV_KEY_2, item.key);
+    TEST_ASSERT_EQUAL(3, item.length);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(value, item.value, 3);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_END, otapp_msg_tlv_iterNext(&iter, &item));
+}
+
+TEST(ot_app_msg_tlv, GivenTwoKeys_WhenCallIterPeek_ThenIteratorNotMoved)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+
+    otapp_msg_tlv_keyAdd(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, 10, value);
+    otapp_msg_tlv_keyAdd(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_2, 3, value);
+
+    otapp_msg_tlv_iterFirst(&iter, buffer, TEST_MSG_TLV_BUF_SIZE, NULL);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_iterPeek(&iter, &item));
+    TEST_ASSERT_EQUAL_HEX16(TEST_MSG_TLV_KEY_2, item.key);
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_iterPeek(&iter, &item));
+    TEST_ASSERT_EQUAL_HEX16(TEST_MSG_TLV_KEY_2, item.key);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_iterNext(&iter, &item));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_END, otapp_msg_tlv_iterPeek(&iter, &item));
+}
+
+TEST(ot_app_msg_tlv, GivenCorruptedLength_WhenIterate_ThenReturnError)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+
+    otapp_msg_tlv_keyAdd(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, 10, value);
+    otapp_msg_tlv_keyAdd(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_2, 3, value);
+
+    buffer[TEST_MSG_TLV_RESERVED_BYTES_FOR_1_KEY_INFO + 10 + 2] = 4; // KEY_2 length crosses written data
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_iterFirst(&iter, buffer, TEST_MSG_TLV_BUF_SIZE, &item));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_iterNext(&iter, &item));
+}
+
+TEST(ot_app_msg_tlv, GivenWrittenBytesBiggerThanBuffer_WhenCallIterFirst_ThenReturnError)
+{
+    otapp_msg_tlv_iter_t iter;
+    const uint16_t bufferSize = TEST_MSG_TLV_RESERVED_BYTES_FOR_1_KEY_INFO + 10;
+
+    otapp_msg_tlv_keyAdd(buffer, bufferSize, TEST_MSG_TLV_KEY_1, 10, value);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_iterFirst(&iter, buffer, bufferSize - 1, NULL));
+}
+
+// otapp_msg_tlv_builderInit / builderAdd
+TEST(ot_app_msg_tlv, GivenNullPtr_WhenCallBuilderInit_ThenReturnError)
+{
+    otapp_msg_tlv_builder_t builder;
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_builderInit(NULL, buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_BUILDER_STRICT));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_builderInit(&builder, NULL, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_BUILDER_STRICT));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_builderAdd(NULL, TEST_MSG_TLV_KEY_1, 10, value));
+}
+
+TEST(ot_app_msg_tlv, GivenTrustedBuilder_WhenCallBuilderAdd_ThenSameLayoutAsKeyAdd)
+{
+    otapp_msg_tlv_builder_t builder;
+    uint8_t bufferExpected[TEST_MSG_TLV_BUF_SIZE] = {0};
+
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, 10, value);
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_2, 1, value);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_builderInit(&builder, buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_BUILDER_TRUSTED));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_builderAdd(&builder, TEST_MSG_TLV_KEY_1, 10, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_builderAdd(&builder, TEST_MSG_TLV_KEY_2, 1, value));
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(bufferExpected, buffer, TEST_MSG_TLV_BUF_SIZE);
+}
+
+TEST(ot_app_msg_tlv, GivenStrictBuilder_WhenAddSameKeyTwice_ThenReturnKeyExist)
+{
+    otapp_msg_tlv_builder_t builder;
+
+    otapp_msg_tlv_builderInit(&builder, buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_BUILDER_STRICT);
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_builderAdd(&builder, TEST_MSG_TLV_KEY_1, 1, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_KEY_EXIST, otapp_msg_tlv_builderAdd(&builder, TEST_MSG_TLV_KEY_1, 1, value));
+}
+
+TEST(ot_app_msg_tlv, GivenStrictBuilderAndFilterCollision_WhenCallBuilderAdd_ThenReturnOk)
+{
+    otapp_msg_tlv_builder_t builder;
+    const uint16_t keyCollision = TEST_MSG_TLV_KEY_1 + OT_APP_MSG_TLV_BUILDER_BITMAP_BITS; // same filter bit, other key
+
+    otapp_msg_tlv_builderInit(&builder, buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_BUILDER_STRICT);
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_builderAdd(&builder, TEST_MSG_TLV_KEY_1, 10, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_builderAdd(&builder, keyCollision, 10, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_KEY_EXIST, otapp_msg_tlv_keyGet(buffer, TEST_MSG_TLV_BUF_SIZE, keyCollision, NULL, NULL));
+}
+
+TEST(ot_app_msg_tlv, GivenBufferFilledByKeyAdd_WhenStrictBuilderAddSameKey_ThenReturnKeyExist)
+{
+    otapp_msg_tlv_builder_t builder;
+
+    otapp_msg_tlv_keyAdd(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, 10, value);
+
+    otapp_msg_tlv_builderInit(&builder, buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_BUILDER_STRICT);
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_KEY_EXIST, otapp_msg_tlv_builderAdd(&builder, TEST_MSG_TLV_KEY_1, 10, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_builderAdd(&builder, TEST_MSG_TLV_KEY_2, 10, value));
+}
+
+TEST(ot_app_msg_tlv, GivenBufSizeForOneKey_WhenCallBuilderAddTwice_ThenReturnErrorNoSpace)
+{
+    otapp_msg_tlv_builder_t builder;
+
+    otapp_msg_tlv_builderInit(&builder, buffer, TEST_MSG_TLV_RESERVED_BYTES_FOR_1_KEY_INFO + 10, OT_APP_MSG_TLV_BUILDER_TRUSTED);
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_builderAdd(&builder, TEST_MSG_TLV_KEY_1, 10, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR_NO_SPACE, otapp_msg_tlv_builderAdd(&builder, TEST_MSG_TLV_KEY_2, 1, value));
+}
+
+// otapp_msg_tlv_keyDelete / keyUpdate
+static void test_msg_tlv_addThreeKeys(uint8_t *buf)
+{
+    otapp_msg_tlv_keyAdd(buf, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, 10, value);
+    otapp_msg_tlv_keyAdd(buf, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_2, 3, value);
+    otapp_msg_tlv_keyAdd(buf, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_3, 5, value);
+}
+
+TEST(ot_app_msg_tlv, GivenNotExistKey_WhenCallKeyDelete_ThenReturnKeyNoExist)
+{
+    test_msg_tlv_addThreeKeys(buffer);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_KEY_NO_EXIST, otapp_msg_tlv_keyDelete(buffer, TEST_MSG_TLV_BUF_SIZE, 0x1234));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_keyDelete(NULL, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1));
+}
+
+TEST(ot_app_msg_tlv, GivenMiddleKey_WhenCallKeyDelete_ThenBufferCompacted)
+{
+    uint8_t bufferExpected[TEST_MSG_TLV_BUF_SIZE] = {0};
+
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, 10, value);
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_3, 5, value);
+    test_msg_tlv_addThreeKeys(buffer);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_keyDelete(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_2));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(bufferExpected, buffer, TEST_MSG_TLV_BUF_SIZE);
+}
+
+TEST(ot_app_msg_tlv, GivenSameLength_WhenCallKeyUpdate_ThenValueChangedInPlace)
+{
+    uint8_t newValue[3] = {0xA, 0xB, 0xC};
+    uint8_t valueOut[3];
+    uint16_t usedBefore, usedAfter;
+
+    test_msg_tlv_addThreeKeys(buffer);
+    otapp_msg_tlv_getBufferTotalUsedSpace(buffer, TEST_MSG_TLV_BUF_SIZE, &usedBefore);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_keyUpdate(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_2, 3, newValue));
+
+    otapp_msg_tlv_getBufferTotalUsedSpace(buffer, TEST_MSG_TLV_BUF_SIZE, &usedAfter);
+    otapp_msg_tlv_keyGet(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_2, NULL, valueOut);
+    TEST_ASSERT_EQUAL(usedBefore, usedAfter);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(newValue, valueOut, 3);
+}
+
+TEST(ot_app_msg_tlv, GivenOtherLength_WhenCallKeyUpdate_ThenSameAsRebuiltBuffer)
 {
-    uint8_t keysQty = 3;
-    const int16_t valueLengthStart = 5;
-    uint16_t bufferSizExpected = TEST_MSG_TLV_RESERVED_BYTES;
-    uint16_t  bufferSizCalculated = 0;
+    uint8_t bufferExpected[TEST_MSG_TLV_BUF_SIZE] = {0};
+
+    // grow
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, 10, value);
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_2, 8, value);
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_3, 5, value);
+    test_msg_tlv_addThreeKeys(buffer);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_keyUpdate(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_2, 8, value));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(bufferExpected, buffer, TEST_MSG_TLV_BUF_SIZE);
+
+    // shrink
+    memset(bufferExpected, 0, TEST_MSG_TLV_BUF_SIZE);
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, 2, value);
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_2, 8, value);
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_3, 5, value);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_keyUpdate(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, 2, value));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(bufferExpected, buffer, TEST_MSG_TLV_BUF_SIZE);
+}
 
-    for (uint8_t i = 0; i < keysQty; i++)
+TEST(ot_app_msg_tlv, GivenNoSpaceForBiggerValue_WhenCallKeyUpdate_ThenReturnErrorNoSpace)
+{
+    const uint16_t bufferSize = TEST_MSG_TLV_RESERVED_BYTES_FOR_1_KEY_INFO + 5;
+    uint8_t bufferExpected[TEST_MSG_TLV_BUF_SIZE] = {0};
+
+    otapp_msg_tlv_keyAdd(buffer, bufferSize, TEST_MSG_TLV_KEY_1, 5, value);
+    memcpy(bufferExpected, buffer, TEST_MSG_TLV_BUF_SIZE);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR_NO_SPACE, otapp_msg_tlv_keyUpdate(buffer, bufferSize, TEST_MSG_TLV_KEY_1, 6, value));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(bufferExpected, buffer, TEST_MSG_TLV_BUF_SIZE);
+}
+
+// compact format (otapp_msg_tlv_formatSet)
+#define TEST_MSG_TLV_KEY_SEQ    0xAA00
+
+static void test_msg_tlv_addSeqKeys(uint8_t *buf, uint16_t bufSize, uint16_t lastLength)
+{
+    static uint8_t bigValue[TEST_MSG_TLV_BUF_SIZE];
+
+    otapp_msg_tlv_keyAdd(buf, bufSize, TEST_MSG_TLV_KEY_SEQ,     1, value);
+    otapp_msg_tlv_keyAdd(buf, bufSize, TEST_MSG_TLV_KEY_SEQ + 1, 4, value);
+    otapp_msg_tlv_keyAdd(buf, bufSize, TEST_MSG_TLV_KEY_SEQ + 2, lastLength, bigValue);
+}
+
+TEST(ot_app_msg_tlv, GivenNotEmptyBuffer_WhenCallFormatSet_ThenReturnError)
+{
+    uint8_t format = 0xFF;
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_formatGet(buffer, TEST_MSG_TLV_BUF_SIZE, &format));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_FORMAT_CLASSIC, format);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_formatSet(buffer, TEST_MSG_TLV_BUF_SIZE, 2));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_formatSet(buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_FORMAT_COMPACT));
+    otapp_msg_tlv_keyAdd(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, 10, value);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_formatSet(buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_FORMAT_CLASSIC));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_formatGet(buffer, TEST_MSG_TLV_BUF_SIZE, &format));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_FORMAT_COMPACT, format);
+}
+
+TEST(ot_app_msg_tlv, GivenCompactFormat_WhenCallKeyAdd_ThenHeadersShorter)
+{
+    uint16_t usedClassic, usedCompact;
+    uint8_t bufferClassic[TEST_MSG_TLV_BUF_SIZE] = {0};
+
+    test_msg_tlv_addSeqKeys(bufferClassic, TEST_MSG_TLV_BUF_SIZE, 10);
+    otapp_msg_tlv_formatSet(buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_FORMAT_COMPACT);
+    test_msg_tlv_addSeqKeys(buffer, TEST_MSG_TLV_BUF_SIZE, 10);
+
+    otapp_msg_tlv_getBufferTotalUsedSpace(bufferClassic, TEST_MSG_TLV_BUF_SIZE, &usedClassic);
+    otapp_msg_tlv_getBufferTotalUsedSpace(buffer, TEST_MSG_TLV_BUF_SIZE, &usedCompact);
+
+    TEST_ASSERT_EQUAL(2 + (4 + 1) + (4 + 4) + (4 + 10), usedClassic);
+    TEST_ASSERT_EQUAL(2 + (3 + 1 + 1) + (1 + 1 + 4) + (1 + 1 + 10), usedCompact);   // first key: 3 byte varint
+}
+
+TEST(ot_app_msg_tlv, GivenCompactFormat_WhenCallKeyGetAndIterate_ThenSameValues)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+    uint8_t valueOut[10];
+    uint16_t lengthOut = 0;
+
+    otapp_msg_tlv_formatSet(buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_FORMAT_COMPACT);
+    otapp_msg_tlv_keyAdd(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_2, 10, value);
+    otapp_msg_tlv_keyAdd(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, 3, value);    // key lower than previous
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_KEY_EXIST, otapp_msg_tlv_keyAdd(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_2, 1, value));
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_KEY_EXIST, otapp_msg_tlv_keyGet(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, &lengthOut, valueOut));
+    TEST_ASSERT_EQUAL(3, lengthOut);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(value, valueOut, 3);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_iterFirst(&iter, buffer, TEST_MSG_TLV_BUF_SIZE, &item));
+    TEST_ASSERT_EQUAL_HEX16(TEST_MSG_TLV_KEY_2, item.key);
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_iterNext(&iter, &item));
+    TEST_ASSERT_EQUAL_HEX16(TEST_MSG_TLV_KEY_1, item.key);
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_END, otapp_msg_tlv_iterNext(&iter, &item));
+}
+
+TEST(ot_app_msg_tlv, GivenCompactFormat_WhenCallBuilderAdd_ThenSameLayoutAsKeyAdd)
+{
+    otapp_msg_tlv_builder_t builder;
+    uint8_t bufferExpected[TEST_MSG_TLV_BUF_SIZE] = {0};
+    uint8_t bigValue[TEST_MSG_TLV_BUF_SIZE] = {0};
+
+    otapp_msg_tlv_formatSet(bufferExpected, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_FORMAT_COMPACT);
+    test_msg_tlv_addSeqKeys(bufferExpected, TEST_MSG_TLV_BUF_SIZE, 200);
+
+    otapp_msg_tlv_formatSet(buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_FORMAT_COMPACT);
+    otapp_msg_tlv_builderInit(&builder, buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_BUILDER_STRICT);
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_builderAdd(&builder, TEST_MSG_TLV_KEY_SEQ, 1, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_builderAdd(&builder, TEST_MSG_TLV_KEY_SEQ + 1, 4, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_builderAdd(&builder, TEST_MSG_TLV_KEY_SEQ + 2, 200, bigValue));
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(bufferExpected, buffer, TEST_MSG_TLV_BUF_SIZE);
+}
+
+TEST(ot_app_msg_tlv, GivenCompactFormat_WhenCallKeyDeleteAndUpdate_ThenSameAsRebuiltBuffer)
+{
+    uint8_t bufferExpected[TEST_MSG_TLV_BUF_SIZE] = {0};
+    uint8_t bigValue[TEST_MSG_TLV_BUF_SIZE] = {0};
+
+    // delete: next key delta is encoded again from the block before the deleted one
+    otapp_msg_tlv_formatSet(bufferExpected, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_FORMAT_COMPACT);
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_SEQ, 1, value);
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_SEQ + 2, 10, bigValue);
+
+    otapp_msg_tlv_formatSet(buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_FORMAT_COMPACT);
+    test_msg_tlv_addSeqKeys(buffer, TEST_MSG_TLV_BUF_SIZE, 10);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_keyDelete(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_SEQ + 1));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(bufferExpected, buffer, TEST_MSG_TLV_BUF_SIZE);
+
+    // update: length 10 -> 200 needs a 2 byte varint
+    memset(bufferExpected, 0, TEST_MSG_TLV_BUF_SIZE);
+    otapp_msg_tlv_formatSet(bufferExpected, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_FORMAT_COMPACT);
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_SEQ, 1, value);
+    otapp_msg_tlv_keyAdd(bufferExpected, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_SEQ + 2, 200, bigValue);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_keyUpdate(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_SEQ + 2, 200, bigValue));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(bufferExpected, buffer, TEST_MSG_TLV_BUF_SIZE);
+}
+
+TEST(ot_app_msg_tlv, GivenCompactFormatWithCorruptedVarint_WhenIterate_ThenReturnError)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+
+    otapp_msg_tlv_formatSet(buffer, TEST_MSG_TLV_BUF_SIZE, OT_APP_MSG_TLV_FORMAT_COMPACT);
+    otapp_msg_tlv_keyAdd(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, 10, value);
+
+    buffer[TEST_MSG_TLV_RESERVED_BYTES]     = 0xFF;  // key varint longer than 3 bytes
+    buffer[TEST_MSG_TLV_RESERVED_BYTES + 1] = 0xFF;
+    buffer[TEST_MSG_TLV_RESERVED_BYTES + 2] = 0xFF;
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_iterFirst(&iter, buffer, TEST_MSG_TLV_BUF_SIZE, &item));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_keyGet(buffer, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_1, NULL, NULL));
+}
+
+static uint16_t test_msg_tlv_messageGetLength(const otMessage *aMessage)
+{
+    (void)aMessage;
+    return testMessageLength;
+}
+
+static uint16_t test_msg_tlv_messageRead(const otMessage *aMessage, uint16_t aOffset, void *aBuf, uint16_t aLength)
+{
+    (void)aMessage;
+    if(aOffset >= testMessageLength) return 0;
+    if(aLength > testMessageLength - aOffset) aLength = testMessageLength - aOffset;
+    memcpy(aBuf, &testMessageData[aOffset], aLength);
+    return aLength;
+}
+
+static otError test_msg_tlv_messageAppend(otMessage *aMessage, const void *aBuf, uint16_t aLength)
+{
+    (void)aMessage;
+    if(aLength > TEST_MSG_TLV_BUF_SIZE - testMessageLength) return OT_ERROR_NO_BUFS;
+    memcpy(&testMessageData[testMessageLength], aBuf, aLength);
+    testMessageLength += aLength;
+    return OT_ERROR_NONE;
+}
+
+static int test_msg_tlv_messageWrite(otMessage *aMessage, uint16_t aOffset, const void *aBuf, uint16_t aLength)
+{
+    (void)aMessage;
+    if(aOffset >= testMessageLength) return 0;
+    if(aLength > testMessageLength - aOffset) aLength = testMessageLength - aOffset;
+    memcpy(&testMessageData[aOffset], aBuf, aLength);
+    return aLength;
+}
+
+static void test_msg_tlv_messageInit(void)
+{
+    memset(testMessageData, 0xEE, sizeof(testMessageData));
+    testMessageLength = TEST_MSG_TLV_MSG_OFFSET;
+
+    otMessageGetLength_fake.custom_fake = test_msg_tlv_messageGetLength;
+    otMessageRead_fake.custom_fake      = test_msg_tlv_messageRead;
+    otMessageAppend_fake.custom_fake    = test_msg_tlv_messageAppend;
+    otMessageWrite_fake.custom_fake     = test_msg_tlv_messageWrite;
+}
+
+static void test_msg_tlv_msgWriteSeqKeys(uint8_t format, uint16_t *totalSizeOut)
+{
+    otapp_msg_tlv_msgWriter_t writer;
+    uint8_t bigValue[200] = {0};
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterInit(&writer, &testMessage, format));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterAdd(&writer, TEST_MSG_TLV_KEY_SEQ, 1, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterAdd(&writer, TEST_MSG_TLV_KEY_SEQ + 1, 4, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterAdd(&writer, TEST_MSG_TLV_KEY_SEQ + 2, sizeof(bigValue), bigValue));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterFinish(&writer, totalSizeOut));
+}
+
+static void test_msg_tlv_bufferSeqKeys(uint8_t *buf, uint8_t format)
+{
+    uint8_t bigValue[200] = {0};
+
+    otapp_msg_tlv_formatSet(buf, TEST_MSG_TLV_BUF_SIZE, format);
+    otapp_msg_tlv_keyAdd(buf, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_SEQ, 1, value);
+    otapp_msg_tlv_keyAdd(buf, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_SEQ + 1, 4, value);
+    otapp_msg_tlv_keyAdd(buf, TEST_MSG_TLV_BUF_SIZE, TEST_MSG_TLV_KEY_SEQ + 2, sizeof(bigValue), bigValue);
+}
+
+TEST(ot_app_msg_tlv, GivenMsgWriter_WhenAddKeys_ThenSameBytesAsKeyAdd)
+{
+    uint16_t totalSize = 0;
+    uint16_t usedBytes = 0;
+    const uint8_t formats[] = {OT_APP_MSG_TLV_FORMAT_CLASSIC, OT_APP_MSG_TLV_FORMAT_COMPACT};
+
+    for (uint8_t i = 0; i < sizeof(formats); i++)
     {
-        bufferSizExpected += (TEST_MSG_TLV_ONE_KEY_LENGTH_BYTES + (valueLengthStart * i + 1));
+        test_msg_tlv_clearBuffer();
+        test_msg_tlv_messageInit();
 
-        bufferSizCalculated = otapp_msg_tlv_calcualeBuffer((valueLengthStart * i + 1), i);
-    }    
-    TEST_ASSERT_EQUAL(bufferSizExpected, bufferSizCalculated);
+        test_msg_tlv_bufferSeqKeys(buffer, formats[i]);
+        test_msg_tlv_msgWriteSeqKeys(formats[i], &totalSize);
+
+        otapp_msg_tlv_getBufferTotalUsedSpace(buffer, TEST_MSG_TLV_BUF_SIZE, &usedBytes);
+        TEST_ASSERT_EQUAL(usedBytes, totalSize);
+        TEST_ASSERT_EQUAL(TEST_MSG_TLV_MSG_OFFSET + totalSize, testMessageLength);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer, &testMessageData[TEST_MSG_TLV_MSG_OFFSET], totalSize);
+    }
+}
+
+TEST(ot_app_msg_tlv, GivenMsgWriterOutput_WhenCallMsgReader_ThenSameItemsAsIter)
+{
+    otapp_msg_tlv_msgReader_t reader;
+    otapp_msg_tlv_msgItem_t msgItem;
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+    int8_t result;
 
-    keysQty = 5;
-    bufferSizExpected = TEST_MSG_TLV_RESERVED_BYTES;
-    for (uint8_t i = 0; i < keysQty; i++)
+    test_msg_tlv_messageInit();
+    test_msg_tlv_bufferSeqKeys(buffer, OT_APP_MSG_TLV_FORMAT_COMPACT);
+    test_msg_tlv_msgWriteSeqKeys(OT_APP_MSG_TLV_FORMAT_COMPACT, NULL);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgReaderInit(&reader, &testMessage, TEST_MSG_TLV_MSG_OFFSET));
+
+    result = otapp_msg_tlv_iterFirst(&iter, buffer, TEST_MSG_TLV_BUF_SIZE, &item);
+    while (result == OT_APP_MSG_TLV_OK)
     {
-        bufferSizExpected += (TEST_MSG_TLV_ONE_KEY_LENGTH_BYTES + (valueLengthStart * i + 1));
+        TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgReaderNext(&reader, &msgItem));
+        TEST_ASSERT_EQUAL_HEX16(item.key, msgItem.key);
+        TEST_ASSERT_EQUAL(item.length, msgItem.length);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(item.value, &testMessageData[msgItem.valueOffset], item.length);
 
-        bufferSizCalculated = otapp_msg_tlv_calcualeBuffer((valueLengthStart * i + 1), i);
-    }    
-    TEST_ASSERT_EQUAL(bufferSizExpected, bufferSizCalculated);
-}
\ No newline at end of file
+        result = otapp_msg_tlv_iterNext(&iter, &item);
+    }
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_END, result);
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_END, otapp_msg_tlv_msgReaderNext(&reader, &msgItem));
+}
+
+TEST(ot_app_msg_tlv, GivenNoMessageBuffers_WhenCallMsgWriterAdd_ThenReturnErrorNoSpace)
+{
+    otapp_msg_tlv_msgWriter_t writer;
+    uint8_t bigValue[TEST_MSG_TLV_BUF_SIZE] = {0};
+
+    test_msg_tlv_messageInit();
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_msgWriterInit(NULL, &testMessage, OT_APP_MSG_TLV_FORMAT_CLASSIC));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_msgWriterInit(&writer, NULL, OT_APP_MSG_TLV_FORMAT_CLASSIC));
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterInit(&writer, &testMessage, OT_APP_MSG_TLV_FORMAT_CLASSIC));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_msgWriterAdd(&writer, TEST_MSG_TLV_KEY_1, 0, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR_NO_SPACE, otapp_msg_tlv_msgWriterAdd(&writer, TEST_MSG_TLV_KEY_1, sizeof(bigValue), bigValue));
+}
+
+TEST(ot_app_msg_tlv, GivenWrittenBytesBiggerThanMessage_WhenCallMsgReaderInit_ThenReturnError)
+{
+    otapp_msg_tlv_msgReader_t reader;
+
+    test_msg_tlv_messageInit();
+    test_msg_tlv_msgWriteSeqKeys(OT_APP_MSG_TLV_FORMAT_CLASSIC, NULL);
+
+    testMessageLength--; // last value byte missing
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_msgReaderInit(&reader, &testMessage, TEST_MSG_TLV_MSG_OFFSET));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_msgReaderInit(&reader, &testMessage, testMessageLength));
+}
+
+TEST(ot_app_msg_tlv, GivenCorruptedLength_WhenCallMsgReaderNext_ThenReturnError)
+{
+    otapp_msg_tlv_msgReader_t reader;
+    otapp_msg_tlv_msgItem_t msgItem;
+    otapp_msg_tlv_msgWriter_t writer;
+
+    test_msg_tlv_messageInit();
+    otapp_msg_tlv_msgWriterInit(&writer, &testMessage, OT_APP_MSG_TLV_FORMAT_CLASSIC);
+    otapp_msg_tlv_msgWriterAdd(&writer, TEST_MSG_TLV_KEY_1, 10, value);
+    otapp_msg_tlv_msgWriterFinish(&writer, NULL);
+
+    testMessageData[TEST_MSG_TLV_MSG_OFFSET + TEST_MSG_TLV_RESERVED_BYTES + 2] = 11; // value longer than written bytes
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgReaderInit(&reader, &testMessage, TEST_MSG_TLV_MSG_OFFSET));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_msgReaderNext(&reader, &msgItem));
+}
+
+static void test_msg_tlv_msgWriteSeqKeysWindow(uint8_t format, uint16_t windowOffset, uint16_t windowSize, uint16_t *totalSizeOut)
+{
+    otapp_msg_tlv_msgWriter_t writer;
+    uint8_t bigValue[200] = {0};
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterInitWindow(&writer, &testMessage, format, windowOffset, windowSize));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterAdd(&writer, TEST_MSG_TLV_KEY_SEQ, 1, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterAdd(&writer, TEST_MSG_TLV_KEY_SEQ + 1, 4, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterAdd(&writer, TEST_MSG_TLV_KEY_SEQ + 2, sizeof(bigValue), bigValue));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterFinish(&writer, totalSizeOut));
+}
+
+TEST(ot_app_msg_tlv, GivenMsgWriterWindows_WhenAppendAllBlocks_ThenSameBytesAsKeyAdd)
+{
+    uint16_t totalSize = 0;
+    uint16_t usedBytes = 0;
+    const uint16_t windowSizes[] = {16, 64};
+    const uint8_t formats[] = {OT_APP_MSG_TLV_FORMAT_CLASSIC, OT_APP_MSG_TLV_FORMAT_COMPACT};
+
+    for (uint8_t i = 0; i < sizeof(formats); i++)
+    {
+        for (uint8_t j = 0; j < sizeof(windowSizes) / sizeof(windowSizes[0]); j++)
+        {
+            test_msg_tlv_clearBuffer();
+            test_msg_tlv_messageInit();
+            test_msg_tlv_bufferSeqKeys(buffer, formats[i]);
+            otapp_msg_tlv_getBufferTotalUsedSpace(buffer, TEST_MSG_TLV_BUF_SIZE, &usedBytes);
+
+            // every block with its own writer, blocks are appended one after another
+            for (uint16_t offset = 0; offset < usedBytes; offset += windowSizes[j])
+            {
+                test_msg_tlv_msgWriteSeqKeysWindow(formats[i], offset, windowSizes[j], &totalSize);
+                TEST_ASSERT_EQUAL(usedBytes, totalSize);
+            }
+
+            TEST_ASSERT_EQUAL(TEST_MSG_TLV_MSG_OFFSET + usedBytes, testMessageLength);
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(buffer, &testMessageData[TEST_MSG_TLV_MSG_OFFSET], usedBytes);
+        }
+    }
+}
+
+TEST(ot_app_msg_tlv, GivenEmptyWindow_WhenCallMsgWriter_ThenOnlySizeCounted)
+{
+    otapp_msg_tlv_msgWriter_t writer;
+    uint16_t totalSize = 0;
+    uint16_t usedBytes = 0;
+
+    test_msg_tlv_messageInit();
+    test_msg_tlv_bufferSeqKeys(buffer, OT_APP_MSG_TLV_FORMAT_COMPACT);
+    otapp_msg_tlv_getBufferTotalUsedSpace(buffer, TEST_MSG_TLV_BUF_SIZE, &usedBytes);
+
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterInitWindow(&writer, NULL, OT_APP_MSG_TLV_FORMAT_COMPACT, 0, 0));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterAdd(&writer, TEST_MSG_TLV_KEY_SEQ, 1, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterAdd(&writer, TEST_MSG_TLV_KEY_SEQ + 1, 4, value));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterAdd(&writer, TEST_MSG_TLV_KEY_SEQ + 2, 200, buffer));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_OK, otapp_msg_tlv_msgWriterFinish(&writer, &totalSize));
+
+    TEST_ASSERT_EQUAL(usedBytes, totalSize);
+    TEST_ASSERT_EQUAL(0, otMessageAppend_fake.call_count);
+    TEST_ASSERT_EQUAL(0, otMessageWrite_fake.call_count);
+
+    // reserved header split by the window, message missing for a non empty window
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_msgWriterInitWindow(&writer, &testMessage, OT_APP_MSG_TLV_FORMAT_COMPACT, 1, 16));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_msgWriterInitWindow(&writer, &testMessage, OT_APP_MSG_TLV_FORMAT_COMPACT, 0, 1));
+    TEST_ASSERT_EQUAL(OT_APP_MSG_TLV_ERROR, otapp_msg_tlv_msgWriterInitWindow(&writer, NULL, OT_APP_MSG_TLV_FORMAT_COMPACT, 0, 16));
+}
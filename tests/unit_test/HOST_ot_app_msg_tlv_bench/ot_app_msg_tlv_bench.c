@@ -0,0 +1,297 @@
+/**
+ * @file ot_app_msg_tlv_bench.c
+ * @brief Host benchmark of the TLV codec: wire size and throughput, classic vs compact format.
+ *
+ * size (default): real payloads are built with the same key layout as otapp_pair_uriResourcesCreate()
+ * (well-known/core reply: uris count | uri1_dt | uri1_path | uri2_dt | ...), once in each
+ * format. Both buffers are decoded again and compared. The output is CSV on stdout:
+ *
+ *   payload,blocks,classic_bytes,compact_bytes,saved_bytes,saved_pct
+ *
+ * speed: three payload shapes (well-known/core, small telemetry values, few bulk values) are
+ * encoded with the builder, decoded with the iterator and looked up with keyGet() in a loop:
+ *
+ *   shape,format,keys,payload_bytes,encode_mb_s,decode_mb_s,encode_ns_per_key,decode_ns_per_key,keyget_ns_per_key
+ *
+ * Usage: HOST_ot_app_msg_tlv_bench [size|speed] [--quick]
+ *   --quick  fewer repetitions in speed mode (smoke run)
+ */
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "ot_app_msg_tlv.h"
+
+#define BENCH_BUF_SIZE          512
+#define BENCH_KEY_PATTERN       0xAA00  // as OTAPP_PAIR_KEY_PATTERN
+#define BENCH_REPS              200000
+#define BENCH_REPS_QUICK        20000
+#define BENCH_SHAPE_KEYS_MAX    16
+
+static const char *bench_uri[] = { "light/on_off", "light/dimm", "btn/state", "test/led", "diag/buf" };
+static const uint32_t bench_devType[] = { 1, 2, 3, 4, 5 };
+
+#define BENCH_ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+static int bench_wellKnownCore(uint8_t *buffer, uint8_t format, uint8_t uriQty, uint16_t *blocksOut)
+{
+    otapp_msg_tlv_builder_t builder;
+    uint16_t used = 0;
+    int8_t result;
+
+    memset(buffer, 0, BENCH_BUF_SIZE);
+    otapp_msg_tlv_formatSet(buffer, BENCH_BUF_SIZE, format);
+    otapp_msg_tlv_builderInit(&builder, buffer, BENCH_BUF_SIZE, OT_APP_MSG_TLV_BUILDER_TRUSTED);
+
+    result = otapp_msg_tlv_builderAdd(&builder, BENCH_KEY_PATTERN, sizeof(uriQty), &uriQty);
+    for (uint8_t i = 0; i < uriQty && result == OT_APP_MSG_TLV_OK; i++)
+    {
+        result = otapp_msg_tlv_builderAdd(&builder, BENCH_KEY_PATTERN + 2*i + 1, sizeof(bench_devType[i]), (const uint8_t *)&bench_devType[i]);
+        if(result == OT_APP_MSG_TLV_OK)
+        {
+            result = otapp_msg_tlv_builderAdd(&builder, BENCH_KEY_PATTERN + 2*i + 2, strlen(bench_uri[i]), (const uint8_t *)bench_uri[i]);
+        }
+    }
+
+    if(result != OT_APP_MSG_TLV_OK || otapp_msg_tlv_getBufferTotalUsedSpace(buffer, BENCH_BUF_SIZE, &used) != OT_APP_MSG_TLV_OK)
+    {
+        return -1;
+    }
+
+    *blocksOut = 1 + 2 * uriQty;
+    return used;
+}
+
+// both formats must decode to the same key / value sequence
+static int bench_sameContent(const uint8_t *a, const uint8_t *b)
+{
+    otapp_msg_tlv_iter_t iterA, iterB;
+    otapp_msg_tlv_item_t itemA, itemB;
+    int8_t resultA = otapp_msg_tlv_iterFirst(&iterA, a, BENCH_BUF_SIZE, &itemA);
+    int8_t resultB = otapp_msg_tlv_iterFirst(&iterB, b, BENCH_BUF_SIZE, &itemB);
+
+    while (resultA == OT_APP_MSG_TLV_OK && resultB == OT_APP_MSG_TLV_OK)
+    {
+        if(itemA.key != itemB.key || itemA.length != itemB.length || memcmp(itemA.value, itemB.value, itemA.length) != 0)
+        {
+            return 0;
+        }
+        resultA = otapp_msg_tlv_iterNext(&iterA, &itemA);
+        resultB = otapp_msg_tlv_iterNext(&iterB, &itemB);
+    }
+
+    return resultA == OT_APP_MSG_TLV_END && resultB == OT_APP_MSG_TLV_END;
+}
+
+// speed: one payload shape = list of (key, value) blocks
+typedef struct {
+    const char *name;
+    uint8_t keys;
+    uint16_t length[BENCH_SHAPE_KEYS_MAX];
+    const uint8_t *value[BENCH_SHAPE_KEYS_MAX];
+} bench_shape_t;
+
+static volatile uint32_t bench_sink;   // keeps the decode loops from being optimized out
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_shapesInit(bench_shape_t *shapes)
+{
+    static uint8_t uriQty = BENCH_ARRAY_SIZE(bench_uri);
+    static uint32_t telemetry[BENCH_SHAPE_KEYS_MAX];
+    static uint8_t bulk[4][96];
+
+    // well-known/core with all uris, same layout as in size mode
+    shapes[0].name = "well-known/core";
+    shapes[0].keys = 1 + 2 * uriQty;
+    shapes[0].length[0] = sizeof(uriQty);
+    shapes[0].value[0] = &uriQty;
+    for (uint8_t i = 0; i < uriQty; i++)
+    {
+        shapes[0].length[1 + 2*i] = sizeof(bench_devType[i]);
+        shapes[0].value[1 + 2*i]  = (const uint8_t *)&bench_devType[i];
+        shapes[0].length[2 + 2*i] = strlen(bench_uri[i]);
+        shapes[0].value[2 + 2*i]  = (const uint8_t *)bench_uri[i];
+    }
+
+    // many small values (sensor readings)
+    shapes[1].name = "telemetry_16x4";
+    shapes[1].keys = BENCH_SHAPE_KEYS_MAX;
+    for (uint8_t i = 0; i < BENCH_SHAPE_KEYS_MAX; i++)
+    {
+        telemetry[i] = 1000u + i;
+        shapes[1].length[i] = sizeof(telemetry[i]);
+        shapes[1].value[i]  = (const uint8_t *)&telemetry[i];
+    }
+
+    // few large values
+    shapes[2].name = "bulk_4x96";
+    shapes[2].keys = BENCH_ARRAY_SIZE(bulk);
+    for (uint8_t i = 0; i < BENCH_ARRAY_SIZE(bulk); i++)
+    {
+        memset(bulk[i], 'a' + i, sizeof(bulk[i]));
+        shapes[2].length[i] = sizeof(bulk[i]);
+        shapes[2].value[i]  = bulk[i];
+    }
+}
+
+static int bench_shapeEncode(uint8_t *buffer, uint8_t format, const bench_shape_t *shape)
+{
+    otapp_msg_tlv_builder_t builder;
+    int8_t result = OT_APP_MSG_TLV_OK;
+
+    memset(buffer, 0, OT_APP_MSG_TLV_RESERVED_SIZE); // empty buffer, old blocks are overwritten
+    otapp_msg_tlv_formatSet(buffer, BENCH_BUF_SIZE, format);
+    otapp_msg_tlv_builderInit(&builder, buffer, BENCH_BUF_SIZE, OT_APP_MSG_TLV_BUILDER_TRUSTED);
+
+    for (uint8_t i = 0; i < shape->keys && result == OT_APP_MSG_TLV_OK; i++)
+    {
+        result = otapp_msg_tlv_builderAdd(&builder, BENCH_KEY_PATTERN + i, shape->length[i], shape->value[i]);
+    }
+    return result == OT_APP_MSG_TLV_OK ? 0 : -1;
+}
+
+static uint32_t bench_shapeDecode(const uint8_t *buffer)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+    uint32_t sum = 0;
+    int8_t result = otapp_msg_tlv_iterFirst(&iter, buffer, BENCH_BUF_SIZE, &item);
+
+    while (result == OT_APP_MSG_TLV_OK)
+    {
+        sum += item.key + item.length + item.value[0] + item.value[item.length - 1];
+        result = otapp_msg_tlv_iterNext(&iter, &item);
+    }
+    return result == OT_APP_MSG_TLV_END ? sum : 0;
+}
+
+static int bench_speed(uint32_t reps)
+{
+    static uint8_t buffer[BENCH_BUF_SIZE];
+    static const char *formatName[] = { "classic", "compact" };
+    bench_shape_t shapes[3];
+    uint64_t start, encodeNs, decodeNs, keyGetNs;
+    uint16_t used = 0;
+    uint16_t length;
+
+    memset(shapes, 0, sizeof(shapes));
+    bench_shapesInit(shapes);
+
+    printf("shape,format,keys,payload_bytes,encode_mb_s,decode_mb_s,encode_ns_per_key,decode_ns_per_key,keyget_ns_per_key\n");
+
+    for (uint8_t s = 0; s < BENCH_ARRAY_SIZE(shapes); s++)
+    {
+        for (uint8_t format = OT_APP_MSG_TLV_FORMAT_CLASSIC; format <= OT_APP_MSG_TLV_FORMAT_COMPACT; format++)
+        {
+            const bench_shape_t *shape = &shapes[s];
+
+            memset(buffer, 0, sizeof(buffer));
+            start = bench_now_ns();
+            for (uint32_t r = 0; r < reps; r++)
+            {
+                if(bench_shapeEncode(buffer, format, shape) != 0)
+                {
+                    fprintf(stderr, "%s %s: encode error\n", shape->name, formatName[format]);
+                    return 1;
+                }
+            }
+            encodeNs = bench_now_ns() - start;
+
+            if(otapp_msg_tlv_getBufferTotalUsedSpace(buffer, BENCH_BUF_SIZE, &used) != OT_APP_MSG_TLV_OK || bench_shapeDecode(buffer) == 0)
+            {
+                fprintf(stderr, "%s %s: decode error\n", shape->name, formatName[format]);
+                return 1;
+            }
+
+            start = bench_now_ns();
+            for (uint32_t r = 0; r < reps; r++)
+            {
+                bench_sink += bench_shapeDecode(buffer);
+            }
+            decodeNs = bench_now_ns() - start;
+
+            // keyGet rescans from the start for every key: O(n^2) for the whole payload
+            start = bench_now_ns();
+            for (uint32_t r = 0; r < reps; r++)
+            {
+                for (uint8_t i = 0; i < shape->keys; i++)
+                {
+                    if(otapp_msg_tlv_keyGet(buffer, BENCH_BUF_SIZE, BENCH_KEY_PATTERN + i, &length, NULL) != OT_APP_MSG_TLV_KEY_EXIST)
+                    {
+                        fprintf(stderr, "%s %s: keyGet error\n", shape->name, formatName[format]);
+                        return 1;
+                    }
+                    bench_sink += length;
+                }
+            }
+            keyGetNs = bench_now_ns() - start;
+
+            const double bytes = (double)used * reps;
+            const double keys = (double)shape->keys * reps;
+            printf("%s,%s,%u,%u,%.1f,%.1f,%.1f,%.1f,%.1f\n", shape->name, formatName[format], shape->keys, used,
+                   bytes * 1e3 / (double)(encodeNs ? encodeNs : 1),
+                   bytes * 1e3 / (double)(decodeNs ? decodeNs : 1),
+                   (double)encodeNs / keys, (double)decodeNs / keys, (double)keyGetNs / keys);
+        }
+    }
+
+    return 0;
+}
+
+static int bench_size(void)
+{
+    static uint8_t classic[BENCH_BUF_SIZE];
+    static uint8_t compact[BENCH_BUF_SIZE];
+    uint16_t blocks = 0;
+
+    printf("payload,blocks,classic_bytes,compact_bytes,saved_bytes,saved_pct\n");
+
+    for (uint8_t uriQty = 1; uriQty <= BENCH_ARRAY_SIZE(bench_uri); uriQty++)
+    {
+        int classicBytes = bench_wellKnownCore(classic, OT_APP_MSG_TLV_FORMAT_CLASSIC, uriQty, &blocks);
+        int compactBytes = bench_wellKnownCore(compact, OT_APP_MSG_TLV_FORMAT_COMPACT, uriQty, &blocks);
+
+        if(classicBytes < 0 || compactBytes < 0 || !bench_sameContent(classic, compact))
+        {
+            fprintf(stderr, "well-known/core %u uris: encode / decode mismatch\n", uriQty);
+            return 1;
+        }
+
+        printf("well-known/core_%u_uris,%u,%d,%d,%d,%.1f\n", uriQty, blocks, classicBytes, compactBytes,
+               classicBytes - compactBytes, 100.0 * (classicBytes - compactBytes) / classicBytes);
+    }
+
+    return 0;
+}
+
+int main(int argc, const char **argv)
+{
+    uint8_t speed = 0;
+    uint32_t reps = BENCH_REPS;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "speed") == 0)
+        {
+            speed = 1;
+        }
+        else if(strcmp(argv[i], "--quick") == 0)
+        {
+            reps = BENCH_REPS_QUICK;
+        }
+        else if(strcmp(argv[i], "size") != 0)
+        {
+            fprintf(stderr, "usage: %s [size|speed] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    return speed ? bench_speed(reps) : bench_size();
+}
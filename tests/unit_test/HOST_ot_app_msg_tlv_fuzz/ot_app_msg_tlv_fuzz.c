@@ -0,0 +1,403 @@
+/**
+ * @file ot_app_msg_tlv_fuzz.c
+ * @brief Fuzz target of the TLV codec and the pairing parsers (untrusted radio input).
+ *
+ * One input is used in three ways:
+ * - as a raw TLV buffer: iterate, keyGet, keyAdd, keyUpdate / keyDelete, strict builder,
+ * - as a well-known/core payload for otapp_pair_uriParseMessage() (RAM buffer),
+ * - as a CoAP payload for otapp_pair_uriParseOtMessage() (otMessage fakes), the result is
+ *   compared with the RAM buffer parser.
+ * Every buffer is heap allocated with the exact input size, so ASan reports any overread.
+ * Broken invariants call abort().
+ *
+ * Build with libFuzzer (clang):
+ *   cmake -DENABLE_LIBFUZZER=ON -DCMAKE_C_COMPILER=clang -S tests/unit_test -B build/fuzz
+ *   build/fuzz/HOST_ot_app_msg_tlv_fuzz/HOST_ot_app_msg_tlv_fuzz corpus/
+ *
+ * Standalone (gcc, run by ctest):
+ *   HOST_ot_app_msg_tlv_fuzz                  seeds + deterministic mutations
+ *   HOST_ot_app_msg_tlv_fuzz -n 1000000       more mutations
+ *   HOST_ot_app_msg_tlv_fuzz -w corpus/       write the seeds as a libFuzzer corpus
+ *   HOST_ot_app_msg_tlv_fuzz crash-1234 ...   replay files (e.g. libFuzzer crash reproducers)
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "ot_app_msg_tlv.h"
+#include "ot_app_msg_tlv_msg.h"
+#include "ot_app_pair.h"
+#include "mock_ot_message.h"
+
+#define FUZZ_INPUT_MAX          1024
+#define FUZZ_KEY_PATTERN        0xAA00  // as OTAPP_PAIR_KEY_PATTERN
+
+#define FUZZ_ASSERT(cond) do { if(!(cond)) { fprintf(stderr, "FUZZ_ASSERT %s:%d: %s\n", __FILE__, __LINE__, #cond); abort(); } } while (0)
+
+static void fuzz_checkIterBounds(const uint8_t *buf, size_t size, const otapp_msg_tlv_item_t *item)
+{
+    FUZZ_ASSERT(item->value >= buf && item->value + item->length <= buf + size);
+}
+
+// returns 1 when the whole buffer decodes to OT_APP_MSG_TLV_END
+static int fuzz_iterAll(const uint8_t *buf, size_t size, uint16_t *keyFirstOut)
+{
+    otapp_msg_tlv_iter_t iter;
+    otapp_msg_tlv_item_t item;
+    int8_t result = otapp_msg_tlv_iterFirst(&iter, buf, (uint16_t)size, &item);
+
+    if(result == OT_APP_MSG_TLV_OK && keyFirstOut != NULL)
+    {
+        *keyFirstOut = item.key;
+    }
+    while (result == OT_APP_MSG_TLV_OK)
+    {
+        fuzz_checkIterBounds(buf, size, &item);
+        result = otapp_msg_tlv_iterNext(&iter, &item);
+    }
+    return result == OT_APP_MSG_TLV_END;
+}
+
+static void fuzz_keyGetCheck(const uint8_t *buf, size_t size, uint16_t key)
+{
+    static uint8_t value[FUZZ_INPUT_MAX];
+    uint16_t length = 0;
+
+    if(otapp_msg_tlv_keyGet(buf, (uint16_t)size, key, &length, NULL) != OT_APP_MSG_TLV_KEY_EXIST)
+    {
+        return;
+    }
+    FUZZ_ASSERT(length <= size);
+    FUZZ_ASSERT(otapp_msg_tlv_keyGet(buf, (uint16_t)size, key, &length, value) == OT_APP_MSG_TLV_KEY_EXIST);
+}
+
+static void fuzz_tlvBuffer(const uint8_t *data, size_t size)
+{
+    static uint8_t valueOut[FUZZ_INPUT_MAX];
+    uint16_t keyFirst = 0;
+    uint16_t length = 0;
+    uint8_t *buf;
+    int valid;
+
+    if(size < OT_APP_MSG_TLV_RESERVED_SIZE || size > FUZZ_INPUT_MAX)
+    {
+        return;
+    }
+    buf = malloc(size);
+    memcpy(buf, data, size);
+
+    valid = fuzz_iterAll(buf, size, &keyFirst);
+    fuzz_keyGetCheck(buf, size, keyFirst);
+    fuzz_keyGetCheck(buf, size, 0xFFFF);
+
+    // append a key taken from the input: when accepted it must be readable back unchanged
+    const uint16_t keyNew = (uint16_t)(data[0] | (data[1] << 8)) ^ 0x5A5A;
+    const uint16_t lengthNew = (uint16_t)(data[size - 1] % 48) + 1;
+    if(otapp_msg_tlv_keyAdd(buf, (uint16_t)size, keyNew, lengthNew, data) == OT_APP_MSG_TLV_OK)
+    {
+        FUZZ_ASSERT(otapp_msg_tlv_keyGet(buf, (uint16_t)size, keyNew, &length, valueOut) == OT_APP_MSG_TLV_KEY_EXIST);
+        FUZZ_ASSERT(length == lengthNew && memcmp(valueOut, data, length) == 0);
+        valid = fuzz_iterAll(buf, size, NULL);
+    }
+
+    // patching a well formed buffer keeps it well formed
+    if(valid)
+    {
+        if(otapp_msg_tlv_keyUpdate(buf, (uint16_t)size, keyFirst, lengthNew, data) == OT_APP_MSG_TLV_OK)
+        {
+            FUZZ_ASSERT(fuzz_iterAll(buf, size, NULL));
+        }
+        if(otapp_msg_tlv_keyDelete(buf, (uint16_t)size, keyFirst) == OT_APP_MSG_TLV_OK)
+        {
+            FUZZ_ASSERT(fuzz_iterAll(buf, size, NULL));
+        }
+    }
+
+    // strict builder over whatever is left
+    otapp_msg_tlv_builder_t builder;
+    memcpy(buf, data, size);
+    if(otapp_msg_tlv_builderInit(&builder, buf, (uint16_t)size, OT_APP_MSG_TLV_BUILDER_STRICT) == OT_APP_MSG_TLV_OK)
+    {
+        if(otapp_msg_tlv_builderAdd(&builder, keyNew, lengthNew, data) == OT_APP_MSG_TLV_OK)
+        {
+            FUZZ_ASSERT(otapp_msg_tlv_keyGet(buf, (uint16_t)size, keyNew, &length, valueOut) == OT_APP_MSG_TLV_KEY_EXIST);
+        }
+    }
+
+    free(buf);
+}
+
+static void fuzz_checkUris(const otapp_pair_resUrisParseData_t *uris, uint16_t urisQty)
+{
+    for (uint16_t i = 0; i < urisQty; i++)
+    {
+        FUZZ_ASSERT(memchr(uris[i].uri, '\0', sizeof(uris[i].uri)) != NULL);
+        FUZZ_ASSERT(uris[i].obs == 1);
+    }
+}
+
+// otMessage fakes reading the fuzz input
+static const uint8_t *fuzz_msgData;
+static uint16_t fuzz_msgLength;
+
+static uint16_t fuzz_messageGetLength(const otMessage *aMessage)
+{
+    (void)aMessage;
+    return fuzz_msgLength;
+}
+
+static uint16_t fuzz_messageRead(const otMessage *aMessage, uint16_t aOffset, void *aBuf, uint16_t aLength)
+{
+    (void)aMessage;
+    if(aOffset >= fuzz_msgLength) return 0;
+    if(aLength > fuzz_msgLength - aOffset) aLength = fuzz_msgLength - aOffset;
+    memcpy(aBuf, &fuzz_msgData[aOffset], aLength);
+    return aLength;
+}
+
+static void fuzz_pairParsers(const uint8_t *data, size_t size)
+{
+    otapp_pair_resUrisParseData_t urisMsg[OTAPP_PAIR_URI_MAX];
+    otapp_pair_resUrisParseData_t *urisBuf;
+    uint16_t urisBufQty = 0;
+    uint16_t urisMsgQty = 0;
+    int8_t resultBuf = OTAPP_PAIR_ERROR;
+    int8_t resultMsg;
+    static otMessage message;
+    uint8_t *msg;
+    uint8_t *buf;
+
+    if(size > FUZZ_INPUT_MAX)
+    {
+        return;
+    }
+
+    // RAM buffer parser: input + alignment padding + space for the parsed structs
+    const size_t bufSize = size + _Alignof(otapp_pair_resUrisParseData_t) - 1 + OTAPP_PAIR_URI_MAX * sizeof(otapp_pair_resUrisParseData_t);
+    buf = malloc(bufSize);
+    memcpy(buf, data, size);
+    memset(buf + size, 0, bufSize - size);
+    urisBuf = otapp_pair_uriParseMessage(buf, (uint16_t)bufSize, &resultBuf, &urisBufQty);
+    if(resultBuf == OTAPP_PAIR_OK)
+    {
+        FUZZ_ASSERT(urisBuf != NULL);
+        FUZZ_ASSERT((const uint8_t *)(urisBuf + urisBufQty) <= buf + bufSize);
+        fuzz_checkUris(urisBuf, urisBufQty);
+    }
+
+    // otMessage parser on an exact size copy
+    msg = malloc(size ? size : 1);
+    memcpy(msg, data, size);
+    fuzz_msgData   = msg;
+    fuzz_msgLength = (uint16_t)size;
+    otMessageGetLength_fake.custom_fake = fuzz_messageGetLength;
+    otMessageRead_fake.custom_fake      = fuzz_messageRead;
+
+    resultMsg = otapp_pair_uriParseOtMessage(&message, 0, urisMsg, OTAPP_PAIR_URI_MAX, &urisMsgQty);
+    if(resultMsg == OTAPP_PAIR_OK)
+    {
+        FUZZ_ASSERT(urisMsgQty <= OTAPP_PAIR_URI_MAX);
+        fuzz_checkUris(urisMsg, urisMsgQty);
+    }
+
+    // both parsers see the same bytes, they may only differ by the URI_MAX limit of the array and
+    // when the header claims more TLV data than the input (RAM parser then reads its output space)
+    uint16_t usedBufSpace = 0;
+    otapp_msg_tlv_getBufferTotalUsedSpace(buf, (uint16_t)bufSize, &usedBufSpace);
+    if(resultBuf == OTAPP_PAIR_OK && urisBufQty <= OTAPP_PAIR_URI_MAX && usedBufSpace <= size)
+    {
+        FUZZ_ASSERT(resultMsg == OTAPP_PAIR_OK && urisMsgQty == urisBufQty);
+        FUZZ_ASSERT(memcmp(urisMsg, urisBuf, urisMsgQty * sizeof(otapp_pair_resUrisParseData_t)) == 0);
+    }
+    if(resultMsg == OTAPP_PAIR_OK)
+    {
+        FUZZ_ASSERT(resultBuf == OTAPP_PAIR_OK);
+    }
+
+    free(msg);
+    free(buf);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    fuzz_tlvBuffer(data, size);
+    fuzz_pairParsers(data, size);
+    return 0;
+}
+
+#ifndef OTAPP_FUZZ_LIBFUZZER
+
+#define FUZZ_MUTATIONS_DEFAULT  20000
+#define FUZZ_SEEDS_MAX          16
+
+typedef struct {
+    uint8_t data[FUZZ_INPUT_MAX];
+    uint16_t size;
+} fuzz_seed_t;
+
+static fuzz_seed_t fuzz_seeds[FUZZ_SEEDS_MAX];
+static uint8_t fuzz_seedsQty;
+
+static const char *fuzz_uri[] = { "light/on_off", "light/dimm", "btn/state", "test/led", "diag/buf" };
+
+static void fuzz_seedWellKnownCore(uint8_t format, uint8_t uriQty)
+{
+    fuzz_seed_t *seed = &fuzz_seeds[fuzz_seedsQty++];
+    otapp_msg_tlv_builder_t builder;
+    uint32_t devType;
+
+    memset(seed->data, 0, sizeof(seed->data));
+    otapp_msg_tlv_formatSet(seed->data, 256, format);
+    otapp_msg_tlv_builderInit(&builder, seed->data, 256, OT_APP_MSG_TLV_BUILDER_TRUSTED);
+    otapp_msg_tlv_builderAdd(&builder, FUZZ_KEY_PATTERN, sizeof(uriQty), &uriQty);
+    for (uint8_t i = 0; i < uriQty; i++)
+    {
+        devType = i + 1;
+        otapp_msg_tlv_builderAdd(&builder, FUZZ_KEY_PATTERN + 2*i + 1, sizeof(devType), (const uint8_t *)&devType);
+        otapp_msg_tlv_builderAdd(&builder, FUZZ_KEY_PATTERN + 2*i + 2, strlen(fuzz_uri[i]), (const uint8_t *)fuzz_uri[i]);
+    }
+    otapp_msg_tlv_getBufferTotalUsedSpace(seed->data, 256, &seed->size);
+    seed->size += 16; // free space for keyAdd
+}
+
+static void fuzz_seedsInit(void)
+{
+    static const uint8_t value[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+    for (uint8_t uriQty = 1; uriQty <= 5; uriQty += 2)
+    {
+        fuzz_seedWellKnownCore(OT_APP_MSG_TLV_FORMAT_CLASSIC, uriQty);
+        fuzz_seedWellKnownCore(OT_APP_MSG_TLV_FORMAT_COMPACT, uriQty);
+    }
+
+    // generic buffer: a few keys, free space at the end
+    fuzz_seed_t *seed = &fuzz_seeds[fuzz_seedsQty++];
+    memset(seed->data, 0, sizeof(seed->data));
+    otapp_msg_tlv_keyAdd(seed->data, 64, 0x0001, 4, value);
+    otapp_msg_tlv_keyAdd(seed->data, 64, 0x0100, 8, value);
+    otapp_msg_tlv_keyAdd(seed->data, 64, 0xFFFF, 1, value);
+    seed->size = 64;
+
+    // empty buffer
+    seed = &fuzz_seeds[fuzz_seedsQty++];
+    memset(seed->data, 0, sizeof(seed->data));
+    seed->size = 32;
+}
+
+static uint32_t fuzz_rand(void)
+{
+    static uint32_t state = 0x12345678;  // fixed seed: reproducible runs
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static uint16_t fuzz_mutate(uint8_t *data, uint16_t size)
+{
+    const uint8_t ops = 1 + fuzz_rand() % 4;
+
+    for (uint8_t i = 0; i < ops && size > 0; i++)
+    {
+        const uint16_t pos = fuzz_rand() % size;
+        switch (fuzz_rand() % 5)
+        {
+            case 0: data[pos] ^= (uint8_t)(1 << (fuzz_rand() % 8)); break;          // bit flip
+            case 1: data[pos] = (uint8_t)fuzz_rand(); break;                         // random byte
+            case 2: data[fuzz_rand() % 2] = (uint8_t)fuzz_rand(); break;             // reserved header
+            case 3: size = pos; break;                                               // truncate
+            default:                                                                 // interesting values
+            {
+                static const uint8_t interesting[] = {0x00, 0x01, 0x7F, 0x80, 0xFF};
+                data[pos] = interesting[fuzz_rand() % sizeof(interesting)];
+                break;
+            }
+        }
+    }
+    return size;
+}
+
+static int fuzz_writeCorpus(const char *dir)
+{
+    char path[512];
+
+    for (uint8_t i = 0; i < fuzz_seedsQty; i++)
+    {
+        snprintf(path, sizeof(path), "%s/seed_%02u.bin", dir, i);
+        FILE *file = fopen(path, "wb");
+        if(file == NULL)
+        {
+            fprintf(stderr, "cannot write %s\n", path);
+            return 1;
+        }
+        fwrite(fuzz_seeds[i].data, 1, fuzz_seeds[i].size, file);
+        fclose(file);
+    }
+    printf("%u seeds written to %s\n", fuzz_seedsQty, dir);
+    return 0;
+}
+
+static int fuzz_replayFile(const char *path)
+{
+    static uint8_t data[FUZZ_INPUT_MAX];
+    FILE *file = fopen(path, "rb");
+
+    if(file == NULL)
+    {
+        fprintf(stderr, "cannot read %s\n", path);
+        return 1;
+    }
+    size_t size = fread(data, 1, sizeof(data), file);
+    fclose(file);
+
+    LLVMFuzzerTestOneInput(data, size);
+    printf("%s: %zu bytes OK\n", path, size);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    static uint8_t data[FUZZ_INPUT_MAX];
+    uint32_t mutations = FUZZ_MUTATIONS_DEFAULT;
+    int result = 0;
+    int files = 0;
+
+    fuzz_seedsInit();
+
+    for (int i = 1; i < argc; i++)
+    {
+        if(strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+        {
+            mutations = (uint32_t)strtoul(argv[++i], NULL, 0);
+        }else if(strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+        {
+            return fuzz_writeCorpus(argv[++i]);
+        }else
+        {
+            result |= fuzz_replayFile(argv[i]);
+            files++;
+        }
+    }
+    if(files > 0)
+    {
+        return result;
+    }
+
+    for (uint8_t i = 0; i < fuzz_seedsQty; i++)
+    {
+        LLVMFuzzerTestOneInput(fuzz_seeds[i].data, fuzz_seeds[i].size);
+    }
+
+    for (uint32_t n = 0; n < mutations; n++)
+    {
+        const fuzz_seed_t *seed = &fuzz_seeds[fuzz_rand() % fuzz_seedsQty];
+        memcpy(data, seed->data, seed->size);
+        LLVMFuzzerTestOneInput(data, fuzz_mutate(data, seed->size));
+    }
+
+    printf("%u seeds, %u mutated inputs: OK\n", fuzz_seedsQty, mutations);
+    return 0;
+}
+
+#endif  /* OTAPP_FUZZ_LIBFUZZER */
@@ -84,6 +84,12 @@ TEST_GROUP_RUNNER(ot_app_pair_UriIndex)
    RUN_TEST_CASE(ot_app_pair_UriIndex, GivenTrueArgsSize3_WhenCallinguriParseMessage_ThenReturnOK);
    RUN_TEST_CASE(ot_app_pair_UriIndex, GivenTrueArgsSizeMax_WhenCallinguriParseMessage_ThenReturnOK);
    RUN_TEST_CASE(ot_app_pair_UriIndex, GivenOverflowSize_WhenCallinguriParseMessage_ThenReturnError);
+   RUN_TEST_CASE(ot_app_pair_UriIndex, GivenOddBufferOffset_WhenCallinguriParseMessage_ThenParsedDataIsAligned);
+
+   // otapp_pair_uriResourcesAppend / otapp_pair_uriParseOtMessage
+   RUN_TEST_CASE(ot_app_pair_UriIndex, GivenTrueArgs_WhenCallingUriResourcesAppend_ThenSameBytesAsUriResourcesCreate);
+   RUN_TEST_CASE(ot_app_pair_UriIndex, GivenAppendedUris_WhenCallingUriParseOtMessage_ThenReturnOK);
+   RUN_TEST_CASE(ot_app_pair_UriIndex, GivenMoreUrisThanOutArray_WhenCallingUriParseOtMessage_ThenReturnError);
 
    //otapp_pair_uriAdd
    RUN_TEST_CASE(ot_app_pair_UriIndex, GivenNullDeviceUrisList_WhenCallingUriAdd_ThenReturnError);
@@ -1,6 +1,7 @@
 #include "unity_fixture.h"
 #include "ot_app_pair.h"
 #include "ot_app_msg_tlv.h"
+#include "mock_ot_message.h"
 #define TEST_P_MSG_TLV_ONE_KEY_LENGTH_BYTES 4
 #define TEST_P_MSG_TLV_RESERVED_BYTES 2
 #define TEST_P_MSG_TLV_RESERVED_BYTES_FOR_1_KEY_INFO (TEST_MSG_TLV_ONE_KEY_LENGTH_BYTES + TEST_MSG_TLV_RESERVED_BYTES)
@@ -24,6 +25,8 @@
 #define TEST_PAIR_TLV_FIRST_BYTES (TEST_P_MSG_TLV_RESERVED_BYTES + TEST_P_MSG_TLV_ONE_KEY_LENGTH_BYTES + 1 )
 #define TEST_PAIR_TLV_URI_QTY(x)  (TEST_PAIR_TLV_FIRST_BYTES + ((x) * 2 * TEST_P_MSG_TLV_ONE_KEY_LENGTH_BYTES))
 #define TEST_PAIR_TLV_URI_DATA_SIZE(uriPath, devType)  (strlen(uriPath) + sizeof(devType))
+// parsed structs start at the next aligned address after the TLV data
+#define TEST_PAIR_PARSE_PADDING(buf, used)  ((_Alignof(otapp_pair_resUrisParseData_t) - ((uintptr_t)((buf) + (used)) % _Alignof(otapp_pair_resUrisParseData_t))) % _Alignof(otapp_pair_resUrisParseData_t))
 
 #define TEST_PAIR_BUFFER_SIZE 1024
 static uint8_t buffer[TEST_PAIR_BUFFER_SIZE];
@@ -287,7 +290,7 @@ TEST(ot_app_pair_UriIndex, GivenTrueArgsSizeMax_WhenCallinguriParseMessage_ThenR
     
     result = otapp_pair_uriResourcesCreate(coap_uri, uriQty, buffer, &bufferSize);
 
-    bufferMinimalSize = bufferSize_expected + (uriQty * sizeof(otapp_pair_resUrisParseData_t));
+    bufferMinimalSize = bufferSize_expected + TEST_PAIR_PARSE_PADDING(buffer, bufferSize_expected) + (uriQty * sizeof(otapp_pair_resUrisParseData_t));
 
     parsedData = otapp_pair_uriParseMessage(buffer, bufferMinimalSize, &result, &parsedDataSize);
     TEST_ASSERT_NOT_EQUAL(NULL, parsedData);
@@ -312,13 +315,151 @@ TEST(ot_app_pair_UriIndex, GivenOverflowSize_WhenCallinguriParseMessage_ThenRetu
     
     result = otapp_pair_uriResourcesCreate(coap_uri, uriQty, buffer, &bufferSize);
 
-    bufferMinimalSize = bufferSize_expected + (uriQty * sizeof(otapp_pair_resUrisParseData_t));
+    bufferMinimalSize = bufferSize_expected + TEST_PAIR_PARSE_PADDING(buffer, bufferSize_expected) + (uriQty * sizeof(otapp_pair_resUrisParseData_t));
 
     parsedData = otapp_pair_uriParseMessage(buffer, bufferMinimalSize - 1, &result, &parsedDataSize);
     TEST_ASSERT_EQUAL(OTAPP_PAIR_ERROR, result);
     TEST_ASSERT_EQUAL(NULL, parsedData);
 }
 
+TEST(ot_app_pair_UriIndex, GivenOddBufferOffset_WhenCallinguriParseMessage_ThenParsedDataIsAligned)
+{
+    int8_t result;
+    uint16_t bufferSize;
+    uint16_t parsedDataSize;
+    otapp_pair_resUrisParseData_t *parsedData;
+
+    // every uri count gives another TLV length, the buffer starts at an odd address
+    for (uint8_t uriQty = 1; uriQty <= UT_OAP_URI_SIZE; uriQty++)
+    {
+        for (uint8_t offset = 1; offset < _Alignof(otapp_pair_resUrisParseData_t) + 1; offset++)
+        {
+            memset(buffer, 0, TEST_PAIR_BUFFER_SIZE);
+            bufferSize = TEST_PAIR_BUFFER_SIZE - offset;
+            result = otapp_pair_uriResourcesCreate(coap_uri, uriQty, buffer + offset, &bufferSize);
+            TEST_ASSERT_EQUAL(OTAPP_PAIR_OK, result);
+
+            bufferSize = otapp_pair_uriParseMessageCalculateBufSize(bufferSize);
+            TEST_ASSERT_TRUE(bufferSize <= TEST_PAIR_BUFFER_SIZE - offset);
+
+            parsedDataSize = 0;
+            parsedData = otapp_pair_uriParseMessage(buffer + offset, bufferSize, &result, &parsedDataSize);
+            TEST_ASSERT_EQUAL(OTAPP_PAIR_OK, result);
+            TEST_ASSERT_NOT_EQUAL(NULL, parsedData);
+            TEST_ASSERT_EQUAL(uriQty, parsedDataSize);
+            TEST_ASSERT_EQUAL(0, (uintptr_t)parsedData % _Alignof(otapp_pair_resUrisParseData_t));
+            TEST_ASSERT_TRUE((uint8_t *)(parsedData + parsedDataSize) <= buffer + offset + bufferSize);
+        }
+    }
+}
+
+// otapp_pair_uriResourcesAppend / otapp_pair_uriParseOtMessage, otMessage backed by buffer[]
+#define TEST_PAIR_MSG_OFFSET 4  // simulated CoAP header before the payload
+static otMessage testPairMessage;
+static uint16_t testPairMessageLength;
+
+static uint16_t test_pair_messageGetLength(const otMessage *aMessage)
+{
+    (void)aMessage;
+    return testPairMessageLength;
+}
+
+static uint16_t test_pair_messageRead(const otMessage *aMessage, uint16_t aOffset, void *aBuf, uint16_t aLength)
+{
+    (void)aMessage;
+    if(aOffset >= testPairMessageLength) return 0;
+    if(aLength > testPairMessageLength - aOffset) aLength = testPairMessageLength - aOffset;
+    memcpy(aBuf, &buffer[aOffset], aLength);
+    return aLength;
+}
+
+static otError test_pair_messageAppend(otMessage *aMessage, const void *aBuf, uint16_t aLength)
+{
+    (void)aMessage;
+    if(aLength > TEST_PAIR_BUFFER_SIZE - testPairMessageLength) return OT_ERROR_NO_BUFS;
+    memcpy(&buffer[testPairMessageLength], aBuf, aLength);
+    testPairMessageLength += aLength;
+    return OT_ERROR_NONE;
+}
+
+static int test_pair_messageWrite(otMessage *aMessage, uint16_t aOffset, const void *aBuf, uint16_t aLength)
+{
+    (void)aMessage;
+    if(aOffset >= testPairMessageLength) return 0;
+    if(aLength > testPairMessageLength - aOffset) aLength = testPairMessageLength - aOffset;
+    memcpy(&buffer[aOffset], aBuf, aLength);
+    return aLength;
+}
+
+static void test_pair_messageInit(void)
+{
+    RESET_FAKE(otMessageGetLength);
+    RESET_FAKE(otMessageRead);
+    RESET_FAKE(otMessageAppend);
+    RESET_FAKE(otMessageWrite);
+    testPairMessageLength = TEST_PAIR_MSG_OFFSET;
+
+    otMessageGetLength_fake.custom_fake = test_pair_messageGetLength;
+    otMessageRead_fake.custom_fake      = test_pair_messageRead;
+    otMessageAppend_fake.custom_fake    = test_pair_messageAppend;
+    otMessageWrite_fake.custom_fake     = test_pair_messageWrite;
+}
+
+TEST(ot_app_pair_UriIndex, GivenTrueArgs_WhenCallingUriResourcesAppend_ThenSameBytesAsUriResourcesCreate)
+{
+    uint8_t uriQty = 3;
+    uint8_t bufferCreate[TEST_PAIR_BUFFER_SIZE] = {0};
+    uint16_t bufferCreateSize = TEST_PAIR_BUFFER_SIZE;
+    uint16_t appendedSize = 0;
+
+    test_pair_messageInit();
+
+    TEST_ASSERT_EQUAL(OTAPP_PAIR_ERROR, otapp_pair_uriResourcesAppend(coap_uri, uriQty, NULL, &appendedSize));
+    TEST_ASSERT_EQUAL(OTAPP_PAIR_ERROR, otapp_pair_uriResourcesAppend(coap_uri, 0, &testPairMessage, &appendedSize));
+
+    TEST_ASSERT_EQUAL(OTAPP_PAIR_OK, otapp_pair_uriResourcesCreate(coap_uri, uriQty, bufferCreate, &bufferCreateSize));
+    TEST_ASSERT_EQUAL(OTAPP_PAIR_OK, otapp_pair_uriResourcesAppend(coap_uri, uriQty, &testPairMessage, &appendedSize));
+
+    TEST_ASSERT_EQUAL(bufferCreateSize, appendedSize);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(bufferCreate, &buffer[TEST_PAIR_MSG_OFFSET], appendedSize);
+}
+
+TEST(ot_app_pair_UriIndex, GivenAppendedUris_WhenCallingUriParseOtMessage_ThenReturnOK)
+{
+    uint8_t uriQty = 3;
+    otapp_pair_resUrisParseData_t parsedData[OTAPP_PAIR_URI_MAX];
+    uint16_t parsedDataSize = 0;
+
+    test_pair_messageInit();
+    TEST_ASSERT_EQUAL(OTAPP_PAIR_OK, otapp_pair_uriResourcesAppend(coap_uri, uriQty, &testPairMessage, NULL));
+
+    TEST_ASSERT_EQUAL(OTAPP_PAIR_OK, otapp_pair_uriParseOtMessage(&testPairMessage, TEST_PAIR_MSG_OFFSET, parsedData, OTAPP_PAIR_URI_MAX, &parsedDataSize));
+    TEST_ASSERT_EQUAL(uriQty, parsedDataSize);
+
+    for (uint8_t i = 0; i < uriQty; i++)
+    {
+        TEST_ASSERT_EQUAL(coap_uri[i].devType, parsedData[i].devTypeUriFn);
+        TEST_ASSERT_EQUAL_STRING(coap_uri[i].resource.mUriPath, parsedData[i].uri);
+        TEST_ASSERT_EQUAL(1, parsedData[i].obs);
+    }
+}
+
+TEST(ot_app_pair_UriIndex, GivenMoreUrisThanOutArray_WhenCallingUriParseOtMessage_ThenReturnError)
+{
+    uint8_t uriQty = 3;
+    otapp_pair_resUrisParseData_t parsedData[OTAPP_PAIR_URI_MAX];
+    uint16_t parsedDataSize = 0;
+
+    test_pair_messageInit();
+    TEST_ASSERT_EQUAL(OTAPP_PAIR_OK, otapp_pair_uriResourcesAppend(coap_uri, uriQty, &testPairMessage, NULL));
+
+    TEST_ASSERT_EQUAL(OTAPP_PAIR_ERROR, otapp_pair_uriParseOtMessage(NULL, TEST_PAIR_MSG_OFFSET, parsedData, OTAPP_PAIR_URI_MAX, &parsedDataSize));
+    TEST_ASSERT_EQUAL(OTAPP_PAIR_ERROR, otapp_pair_uriParseOtMessage(&testPairMessage, TEST_PAIR_MSG_OFFSET, parsedData, uriQty - 1, &parsedDataSize));
+
+    testPairMessageLength--; // payload truncated
+    TEST_ASSERT_EQUAL(OTAPP_PAIR_ERROR, otapp_pair_uriParseOtMessage(&testPairMessage, TEST_PAIR_MSG_OFFSET, parsedData, OTAPP_PAIR_URI_MAX, &parsedDataSize));
+}
+
 //otapp_pair_uriAdd
 TEST(ot_app_pair_UriIndex, GivenNullDeviceUrisList_WhenCallingUriAdd_ThenReturnError)
 {
@@ -51,6 +51,7 @@
 #define HRO_TOOL_PACKED_FIELD   __attribute__((packed))
 #define HRO_TOOL_PACKED_END     __attribute__((packed))
 #define HRO_TOOL_WEAK           __attribute__((weak))
+#define HRO_TOOL_CLEANUP(fn)    __attribute__((cleanup(fn)))
 
 #define HRO_ALIGN_16            __attribute__ ((aligned (16)))
 #define HRO_ALIGN_4            __attribute__ ((aligned (4)))